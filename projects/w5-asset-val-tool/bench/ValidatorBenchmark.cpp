@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <fmt/core.h>
+#include "AssetLoader.h"
+#include "DegenerateTriangleDetector.h"
+#include "DuplicateVertexDetector.h"
+#include "EdgeAdjacency.h"
+#include "HiddenGeometryAnalyzer.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
+#include "QuadOverdrawAnalyzer.h"
+#include "SelfIntersectionAnalyzer.h"
+#include "ThreadPool.h"
+#include "TriangleBVH.h"
+#include "Validator.h"
+#include "VertexKernels.h"
+
+// Synthetic workloads for the validator. Run with no arguments; every
+// scene is generated in memory so results do not depend on asset files.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Flat grid of gridSize x gridSize quads with planar UVs
+MeshData makeGridMesh(const std::string& name, uint32_t gridSize) {
+    MeshData mesh;
+    mesh.name = name;
+
+    const uint32_t rowVertices = gridSize + 1;
+    mesh.vertices.reserve(rowVertices * rowVertices);
+    mesh.normals.reserve(rowVertices * rowVertices);
+    mesh.uvCoords.reserve(rowVertices * rowVertices);
+    for (uint32_t y = 0; y <= gridSize; ++y) {
+        for (uint32_t x = 0; x <= gridSize; ++x) {
+            const float u = static_cast<float>(x) / gridSize;
+            const float v = static_cast<float>(y) / gridSize;
+            mesh.vertices.emplace_back(u, 0.0f, v);
+            mesh.normals.emplace_back(0.0f, 1.0f, 0.0f);
+            mesh.uvCoords.emplace_back(u, v);
+        }
+    }
+
+    mesh.indices.reserve(gridSize * gridSize * 6);
+    for (uint32_t y = 0; y < gridSize; ++y) {
+        for (uint32_t x = 0; x < gridSize; ++x) {
+            const uint32_t i0 = y * rowVertices + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + rowVertices;
+            const uint32_t i3 = i2 + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    }
+    mesh.triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    mesh.materialIndices.push_back(0);
+    return mesh;
+}
+
+SceneData makeScene(uint32_t meshCount, uint32_t gridSize) {
+    SceneData scene;
+    scene.filePath = "synthetic";
+    scene.meshes.reserve(meshCount);
+    for (uint32_t i = 0; i < meshCount; ++i) {
+        scene.meshes.push_back(makeGridMesh("mesh_" + std::to_string(i), gridSize));
+        scene.totalVertices += static_cast<uint32_t>(scene.meshes.back().vertices.size());
+        scene.totalTriangles += scene.meshes.back().triangleCount;
+    }
+
+    MaterialData material;
+    material.name = "material_0";
+    scene.materials.push_back(material);
+    return scene;
+}
+
+template <typename Fn>
+double bestOfMilliseconds(int repetitions, Fn&& fn) {
+    double best = 0.0;
+    for (int r = 0; r < repetitions; ++r) {
+        const auto start = Clock::now();
+        fn();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (r == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+// Validator::validate wall time from 1 to 32 threads on a 2,000-mesh scene
+void benchValidationScaling() {
+    const SceneData scene = makeScene(2000, 32);
+    fmt::print("== Validator::validate scaling ({} meshes, {} triangles) ==\n",
+               scene.meshes.size(), scene.totalTriangles);
+    fmt::print("{:>8} {:>12} {:>9}\n", "threads", "ms", "speedup");
+
+    double serialMs = 0.0;
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+        ValidationConfig config;
+        config.threadCount = threads;
+        Validator validator(config);
+
+        const double ms = bestOfMilliseconds(5, [&]() { validator.validate(scene); });
+        if (threads == 1) {
+            serialMs = ms;
+        }
+        fmt::print("{:>8} {:>12.2f} {:>8.2f}x\n", threads, ms, serialMs / ms);
+    }
+    fmt::print("\n");
+}
+
+// Per-stream kernel throughput for every instruction set this CPU supports
+void benchVertexKernels() {
+    const size_t vertexCount = 4 * 1024 * 1024;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-0.1f, 1.1f);
+
+    std::vector<glm::vec3> positions(vertexCount);
+    std::vector<glm::vec3> normals(vertexCount);
+    std::vector<glm::vec2> uvs(vertexCount);
+    std::vector<glm::vec3> tangents(vertexCount);
+    std::vector<glm::vec3> bitangents(vertexCount);
+    std::vector<int8_t> handedness(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        positions[i] = glm::vec3(dist(rng), dist(rng), dist(rng)) * 100.0f;
+        normals[i] = glm::normalize(glm::vec3(dist(rng) - 0.5f, dist(rng) - 0.5f, dist(rng) - 0.5f));
+        uvs[i] = glm::vec2(dist(rng), dist(rng));
+        tangents[i] = glm::vec3(dist(rng) - 0.5f, dist(rng) - 0.5f, dist(rng) - 0.5f);
+        bitangents[i] = glm::vec3(dist(rng) - 0.5f, dist(rng) - 0.5f, dist(rng) - 0.5f);
+    }
+
+    fmt::print("== Vertex stream kernels ({} vertices) ==\n", vertexCount);
+    fmt::print("{:>8} {:>16} {:>16} {:>16} {:>16}\n", "isa", "uv Mvert/s", "position Mvert/s", "normal Mvert/s",
+               "tangent Mvert/s");
+
+    const auto best = VertexKernels::getBestInstructionSet();
+    for (auto isa : {VertexKernels::InstructionSet::Scalar, VertexKernels::InstructionSet::SSE41,
+                     VertexKernels::InstructionSet::AVX2}) {
+        if (static_cast<int>(isa) > static_cast<int>(best)) {
+            continue;
+        }
+
+        const double uvMs = bestOfMilliseconds(10, [&]() {
+            VertexKernels::analyzeUVs(uvs.data(), uvs.size(), 0.001f, isa);
+        });
+        const double positionMs = bestOfMilliseconds(10, [&]() {
+            VertexKernels::analyzePositions(positions.data(), positions.size(), isa);
+        });
+        const double normalMs = bestOfMilliseconds(10, [&]() {
+            VertexKernels::analyzeNormals(normals.data(), normals.size(), isa);
+        });
+        const double tangentMs = bestOfMilliseconds(10, [&]() {
+            VertexKernels::analyzeTangents(normals.data(), tangents.data(), bitangents.data(), vertexCount,
+                                           handedness.data(), isa);
+        });
+
+        auto throughput = [&](double ms) { return vertexCount / (ms * 1000.0); };
+        fmt::print("{:>8} {:>16.1f} {:>16.1f} {:>16.1f} {:>16.1f}\n", VertexKernels::getInstructionSetName(isa),
+                   throughput(uvMs), throughput(positionMs), throughput(normalMs), throughput(tangentMs));
+    }
+    fmt::print("\n");
+}
+
+// Degenerate-triangle, duplicate-vertex, adjacency and quad-overdraw scans
+// over a 10M-triangle mesh
+void benchGeometryScans() {
+    const MeshData mesh = makeGridMesh("large", 2237);
+    fmt::print("== Geometry scans ({} vertices, {} triangles) ==\n", mesh.vertices.size(), mesh.triangleCount);
+    fmt::print("{:>8} {:>14} {:>14} {:>14} {:>14}\n", "threads", "degenerate ms", "duplicate ms", "adjacency ms",
+               "quad ms");
+
+    const DegenerateTriangleDetector degenerate(1e-10f, 1e-3f);
+    const DuplicateVertexDetector duplicates(1e-5f, 1e-3f);
+    const QuadOverdrawAnalyzer quads(1080, 60.0f);
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        const double degenerateMs = bestOfMilliseconds(3, [&]() {
+            degenerate.analyze(mesh.vertices, mesh.indices, pool);
+        });
+        const double duplicateMs = bestOfMilliseconds(3, [&]() {
+            duplicates.analyze(mesh.vertices, mesh.normals, mesh.uvCoords, mesh.tangents, mesh.bitangents, pool);
+        });
+        const double adjacencyMs = bestOfMilliseconds(3, [&]() {
+            EdgeAdjacency adjacency;
+            adjacency.build(mesh.indices, EdgeAdjacency::weldPositions(mesh.vertices, pool), mesh.vertices.size(), pool);
+            adjacency.analyzeTopology();
+        });
+        const double quadMs = bestOfMilliseconds(3, [&]() {
+            quads.profile(mesh.vertices, mesh.indices, mesh.worldTransform, pool);
+        });
+        fmt::print("{:>8} {:>14.2f} {:>14.2f} {:>14.2f} {:>14.2f}\n", threads, degenerateMs, duplicateMs, adjacencyMs,
+                   quadMs);
+    }
+    fmt::print("\n");
+}
+
+// LOD chain generation (50/25/10%) over a scene of mid-sized meshes; the
+// grids get a wave so collapses have a real error to rank by
+void benchSimplification() {
+    SceneData scene = makeScene(16, 256);
+    for (auto& mesh : scene.meshes) {
+        for (auto& p : mesh.vertices) {
+            p.y = 0.05f * std::sin(p.x * 20.0f) * std::cos(p.z * 20.0f);
+        }
+    }
+    fmt::print("== LOD generation ({} meshes, {} triangles) ==\n", scene.meshes.size(), scene.totalTriangles);
+    fmt::print("{:>8} {:>12} {:>9}\n", "threads", "ms", "speedup");
+
+    const MeshSimplifier simplifier(0.0f, 32);
+    const std::vector<float> ratios = {0.5f, 0.25f, 0.1f};
+    double serialMs = 0.0;
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        const double ms = bestOfMilliseconds(3, [&]() {
+            simplifier.buildSceneLods(scene, ratios, pool);
+        });
+        if (threads == 1) {
+            serialMs = ms;
+        }
+        fmt::print("{:>8} {:>12.2f} {:>8.2f}x\n", threads, ms, serialMs / ms);
+    }
+    fmt::print("\n");
+}
+
+// Hidden-geometry ray casting: BVH build time and ray throughput over 16
+// wavy grids, half of them sealed inside a box so their triangles cast
+// every ray
+void benchVisibility() {
+    SceneData scene = makeScene(16, 64);
+    for (size_t m = 0; m < scene.meshes.size(); ++m) {
+        for (auto& p : scene.meshes[m].vertices) {
+            p.y = 0.05f * std::sin(p.x * 20.0f) * std::cos(p.z * 20.0f);
+            p.x += 1.5f * static_cast<float>(m % 8);
+            p.z += m < 8 ? 0.0f : 3.0f;
+        }
+    }
+    MeshData box;
+    box.name = "box";
+    const glm::vec3 boxMin(-0.25f, -0.5f, 2.75f), boxMax(11.75f, 0.5f, 4.25f);
+    for (int corner = 0; corner < 8; ++corner) {
+        box.vertices.emplace_back(corner & 1 ? boxMax.x : boxMin.x, corner & 2 ? boxMax.y : boxMin.y,
+                                  corner & 4 ? boxMax.z : boxMin.z);
+    }
+    box.indices = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+                   2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+    box.triangleCount = 12;
+    scene.meshes.push_back(box);
+
+    std::vector<glm::vec3> corners;
+    for (const auto& mesh : scene.meshes) {
+        for (uint32_t index : mesh.indices) {
+            corners.push_back(mesh.vertices[index]);
+        }
+    }
+    fmt::print("== Hidden geometry ({} meshes, {} triangles) ==\n", scene.meshes.size(), corners.size() / 3);
+    fmt::print("{:>8} {:>12} {:>12} {:>12} {:>10} {:>10}\n", "threads", "build ms", "analyze ms", "rays",
+               "Mrays/s", "hidden %");
+
+    const HiddenGeometryAnalyzer analyzer(32);
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        const double buildMs = bestOfMilliseconds(3, [&]() {
+            TriangleBVH bvh;
+            bvh.build(corners, pool);
+        });
+        HiddenGeometryResult hidden;
+        const double analyzeMs = bestOfMilliseconds(3, [&]() { hidden = analyzer.analyze(scene, pool); });
+        const double traceMs = std::max(analyzeMs - buildMs, 1e-3);
+        fmt::print("{:>8} {:>12.2f} {:>12.2f} {:>12} {:>10.2f} {:>10.1f}\n", threads, buildMs, analyzeMs,
+                   hidden.raysCast, hidden.raysCast / (traceMs * 1e3), hidden.hiddenPercentage);
+    }
+    fmt::print("\n");
+}
+
+// Self-intersection search on a 1M-triangle mesh: two wavy sheets merged
+// into one, crossing each other along curves
+void benchSelfIntersections() {
+    MeshData mesh = makeGridMesh("sheets", 500);
+    for (auto& p : mesh.vertices) {
+        p.y = 0.05f * std::sin(p.x * 20.0f);
+    }
+    const MeshData other = makeGridMesh("other", 500);
+    const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+    for (const auto& p : other.vertices) {
+        mesh.vertices.emplace_back(p.x, 0.05f * std::cos(p.z * 17.0f), p.z);
+    }
+    for (uint32_t index : other.indices) {
+        mesh.indices.push_back(base + index);
+    }
+    fmt::print("== Self-intersections ({} triangles) ==\n", mesh.indices.size() / 3);
+    fmt::print("{:>8} {:>12} {:>9} {:>14} {:>14}\n", "threads", "ms", "speedup", "candidates", "intersecting");
+
+    const SelfIntersectionAnalyzer analyzer(1e-5f);
+    double serialMs = 0.0;
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        SelfIntersectionResult intersections;
+        const double ms = bestOfMilliseconds(3, [&]() {
+            intersections = analyzer.analyze(mesh.vertices, mesh.indices, pool);
+        });
+        if (threads == 1) {
+            serialMs = ms;
+        }
+        fmt::print("{:>8} {:>12.2f} {:>8.2f}x {:>14} {:>14}\n", threads, ms, serialMs / ms,
+                   intersections.candidatePairs, intersections.intersectingTriangles);
+    }
+    fmt::print("\n");
+}
+
+// Meshlet building over a scene of 64 meshes: meshes build in parallel,
+// each one greedily on its own thread
+void benchMeshlets() {
+    const SceneData scene = makeScene(64, 128);
+    fmt::print("== Meshlets ({} meshes, {} triangles, 64 vertices / 124 triangles) ==\n", scene.meshes.size(),
+               scene.totalTriangles);
+    fmt::print("{:>8} {:>12} {:>9} {:>10} {:>14}\n", "threads", "ms", "speedup", "meshlets", "triangle fill");
+
+    const MeshletBuilder builder(64, 124);
+    double serialMs = 0.0;
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        std::vector<MeshletMesh> meshlets;
+        const double ms = bestOfMilliseconds(3, [&]() {
+            meshlets = builder.buildScene(scene, pool);
+        });
+        if (threads == 1) {
+            serialMs = ms;
+        }
+        size_t meshletCount = 0;
+        uint64_t triangles = 0;
+        for (const MeshletMesh& mesh : meshlets) {
+            meshletCount += mesh.meshlets.size();
+            for (const Meshlet& meshlet : mesh.meshlets) {
+                triangles += meshlet.triangleCount;
+            }
+        }
+        fmt::print("{:>8} {:>12.2f} {:>8.2f}x {:>10} {:>13.1f}%\n", threads, ms, serialMs / ms, meshletCount,
+                   100.0 * triangles / (meshletCount * builder.getMaxTriangles()));
+    }
+    fmt::print("\n");
+}
+
+// --fix on a 1M-triangle grid with its triangles shuffled, once over
+// shared vertices and once with every corner a vertex of its own, which
+// gives the weld three times the vertices and real merging to do
+void benchOptimizer() {
+    const MeshData grid = makeGridMesh("shuffled", 707);
+    std::vector<std::array<uint32_t, 3>> triangles(grid.triangleCount);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        triangles[t] = {grid.indices[t * 3], grid.indices[t * 3 + 1], grid.indices[t * 3 + 2]};
+    }
+    std::mt19937 rng(42);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+
+    MeshData shared = grid;
+    MeshData split;
+    shared.indices.clear();
+    split.name = "split";
+    for (const auto& triangle : triangles) {
+        shared.indices.insert(shared.indices.end(), triangle.begin(), triangle.end());
+        for (uint32_t index : triangle) {
+            split.indices.push_back(static_cast<uint32_t>(split.vertices.size()));
+            split.vertices.push_back(grid.vertices[index]);
+            split.normals.push_back(grid.normals[index]);
+            split.uvCoords.push_back(grid.uvCoords[index]);
+        }
+    }
+    split.triangleCount = grid.triangleCount;
+    fmt::print("== Mesh optimization ({} triangles; {} shared or {} split vertices) ==\n", grid.triangleCount,
+               shared.vertices.size(), split.vertices.size());
+    fmt::print("{:>8} {:>12} {:>12} {:>12} {:>12}\n", "threads", "shared ms", "split ms", "ACMR before",
+               "ACMR after");
+
+    const MeshOptimizer optimizer(1e-5f, 1e-3f, VertexCacheModel::FIFO, 32);
+    for (uint32_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        ThreadPool pool(threads);
+        // Optimizes in place, so every run starts from a fresh copy
+        MeshOptimizationResult result;
+        auto run = [&](const MeshData& mesh) {
+            double best = 0.0;
+            for (int r = 0; r < 3; ++r) {
+                MeshData copy = mesh;
+                const auto start = Clock::now();
+                result = optimizer.optimize(copy, pool);
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                best = r == 0 ? ms : std::min(best, ms);
+            }
+            return best;
+        };
+        const double splitMs = run(split);
+        const double sharedMs = run(shared); // Last, so the ACMR columns are the shared mesh's
+        fmt::print("{:>8} {:>12.2f} {:>12.2f} {:>12.3f} {:>12.3f}\n", threads, sharedMs, splitMs,
+                   result.acmrBefore, result.acmrAfter);
+    }
+    fmt::print("\n");
+}
+
+} // namespace
+
+int main() {
+    benchValidationScaling();
+    benchVertexKernels();
+    benchGeometryScans();
+    benchSimplification();
+    benchVisibility();
+    benchSelfIntersections();
+    benchMeshlets();
+    benchOptimizer();
+    return 0;
+}
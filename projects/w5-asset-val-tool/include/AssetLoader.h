@@ -13,25 +13,42 @@ struct MeshData {
     std::vector<glm::vec3> vertices;
     std::vector<glm::vec3> normals;
     std::vector<glm::vec2> uvCoords;
+    std::vector<glm::vec3> tangents;   // Empty, or one per vertex with bitangents
+    std::vector<glm::vec3> bitangents;
     std::vector<uint32_t> indices;
     std::vector<uint32_t> materialIndices;
+    
+    // Accumulated transform of the node this mesh was loaded from; a mesh
+    // used by several nodes is loaded once per node
+    glm::mat4 worldTransform;
     uint32_t triangleCount;
     
-    MeshData() : triangleCount(0) {}
+    // Index of the file's mesh this was loaded from: meshes sharing it are
+    // instanced by the file already. kNoSourceMesh for generated meshes.
+    uint32_t sourceMesh;
+    static constexpr uint32_t kNoSourceMesh = 0xFFFFFFFFu;
+    
+    MeshData() : worldTransform(1.0f), triangleCount(0), sourceMesh(kNoSourceMesh) {}
 };
 
 struct MaterialData {
     std::string name;
     glm::vec3 albedo;
+    float alpha;            // Base color alpha
     float metallic;
     float roughness;
+    glm::vec3 emissive;
+    std::string alphaMode;  // glTF alpha mode: OPAQUE, MASK or BLEND
+    float alphaCutoff;      // MASK only
+    bool doubleSided;
     std::string albedoTexture;
     std::string normalTexture;
     std::string metallicRoughnessTexture;
     std::string emissiveTexture;
     std::string occlusionTexture;
     
-    MaterialData() : albedo(1.0f), metallic(0.0f), roughness(1.0f) {}
+    MaterialData() : albedo(1.0f), alpha(1.0f), metallic(0.0f), roughness(1.0f), emissive(0.0f),
+                     alphaMode("OPAQUE"), alphaCutoff(0.5f), doubleSided(false) {}
 };
 
 struct TextureData {
@@ -41,8 +58,10 @@ struct TextureData {
     uint32_t height;
     uint32_t channels;
     std::string format;
+    bool isNormalMap; // Some material uses it as a normal map
+    std::vector<uint8_t> embeddedData; // Encoded image of an embedded texture ("*N"), as stored in the file
     
-    TextureData() : width(0), height(0), channels(0) {}
+    TextureData() : width(0), height(0), channels(0), isNormalMap(false) {}
 };
 
 struct SceneData {
@@ -51,6 +70,10 @@ struct SceneData {
     std::vector<MaterialData> materials;
     std::vector<TextureData> textures;
     
+    // Generated levels of detail: meshLods[i] holds LOD1, LOD2, ... of
+    // meshes[i]. Empty unless LOD generation ran.
+    std::vector<std::vector<MeshData>> meshLods;
+    
     // Scene statistics
     uint32_t totalVertices;
     uint32_t totalTriangles;
@@ -78,8 +101,8 @@ private:
     bool verboseLogging;
     
     // Internal processing functions
-    void processNode(aiNode* node, const aiScene* scene, SceneData& sceneData);
-    void processMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData);
+    void processNode(aiNode* node, const aiScene* scene, SceneData& sceneData, const aiMatrix4x4& parentTransform);
+    void processMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData, const aiMatrix4x4& transform);
     void processMaterials(const aiScene* scene, SceneData& sceneData);
     void processTextures(const aiScene* scene, SceneData& sceneData, const std::string& basePath);
     
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "VertexKernels.h"
+
+struct BoundingSphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+};
+
+struct MeshBounds {
+    bool valid = false; // False when the mesh has no finite vertex
+
+    // Local space: the box comes straight from the position stream stats
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+    BoundingSphere sphere;
+
+    // Through MeshData::worldTransform
+    glm::vec3 worldMin = glm::vec3(0.0f);
+    glm::vec3 worldMax = glm::vec3(0.0f);
+    BoundingSphere worldSphere;
+
+    // Stray vertices: further from the mesh's median point than the stray
+    // factor times the radius holding 99% of its vertices
+    float coreRadius = 0.0f;
+    uint64_t strayVertices = 0;
+    float maxStrayDistance = 0.0f;
+    std::vector<uint32_t> worstStrayVertices; // Furthest first, at most kMaxWorstStrayVertices
+
+    static constexpr size_t kMaxWorstStrayVertices = 16;
+};
+
+struct SceneBounds {
+    bool valid = false;
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+    BoundingSphere sphere;
+};
+
+// Bounding volumes for culling data and scale sanity checks.
+//
+// The box reuses the SIMD min/max reduction the validator already runs
+// over every position stream. The sphere is Ritter's: start from the most
+// distant pair among the six axis-extreme vertices, then grow it over one
+// more pass; if half the box diagonal is smaller, that sphere is used
+// instead. The median point and core radius come from an evenly strided
+// sample of at most kSampleSize vertices, so stray detection costs one
+// extra comparison per vertex in the growing pass.
+class BoundsAnalyzer {
+public:
+    explicit BoundsAnalyzer(float strayVertexFactor);
+
+    MeshBounds analyze(const std::vector<glm::vec3>& vertices, const PositionStreamStats& stats,
+                       const glm::mat4& worldTransform) const;
+
+    // World-space union of the valid meshes' bounds
+    static SceneBounds combine(const std::vector<const MeshBounds*>& meshes);
+
+    static constexpr size_t kSampleSize = 1 << 16;
+
+private:
+    float strayVertexFactor;
+};
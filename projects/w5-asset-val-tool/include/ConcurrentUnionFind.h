@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Lock-free union-find over ids 0..size-1, safe to unite() from many
+// threads at once.
+//
+// A link is a compare-and-swap that hangs the larger root under the
+// smaller, and find() halves paths as it walks. Parents only ever move to
+// smaller ids, so there are no cycles and every set's root is its smallest
+// member whatever the thread timing; results built from roots are
+// deterministic. Relaxed ordering is enough: each parent slot is only ever
+// read and CASed on its own, and callers read the final roots after the
+// pool has joined.
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(size_t size) : parent(new std::atomic<uint32_t>[size]) {
+        for (size_t i = 0; i < size; ++i) {
+            parent[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t up = parent[x].load(std::memory_order_relaxed);
+            if (up == x) {
+                return x;
+            }
+            const uint32_t grand = parent[up].load(std::memory_order_relaxed);
+            if (grand != up) {
+                // Path halving; losing the race to another writer is harmless
+                parent[x].compare_exchange_weak(up, grand, std::memory_order_relaxed);
+            }
+            x = grand;
+        }
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            // Only succeeds while a is still a root
+            uint32_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<uint32_t>[]> parent;
+};
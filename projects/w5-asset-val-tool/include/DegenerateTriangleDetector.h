@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+struct DegenerateTriangleResult {
+    uint64_t zeroAreaTriangles = 0;             // Repeated indices or area below the absolute epsilon
+    uint64_t nearDegenerateTriangles = 0;       // Needles and slivers: height / longest edge below the ratio
+    std::vector<uint32_t> degenerateTriangles;  // Zero-area triangle indices, ascending
+};
+
+// Finds triangles that rasterize to nothing (zero area) or almost nothing
+// (needles and slivers whose height is tiny compared to their longest edge).
+//
+// Each triangle is classified independently, so the index buffer is split
+// into fixed chunks across the pool and the per-chunk results are merged in
+// chunk order - linear time, and identical output for any thread count.
+class DegenerateTriangleDetector {
+public:
+    DegenerateTriangleDetector(float areaEpsilon, float nearDegenerateRatio);
+
+    DegenerateTriangleResult analyze(const std::vector<glm::vec3>& vertices,
+                                     const std::vector<uint32_t>& indices,
+                                     ThreadPool& pool) const;
+
+private:
+    float areaEpsilon;
+    float nearDegenerateRatio;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+struct DuplicateVertexResult {
+    uint64_t coincidentVertices = 0; // Within tolerance of an earlier vertex's position
+    uint64_t weldableVertices = 0;   // ...and its attributes as well: removable by welding
+    float weldSavingsPercentage = 0.0f; // weldableVertices / vertex count * 100
+};
+
+// Finds vertices that could be welded into an earlier one.
+//
+// Positions are quantized to a grid of cells a few tolerances wide and the
+// occupied cells are stored in a lock-free open-addressing hash, each with
+// a sorted range of its vertices. A vertex is then compared only with
+// its own cell and the neighbours it is within tolerance of, so both
+// passes are linear in vertex count and run in parallel. Candidates are compared on position,
+// normal and UV, so seam and hard-edge splits (same position, different
+// attributes) count as coincident but not as weldable. With tangent frames
+// the handedness must match too: mirrored-UV seams share position, normal
+// and UV along the mirror line but not the bitangent's side.
+class DuplicateVertexDetector {
+public:
+    DuplicateVertexDetector(float positionTolerance, float attributeTolerance);
+
+    DuplicateVertexResult analyze(const std::vector<glm::vec3>& vertices,
+                                  const std::vector<glm::vec3>& normals,
+                                  const std::vector<glm::vec2>& uvCoords,
+                                  const std::vector<glm::vec3>& tangents,
+                                  const std::vector<glm::vec3>& bitangents,
+                                  ThreadPool& pool) const;
+
+    // Welding map for the same matching rule: every vertex maps to the
+    // lowest-numbered vertex of its cluster (itself if it has no match)
+    std::vector<uint32_t> buildWeldRemap(const std::vector<glm::vec3>& vertices,
+                                         const std::vector<glm::vec3>& normals,
+                                         const std::vector<glm::vec2>& uvCoords,
+                                         const std::vector<glm::vec3>& tangents,
+                                         const std::vector<glm::vec3>& bitangents,
+                                         ThreadPool& pool) const;
+
+private:
+    // Shared scan; fills weldTargets (if given) with the matched earlier
+    // vertex, or the vertex itself when it has none
+    DuplicateVertexResult scan(const std::vector<glm::vec3>& vertices,
+                               const std::vector<glm::vec3>& normals,
+                               const std::vector<glm::vec2>& uvCoords,
+                               const std::vector<glm::vec3>& tangents,
+                               const std::vector<glm::vec3>& bitangents,
+                               ThreadPool& pool, std::vector<uint32_t>* weldTargets) const;
+
+    float positionTolerance;
+    float attributeTolerance;
+};
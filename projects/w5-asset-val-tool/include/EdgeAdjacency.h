@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// One undirected edge of the triangle mesh, keyed by canonical vertex ids
+struct MeshEdge {
+    uint32_t v0;           // Lower canonical vertex id
+    uint32_t v1;           // Higher canonical vertex id
+    uint32_t faceCount;    // Triangles using this edge
+    uint32_t forwardCount; // ...of which traverse it as v0 -> v1
+};
+
+struct MeshTopologyResult {
+    uint64_t edgeCount = 0;
+    uint64_t boundaryEdges = 0;    // Used by exactly one triangle
+    uint64_t boundaryLoops = 0;    // Connected chains of boundary edges (holes / open borders)
+    uint64_t nonManifoldEdges = 0; // Used by three or more triangles
+    uint64_t windingFlips = 0;     // Two-triangle edges traversed in the same direction by both
+    bool isWatertight = true;      // No boundary and no non-manifold edges
+};
+
+// Undirected edge table built from an index buffer.
+//
+// Triangles are processed in fixed chunks; each chunk scatters its
+// half-edges into hash-selected buckets, and every bucket is then merged
+// by its own task with a private open-addressing table. Both passes are
+// linear and parallel, and the edge order depends only on the input.
+//
+// Vertices that were split only for attributes (UV seams, hard normals)
+// share an edge when the table is built over canonical ids from
+// weldPositions(), which is what topology checks want.
+class EdgeAdjacency {
+public:
+    // Canonical id per vertex: the lowest index with an identical position
+    static std::vector<uint32_t> weldPositions(const std::vector<glm::vec3>& vertices, ThreadPool& pool);
+
+    // Canonical id per vertex: the lowest index with an identical position
+    // and UV, so only vertices split by a UV seam keep separate ids. Falls
+    // back to weldPositions() when uvs does not match the vertex count.
+    static std::vector<uint32_t> weldPositionsAndUVs(const std::vector<glm::vec3>& vertices,
+                                                     const std::vector<glm::vec2>& uvs, ThreadPool& pool);
+
+    // remap may be empty (use indices as-is). Triangles with repeated or
+    // out-of-range indices contribute no edges.
+    void build(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap,
+               size_t vertexCount, ThreadPool& pool);
+
+    const std::vector<MeshEdge>& getEdges() const { return edges; }
+
+    // Boundary, non-manifold and winding statistics over the edge table
+    MeshTopologyResult analyzeTopology() const;
+
+private:
+    std::vector<MeshEdge> edges;
+};
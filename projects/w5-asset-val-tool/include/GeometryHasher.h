@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AssetLoader.h"
+#include "ThreadPool.h"
+
+// Order-invariant fingerprint of a mesh's triangles
+struct GeometryKey {
+    uint64_t hash = 0;
+    uint64_t check = 0;     // Independent second sum; a match needs both
+    uint32_t triangles = 0;
+
+    bool operator==(const GeometryKey& other) const {
+        return hash == other.hash && check == other.check && triangles == other.triangles;
+    }
+};
+
+struct GeometryHash {
+    GeometryKey exact;      // Positions, normals and UVs bit for bit
+
+    // Principal frame: area-weighted centroid and axes of the triangles'
+    // second moments, largest extent first. Only set when the three extents
+    // differ enough for the axes to be well defined.
+    bool hasFrame = false;
+    uint64_t shape = 0;     // Triangle count, vertex format and quantized extents
+    glm::dvec3 center;
+    glm::dvec3 axes[3];
+    double scale = 0.0;     // RMS extent along the major axis
+};
+
+// Meshes with the same geometry, as stored or after a rigid transform
+struct DuplicateMeshGroup {
+    std::vector<uint32_t> meshes;   // Scene order; the first would be the instanced source
+    bool transformed = false;       // Some meshes match only after rotation/translation
+    uint32_t storedCopies = 0;      // Distinct meshes in the file; node references share one
+    uint64_t bytesSaved = 0;        // Vertex and index memory of the redundant copies
+    uint64_t drawsSaved = 0;        // Meshes beyond one instanced draw per material
+
+    // Set when a mesh index from an earlier run holds this geometry, from another file
+    std::string indexFile;
+    std::string indexMesh;
+};
+
+struct DuplicateMeshResult {
+    uint64_t duplicateMeshes = 0;   // Meshes that would become instances
+    uint64_t transformedMeshes = 0; // Of those, rigid-transform matches
+    uint64_t bytesSaved = 0;
+    uint64_t drawsSaved = 0;
+    uint32_t indexMatches = 0;
+    std::vector<DuplicateMeshGroup> groups; // Most bytes saved first
+
+    std::vector<GeometryHash> meshHashes;   // Per scene mesh, for matchIndex()
+};
+
+// Exact geometry keys of meshes seen across a batch of files, persisted as
+// JSON so one validation run per file still finds copies across the batch
+class GeometryIndex {
+public:
+    struct Entry {
+        GeometryKey key;
+        std::string file;
+        std::string mesh;
+    };
+
+    // A missing file is an empty index; a corrupt one throws std::runtime_error
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+
+    const Entry* find(const GeometryKey& key) const;
+    void add(const Entry& entry); // Keeps the first entry per key
+
+private:
+    std::unordered_multimap<uint64_t, Entry> entries;
+};
+
+// Finds meshes that are copies of each other, so they can become instances.
+//
+// The exact key hashes every triangle from its corners' attribute bits, with
+// the corners rotated (keeping the winding) to start at the smallest corner
+// hash, and sums the triangle hashes. Sums commute, so the key ignores
+// vertex order, index order and triangle order, and chunks of a mesh are
+// hashed in parallel in a single pass without sorting anything.
+//
+// Rigid matching compares meshes in their principal frames: meshes whose
+// shape signatures agree are aligned by their frames (trying the four axis
+// sign choices that keep the frame right-handed) and every triangle must
+// then have a counterpart within tolerance * scale. Meshes with nearly equal
+// extents (spheres, cubes) have no stable frame and only match exactly.
+// Scaled copies do not match. The batch index holds exact keys only, since
+// rigid matching needs the other file's geometry.
+class GeometryHasher {
+public:
+    GeometryHasher(bool matchRigid, float tolerance, uint32_t minTriangles);
+
+    GeometryHash hash(const MeshData& mesh, ThreadPool& pool) const;
+
+    DuplicateMeshResult analyze(const SceneData& scene, ThreadPool& pool) const;
+
+    // Credits meshes already present in index from other files, then
+    // records this scene's meshes in it
+    void matchIndex(const SceneData& scene, DuplicateMeshResult& result, GeometryIndex& index) const;
+
+    static uint64_t meshBytes(const MeshData& mesh); // Vertex and index buffers
+
+private:
+    bool matchRigid;
+    float tolerance;
+    uint32_t minTriangles;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "AssetLoader.h"
+
+// Writes a SceneData back out as glTF 2.0: one node per MeshData, placed
+// by its world transform, and one single-primitive mesh per source mesh,
+// so nodes instancing a mesh in the source file still share it. Vertices
+// carry POSITION, NORMAL, TANGENT (handedness in w) and TEXCOORD_0 as far
+// as the mesh has them. Materials become metallic-roughness PBR materials
+// referencing the same image files.
+//
+// ".glb" output embeds the buffer in the binary container; anything else
+// writes a .gltf plus a .bin next to it. Texture URIs are rewritten to be
+// relative to the output file, so an optimized copy written to another
+// directory still finds the source textures. Embedded PNG and JPEG
+// textures are copied into the buffer.
+//
+// Generated levels of detail (SceneData::meshLods) are written as extra
+// nodes outside the scene, chained to their base node with MSFT_lod.
+class GltfWriter {
+public:
+    // sourcePath is the file the scene was loaded from; texture paths in
+    // the materials are relative to it
+    bool write(const SceneData& sceneData, const std::string& sourcePath, const std::string& outputPath);
+
+    void setIncludeLods(bool include) { includeLods = include; }
+
+    // Bytes written by the last successful write(), buffers included
+    uint64_t getWrittenBytes() const { return writtenBytes; }
+
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    bool includeLods = true;
+    uint64_t writtenBytes = 0;
+    std::string lastError;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "AssetLoader.h"
+
+// Formats textures are assumed to be transcoded to before upload
+enum class GpuTextureFormat {
+    RGBA8,   // Uncompressed, 4 bytes per texel
+    BC1,     // 8 bytes per 4x4 block
+    BC4,     // 8 bytes per 4x4 block, single channel
+    BC5,     // 16 bytes per 4x4 block, two channels (normal maps)
+    BC7,     // 16 bytes per 4x4 block
+    ASTC4x4, // ASTC always spends 16 bytes per block; larger blocks
+    ASTC6x6, // trade quality for size
+    ASTC8x8
+};
+
+// Resident GPU bytes of one mesh or texture
+struct GpuMemoryEstimate {
+    uint64_t bytes = 0;
+
+    // Meshes
+    uint64_t vertexBytes = 0;
+    uint64_t indexBytes = 0;
+    uint32_t vertexStride = 0;
+    uint32_t indexSize = 0; // 2 or 4
+
+    // Textures
+    GpuTextureFormat format = GpuTextureFormat::RGBA8;
+    uint32_t mipLevels = 0;
+};
+
+// Estimates what assets occupy once resident on the GPU.
+//
+// Meshes: the interleaved streams they carry (position, plus normal, UV,
+// tangent and bitangent when present) times the vertex count, and the
+// index buffer at the narrowest width that addresses every vertex. Textures: every level of
+// the mip chain down to 1x1 in the target format, block formats rounded
+// up to whole blocks per level. Normal maps get their own format since
+// they are usually two-channel.
+class GpuMemoryEstimator {
+public:
+    GpuMemoryEstimator(GpuTextureFormat colorFormat, GpuTextureFormat normalFormat, bool mipChains);
+
+    GpuMemoryEstimate estimateMesh(const MeshData& mesh) const;
+    GpuMemoryEstimate estimateTexture(const TextureData& texture) const;
+
+    // Bytes of the top level, or of the whole mip chain, in a format
+    static uint64_t textureBytes(uint32_t width, uint32_t height, GpuTextureFormat format, bool mipChain,
+                                 uint32_t* mipLevels = nullptr);
+
+    static uint32_t vertexStride(const MeshData& mesh);
+    // glTF forbids the largest index value, hence 65535 rather than 65536
+    static uint32_t indexSize(size_t vertexCount) { return vertexCount <= 0xFFFF ? 2 : 4; }
+
+    // "rgba8", "bc1", "bc4", "bc5", "bc7", "astc_4x4", "astc_6x6", "astc_8x8",
+    // case-insensitive; throws std::invalid_argument otherwise
+    static GpuTextureFormat parseFormat(const std::string& name);
+    static const char* formatName(GpuTextureFormat format);
+
+private:
+    GpuTextureFormat colorFormat;
+    GpuTextureFormat normalFormat;
+    bool mipChains;
+};
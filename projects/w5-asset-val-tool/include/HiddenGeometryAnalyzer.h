@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AssetLoader.h"
+
+class ThreadPool;
+
+// Triangles of one mesh that no viewpoint can see
+struct HiddenMeshResult {
+    uint32_t mesh = 0;              // Scene mesh index
+    uint64_t triangles = 0;
+    uint64_t hiddenTriangles = 0;
+    float hiddenPercentage = 0.0f;
+    std::vector<uint32_t> hiddenSamples; // First hidden triangle indices, at most kMaxListed
+
+    static constexpr size_t kMaxListed = 8;
+};
+
+struct HiddenGeometryResult {
+    bool analyzed = false;
+    uint64_t sceneTriangles = 0;
+    uint64_t testedTriangles = 0;    // Non-degenerate triangles with valid indices
+    uint64_t hiddenTriangles = 0;
+    float hiddenPercentage = 0.0f;   // Of the tested triangles: removable without a visible change
+    uint32_t directions = 0;         // Per sample point, besides the two normal directions
+    uint64_t raysCast = 0;
+    uint32_t bvhNodes = 0;
+
+    std::vector<HiddenMeshResult> meshes; // Meshes with hidden triangles, most hidden first
+};
+
+// Interior geometry nobody can see: bolts inside housings, the back sides
+// of panels merged flush against each other, shells buried in a kitbash.
+//
+// All meshes are transformed to world space and put into one TriangleBVH.
+// Every triangle is then tested from a sphere of viewpoints at infinity:
+// from four points on it (the centroid and three points towards the
+// corners), rays go along both normals and along a Fibonacci sphere of
+// directions, and the first ray that leaves the scene unblocked makes the
+// triangle visible. Both sides count, so open and double-sided surfaces
+// are not flagged. Origins sit a small fraction of the scene diagonal off
+// the surface on the ray's side and the triangle's own id is ignored, so
+// a surface does not occlude itself.
+//
+// Visible triangles usually escape within a ray or two; only hidden ones
+// cast every ray. Triangles are traced in chunks across the pool, and the
+// result does not depend on the thread count.
+class HiddenGeometryAnalyzer {
+public:
+    explicit HiddenGeometryAnalyzer(uint32_t directions);
+
+    HiddenGeometryResult analyze(const SceneData& scene, ThreadPool& pool) const;
+
+private:
+    uint32_t directions;
+};
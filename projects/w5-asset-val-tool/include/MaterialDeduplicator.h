@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AssetLoader.h"
+
+// Materials that render identically once names are ignored
+struct MaterialDedupGroup {
+    uint64_t hash = 0;              // Of the canonical form
+    std::vector<uint32_t> materials; // Scene material indices; the first is kept
+
+    // Set when a material index from an earlier run already holds this
+    // material, from another file
+    std::string indexFile;
+    std::string indexMaterial;
+};
+
+struct MaterialDedupResult {
+    uint32_t materialCount = 0;
+    uint32_t uniqueMaterials = 0;      // Distinct canonical forms in this scene
+    uint32_t indexMatches = 0;         // Of those, already known from other files
+    std::vector<MaterialDedupGroup> groups; // One per canonical form, in order of first use
+};
+
+// Canonical forms of materials seen across a batch of files, persisted as
+// JSON so one validation run per file still dedups across the batch
+class MaterialIndex {
+public:
+    struct Entry {
+        std::string canonical;
+        std::string file;
+        std::string material;
+    };
+
+    // A missing file is an empty index; a corrupt one throws std::runtime_error
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+
+    const Entry* find(uint64_t hash, const std::string& canonical) const;
+    void add(uint64_t hash, const Entry& entry); // Keeps the first entry per canonical form
+
+private:
+    std::unordered_multimap<uint64_t, Entry> entries;
+};
+
+// Groups materials by a canonical form that ignores everything a renderer
+// does not see: the name, factor noise below one quantization step, and
+// spelling differences in texture paths.
+//
+// Factors are clamped to [0, 1] and rounded to factorSteps levels (255
+// matches 8-bit texture precision); emissive factors keep values above 1,
+// which emissive strength produces. Base color alpha only counts for MASK
+// and BLEND materials and the alpha cutoff only for MASK, as glTF ignores
+// them otherwise. Texture paths are percent-decoded, resolved against the
+// scene's directory and lexically normalized with forward slashes;
+// embedded textures ("*0") are qualified by the scene file so they never
+// match across files. The canonical form is hashed, and
+// materials sharing a hash are only grouped when the forms are equal.
+class MaterialDeduplicator {
+public:
+    explicit MaterialDeduplicator(uint32_t factorSteps);
+
+    std::string canonicalize(const MaterialData& material, const std::string& sceneFile) const;
+    static uint64_t hashCanonical(const std::string& canonical);
+
+    MaterialDedupResult analyze(const SceneData& scene) const;
+
+    // Marks groups already present in index, then records this scene's
+    // materials in it
+    void matchIndex(const SceneData& scene, MaterialDedupResult& result, MaterialIndex& index) const;
+
+private:
+    uint32_t factorSteps;
+};
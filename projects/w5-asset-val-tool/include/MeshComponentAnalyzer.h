@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// One connected shell of a mesh, identified by its first triangle
+struct MeshComponent {
+    static constexpr uint32_t kNotDuplicate = UINT32_MAX;
+
+    uint32_t firstTriangle = 0;
+    uint32_t triangles = 0;
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+
+    // Volume of the sphere around the component's box over the sphere
+    // around the whole mesh's box; flat shells still get a size
+    float volumeRatio = 0.0f;
+
+    // Stacked copies only: first triangle of the earlier piece with the
+    // same triangle count and bounding box
+    uint32_t duplicateOf = kNotDuplicate;
+};
+
+struct MeshComponentResult {
+    uint32_t componentCount = 0;
+    uint32_t largestTriangles = 0;
+
+    // Components per power-of-two triangle count: 1, 2-3, 4-7, ...
+    std::vector<uint32_t> sizeHistogram;
+
+    // Components below the triangle or volume minimum; never the largest one
+    uint32_t debrisComponents = 0;
+    uint64_t debrisTriangles = 0;
+
+    // Index-connected pieces repeating an earlier piece, outside debris
+    uint32_t duplicateShells = 0;
+    uint64_t duplicateTriangles = 0;
+
+    std::vector<MeshComponent> largestComponents; // Most triangles first, at most kMaxListed
+    std::vector<MeshComponent> removalCandidates; // Debris and duplicates, fewest triangles first, at most kMaxListed
+
+    static constexpr size_t kMaxListed = 16;
+};
+
+// Connected components of the index buffer: floating debris, interior
+// leftovers and stacked duplicate shells in scanned or kitbashed assets.
+//
+// Triangles connect through shared positions (vertices are welded first,
+// see EdgeAdjacency), so UV seams and hard normals do not split a shell.
+// A copy stacked on its original shares every position with it and so
+// joins the same component; stacked copies are instead found among the
+// pieces connected through the raw indices, as pieces with the same
+// triangle count and bit-identical box.
+//
+// Chunks of the index buffer union every triangle's corners in two
+// ConcurrentUnionFinds (welded and raw) across the pool; both are then
+// numbered by first triangle and their boxes gathered in one linear pass,
+// so the result does not depend on the thread count.
+class MeshComponentAnalyzer {
+public:
+    // Components with fewer than minTriangles triangles or a volume ratio
+    // below minVolumeRatio are debris
+    MeshComponentAnalyzer(uint32_t minTriangles, float minVolumeRatio);
+
+    MeshComponentResult analyze(const std::vector<glm::vec3>& vertices,
+                                const std::vector<uint32_t>& indices,
+                                ThreadPool& pool) const;
+
+private:
+    uint32_t minTriangles;
+    float minVolumeRatio;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AssetLoader.h"
+#include "ValidationResult.h"
+#include "VertexCacheAnalyzer.h"
+
+class ThreadPool;
+
+// Rewrites meshes for the GPU vertex pipeline, in three passes:
+//
+//   1. Weld: vertices matching an earlier one on position, normal, UV and
+//      tangent handedness (DuplicateVertexDetector's rule) are merged;
+//      triangles that collapse as a result are dropped.
+//   2. Triangle order: Tipsify (Sander et al. 2007). The next fan is
+//      around the vertex of the last fan that has been in the cache
+//      longest while its remaining triangles still fit, falling back to a
+//      dead-end stack of recent vertices. One linear pass over a vertex ->
+//      triangle adjacency table.
+//   3. Vertex order: vertices are renumbered in order of first use, which
+//      also drops unreferenced ones, so fetches walk the buffer forwards.
+//
+// Meshes are independent and optimized in parallel; node instances of one
+// source mesh are optimized once and share the result. ACMR before and
+// after is measured with the configured cache model.
+class MeshOptimizer {
+public:
+    MeshOptimizer(float weldPositionTolerance, float weldAttributeTolerance,
+                  VertexCacheModel cacheModel, uint32_t cacheSize);
+
+    // Optimizes one mesh in place. Triangles with out-of-range indices are
+    // removed along the way.
+    MeshOptimizationResult optimize(MeshData& mesh, ThreadPool& pool) const;
+
+    // Optimizes every mesh of the scene and updates its totals. One result
+    // per optimized mesh: instances of a source mesh share their first's.
+    std::vector<MeshOptimizationResult> optimizeScene(SceneData& sceneData, ThreadPool& pool) const;
+
+    // Triangle order for the vertex cache; indices must be in range
+    static std::vector<uint32_t> reorderForVertexCache(const std::vector<uint32_t>& indices,
+                                                       size_t vertexCount, uint32_t cacheSize);
+
+    // Vertex + index buffer bytes as written to glTF
+    static uint64_t geometryBytes(const MeshData& mesh);
+
+private:
+    float weldPositionTolerance;
+    float weldAttributeTolerance;
+    VertexCacheModel cacheModel;
+    uint32_t cacheSize;
+};
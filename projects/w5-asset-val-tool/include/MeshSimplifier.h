@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AssetLoader.h"
+#include "ValidationResult.h"
+
+class ThreadPool;
+
+// Quadric error metric simplifier producing LOD chains.
+//
+// Every collapse moves a vertex onto one of its neighbours, so surviving
+// vertices keep their original position, normal, UV and tangent frame.
+// Vertices are classified once over position-welded topology:
+//   - manifold vertices may collapse along any edge;
+//   - border vertices only along their open border;
+//   - seam vertices (one position, two attribute sets) only along the
+//     seam, with both copies moving to the matching copy on the other side;
+//   - anything more complex is locked.
+// Borders and seams also get perpendicular edge quadrics so they keep
+// their shape.
+//
+// Each pass rebuilds the edge table, sorts all candidate collapses by
+// error and applies the cheapest non-overlapping ones that do not flip a
+// triangle, until the next target is reached. Levels are snapshots of one
+// continuous run, so a whole chain costs little more than its last level.
+class MeshSimplifier {
+public:
+    // maxRelativeError stops a level early once the cheapest collapse would
+    // move the surface by more than this share of the bounding box
+    // diagonal (0 means no limit). cacheSize is the vertex cache the output
+    // triangle order is tuned for.
+    MeshSimplifier(float maxRelativeError, uint32_t cacheSize);
+
+    // One standalone mesh per ratio (sorted descending), vertices compacted
+    // and triangles ordered for the vertex cache
+    std::vector<MeshData> buildLodChain(const MeshData& mesh, const std::vector<float>& ratios,
+                                        ThreadPool& pool, MeshLodResult& result) const;
+
+    // Fills sceneData.meshLods for every mesh, meshes in parallel
+    std::vector<MeshLodResult> buildSceneLods(SceneData& sceneData, const std::vector<float>& ratios,
+                                              ThreadPool& pool) const;
+
+private:
+    float maxRelativeError;
+    uint32_t cacheSize;
+};
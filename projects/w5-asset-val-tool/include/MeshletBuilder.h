@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "AssetLoader.h"
+
+class ThreadPool;
+
+// One cluster of a mesh: up to maxVertices vertices and maxTriangles
+// triangles, culled as a unit
+struct Meshlet {
+    uint32_t vertexOffset = 0;   // First entry in MeshletMesh::vertices
+    uint32_t triangleOffset = 0; // First byte in MeshletMesh::triangles, 4-byte aligned
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+
+    // Bounding sphere, mesh space
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+
+    // Normal cone: every triangle faces away from a camera at p when
+    // dot(normalize(coneApex - p), coneAxis) >= coneCutoff. A cutoff of 1
+    // never culls (normals spread too wide).
+    glm::vec3 coneApex = glm::vec3(0.0f);
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    float coneCutoff = 1.0f;
+
+    static constexpr uint32_t kExportedBytes = 56; // Descriptor size in the sidecar, see MeshletWriter
+};
+
+struct MeshletMesh {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices; // Mesh vertex indices, per meshlet
+    std::vector<uint8_t> triangles; // Three meshlet-local vertex indices per triangle, padded per meshlet
+};
+
+struct MeshletResult {
+    uint32_t meshletCount = 0;
+    uint64_t triangles = 0;          // Non-degenerate triangles with valid indices
+    uint64_t meshletVertices = 0;    // Summed over meshlets: vertices transformed once per meshlet
+    float verticesPerTriangle = 0.0f;
+
+    // Average use of the limits; fill takes the fuller of the two per meshlet
+    float vertexFill = 0.0f;
+    float triangleFill = 0.0f;
+    float averageFill = 0.0f;
+    uint32_t underfilledMeshlets = 0; // Below half of both limits
+
+    // Cone culling over uniformly distributed view directions
+    uint32_t cullableMeshlets = 0;   // Meshlets with a usable normal cone
+    float meshletCullRate = 0.0f;    // Expected share of meshlets culled
+    float triangleCullRate = 0.0f;   // Expected share of triangles culled, at most ~0.5 (backfaces)
+
+    float averageRadius = 0.0f;      // Bounding sphere radius over the mesh's bbox diagonal
+    uint64_t dataBytes = 0;          // Descriptors, vertex indices and triangle bytes as exported
+};
+
+// Partitions meshes into meshlets for cluster culling on mesh shader or
+// compute-driven renderers.
+//
+// The builder is greedy and follows the surface: starting from the first
+// unused triangle, it keeps adding the unused triangle adjacent to the
+// meshlet that brings in the fewest new vertices, preferring triangles
+// whose vertices have the fewest unused triangles left, so the meshlet
+// closes off vertices instead of growing a ragged border. Used triangles
+// are dropped from the vertex adjacency as they go, so the search only
+// walks the meshlet's open border. When the border runs out of unused
+// triangles (a disconnected piece is used up), a kd-tree over triangle
+// centroids finds the unused triangle nearest the meshlet's centroid to
+// continue from, so pieces are grouped with their neighbours; the tree is
+// only built for meshes where that happens. A meshlet is closed when the
+// next triangle would exceed either limit; the next one starts at the
+// first unused triangle in index order, which after --fix is vertex-cache
+// order and stays next to the last.
+//
+// Every meshlet gets a Ritter bounding sphere and a normal cone: the axis
+// is the mean of its unit face normals and the cutoff the sine of the
+// widest normal's angle to it. Cones wider than ~84 degrees never cull.
+// For a uniformly random view direction, a cone with cutoff c culls with
+// probability (1 - c) / 2 (the spherical cap it faces away from), which
+// gives the expected cull rates without sampling views.
+class MeshletBuilder {
+public:
+    // Limits are clamped to [3, 255] vertices and [1, 255] triangles so
+    // counts and local indices fit a byte
+    MeshletBuilder(uint32_t maxVertices, uint32_t maxTriangles);
+
+    MeshletMesh build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices,
+                      ThreadPool& pool) const;
+
+    MeshletResult analyze(const MeshletMesh& meshlets, const std::vector<glm::vec3>& vertices) const;
+
+    // One MeshletMesh per scene mesh, meshes in parallel
+    std::vector<MeshletMesh> buildScene(const SceneData& sceneData, ThreadPool& pool) const;
+
+    uint32_t getMaxVertices() const { return maxVertices; }
+    uint32_t getMaxTriangles() const { return maxTriangles; }
+
+private:
+    uint32_t maxVertices;
+    uint32_t maxTriangles;
+};
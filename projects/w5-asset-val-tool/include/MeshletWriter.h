@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "MeshletBuilder.h"
+
+// Writes the meshlets of a scene as a binary sidecar, so the runtime loads
+// them instead of rebuilding them. Little-endian, every block 4-byte aligned:
+//
+//   header:   "MSLT", u32 version (1), u32 mesh count, u32 max vertices,
+//             u32 max triangles
+//   per mesh: u32 name length, name bytes (padded), u32 meshlet count,
+//             u32 vertex index count, u32 triangle byte count, then
+//             meshlet count descriptors of 56 bytes
+//               u32 vertex offset, u32 triangle byte offset,
+//               u8 vertex count, u8 triangle count, u16 0,
+//               f32 center[3], f32 radius,
+//               f32 cone apex[3], f32 cone axis[3], f32 cone cutoff
+//             then the u32 vertex indices and the triangle bytes (padded)
+//
+// Meshes come in scene order. Vertex indices refer to the mesh's vertex
+// buffer as written by --fix; the loader welds and reorders vertices, so
+// they do not match the source file's buffers.
+class MeshletWriter {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    bool write(const SceneData& sceneData, const std::vector<MeshletMesh>& meshlets,
+               uint32_t maxVertices, uint32_t maxTriangles, const std::string& outputPath);
+
+    uint64_t getWrittenBytes() const { return writtenBytes; }
+
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    uint64_t writtenBytes = 0;
+    std::string lastError;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <fmt/format.h>
+
+// Analysis results shared by the profiles of one multi-profile run.
+//
+// A metric is keyed by the asset it describes and every parameter the
+// analysis takes (not the thresholds it is later compared against), so
+// profiles that agree on those parameters compute it once while each still
+// applies its own limits. The cache holds asset addresses: it must not
+// outlive the SceneData it was filled from.
+class MetricCache {
+public:
+    // The metric stored under (asset, key), computed by compute() on first
+    // use. A concurrent caller for the same key waits for the first one.
+    template <typename T, typename Compute>
+    const T& get(const void* asset, const std::string& key, Compute&& compute) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::shared_ptr<Entry>& slot = entries[fmt::format("{}|{}", asset, key)];
+            if (!slot) {
+                slot = std::make_shared<Entry>();
+            }
+            entry = slot;
+        }
+        bool computedHere = false;
+        std::call_once(entry->once, [&]() {
+            entry->value = std::make_shared<T>(compute());
+            computedHere = true;
+        });
+        (computedHere ? computed : reused).fetch_add(1, std::memory_order_relaxed);
+        return *static_cast<const T*>(entry->value.get());
+    }
+
+    uint64_t computedCount() const { return computed.load(); }
+    uint64_t reusedCount() const { return reused.load(); }
+
+private:
+    struct Entry {
+        std::once_flag once;
+        std::shared_ptr<void> value;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+    std::atomic<uint64_t> computed{0};
+    std::atomic<uint64_t> reused{0};
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Whole-string matcher for naming-convention patterns (std::regex_match
+// semantics, ECMAScript syntax).
+//
+// Patterns made of regular constructs only - literals, classes, groups,
+// alternation and quantifiers - are compiled once into a byte-level DFA,
+// so a match is one table lookup per character with no allocation and no
+// backtracking. Anything else (backreferences, lookahead, word boundaries,
+// anchors in the middle of the pattern) falls back to a std::regex.
+// Matching is const and safe to call from any number of threads.
+class NameMatcher {
+public:
+    NameMatcher();
+    explicit NameMatcher(const std::string& pattern); // Throws std::regex_error for invalid patterns
+
+    bool matches(const std::string& name) const;
+
+    const std::string& getPattern() const { return pattern; }
+    bool isDFA() const { return !fallback; }
+    size_t getStateCount() const { return accepting.size(); }
+
+private:
+    std::string pattern;
+
+    // DFA over byte equivalence classes; -1 is the dead state
+    uint8_t byteClass[256];
+    uint32_t classCount;
+    std::vector<int32_t> transitions; // state * classCount + class
+    std::vector<uint8_t> accepting;
+
+    std::optional<std::regex> fallback;
+
+    bool compileDFA();
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// Projected triangle sizes of one mesh, binned so the quad cost can be
+// evaluated at any viewing distance without revisiting the triangles.
+//
+// Per triangle, A0 and P0 are its projected pixel area and perimeter at
+// one metre. Beyond its crossover distance a triangle is shaded as one
+// quad per covered pixel; closer, by the quads its footprint overlaps.
+struct QuadOverdrawProfile {
+    static constexpr float kMinLog2Distance = -8.0f; // Bins cover 2^-8 to 2^16 metres
+    static constexpr int kBinsPerOctave = 8;
+    static constexpr int kBins = 24 * kBinsPerOctave;
+
+    uint64_t measuredTriangles = 0; // Non-degenerate, finite triangles
+    double area = 0.0;              // Sum of A0
+
+    // Per crossover-distance bin: sums over the triangles falling in it
+    std::vector<double> binArea;      // A0
+    std::vector<double> binPerimeter; // P0
+    std::vector<uint32_t> binTriangles;
+
+    // Triangles per bin of the distance beyond which they cover less than
+    // one 2x2 quad
+    std::vector<uint32_t> binSmall;
+};
+
+// Quad cost of a mesh seen from one distance
+struct QuadOverdrawSample {
+    float distance = 0.0f;           // Metres
+    float quadEfficiency = 1.0f;     // Covered pixels over shaded quad lanes, 0.25 to 1
+    float smallTriangleShare = 0.0f; // Triangles covering less than one 2x2 quad
+    float pixelsPerTriangle = 0.0f;  // Mean projected area
+};
+
+struct QuadOverdrawResult {
+    uint64_t measuredTriangles = 0;
+    std::vector<QuadOverdrawSample> references; // One per configured reference distance, nearest first
+
+    // Distance at which quad efficiency falls below the configured minimum,
+    // i.e. where a coarser LOD should take over; 0 when it never does
+    float lodDistance = 0.0f;
+};
+
+// Helper-lane cost of small triangles: GPUs shade 2x2 pixel quads, so a
+// triangle covering one pixel still runs four lanes.
+//
+// Triangles are projected for a camera with the configured vertical
+// resolution and field of view, averaging over orientations (a random
+// facing halves area and shortens lengths by pi/4). The quads a triangle
+// touches are estimated from its projected area A and perimeter P as
+// A/4 + P/pi + 1 (the expected cells a convex shape overlaps on a grid of
+// 2x2 quads), capped at one per covered pixel. Efficiency is covered
+// pixels over four lanes per shaded quad.
+//
+// A and P scale with 1/d^2 and 1/d, so the cost at any distance follows
+// from per-triangle sums binned by crossover distance; one linear pass
+// builds the bins, and samples and the LOD distance are read off them to
+// within an eighth of an octave. The pass runs per block of triangles
+// (see VertexKernels::TriangleBlock).
+class QuadOverdrawAnalyzer {
+public:
+    QuadOverdrawAnalyzer(uint32_t screenHeight, float verticalFovDegrees);
+
+    // Positions are scaled by worldTransform's average scale factor
+    QuadOverdrawProfile profile(const std::vector<glm::vec3>& vertices,
+                                const std::vector<uint32_t>& indices,
+                                const glm::mat4& worldTransform, ThreadPool& pool) const;
+
+    static QuadOverdrawSample sample(const QuadOverdrawProfile& profile, float distance);
+
+    // Nearest distance where efficiency drops below minEfficiency; 0 if it
+    // stays above it across the binned range
+    static float transitionDistance(const QuadOverdrawProfile& profile, float minEfficiency);
+
+private:
+    float pixelsPerMetre; // At one metre, along the vertical
+};
@@ -20,6 +20,12 @@ public:
     bool generateHTMLReport(const ValidationResult& result, const std::string& outputPath);
     bool generateConsoleReport(const ValidationResult& result);
     
+    // Runtime hints per mesh: mip bias and streaming priority from the
+    // texel density analysis, plus the target they are relative to (0 when
+    // the scene average was used)
+    bool generateTexelDensityHints(const ValidationResult& result, const std::string& outputPath,
+                                   float targetDensity);
+    
     // Generate report based on format
     bool generateReport(const ValidationResult& result, const std::string& outputPath, ReportFormat format);
     
@@ -46,20 +52,42 @@ private:
     std::string createHTMLReport(const ValidationResult& result);
     std::string generateHTMLHeader(const std::string& title);
     std::string generateHTMLSummary(const ValidationResult& result);
+    std::string generateHTMLProfiles(const ValidationResult& result);
     std::string generateHTMLStatistics(const ValidationResult& result);
     std::string generateHTMLIssueTable(const std::vector<ValidationIssue>& issues, const std::string& title);
     std::string generateHTMLMeshDetails(const std::vector<MeshValidationResult>& meshResults);
     std::string generateHTMLMaterialDetails(const std::vector<MaterialValidationResult>& materialResults);
+    std::string generateHTMLTexelDensity(const ValidationResult& result);
+    std::string generateHTMLBounds(const ValidationResult& result);
+    std::string generateHTMLGpuMemory(const ValidationResult& result);
+    std::string generateHTMLDrawCalls(const ValidationResult& result);
+    std::string generateHTMLHiddenGeometry(const ValidationResult& result);
+    std::string generateHTMLDuplicateMeshes(const ValidationResult& result);
+    std::string generateHTMLMaterialDedup(const ValidationResult& result);
+    std::string generateHTMLOptimization(const ValidationResult& result);
+    std::string generateHTMLLods(const ValidationResult& result);
+    std::string generateHTMLRuleCosts(const ValidationResult& result);
     std::string generateHTMLFooter();
     
     // Console report helpers
     void printConsoleSummary(const ValidationResult& result);
+    void printConsoleProfiles(const ValidationResult& result);
     void printConsoleStatistics(const ValidationResult& result);
     void printConsoleIssues(const std::vector<ValidationIssue>& issues, const std::string& title);
     void printConsoleMeshDetails(const std::vector<MeshValidationResult>& meshResults);
     void printConsoleMaterialDetails(const std::vector<MaterialValidationResult>& materialResults);
+    void printConsoleBounds(const ValidationResult& result);
+    void printConsoleGpuMemory(const ValidationResult& result);
+    void printConsoleDrawCalls(const ValidationResult& result);
+    void printConsoleHiddenGeometry(const ValidationResult& result);
+    void printConsoleDuplicateMeshes(const ValidationResult& result);
+    void printConsoleMaterialDedup(const ValidationResult& result);
+    void printConsoleOptimization(const ValidationResult& result);
+    void printConsoleLods(const ValidationResult& result);
+    void printConsoleRuleCosts(const ValidationResult& result);
     
     // Utility functions
+    static std::vector<const RuleCostResult*> sortRuleCosts(const ValidationResult& result); // Slowest first
     std::string getSeverityColor(Severity severity);
     std::string getSeverityIcon(Severity severity);
     std::string formatFileSize(uint64_t bytes);
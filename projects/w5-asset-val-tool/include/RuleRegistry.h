@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "ValidationConfig.h"
+#include "ValidationResult.h"
+
+struct ValidationPlan;
+class ThreadPool;
+
+// Rule signatures. Every rule reads its thresholds from the plan, never
+// from the config, and only writes to the result slot it is handed. Mesh
+// rules also get the pool so heavy ones can split their own index range.
+// Scene passes run after every per-asset rule and aggregate the complete
+// result, so they get all of it.
+using SceneRule = void (*)(const ValidationPlan& plan, const SceneData& scene, std::vector<ValidationIssue>& issues);
+using ScenePass = void (*)(const ValidationPlan& plan, ThreadPool& pool, const SceneData& scene,
+                           ValidationResult& result);
+using MeshRule = void (*)(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                          MeshValidationResult& result);
+using MaterialRule = void (*)(const ValidationPlan& plan, const MaterialData& material, MaterialValidationResult& result);
+using TextureRule = void (*)(const ValidationPlan& plan, const TextureData& texture, std::vector<ValidationIssue>& issues);
+
+// Whether a rule runs under a configuration
+using RuleEnabled = bool (*)(const ValidationConfig& config);
+
+enum class RuleScope {
+    Scene,
+    Mesh,
+    Material,
+    Texture
+};
+
+// Data a rule reads, as a bit mask. A rule that reads none of these only
+// looks at names and counts.
+namespace RuleData {
+    const uint32_t Positions = 1u << 0;
+    const uint32_t Normals = 1u << 1;
+    const uint32_t UVs = 1u << 2;
+    const uint32_t Indices = 1u << 3;
+    const uint32_t Materials = 1u << 4;
+    const uint32_t Textures = 1u << 5;
+    const uint32_t Tangents = 1u << 6;
+}
+
+// Cost tiers, cheapest first. Rules of one scope run tier by tier, in
+// registration order within a tier.
+enum class RuleCost {
+    Metadata, // Constant per asset: counts, names, factors
+    Linear,   // A few passes over the asset's streams
+    Heavy     // Rasterization or other work beyond the stream size
+};
+
+struct RuleDescriptor {
+    std::string name;
+    RuleScope scope = RuleScope::Mesh;
+    uint32_t data = 0; // RuleData bits
+    RuleCost cost = RuleCost::Linear;
+
+    // The function matching scope; the others stay null. Scene rules have
+    // either a sceneRule or a scenePass.
+    SceneRule sceneRule = nullptr;
+    ScenePass scenePass = nullptr;
+    MeshRule meshRule = nullptr;
+    MaterialRule materialRule = nullptr;
+    TextureRule textureRule = nullptr;
+
+    // Null means always. Names in ValidationConfig::disabledRules are
+    // dropped either way.
+    RuleEnabled enabled = nullptr;
+};
+
+// Descriptor for a rule function; the overload picks the scope
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, SceneRule rule,
+                            RuleEnabled enabled = nullptr);
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, ScenePass rule,
+                            RuleEnabled enabled = nullptr);
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, MeshRule rule,
+                            RuleEnabled enabled = nullptr);
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, MaterialRule rule,
+                            RuleEnabled enabled = nullptr);
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, TextureRule rule,
+                            RuleEnabled enabled = nullptr);
+
+// The set of rules a Validator compiles plans from. Built-in rules are
+// registered by the Validator itself; studio-specific rules are added
+// through Validator::registerRule without touching the built-in ones.
+class RuleRegistry {
+public:
+    // Throws std::invalid_argument for an empty or duplicate name, or when
+    // the function set does not match the scope
+    void add(const RuleDescriptor& rule);
+
+    const std::vector<RuleDescriptor>& getRules() const { return rules; }
+    const RuleDescriptor* find(const std::string& name) const;
+
+    static const char* scopeName(RuleScope scope);
+    static const char* costName(RuleCost cost);
+    static std::string dataNames(uint32_t data); // e.g. "positions+indices", "metadata"
+
+private:
+    std::vector<RuleDescriptor> rules;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// Two triangles of the same mesh passing through each other
+struct SelfIntersection {
+    uint32_t triangleA = 0; // Lower triangle index
+    uint32_t triangleB = 0;
+    glm::vec3 location = glm::vec3(0.0f); // Mesh space: middle of the intersection segment
+    bool coplanar = false;                // Overlap within one plane (location is A's centroid)
+};
+
+struct SelfIntersectionResult {
+    uint64_t candidatePairs = 0;     // Non-adjacent triangle pairs whose boxes overlap
+    uint64_t intersectingPairs = 0;
+    uint64_t coplanarPairs = 0;      // ...of which overlap within one plane
+    uint32_t intersectingTriangles = 0;
+
+    // Mesh-space box around every intersection location; zero when none
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+
+    std::vector<SelfIntersection> intersections; // Ordered by triangle pair, at most kMaxListed
+
+    static constexpr size_t kMaxListed = 16;
+};
+
+// Triangles of one mesh that intersect each other, which breaks baking
+// cages, voxelizers and physics cooking.
+//
+// A TriangleBVH is built over the mesh and traversed against itself: a
+// node pairs with itself (its two children with themselves and with each
+// other) and two nodes descend only while their boxes overlap, so only
+// nearby leaves meet and the cost follows the number of close pairs, not
+// n^2. The first levels of the traversal are expanded into a few thousand
+// independent node pairs that run as pool tasks.
+//
+// Leaf pairs go through a triangle-triangle test after Moller: each
+// triangle must straddle the other's plane, and the two intervals where
+// they cross the line of the planes must overlap. Triangles sharing one
+// or two positions (welded, see EdgeAdjacency) touch by construction and
+// are skipped; sharing all three makes a duplicate face. Crossings or
+// overlaps within the contact tolerance count as touching, not
+// intersecting. Coplanar pairs intersect when an edge crosses an edge of
+// the other or a corner or centroid lies inside it.
+class SelfIntersectionAnalyzer {
+public:
+    // Contacts closer than relativeTolerance times the mesh's box diagonal
+    // are touching
+    explicit SelfIntersectionAnalyzer(float relativeTolerance);
+
+    SelfIntersectionResult analyze(const std::vector<glm::vec3>& vertices,
+                                   const std::vector<uint32_t>& indices,
+                                   ThreadPool& pool) const;
+
+private:
+    float relativeTolerance;
+};
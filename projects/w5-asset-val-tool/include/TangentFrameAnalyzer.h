@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AssetLoader.h"
+#include "VertexKernels.h"
+
+class ThreadPool;
+
+struct TangentFrameResult {
+    bool hasTangents = false;
+    TangentStreamStats tangentStats;
+
+    // Triangles with in-range indices, a non-zero face and usable normals
+    uint64_t checkedTriangles = 0;
+
+    // Summed vertex normal more than the allowed angle from the face normal
+    uint64_t windingMismatchTriangles = 0;
+    std::vector<uint32_t> worstWindingTriangles; // Largest angle first, at most kMaxWorstTriangles
+
+    // Corners with both +1 and -1 handedness
+    uint64_t mixedHandednessTriangles = 0;
+    std::vector<uint32_t> mixedHandednessSamples; // Lowest triangle index first, at most kMaxWorstTriangles
+
+    static constexpr size_t kMaxWorstTriangles = 16;
+};
+
+// Shading frame sanity: vertex normals against face winding, and tangent
+// frames against their normals.
+//
+// Tangents go through one SIMD stream pass (see VertexKernels) that counts
+// broken and zero-length tangents and records every vertex's handedness.
+// The face normal, summed vertex normal and their cosine are then computed
+// per block of triangles (see VertexKernels::TriangleBlock).
+class TangentFrameAnalyzer {
+public:
+    // maxNormalFaceAngle in degrees; 90 flags only normals facing away
+    explicit TangentFrameAnalyzer(float maxNormalFaceAngle);
+
+    TangentFrameResult analyze(const MeshData& mesh, ThreadPool& pool) const;
+
+private:
+    float minCosine;
+};
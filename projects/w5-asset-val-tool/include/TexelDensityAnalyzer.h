@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+struct TexelDensityResult {
+    // Texture the densities refer to; 0 when the mesh has no sized texture
+    uint32_t textureWidth = 0;
+    uint32_t textureHeight = 0;
+
+    uint64_t measuredTriangles = 0; // Triangles with both world and UV area
+    double worldArea = 0.0;         // Square metres over measured triangles
+    double texelArea = 0.0;         // Texels they cover (UV area * width * height)
+
+    // Texels per metre; the median is weighted by world area
+    float minDensity = 0.0f;
+    float medianDensity = 0.0f;
+    float maxDensity = 0.0f;
+
+    // Triangles per half octave of density, starting at 1 texel/m; the end
+    // buckets also hold everything beyond them
+    static constexpr float kHistogramBinOctaves = 0.5f;
+    std::vector<uint32_t> histogram;
+
+    uint64_t outlierTriangles = 0;        // Further than the allowed ratio from the reference
+    std::vector<uint32_t> worstTriangles; // Largest deviations first, at most kMaxWorstTriangles
+
+    // Runtime hints, filled in once the whole scene is known:
+    // log2(density / reference), i.e. mips the runtime can skip (negative
+    // means the mesh is under-textured), and the mesh's share of the
+    // largest mesh surface as a streaming priority in [0, 1]
+    float mipBias = 0.0f;
+    float streamingPriority = 0.0f;
+
+    static constexpr size_t kMaxWorstTriangles = 16;
+};
+
+// Texel density (texels per world-space metre) of every triangle: the
+// square root of its UV area over its world area, scaled by the texture
+// resolution. World areas come from the mesh-space cross products mapped
+// through the cofactor of the node transform's linear part, which is exact
+// under non-uniform scale and shear; positions are taken to be in metres,
+// as glTF specifies.
+//
+// Areas and logarithms are computed per block of triangles (see
+// VertexKernels::TriangleBlock), the log2 with VertexKernels::fastLog2.
+class TexelDensityAnalyzer {
+public:
+    // referenceDensity: texels per metre outliers are measured against; 0
+    // uses the mesh's own median. maxRatio: allowed factor either way.
+    TexelDensityAnalyzer(float referenceDensity, float maxRatio);
+
+    TexelDensityResult analyze(const std::vector<glm::vec3>& vertices,
+                               const std::vector<glm::vec2>& uvs,
+                               const std::vector<uint32_t>& indices,
+                               const glm::mat4& worldTransform,
+                               uint32_t textureWidth, uint32_t textureHeight,
+                               ThreadPool& pool) const;
+
+private:
+    float referenceDensity;
+    float maxRatio;
+};
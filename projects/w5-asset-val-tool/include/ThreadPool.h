@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool used to run validation rules in parallel.
+//
+// Every worker owns a deque: it pushes and pops its own tasks at the back
+// and steals from the front of other workers' deques when it runs dry.
+// The thread calling parallelFor() takes part in the work while it waits,
+// so nested parallelFor() calls (e.g. a per-mesh rule that splits its own
+// triangle range) cannot deadlock the pool.
+class ThreadPool {
+public:
+    // threadCount includes the calling thread; 0 means one per hardware thread.
+    // A pool of size 1 has no workers and runs everything on the caller.
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Run fn(i) for every i in [0, count) and block until all calls returned.
+    // Indices are grouped into chunks of grainSize per task. The first
+    // exception thrown by fn is rethrown here once the loop has drained.
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t grainSize = 1);
+
+    // Total number of threads taking part in parallelFor (workers + caller)
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+private:
+    struct TaskGroup {
+        std::atomic<size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<size_t> queuedTasks{0};
+    std::atomic<size_t> nextQueue{0};
+    bool stopping;
+
+    void workerLoop(size_t workerIndex);
+    void push(Task task);
+    bool tryRunOne();
+    bool popLocal(size_t queueIndex, Task& task);
+    bool steal(size_t thiefIndex, Task& task);
+    void execute(Task& task);
+};
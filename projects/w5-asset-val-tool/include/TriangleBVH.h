@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// 32-byte BVH node. Inner nodes keep their children next to each other.
+struct BVHNode {
+    glm::vec3 min;
+    uint32_t first; // Leaf: first slot in leaf order; inner: left child (right is first + 1)
+    glm::vec3 max;
+    uint32_t count; // Leaf: triangles in it; inner: 0
+
+    bool isLeaf() const { return count > 0; }
+};
+
+// Bounding volume hierarchy over a triangle soup.
+//
+// Construction is top-down with a binned surface area heuristic: the
+// centroids of a node's triangles are binned along each axis and the
+// cheapest of the bin boundaries (traversal cost 1, one unit per triangle)
+// is split, or the node becomes a leaf when no split beats intersecting
+// everything. Large nodes bin their triangles in parallel chunks, and the
+// two subtrees of a large node are built as two pool tasks; child pairs
+// are claimed from an atomic counter and triangles are partitioned in
+// place within each node's own range, so tasks never share memory. The
+// tree and leaf order do not depend on the thread count.
+//
+// After the build, triangle corners are stored in leaf order, so a leaf's
+// triangles sit next to each other in memory.
+class TriangleBVH {
+public:
+    // corners holds three per triangle; triangle ids are positions in it / 3
+    void build(std::vector<glm::vec3> corners, ThreadPool& pool);
+
+    // Does the ray hit any triangle with t in (tMin, tMax)? Two-sided; the
+    // triangle with id ignore (e.g. the ray's own surface) is skipped
+    bool occluded(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax,
+                  uint32_t ignore) const;
+
+    const std::vector<BVHNode>& getNodes() const { return nodes; }
+
+    // Triangle id stored in leaf slot s, and its corners
+    uint32_t triangleAt(uint32_t slot) const { return order[slot]; }
+    const glm::vec3* cornersAt(uint32_t slot) const { return &corners[size_t(slot) * 3]; }
+    size_t triangleCount() const { return order.size(); }
+
+    static constexpr uint32_t kNoTriangle = UINT32_MAX;
+
+private:
+    std::vector<BVHNode> nodes;
+    std::vector<uint32_t> order;     // Leaf slot -> triangle id
+    std::vector<glm::vec3> corners;  // In leaf order
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// One UV island, identified by the first triangle that belongs to it
+struct UVIslandSample {
+    uint32_t firstTriangle = 0;
+    uint32_t triangles = 0;
+    float texels = 0.0f; // UV area * texture width * height
+};
+
+struct UVIslandResult {
+    uint32_t islandCount = 0;
+
+    // Distinct positions and distinct (position, UV) pairs the triangles
+    // use; the difference is the vertices UV seams force the GPU to copy
+    uint64_t positionVertices = 0;
+    uint64_t uvVertices = 0;
+    uint64_t seamVertices = 0;
+
+    // Edges shared in 3D but split in UV space, and their length in model units
+    uint64_t seamEdges = 0;
+    double seamLength = 0.0;
+
+    // Texture the tiny-island test measured against
+    uint32_t textureWidth = 0;
+    uint32_t textureHeight = 0;
+
+    // Islands covering fewer texels than the minimum
+    uint32_t tinyIslands = 0;
+    uint64_t tinyIslandTriangles = 0;
+    std::vector<UVIslandSample> smallestIslands; // Tiny islands, fewest texels first, at most kMaxSmallestIslands
+
+    static constexpr size_t kMaxSmallestIslands = 16;
+};
+
+// UV islands, seams and the vertex splits they cause.
+//
+// Vertices are welded twice with hash buckets (see EdgeAdjacency): by
+// position, and by position plus UV. Chunks of the index buffer then
+// union every triangle's welded corners in a ConcurrentUnionFind across
+// the pool; roots are set minima whatever the thread timing, so island
+// numbering (by first triangle) is deterministic.
+//
+// Seam edges are UV-space boundary edges whose position-space edge still
+// has a triangle on both sides; each seam shows up once in each island it
+// separates. Every pass is linear apart from sorting the position-space
+// boundary edges, which are few on real meshes.
+class UVIslandAnalyzer {
+public:
+    // Islands covering fewer texels than minIslandTexels are tiny
+    explicit UVIslandAnalyzer(float minIslandTexels);
+
+    UVIslandResult analyze(const std::vector<glm::vec3>& vertices,
+                           const std::vector<glm::vec2>& uvs,
+                           const std::vector<uint32_t>& indices,
+                           uint32_t textureWidth, uint32_t textureHeight,
+                           ThreadPool& pool) const;
+
+private:
+    float minIslandTexels;
+};
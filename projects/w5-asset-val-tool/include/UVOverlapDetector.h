@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct UVOverlapResult {
+    uint64_t coveredTexels = 0;                 // Texels covered by at least one triangle
+    uint64_t overlappingTexels = 0;             // Texels covered by two or more triangles
+    float overlapPercentage = 0.0f;             // overlappingTexels / coveredTexels * 100
+    std::vector<uint32_t> overlappingTriangles; // Triangle indices, ascending
+};
+
+// Finds overlapping UV triangles by rasterizing them into an occupancy grid
+// covering the 0-1 UV square at a configurable resolution.
+//
+// Each texel center is owned by at most one triangle of a watertight UV
+// chart (top-left fill rule on snapped integer coordinates), so triangles
+// that merely share an edge never count as overlapping. Cost is linear in
+// triangle count plus covered texel area, instead of testing every pair.
+class UVOverlapDetector {
+public:
+    explicit UVOverlapDetector(uint32_t resolution = 1024);
+
+    UVOverlapResult analyze(const std::vector<glm::vec2>& uvCoords,
+                            const std::vector<uint32_t>& indices) const;
+
+    uint32_t getResolution() const { return resolution; }
+
+private:
+    uint32_t resolution;
+};
@@ -21,6 +21,107 @@ struct ValidationConfig {
     bool checkUVRange = true;
     bool checkUVOverlaps = true;
     float uvTolerance = 0.001f;
+    uint32_t uvOverlapResolution = 1024;    // Occupancy grid texels per UV unit
+    float maxUVOverlapPercentage = 1.0f;    // Overlapping share of covered texels
+    bool checkUVIslands = true;
+    float maxSeamVertexRatio = 0.5f;        // Vertices split by UV seams per position (0 = no limit)
+    float minIslandTexels = 16.0f;          // Islands covering fewer texels are tiny
+    uint32_t maxTinyIslands = 8;            // Tiny islands allowed per mesh
+    uint32_t islandAtlasSize = 1024;        // Texture size assumed for meshes without a sized texture
+    
+    // Geometry validation
+    bool checkDegenerateTriangles = true;
+    float degenerateAreaEpsilon = 1e-10f;   // Triangles below this area count as zero-area
+    float nearDegenerateRatio = 1e-3f;      // Height / longest edge below this is a needle or sliver
+    bool checkDuplicateVertices = true;
+    float weldPositionTolerance = 1e-5f;    // Distance within which vertices are coincident
+    float weldAttributeTolerance = 1e-3f;   // Per-component normal/UV difference still considered equal
+    bool checkTopology = true;              // Boundary loops, non-manifold edges, winding flips
+    bool requireWatertight = false;         // Open borders are errors rather than informational
+    bool checkConnectedComponents = true;   // Floating debris and stacked duplicate shells
+    uint32_t minComponentTriangles = 8;     // Smaller detached components are debris
+    float minComponentVolumeRatio = 1e-6f;  // Detached components below this share of the mesh's bounding volume are debris
+    uint32_t maxDebrisComponents = 0;       // Debris components allowed per mesh
+    bool checkSelfIntersections = true;     // Triangles of one mesh passing through each other
+    float selfIntersectionTolerance = 1e-5f; // Contact depth, as a share of the mesh's bbox diagonal, still counted as touching
+    uint32_t maxSelfIntersections = 0;      // Intersecting triangles allowed per mesh
+    
+    // Spatial extent (scene units after node transforms; glTF specifies metres)
+    bool checkBounds = true;
+    float maxSceneExtent = 1000.0f;         // Longest scene box side; centimetre exports land far above this
+    float minSceneExtent = 0.01f;           // Longest side below this suggests a unit mix-up the other way
+    float maxOriginOffset = 100.0f;         // Scene box centre distance from the origin
+    float strayVertexFactor = 10.0f;        // Vertices this many core radii from the mesh centre are strays (0 = off)
+    
+    // GPU vertex pipeline efficiency (thresholds of 0 disable that check)
+    bool checkVertexCache = true;
+    std::vector<std::string> vertexCacheModels = {"fifo", "lru"}; // Simulated caches: every model at every size
+    std::vector<uint32_t> vertexCacheSizes = {16, 32, 64};        // Post-transform cache entries
+    std::string vertexCacheModel = "fifo";  // Cache --fix and LODs order triangles for: "fifo" or "lru"
+    uint32_t vertexCacheSize = 32;
+    float maxACMR = 0.0f;                   // Vertex shader invocations per triangle; its floor depends on the mesh, so ATVR is the default gate
+    float maxATVR = 2.0f;                   // Vertex shader invocations per unique vertex
+    float maxVertexFetchOverfetch = 2.0f;   // Fetched bytes over vertex buffer bytes used
+    
+    // Meshlets for cluster culling
+    bool checkMeshlets = true;
+    uint32_t meshletMaxVertices = 64;       // Per meshlet, at most 255
+    uint32_t meshletMaxTriangles = 124;     // Per meshlet, at most 255
+    float minMeshletTriangleFill = 0.5f;    // Average triangles per meshlet over the limit (0 = off)
+    
+    // Duplicate geometry
+    bool checkDuplicateMeshes = true;
+    bool matchRigidDuplicates = true;       // Also match rotated/translated copies
+    float rigidDuplicateTolerance = 0.001f; // Fraction of the mesh's RMS extent
+    uint32_t minDuplicateTriangles = 100;   // Smaller meshes are not worth instancing
+    uint32_t maxDuplicateSuggestions = 10;  // Duplicate groups listed as issues
+    
+    // Material deduplication
+    bool checkMaterialDedup = true;
+    uint32_t materialFactorSteps = 255;     // Factor quantization levels over [0, 1]
+    
+    // Normal and tangent frames
+    bool checkTangentFrames = true;
+    float maxNormalFaceAngle = 90.0f;       // Degrees between summed vertex normals and the face normal
+    
+    // GPU memory budgets (MB; 0 disables a budget)
+    bool checkGpuMemory = true;
+    std::string textureFormat = "bc7";      // rgba8, bc1, bc4, bc5, bc7, astc_4x4, astc_6x6 or astc_8x8
+    std::string normalTextureFormat = "bc5";
+    bool mipChains = true;                  // Count full mip chains, not just the top level
+    float maxMeshMemoryMB = 0.0f;
+    float maxTextureMemoryMB = 0.0f;
+    float maxTotalMemoryMB = 256.0f;
+    
+    // Draw calls and batching
+    bool checkDrawCalls = true;
+    uint32_t maxDrawCalls = 1000;
+    uint32_t maxBatchVertices = 65535;      // Largest merged mesh; 0 = no limit
+    uint32_t maxBatchSuggestions = 10;      // Merge/instance suggestions listed as issues
+    
+    // Small triangles and quad overdraw (distances in metres)
+    bool checkQuadOverdraw = true;
+    uint32_t quadScreenHeight = 1080;       // Vertical resolution of the reference view
+    float quadVerticalFov = 60.0f;          // Degrees
+    std::vector<float> quadReferenceDistances = {2.0f, 10.0f, 50.0f}; // Where the mesh is expected to be seen
+    float minQuadEfficiency = 0.5f;         // Covered pixels per shaded quad lane before a LOD should take over
+    
+    // Hidden (interior) geometry; off by default, as it casts rays over the whole scene
+    bool checkHiddenGeometry = false;
+    uint32_t visibilityDirections = 32;     // Ray directions per sample point, besides the two normals
+    float maxHiddenPercentage = 1.0f;       // Share of triangles no viewpoint sees, per mesh and scene
+    
+    // LOD generation
+    bool generateLODs = false;
+    std::vector<float> lodRatios = {0.5f, 0.25f, 0.1f}; // Triangle share of the base mesh per level
+    float lodMaxRelativeError = 0.0f;       // Stop a level past this share of the bbox diagonal (0 = no limit)
+    bool writeLODs = true;                  // Add the levels to the --fix output
+    
+    // Texel density (texels per metre)
+    bool checkTexelDensity = true;
+    float targetTexelDensity = 0.0f;        // Studio target; 0 = compare against the scene average
+    float maxDensityRatio = 4.0f;           // Allowed factor above or below the reference
+    float maxOutlierPercentage = 5.0f;      // Share of triangles allowed beyond that factor
     
     // Naming conventions
     bool enforceNamingConventions = true;
@@ -28,6 +129,9 @@ struct ValidationConfig {
     std::string materialNamePattern = "^[a-zA-Z][a-zA-Z0-9_]*$";
     std::string textureNamePattern = "^[a-zA-Z][a-zA-Z0-9_]*\\.(png|jpg|jpeg|tga|bmp)$";
     
+    // Rule selection: names of built-in or registered rules to skip
+    std::vector<std::string> disabledRules;
+    
     // Material validation
     bool requireAlbedoTexture = false;
     bool requireNormalTexture = false;
@@ -40,6 +144,9 @@ struct ValidationConfig {
     // Performance
     bool enableDetailedLogging = true;
     bool generateSuggestions = true;
+    uint32_t threadCount = 0; // 0 = one worker per hardware thread
+    bool failFast = false;    // Stop at the first ERROR or CRITICAL issue
+    uint32_t maxErrors = 0;   // Stop once this many ERROR/CRITICAL issues were found (0 = run everything)
     
     // Load configuration from JSON file
     static ValidationConfig loadFromFile(const std::string& configPath);
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "ValidationConfig.h"
+#include "ValidationResult.h"
+#include "AssetLoader.h"
+#include "NameMatcher.h"
+#include "VertexCacheAnalyzer.h"
+#include "GpuMemoryEstimator.h"
+#include "RuleRegistry.h"
+#include "MetricCache.h"
+
+// A ValidationConfig compiled for execution: name patterns turned into
+// matchers, thresholds resolved into the form the rules compare against,
+// and the enabled rules listed in the order they run. Disabled rules are
+// simply absent, so the per-asset loops carry no enablement checks.
+//
+// The constructor resolves everything that depends only on the config;
+// Validator::compilePlan then fills in the rule lists. Plans are built
+// once per configuration and only ever handed out as
+// shared_ptr<const ValidationPlan>; nothing mutates one after compilation,
+// so every worker thread reads the same plan without synchronization.
+struct ValidationPlan {
+    explicit ValidationPlan(const ValidationConfig& config);
+
+    // Polygon limits
+    uint32_t maxTrianglesPerMesh;
+    uint32_t maxVerticesPerMesh;
+    uint32_t maxTotalTriangles;
+
+    // Texture limits
+    uint32_t maxTextureWidth;
+    uint32_t maxTextureHeight;
+    std::unordered_set<std::string> allowedTextureFormats; // Lower case, no leading dot
+
+    // UV validation
+    bool checkUVRange;
+    float uvTolerance;
+    uint32_t uvOverlapResolution;
+    float maxUVOverlapPercentage;
+    float maxSeamVertexRatio;
+    float minIslandTexels;
+    uint32_t maxTinyIslands;
+    uint32_t islandAtlasSize;
+
+    // Geometry validation
+    float degenerateAreaEpsilon;
+    float nearDegenerateRatio;
+    float weldPositionTolerance;
+    float weldAttributeTolerance;
+    bool requireWatertight;
+    uint32_t minComponentTriangles;
+    float minComponentVolumeRatio;
+    uint32_t maxDebrisComponents;
+    float selfIntersectionTolerance;
+    uint32_t maxSelfIntersections;
+    
+    // Spatial extent (0 disables a limit)
+    float maxSceneExtent;
+    float minSceneExtent;
+    float maxOriginOffset;
+    float strayVertexFactor;
+
+    // GPU vertex pipeline efficiency
+    std::vector<VertexCacheModel> vertexCacheModels; // No repeats
+    std::vector<uint32_t> vertexCacheSizes;          // Positive, ascending, no repeats
+    VertexCacheModel vertexCacheModel;               // Target of --fix and LODs
+    uint32_t vertexCacheSize;
+    float maxACMR;
+    float maxATVR;
+    float maxVertexFetchOverfetch;
+    
+    // Meshlets
+    uint32_t meshletMaxVertices;
+    uint32_t meshletMaxTriangles;
+    float minMeshletTriangleFill;
+    
+    // Duplicate geometry
+    bool findDuplicateMeshes;
+    bool matchRigidDuplicates;
+    float rigidDuplicateTolerance;
+    uint32_t minDuplicateTriangles;
+    uint32_t maxDuplicateSuggestions;
+    
+    // Material deduplication
+    bool dedupMaterials;
+    uint32_t materialFactorSteps;
+    
+    // Normal and tangent frames
+    float maxNormalFaceAngle;
+    
+    // GPU memory budgets in bytes (0 = no budget)
+    GpuTextureFormat textureFormat;
+    GpuTextureFormat normalTextureFormat;
+    bool mipChains;
+    uint64_t maxMeshMemoryBytes;
+    uint64_t maxTextureMemoryBytes;
+    uint64_t maxTotalMemoryBytes;
+    
+    // Draw calls and batching
+    uint32_t maxDrawCalls;
+    uint32_t maxBatchVertices;
+    uint32_t maxBatchSuggestions;
+
+    // Small triangles and quad overdraw
+    uint32_t quadScreenHeight;
+    float quadVerticalFov;
+    std::vector<float> quadReferenceDistances; // Positive, ascending, no repeats
+    float minQuadEfficiency;
+
+    // Hidden geometry
+    uint32_t visibilityDirections;
+    float maxHiddenPercentage;
+
+    // LOD generation
+    std::vector<float> lodRatios; // In (0, 1), descending, no repeats
+    float lodMaxRelativeError;
+    
+    // Texel density
+    float targetTexelDensity; // 0 = scene average
+    float maxDensityRatio;    // At least 1
+    float maxOutlierPercentage;
+
+    // Naming conventions
+    NameMatcher meshNameMatcher;
+    NameMatcher materialNameMatcher;
+    NameMatcher textureNameMatcher;
+
+    // Material requirements
+    bool requireAlbedoTexture;
+    bool requireNormalTexture;
+    bool requireMetallicRoughnessTexture;
+
+    // Early exit: stop after this many ERROR/CRITICAL issues, 0 = never
+    uint32_t errorBudget;
+
+    // Set for the profiles of a multi-profile run: expensive metrics are
+    // looked up here before being computed. The cache synchronizes itself,
+    // so the plan is still safe to share.
+    std::shared_ptr<MetricCache> metrics;
+
+    // Active rules, copied from the registry. The per-scope lists index
+    // into rules in execution order: cheapest cost tier first, registration
+    // order within a tier. The first meshMetadataRuleCount mesh rules only
+    // look at counts and names, never at vertex data. Scene passes run
+    // last, over the complete per-asset results.
+    std::vector<RuleDescriptor> rules;
+    std::vector<uint32_t> sceneRules;
+    std::vector<uint32_t> scenePasses;
+    std::vector<uint32_t> meshRules;
+    size_t meshMetadataRuleCount = 0;
+    std::vector<uint32_t> materialRules;
+    std::vector<uint32_t> textureRules;
+};
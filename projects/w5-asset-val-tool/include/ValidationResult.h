@@ -3,6 +3,21 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "VertexKernels.h"
+#include "TexelDensityAnalyzer.h"
+#include "BoundsAnalyzer.h"
+#include "TangentFrameAnalyzer.h"
+#include "GpuMemoryEstimator.h"
+#include "DrawCallEstimator.h"
+#include "MaterialDeduplicator.h"
+#include "GeometryHasher.h"
+#include "UVIslandAnalyzer.h"
+#include "MeshComponentAnalyzer.h"
+#include "QuadOverdrawAnalyzer.h"
+#include "HiddenGeometryAnalyzer.h"
+#include "SelfIntersectionAnalyzer.h"
+#include "MeshletBuilder.h"
+#include "VertexCacheAnalyzer.h"
 
 enum class Severity {
     INFO,
@@ -31,7 +46,65 @@ struct MeshValidationResult {
     std::vector<ValidationIssue> issues;
     bool hasValidUVs;
     
-    MeshValidationResult() : vertexCount(0), triangleCount(0), materialCount(0), hasValidUVs(true) {}
+    // Per-stream vertex statistics
+    PositionStreamStats positionStats;
+    NormalStreamStats normalStats;
+    UVStreamStats uvStats;
+    
+    // Degenerate triangles and duplicate vertices
+    uint64_t zeroAreaTriangles;
+    uint64_t nearDegenerateTriangles;
+    std::vector<uint32_t> degenerateTriangles;
+    uint64_t coincidentVertices;
+    uint64_t weldableVertices;
+    
+    // Edge topology over position-welded vertices
+    uint64_t boundaryEdges;
+    uint64_t boundaryLoops;
+    uint64_t nonManifoldEdges;
+    uint64_t windingFlips;
+    bool isWatertight;
+    
+    // Connected shells, floating debris and stacked duplicates
+    MeshComponentResult components;
+    
+    // Triangles passing through other triangles of the mesh
+    SelfIntersectionResult selfIntersections;
+    
+    // Simulated GPU vertex pipeline efficiency, one entry per simulated
+    // cache; the scalars are the worst over them
+    std::vector<VertexCacheResult> vertexCaches;
+    float acmr;
+    float atvr;
+    float vertexFetchOverfetch;
+    
+    // Meshlet fill and cone culling potential
+    MeshletResult meshlets;
+    
+    // Quad shading efficiency at the reference distances, LOD distance
+    QuadOverdrawResult quadOverdraw;
+    
+    // UV overlap analysis
+    float uvOverlapPercentage;
+    std::vector<uint32_t> overlappingTriangles;
+    
+    // UV islands, seams and the vertices they split
+    UVIslandResult uvIslands;
+    
+    // Texel density against the mesh's first material's main texture
+    TexelDensityResult texelDensity;
+    
+    // Local and world bounding volumes, stray vertices
+    MeshBounds bounds;
+    
+    // Normals against winding, tangent frame handedness
+    TangentFrameResult tangentFrames;
+    
+    MeshValidationResult() : vertexCount(0), triangleCount(0), materialCount(0), hasValidUVs(true),
+                             zeroAreaTriangles(0), nearDegenerateTriangles(0), coincidentVertices(0),
+                             weldableVertices(0), boundaryEdges(0), boundaryLoops(0), nonManifoldEdges(0),
+                             windingFlips(0), isWatertight(true), acmr(0.0f), atvr(0.0f),
+                             vertexFetchOverfetch(0.0f), uvOverlapPercentage(0.0f) {}
 };
 
 struct MaterialValidationResult {
@@ -40,7 +113,84 @@ struct MaterialValidationResult {
     std::vector<ValidationIssue> issues;
     bool hasValidTextures;
     
-    MaterialValidationResult() : hasValidTextures(true) {}
+    // Texel density over every mesh using the material: overall texels per
+    // metre, and the largest over the smallest mesh median
+    float texelDensity;
+    float texelDensitySpread;
+    
+    MaterialValidationResult() : hasValidTextures(true), texelDensity(0.0f), texelDensitySpread(0.0f) {}
+};
+
+// Before/after figures for one mesh rewritten by --fix
+struct MeshOptimizationResult {
+    std::string meshName;
+    uint32_t verticesBefore = 0;
+    uint32_t verticesAfter = 0;
+    uint32_t trianglesBefore = 0;
+    uint32_t trianglesAfter = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    uint64_t bytesBefore = 0; // Vertex + index buffer bytes
+    uint64_t bytesAfter = 0;
+};
+
+// One generated level of detail
+struct LodLevelResult {
+    float targetRatio = 0.0f;   // Requested share of the base triangle count
+    uint32_t triangleCount = 0;
+    uint32_t vertexCount = 0;
+    float error = 0.0f;         // Largest quadric distance error, model units
+    float relativeError = 0.0f; // error / bounding box diagonal
+};
+
+struct MeshLodResult {
+    std::string meshName;
+    uint32_t baseTriangles = 0;
+    std::vector<LodLevelResult> levels;
+};
+
+// One asset's share of the GPU memory estimate
+struct GpuMemoryEntry {
+    std::string name;
+    std::string kind;        // mesh or texture
+    uint32_t width = 0;      // Textures only
+    uint32_t height = 0;
+    uint32_t instances = 1;  // Meshes: scene meshes sharing these buffers, counted once
+    GpuMemoryEstimate estimate;
+};
+
+struct GpuMemoryResult {
+    uint64_t meshBytes = 0;
+    uint64_t textureBytes = 0;
+    uint64_t totalBytes = 0;
+    std::vector<GpuMemoryEntry> entries; // Largest first
+};
+
+// Cost of one rule over one validation run
+struct RuleCostResult {
+    std::string ruleName;
+    std::string scope;           // scene, mesh, material or texture
+    std::string costTier;        // Declared tier: metadata, linear or heavy
+    std::string data;            // Declared inputs, e.g. "positions+indices"
+    uint64_t invocations = 0;    // Assets the rule ran on
+    uint64_t itemsProcessed = 0; // Triangles, vertices or assets, by the data read
+    double totalMs = 0.0;        // Summed over workers
+};
+
+// Outcome of one profile of a multi-profile run
+struct ProfileVerdict {
+    std::string name;
+    bool isValid = true;
+    bool stoppedEarly = false;
+    uint32_t criticalCount = 0;
+    uint32_t errorCount = 0;
+    uint32_t warningCount = 0;
+    uint32_t infoCount = 0;
+    std::vector<ValidationIssue> failures; // ERROR and CRITICAL issues, scene first, then per asset
+    
+    // Metric cache use while this profile ran
+    uint64_t metricsComputed = 0;
+    uint64_t metricsReused = 0;
 };
 
 struct ValidationResult {
@@ -50,6 +200,42 @@ struct ValidationResult {
     std::vector<MaterialValidationResult> materialResults;
     std::vector<ValidationIssue> globalIssues;
     
+    // Set when an error budget (fail-fast) ended the run before every rule ran
+    bool stoppedEarly;
+    
+    // World-space union of the mesh bounds
+    SceneBounds sceneBounds;
+    
+    // Estimated resident GPU memory
+    GpuMemoryResult gpuMemory;
+    
+    // Draw calls as submitted and after instancing/merging
+    DrawCallStats drawCalls;
+    
+    // Interior triangles no viewpoint sees; empty unless the check ran
+    HiddenGeometryResult hiddenGeometry;
+    
+    // Copies of the same geometry; index matches only with --mesh-index
+    DuplicateMeshResult duplicateMeshes;
+    
+    // Materials equal up to name; index matches only with --material-index
+    MaterialDedupResult materialDedup;
+    
+    // One verdict per profile when several ran; the rest of the result is
+    // the first profile's, and isValid holds only if every profile passed
+    std::vector<ProfileVerdict> profiles;
+    
+    // Per-rule wall time and work, in plan order
+    std::vector<RuleCostResult> ruleCosts;
+    
+    // Filled in by --fix
+    std::vector<MeshOptimizationResult> optimizationResults;
+    std::string optimizedFilePath;
+    uint64_t optimizedFileSize;
+    
+    // Filled in by LOD generation
+    std::vector<MeshLodResult> lodResults;
+    
     // Statistics
     uint32_t totalVertices;
     uint32_t totalTriangles;
@@ -57,7 +243,7 @@ struct ValidationResult {
     uint32_t totalMaterials;
     uint32_t totalTextures;
     
-    ValidationResult() : isValid(true), totalVertices(0), totalTriangles(0), 
+    ValidationResult() : isValid(true), stoppedEarly(false), optimizedFileSize(0), totalVertices(0), totalTriangles(0), 
                         totalMeshes(0), totalMaterials(0), totalTextures(0) {}
     
     void addIssue(const ValidationIssue& issue) {
@@ -71,6 +257,38 @@ struct ValidationResult {
 // JSON serialization helpers
 void to_json(nlohmann::json& j, const Severity& severity);
 void to_json(nlohmann::json& j, const ValidationIssue& issue);
+void to_json(nlohmann::json& j, const PositionStreamStats& stats);
+void to_json(nlohmann::json& j, const NormalStreamStats& stats);
+void to_json(nlohmann::json& j, const UVStreamStats& stats);
+void to_json(nlohmann::json& j, const TexelDensityResult& result);
+void to_json(nlohmann::json& j, const TangentFrameResult& result);
+void to_json(nlohmann::json& j, const UVIslandSample& island);
+void to_json(nlohmann::json& j, const UVIslandResult& result);
+void to_json(nlohmann::json& j, const MeshComponent& component);
+void to_json(nlohmann::json& j, const MeshComponentResult& result);
+void to_json(nlohmann::json& j, const SelfIntersection& intersection);
+void to_json(nlohmann::json& j, const SelfIntersectionResult& result);
+void to_json(nlohmann::json& j, const MeshletResult& result);
+void to_json(nlohmann::json& j, const QuadOverdrawSample& sample);
+void to_json(nlohmann::json& j, const QuadOverdrawResult& result);
+void to_json(nlohmann::json& j, const BoundingSphere& sphere);
+void to_json(nlohmann::json& j, const MeshBounds& bounds);
+void to_json(nlohmann::json& j, const SceneBounds& bounds);
 void to_json(nlohmann::json& j, const MeshValidationResult& result);
 void to_json(nlohmann::json& j, const MaterialValidationResult& result);
+void to_json(nlohmann::json& j, const MeshOptimizationResult& result);
+void to_json(nlohmann::json& j, const LodLevelResult& result);
+void to_json(nlohmann::json& j, const GpuMemoryEntry& entry);
+void to_json(nlohmann::json& j, const GpuMemoryResult& result);
+void to_json(nlohmann::json& j, const ProfileVerdict& verdict);
+void to_json(nlohmann::json& j, const DuplicateMeshGroup& group);
+void to_json(nlohmann::json& j, const DuplicateMeshResult& result);
+void to_json(nlohmann::json& j, const MaterialDedupGroup& group);
+void to_json(nlohmann::json& j, const MaterialDedupResult& result);
+void to_json(nlohmann::json& j, const DrawBatch& batch);
+void to_json(nlohmann::json& j, const DrawCallStats& stats);
+void to_json(nlohmann::json& j, const HiddenMeshResult& result);
+void to_json(nlohmann::json& j, const HiddenGeometryResult& result);
+void to_json(nlohmann::json& j, const RuleCostResult& result);
+void to_json(nlohmann::json& j, const MeshLodResult& result);
 void to_json(nlohmann::json& j, const ValidationResult& result);
\ No newline at end of file
@@ -3,9 +3,61 @@
 #include "ValidationResult.h"
 #include "ValidationConfig.h"
 #include "AssetLoader.h"
+#include "ThreadPool.h"
+#include "UVOverlapDetector.h"
+#include "DegenerateTriangleDetector.h"
+#include "DuplicateVertexDetector.h"
+#include "EdgeAdjacency.h"
+#include "TexelDensityAnalyzer.h"
+#include "BoundsAnalyzer.h"
+#include "GpuMemoryEstimator.h"
+#include "DrawCallEstimator.h"
+#include "MaterialDeduplicator.h"
+#include "GeometryHasher.h"
+#include "HiddenGeometryAnalyzer.h"
+#include "ValidationPlan.h"
 #include <glm/glm.hpp>
+#include <atomic>
 #include <memory>
 
+// Shared ERROR/CRITICAL counter for fail-fast runs. Rules report what they
+// added; once the limit is reached every worker stops picking up rules.
+// A rule already running is allowed to finish.
+class ErrorBudget {
+public:
+    explicit ErrorBudget(uint32_t limit) : limit(limit) {}
+    
+    bool exhausted() const { return stopped.load(std::memory_order_relaxed); }
+    
+    // Counts the ERROR and CRITICAL issues in issues[from..]
+    void spend(const std::vector<ValidationIssue>& issues, size_t from);
+
+private:
+    const uint32_t limit;
+    std::atomic<uint32_t> errors{0};
+    std::atomic<bool> stopped{false};
+};
+
+// Time and work of one rule over one validate() call. Nested parallel
+// rules wait by helping the pool, so their time can include other work.
+struct RuleCounters {
+    std::atomic<uint64_t> nanoseconds{0};
+    std::atomic<uint64_t> invocations{0};
+    std::atomic<uint64_t> items{0};
+};
+
+// Per-run state handed to the per-asset drivers; both parts are optional
+struct RuleRun {
+    ErrorBudget* budget = nullptr;
+    RuleCounters* counters = nullptr; // One per ValidationPlan::rules entry
+};
+
+// One named configuration of a multi-profile run
+struct ValidationProfile {
+    std::string name;
+    ValidationConfig config;
+};
+
 class Validator {
 public:
     Validator();
@@ -15,42 +67,158 @@ public:
     // Main validation function
     ValidationResult validate(const SceneData& sceneData);
     
-    // Individual validation functions
+    // Validates the scene against every profile in one pass over the data:
+    // metrics are computed once per distinct set of analysis parameters and
+    // every profile's thresholds are applied to them. Returns the first
+    // profile's full result with a verdict per profile. Profiles share this
+    // validator's thread pool and registered rules.
+    ValidationResult validateProfiles(const SceneData& sceneData, const std::vector<ValidationProfile>& profiles);
+    
+    // Individual validation functions, run against the current plan
     void validateMesh(const MeshData& mesh, MeshValidationResult& result);
     void validateMaterial(const MaterialData& material, MaterialValidationResult& result);
     void validateTexture(const TextureData& texture, std::vector<ValidationIssue>& issues);
-    void validateNamingConventions(const SceneData& sceneData, std::vector<ValidationIssue>& issues);
-    void validateSceneLimits(const SceneData& sceneData, std::vector<ValidationIssue>& issues);
+    static void validateNamingConventions(const ValidationPlan& plan, const SceneData& sceneData,
+                                          std::vector<ValidationIssue>& issues);
+    static void validateSceneLimits(const ValidationPlan& plan, const SceneData& sceneData,
+                                    std::vector<ValidationIssue>& issues);
     
     // Configuration management
-    void setConfig(const ValidationConfig& config) { this->config = config; }
+    void setConfig(const ValidationConfig& config);
     const ValidationConfig& getConfig() const { return config; }
+    const ValidationPlan& getPlan() const { return *plan; }
+    ThreadPool& getThreadPool() { return *threadPool; }
+    
+    // Add a studio-specific rule next to the built-in ones; the plan is
+    // recompiled so the next validate() runs it. Throws like RuleRegistry::add.
+    void registerRule(const RuleDescriptor& rule);
+    const RuleRegistry& getRuleRegistry() const { return registry; }
+    
+    // Compile a configuration into an immutable, shareable plan
+    static std::shared_ptr<const ValidationPlan> compilePlan(const ValidationConfig& config,
+                                                             const RuleRegistry& registry,
+                                                             std::shared_ptr<MetricCache> metrics = nullptr);
 
 private:
     ValidationConfig config;
+    RuleRegistry registry;
+    std::shared_ptr<const ValidationPlan> plan;
+    std::unique_ptr<ThreadPool> threadPool;
+    
+    // validate() against an explicit plan
+    ValidationResult runPlan(const ValidationPlan& activePlan, const SceneData& sceneData);
+    
+    // Runs the plan with an error budget: scene rules, then every cheap
+    // per-asset rule, then the vertex data rules, stopping between rules
+    // once the budget is spent
+    void validateWithBudget(const ValidationPlan& plan, const SceneData& sceneData, ValidationResult& result,
+                            std::vector<std::vector<ValidationIssue>>& textureIssues, const RuleRun& run);
+    
+    // Scene-relative texel density: mip bias and streaming priority per
+    // mesh, and the per-material aggregate with its spread warning
+    static void resolveTexelDensity(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                    ValidationResult& result);
+    
+    // Scene bounds from the mesh bounds, with the extent and origin checks
+    static void resolveSceneBounds(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                   ValidationResult& result);
+    
+    // GPU memory breakdown, largest first, with the total budget check
+    static void resolveGpuMemory(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                 ValidationResult& result);
+    
+    // Meshes copied instead of instanced
+    static void resolveDuplicateMeshes(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                       ValidationResult& result);
+    
+    // Materials that differ only in name
+    static void resolveMaterialDedup(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                     ValidationResult& result);
+    
+    // Draw-call estimate, draw budget and batching suggestions
+    static void resolveDrawCalls(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                 ValidationResult& result);
+    
+    // Triangles no viewpoint can see, per mesh and for the scene
+    static void resolveHiddenGeometry(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                      ValidationResult& result);
+    
+    // The built-in rules with their declared data, scope and cost
+    static RuleRegistry createBuiltinRegistry();
     
-    // Detailed validation functions
-    void validatePolygonCount(const MeshData& mesh, std::vector<ValidationIssue>& issues);
-    void validateUVCoordinates(const MeshData& mesh, std::vector<ValidationIssue>& issues);
-    void validateVertexData(const MeshData& mesh, std::vector<ValidationIssue>& issues);
-    void validateMeshNaming(const std::string& name, std::vector<ValidationIssue>& issues);
+    // Per-asset drivers: vertex stream analysis plus the plan's rule lists.
+    // A run without a budget runs every rule.
+    static void applyMeshRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                               MeshValidationResult& result);
+    static void applyMeshMetadataRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                       MeshValidationResult& result, const RuleRun& run);
+    static void applyMeshGeometryRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                       MeshValidationResult& result, const RuleRun& run);
+    static void applyMaterialRules(const ValidationPlan& plan, const MaterialData& material,
+                                   MaterialValidationResult& result, const RuleRun& run);
+    static void applyTextureRules(const ValidationPlan& plan, const TextureData& texture,
+                                  std::vector<ValidationIssue>& issues, const RuleRun& run);
     
-    void validateMaterialProperties(const MaterialData& material, std::vector<ValidationIssue>& issues);
-    void validateMaterialTextures(const MaterialData& material, std::vector<ValidationIssue>& issues);
-    void validateMaterialNaming(const std::string& name, std::vector<ValidationIssue>& issues);
+    // Mesh rules
+    static void validatePolygonCount(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                     MeshValidationResult& result);
+    static void validateUVCoordinates(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                      MeshValidationResult& result);
+    static void validateUVOverlaps(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                   MeshValidationResult& result);
+    static void validateUVIslands(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                  MeshValidationResult& result);
+    static void validateQuadOverdraw(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                     MeshValidationResult& result);
+    static void validateVertexData(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                   MeshValidationResult& result);
+    static void validateTangentFrames(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                      MeshValidationResult& result);
+    static void validateBounds(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                               MeshValidationResult& result);
+    static void validateDegenerateTriangles(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                            MeshValidationResult& result);
+    static void validateDuplicateVertices(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                          MeshValidationResult& result);
+    static void validateTopology(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                 MeshValidationResult& result);
+    static void validateConnectedComponents(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                            MeshValidationResult& result);
+    static void validateSelfIntersections(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                          MeshValidationResult& result);
+    static void validateVertexCache(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                    MeshValidationResult& result);
+    static void validateMeshlets(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                 MeshValidationResult& result);
+    static void validateTexelDensity(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                     MeshValidationResult& result);
+    static void validateMeshNaming(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                   MeshValidationResult& result);
+    static void validateMeshGpuMemory(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                      MeshValidationResult& result);
     
-    void validateTextureResolution(const TextureData& texture, std::vector<ValidationIssue>& issues);
-    void validateTextureFormat(const TextureData& texture, std::vector<ValidationIssue>& issues);
-    void validateTexturePowerOfTwo(const TextureData& texture, std::vector<ValidationIssue>& issues);
-    void validateTextureNaming(const std::string& name, std::vector<ValidationIssue>& issues);
+    // Material rules
+    static void validateMaterialProperties(const ValidationPlan& plan, const MaterialData& material,
+                                           MaterialValidationResult& result);
+    static void validateMaterialTextures(const ValidationPlan& plan, const MaterialData& material,
+                                         MaterialValidationResult& result);
+    static void validateMaterialNaming(const ValidationPlan& plan, const MaterialData& material,
+                                       MaterialValidationResult& result);
     
-    // UV validation helpers
-    bool checkUVRange(const std::vector<glm::vec2>& uvCoords);
-    bool checkUVOverlaps(const std::vector<glm::vec2>& uvCoords, const std::vector<uint32_t>& indices);
-    float calculateUVOverlapPercentage(const std::vector<glm::vec2>& uvCoords, const std::vector<uint32_t>& indices);
+    // Texture rules
+    static void validateTextureResolution(const ValidationPlan& plan, const TextureData& texture,
+                                          std::vector<ValidationIssue>& issues);
+    static void validateTextureFormat(const ValidationPlan& plan, const TextureData& texture,
+                                      std::vector<ValidationIssue>& issues);
+    static void validateTexturePowerOfTwo(const ValidationPlan& plan, const TextureData& texture,
+                                          std::vector<ValidationIssue>& issues);
+    static void validateTextureNaming(const ValidationPlan& plan, const TextureData& texture,
+                                      std::vector<ValidationIssue>& issues);
+    static void validateTextureGpuMemory(const ValidationPlan& plan, const TextureData& texture,
+                                         std::vector<ValidationIssue>& issues);
     
     // Utility functions
-    bool isPowerOfTwo(uint32_t value);
+    static bool isPowerOfTwo(uint32_t value);
     std::string getSeverityString(Severity severity);
     std::string generateSuggestion(const std::string& category, const std::string& issue);
     
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class VertexCacheModel {
+    FIFO, // Fixed-function post-transform cache of older GPUs
+    LRU   // Closer to the batch reuse of modern GPUs
+};
+
+struct VertexCacheResult {
+    VertexCacheModel model = VertexCacheModel::FIFO; // Simulated cache
+    uint32_t cacheSize = 0;
+    uint64_t transformedVertices = 0; // Post-transform cache misses: vertex shader invocations
+    uint64_t uniqueVertices = 0;      // Distinct vertices referenced by valid triangles
+    uint64_t fetchedBytes = 0;        // Vertex buffer bytes pulled through the fetch cache
+    float acmr = 0.0f;                // transformedVertices / triangles; uniqueVertices / triangles best, 3.0 worst
+    float atvr = 0.0f;                // transformedVertices / uniqueVertices; 1.0 best
+    float overfetch = 0.0f;           // fetchedBytes / (uniqueVertices * stride); 1.0 best
+};
+
+// Replays an index buffer through a simulated post-transform vertex cache
+// and a vertex fetch cache.
+//
+// Every cache miss is one vertex shader invocation and one vertex fetch.
+// Fetches go through a direct-mapped cache of 64-byte lines, so index
+// orders that jump around the vertex buffer pay for the lines they waste.
+// The fetch model is a rough approximation of real hardware, but it ranks
+// vertex orders the same way. Triangles with out-of-range indices are
+// skipped.
+class VertexCacheAnalyzer {
+public:
+    VertexCacheAnalyzer(VertexCacheModel model, uint32_t cacheSize);
+
+    VertexCacheResult analyze(const std::vector<uint32_t>& indices, size_t vertexCount,
+                              uint32_t vertexStride) const;
+
+    // "fifo" / "lru", case-insensitive; throws std::invalid_argument otherwise
+    static VertexCacheModel parseModel(const std::string& name);
+    static const char* modelName(VertexCacheModel model);
+
+private:
+    VertexCacheModel model;
+    uint32_t cacheSize;
+};
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+
+// Single-pass statistics over the per-vertex streams of a MeshData.
+//
+// Every stream is walked exactly once by a kernel that is picked at
+// runtime: AVX2 or SSE4.1 on x86 CPUs that support them, portable scalar
+// code everywhere else. All variants produce identical results.
+
+// |length - 1| histogram for normals: bin i counts deviations below
+// kNormalDeviationLimits[i]; the last bin collects everything larger.
+constexpr size_t kNormalDeviationBins = 4;
+constexpr float kNormalDeviationLimits[kNormalDeviationBins - 1] = {1e-3f, 1e-2f, 1e-1f};
+
+struct UVStreamStats {
+    glm::vec2 min = glm::vec2(0.0f);     // Over finite UVs only
+    glm::vec2 max = glm::vec2(0.0f);
+    uint64_t outOfRangeCount = 0;        // Outside [-tolerance, 1 + tolerance]
+    uint64_t nonFiniteCount = 0;         // NaN or Inf in either component
+};
+
+struct PositionStreamStats {
+    glm::vec3 min = glm::vec3(0.0f);     // Over finite positions only
+    glm::vec3 max = glm::vec3(0.0f);
+    uint64_t nonFiniteCount = 0;
+};
+
+struct NormalStreamStats {
+    uint64_t nonFiniteCount = 0;
+    std::array<uint64_t, kNormalDeviationBins> deviationHistogram{};
+};
+
+// Tangents shorter than this (squared) carry no direction
+constexpr float kMinTangentLengthSq = 1e-8f;
+
+// Tangent frames against their normals: a frame is mirrored when the
+// bitangent points away from cross(normal, tangent)
+struct TangentStreamStats {
+    uint64_t nonFiniteCount = 0;  // NaN or Inf in the tangent or bitangent
+    uint64_t zeroLengthCount = 0; // Tangent below kMinTangentLengthSq
+    uint64_t mirroredCount = 0;   // Negative handedness
+};
+
+namespace VertexKernels {
+
+enum class InstructionSet {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+// Best instruction set supported by this CPU (detected once)
+InstructionSet getBestInstructionSet();
+const char* getInstructionSetName(InstructionSet instructionSet);
+
+// An unsupported instructionSet silently falls back to the best available one
+UVStreamStats analyzeUVs(const glm::vec2* uvs, size_t count, float tolerance,
+                         InstructionSet instructionSet = getBestInstructionSet());
+PositionStreamStats analyzePositions(const glm::vec3* positions, size_t count,
+                                     InstructionSet instructionSet = getBestInstructionSet());
+NormalStreamStats analyzeNormals(const glm::vec3* normals, size_t count,
+                                 InstructionSet instructionSet = getBestInstructionSet());
+// Writes every vertex's handedness: +1, -1, or 0 where the frame is unusable
+TangentStreamStats analyzeTangents(const glm::vec3* normals, const glm::vec3* tangents,
+                                   const glm::vec3* bitangents, size_t count, int8_t* handedness,
+                                   InstructionSet instructionSet = getBestInstructionSet());
+
+// Per-triangle passes (texel density, tangent frames, quad overdraw) split
+// the index buffer into chunks of kTrianglesPerChunk that run across the
+// pool and merge in chunk order, so results do not depend on the thread
+// count. Within a chunk, triangles go in blocks of kTriangleBlock: the
+// corners are gathered into structure-of-arrays scratch and the math runs
+// in branch-free loops over the whole block that the compiler vectorizes.
+constexpr size_t kTrianglesPerChunk = 1 << 16;
+constexpr size_t kTriangleBlock = 8;
+
+struct TriangleBlock {
+    size_t count = 0;                       // Triangles in the block; the rest is padding
+    bool valid[kTriangleBlock];             // In the block with all three indices in range
+    uint32_t i0[kTriangleBlock], i1[kTriangleBlock], i2[kTriangleBlock];
+    float e0x[kTriangleBlock], e0y[kTriangleBlock], e0z[kTriangleBlock]; // p1 - p0
+    float e1x[kTriangleBlock], e1y[kTriangleBlock], e1z[kTriangleBlock]; // p2 - p0
+
+    // Gathers triangles [first, min(first + kTriangleBlock, end)). Padding
+    // and invalid triangles read vertex 0 for every corner, a zero-area
+    // stand-in the block math runs over harmlessly. Without vertices the
+    // whole block is invalid and positions is not read.
+    void gather(const uint32_t* indices, size_t first, size_t end, const glm::vec3* positions,
+                size_t vertexCount) {
+        count = std::min(kTriangleBlock, end - first);
+        if (vertexCount == 0) {
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                valid[k] = false;
+                i0[k] = i1[k] = i2[k] = 0;
+                e0x[k] = e0y[k] = e0z[k] = e1x[k] = e1y[k] = e1z[k] = 0.0f;
+            }
+            return;
+        }
+        for (size_t k = 0; k < kTriangleBlock; ++k) {
+            uint32_t a = 0, b = 0, c = 0;
+            valid[k] = false;
+            if (k < count) {
+                const uint32_t* corners = indices + (first + k) * 3;
+                a = corners[0];
+                b = corners[1];
+                c = corners[2];
+                valid[k] = a < vertexCount && b < vertexCount && c < vertexCount;
+                if (!valid[k]) {
+                    a = b = c = 0;
+                }
+            }
+            i0[k] = a;
+            i1[k] = b;
+            i2[k] = c;
+            const glm::vec3& p0 = positions[a];
+            e0x[k] = positions[b].x - p0.x;
+            e0y[k] = positions[b].y - p0.y;
+            e0z[k] = positions[b].z - p0.z;
+            e1x[k] = positions[c].x - p0.x;
+            e1y[k] = positions[c].y - p0.y;
+            e1z[k] = positions[c].z - p0.z;
+        }
+    }
+};
+
+// log2(x) for positive normal floats: exponent plus a cubic fit of log2
+// over the mantissa in [1, 2), accurate to 0.0013 octaves. Garbage for 0,
+// NaN and denormals, which the callers mask out.
+inline float fastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int32_t>((bits >> 23) & 255) - 127);
+    const uint32_t mantissaBits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float m;
+    std::memcpy(&m, &mantissaBits, sizeof(m));
+    return exponent + ((0.15824871f * m - 1.05187502f) * m + 3.04788415f) * m - 2.15428594f;
+}
+
+namespace detail {
+
+// Running state shared by all kernel variants. Min/max start at +/-FLT_MAX
+// and are collapsed to zero by the public entry points when nothing finite
+// was seen.
+struct UVAccumulator {
+    float min[2];
+    float max[2];
+    uint64_t outOfRange = 0;
+    uint64_t nonFinite = 0;
+    UVAccumulator();
+};
+
+struct Vec3Accumulator {
+    float min[3];
+    float max[3];
+    uint64_t nonFinite = 0;
+    std::array<uint64_t, kNormalDeviationBins> histogram{};
+    Vec3Accumulator();
+};
+
+struct TangentAccumulator {
+    uint64_t nonFinite = 0;
+    uint64_t zeroLength = 0;
+    uint64_t mirrored = 0;
+};
+
+// Scalar kernels; the SIMD variants call these for the tail of a stream
+void accumulateUVsScalar(const float* uvs, size_t count, float tolerance, UVAccumulator& acc);
+void accumulatePositionsScalar(const float* positions, size_t count, Vec3Accumulator& acc);
+void accumulateNormalsScalar(const float* normals, size_t count, Vec3Accumulator& acc);
+void accumulateTangentsScalar(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                              int8_t* handedness, TangentAccumulator& acc);
+
+#if defined(VERTEX_KERNELS_X86)
+void accumulateUVsSSE41(const float* uvs, size_t count, float tolerance, UVAccumulator& acc);
+void accumulatePositionsSSE41(const float* positions, size_t count, Vec3Accumulator& acc);
+void accumulateNormalsSSE41(const float* normals, size_t count, Vec3Accumulator& acc);
+void accumulateTangentsSSE41(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                             int8_t* handedness, TangentAccumulator& acc);
+
+void accumulateUVsAVX2(const float* uvs, size_t count, float tolerance, UVAccumulator& acc);
+void accumulatePositionsAVX2(const float* positions, size_t count, Vec3Accumulator& acc);
+void accumulateNormalsAVX2(const float* normals, size_t count, Vec3Accumulator& acc);
+void accumulateTangentsAVX2(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                            int8_t* handedness, TangentAccumulator& acc);
+#endif
+
+} // namespace detail
+} // namespace VertexKernels
@@ -1,7 +1,96 @@
 #include "AssetLoader.h"
+#include <assimp/GltfMaterial.h>
 #include <fmt/core.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+
+namespace {
+    struct ImageHeader {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channels = 0;
+    };
+    
+    uint32_t readBE16(const unsigned char* p) { return (uint32_t(p[0]) << 8) | p[1]; }
+    uint32_t readBE32(const unsigned char* p) { return (readBE16(p) << 16) | readBE16(p + 2); }
+    uint32_t readLE16(const unsigned char* p) { return (uint32_t(p[1]) << 8) | p[0]; }
+    uint32_t readLE32(const unsigned char* p) { return (readLE16(p + 2) << 16) | readLE16(p); }
+    
+    // JPEG: walk the markers up to the first start-of-frame
+    bool readJPEGHeader(std::istream& file, ImageHeader& header) {
+        file.seekg(2);
+        unsigned char marker[4];
+        while (file.read(reinterpret_cast<char*>(marker), 4)) {
+            if (marker[0] != 0xFF) {
+                return false;
+            }
+            const uint32_t type = marker[1];
+            const uint32_t length = readBE16(marker + 2);
+            // SOF0..SOF15 except DHT (C4), JPG (C8) and DAC (CC)
+            if (type >= 0xC0 && type <= 0xCF && type != 0xC4 && type != 0xC8 && type != 0xCC) {
+                unsigned char frame[6];
+                if (!file.read(reinterpret_cast<char*>(frame), 6)) {
+                    return false;
+                }
+                header.height = readBE16(frame + 1);
+                header.width = readBE16(frame + 3);
+                header.channels = frame[5];
+                return true;
+            }
+            if (length < 2) {
+                return false;
+            }
+            file.seekg(length - 2, std::ios::cur);
+        }
+        return false;
+    }
+    
+    // Dimensions and channel count from a PNG, JPEG, BMP or TGA header;
+    // false for anything else or a truncated file
+    bool readImageHeader(std::istream& file, ImageHeader& header) {
+        unsigned char bytes[32] = {};
+        if (!file.read(reinterpret_cast<char*>(bytes), 2)) {
+            return false;
+        }
+        file.read(reinterpret_cast<char*>(bytes) + 2, sizeof(bytes) - 2);
+        const std::streamsize size = file.gcount() + 2;
+        file.clear();
+        
+        static const unsigned char pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        if (size >= 26 && std::equal(pngSignature, pngSignature + 8, bytes)) {
+            // IHDR is always the first chunk
+            static const uint32_t pngChannels[7] = {1, 0, 3, 1, 2, 0, 4};
+            header.width = readBE32(bytes + 16);
+            header.height = readBE32(bytes + 20);
+            header.channels = bytes[25] < 7 ? pngChannels[bytes[25]] : 0;
+            return header.width > 0 && header.height > 0;
+        }
+        if (bytes[0] == 0xFF && bytes[1] == 0xD8) {
+            return readJPEGHeader(file, header) && header.width > 0 && header.height > 0;
+        }
+        if (size >= 30 && bytes[0] == 'B' && bytes[1] == 'M') {
+            header.width = readLE32(bytes + 18);
+            // Negative heights mark top-down bitmaps
+            const int32_t height = static_cast<int32_t>(readLE32(bytes + 22));
+            header.height = static_cast<uint32_t>(height < 0 ? -height : height);
+            header.channels = readLE16(bytes + 28) / 8;
+            return header.width > 0 && header.height > 0;
+        }
+        // TGA has no signature; require a known image type and pixel depth
+        const unsigned char tgaType = bytes[2] & ~8u;
+        if (size >= 18 && bytes[1] <= 1 && (tgaType == 1 || tgaType == 2 || tgaType == 3) &&
+            (bytes[16] == 8 || bytes[16] == 16 || bytes[16] == 24 || bytes[16] == 32)) {
+            header.width = readLE16(bytes + 12);
+            header.height = readLE16(bytes + 14);
+            header.channels = bytes[1] == 1 ? 3 : bytes[16] / 8;
+            return header.width > 0 && header.height > 0;
+        }
+        return false;
+    }
+}
+
 
 AssetLoader::AssetLoader() : verboseLogging(false) {
     // Configure Assimp importer
@@ -56,7 +145,7 @@ bool AssetLoader::loadGLTF(const std::string& filePath, SceneData& sceneData) {
         processTextures(scene, sceneData, getDirectoryPath(filePath));
         
         // Process scene hierarchy
-        processNode(scene->mRootNode, scene, sceneData);
+        processNode(scene->mRootNode, scene, sceneData, aiMatrix4x4());
         
         // Calculate totals
         sceneData.totalVertices = 0;
@@ -77,23 +166,36 @@ bool AssetLoader::loadGLTF(const std::string& filePath, SceneData& sceneData) {
     }
 }
 
-void AssetLoader::processNode(aiNode* node, const aiScene* scene, SceneData& sceneData) {
+void AssetLoader::processNode(aiNode* node, const aiScene* scene, SceneData& sceneData,
+                              const aiMatrix4x4& parentTransform) {
+    const aiMatrix4x4 transform = parentTransform * node->mTransformation;
+    
     // Process all meshes in this node
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        processMesh(mesh, scene, sceneData);
+        processMesh(mesh, scene, sceneData, transform);
+        sceneData.meshes.back().sourceMesh = node->mMeshes[i];
     }
     
     // Process child nodes recursively
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(node->mChildren[i], scene, sceneData);
+        processNode(node->mChildren[i], scene, sceneData, transform);
     }
 }
 
-void AssetLoader::processMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData) {
+void AssetLoader::processMesh(aiMesh* mesh, const aiScene* scene, SceneData& sceneData,
+                              const aiMatrix4x4& transform) {
     MeshData meshData;
     meshData.name = mesh->mName.C_Str();
     
+    // Assimp matrices are row-major (a1..a4 is the first row), glm's are
+    // column-major
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            meshData.worldTransform[column][row] = transform[row][column];
+        }
+    }
+    
     if (meshData.name.empty()) {
         meshData.name = "mesh_" + std::to_string(sceneData.meshes.size());
     }
@@ -122,6 +224,16 @@ void AssetLoader::processMesh(aiMesh* mesh, const aiScene* scene, SceneData& sce
         }
     }
     
+    // Extract the tangent frame
+    if (mesh->HasTangentsAndBitangents()) {
+        meshData.tangents.reserve(mesh->mNumVertices);
+        meshData.bitangents.reserve(mesh->mNumVertices);
+        for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+            meshData.tangents.emplace_back(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+            meshData.bitangents.emplace_back(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+        }
+    }
+    
     // Extract UV coordinates (first channel only)
     if (mesh->HasTextureCoords(0)) {
         meshData.uvCoords.reserve(mesh->mNumVertices);
@@ -182,6 +294,23 @@ void AssetLoader::processMaterials(const aiScene* scene, SceneData& sceneData) {
         material->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness);
         matData.roughness = roughness;
         
+        float opacity = 1.0f;
+        if (material->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS) {
+            matData.alpha = opacity;
+        }
+        if (material->Get(AI_MATKEY_COLOR_EMISSIVE, color) == AI_SUCCESS) {
+            matData.emissive = glm::vec3(color.r, color.g, color.b);
+        }
+        aiString alphaMode;
+        if (material->Get(AI_MATKEY_GLTF_ALPHAMODE, alphaMode) == AI_SUCCESS) {
+            matData.alphaMode = alphaMode.C_Str();
+        }
+        material->Get(AI_MATKEY_GLTF_ALPHACUTOFF, matData.alphaCutoff);
+        int twoSided = 0;
+        if (material->Get(AI_MATKEY_TWOSIDED, twoSided) == AI_SUCCESS) {
+            matData.doubleSided = twoSided != 0;
+        }
+        
         // Get texture paths
         aiString texPath;
         if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texPath) == AI_SUCCESS) {
@@ -207,6 +336,7 @@ void AssetLoader::processMaterials(const aiScene* scene, SceneData& sceneData) {
 
 void AssetLoader::processTextures(const aiScene* scene, SceneData& sceneData, const std::string& basePath) {
     std::vector<std::string> textureFiles;
+    std::vector<std::string> normalMaps;
     
     // Collect all texture file paths from materials
     for (const auto& material : sceneData.materials) {
@@ -215,6 +345,7 @@ void AssetLoader::processTextures(const aiScene* scene, SceneData& sceneData, co
         }
         if (!material.normalTexture.empty()) {
             textureFiles.push_back(material.normalTexture);
+            normalMaps.push_back(material.normalTexture);
         }
         if (!material.metallicRoughnessTexture.empty()) {
             textureFiles.push_back(material.metallicRoughnessTexture);
@@ -237,10 +368,30 @@ void AssetLoader::processTextures(const aiScene* scene, SceneData& sceneData, co
         texData.name = extractFileName(texFile);
         texData.filePath = texFile;
         texData.format = extractFileExtension(texFile);
+        texData.isNormalMap = std::find(normalMaps.begin(), normalMaps.end(), texFile) != normalMaps.end();
         
-        // Try to analyze texture file
+        // Embedded textures keep their encoded bytes so --fix can write
+        // them back; raw texel arrays only give the dimensions
+        const aiTexture* embedded = texFile[0] == '*' ? scene->GetEmbeddedTexture(texFile.c_str()) : nullptr;
         std::string fullPath = basePath + "/" + texFile;
-        if (fileExists(fullPath)) {
+        if (embedded) {
+            if (embedded->mHeight == 0) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(embedded->pcData);
+                texData.embeddedData.assign(bytes, bytes + embedded->mWidth);
+                texData.format = embedded->achFormatHint;
+                std::istringstream image(std::string(texData.embeddedData.begin(), texData.embeddedData.end()));
+                ImageHeader header;
+                if (readImageHeader(image, header)) {
+                    texData.width = header.width;
+                    texData.height = header.height;
+                    texData.channels = header.channels;
+                }
+            } else {
+                texData.width = embedded->mWidth;
+                texData.height = embedded->mHeight;
+                texData.channels = 4;
+            }
+        } else if (fileExists(fullPath)) {
             analyzeTexture(fullPath, texData);
         } else {
             logWarning("Texture file not found: " + fullPath);
@@ -275,8 +426,18 @@ bool AssetLoader::fileExists(const std::string& filePath) {
 }
 
 bool AssetLoader::analyzeTexture(const std::string& texturePath, TextureData& textureData) {
-    // Simple analysis - in a real implementation, you'd use image loading library
-    // For now, we'll just check file size and set some defaults
+    // Read the real dimensions from the image header when the format is one
+    // we know; texel density depends on them
+    ImageHeader header;
+    std::ifstream file(texturePath, std::ios::binary);
+    if (readImageHeader(file, header)) {
+        textureData.width = header.width;
+        textureData.height = header.height;
+        textureData.channels = header.channels;
+        return true;
+    }
+    
+    // Otherwise fall back to a guess from the file size
     try {
         auto fileSize = std::filesystem::file_size(texturePath);
         
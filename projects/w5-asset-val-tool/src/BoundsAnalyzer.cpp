@@ -0,0 +1,225 @@
+#include "BoundsAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float kCoreQuantile = 0.99f;
+
+    bool isFinite(const glm::vec3& v) {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    float distanceSquared(const glm::vec3& a, const glm::vec3& b) {
+        const glm::vec3 d = a - b;
+        return glm::dot(d, d);
+    }
+
+    // Half the box diagonal around the box centre encloses everything the
+    // box does; keep whichever sphere is smaller
+    BoundingSphere tighterOfBoxSphere(const BoundingSphere& sphere, const glm::vec3& min, const glm::vec3& max) {
+        const float boxRadius = 0.5f * glm::length(max - min);
+        if (boxRadius < sphere.radius) {
+            BoundingSphere boxSphere;
+            boxSphere.center = (min + max) * 0.5f;
+            boxSphere.radius = boxRadius;
+            return boxSphere;
+        }
+        return sphere;
+    }
+
+    // Median point and the radius around it holding kCoreQuantile of the
+    // vertices, from an evenly strided sample
+    void estimateCore(const std::vector<glm::vec3>& vertices, glm::vec3& median, float& coreRadius) {
+        const size_t stride = std::max<size_t>(1, vertices.size() / BoundsAnalyzer::kSampleSize);
+        std::vector<glm::vec3> sample;
+        sample.reserve(std::min(vertices.size(), BoundsAnalyzer::kSampleSize + 1));
+        for (size_t i = 0; i < vertices.size(); i += stride) {
+            if (isFinite(vertices[i])) {
+                sample.push_back(vertices[i]);
+            }
+        }
+        if (sample.empty()) {
+            return;
+        }
+
+        std::vector<float> values(sample.size());
+        for (int axis = 0; axis < 3; ++axis) {
+            for (size_t i = 0; i < sample.size(); ++i) {
+                values[i] = sample[i][axis];
+            }
+            auto middle = values.begin() + values.size() / 2;
+            std::nth_element(values.begin(), middle, values.end());
+            median[axis] = *middle;
+        }
+
+        for (size_t i = 0; i < sample.size(); ++i) {
+            values[i] = distanceSquared(sample[i], median);
+        }
+        auto quantile = values.begin() + static_cast<size_t>(kCoreQuantile * (values.size() - 1));
+        std::nth_element(values.begin(), quantile, values.end());
+        coreRadius = std::sqrt(*quantile);
+    }
+}
+
+BoundsAnalyzer::BoundsAnalyzer(float strayVertexFactor) : strayVertexFactor(strayVertexFactor) {}
+
+MeshBounds BoundsAnalyzer::analyze(const std::vector<glm::vec3>& vertices, const PositionStreamStats& stats,
+                                   const glm::mat4& worldTransform) const {
+    MeshBounds bounds;
+    if (stats.nonFiniteCount >= vertices.size()) {
+        return bounds;
+    }
+    bounds.valid = true;
+    bounds.min = stats.min;
+    bounds.max = stats.max;
+
+    // Axis-extreme vertices
+    size_t minIndex[3], maxIndex[3];
+    size_t first = 0;
+    while (!isFinite(vertices[first])) {
+        ++first;
+    }
+    std::fill(minIndex, minIndex + 3, first);
+    std::fill(maxIndex, maxIndex + 3, first);
+    for (size_t i = first + 1; i < vertices.size(); ++i) {
+        const glm::vec3& v = vertices[i];
+        if (!isFinite(v)) {
+            continue;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            if (v[axis] < vertices[minIndex[axis]][axis]) {
+                minIndex[axis] = i;
+            }
+            if (v[axis] > vertices[maxIndex[axis]][axis]) {
+                maxIndex[axis] = i;
+            }
+        }
+    }
+
+    // Ritter's initial sphere spans the most distant extreme pair
+    int widest = 0;
+    float widestSquared = -1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float span = distanceSquared(vertices[minIndex[axis]], vertices[maxIndex[axis]]);
+        if (span > widestSquared) {
+            widestSquared = span;
+            widest = axis;
+        }
+    }
+    glm::vec3 center = (vertices[minIndex[widest]] + vertices[maxIndex[widest]]) * 0.5f;
+    float radius = 0.5f * std::sqrt(widestSquared);
+
+    glm::vec3 median(0.0f);
+    estimateCore(vertices, median, bounds.coreRadius);
+    const float strayLimit = strayVertexFactor * bounds.coreRadius;
+    const bool findStrays = bounds.coreRadius > 0.0f && strayVertexFactor > 0.0f;
+    std::vector<std::pair<float, uint32_t>> strays; // (distance, vertex)
+
+    // Grow over every vertex; the same pass measures strays
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const glm::vec3& v = vertices[i];
+        if (!isFinite(v)) {
+            continue;
+        }
+        const float d2 = distanceSquared(v, center);
+        if (d2 > radius * radius) {
+            const float d = std::sqrt(d2);
+            const float grown = 0.5f * (radius + d);
+            center += (v - center) * ((grown - radius) / d);
+            radius = grown;
+        }
+        if (findStrays) {
+            const float m2 = distanceSquared(v, median);
+            if (m2 > strayLimit * strayLimit) {
+                strays.emplace_back(std::sqrt(m2), static_cast<uint32_t>(i));
+            }
+        }
+    }
+    bounds.sphere.center = center;
+    bounds.sphere.radius = radius;
+    bounds.sphere = tighterOfBoxSphere(bounds.sphere, bounds.min, bounds.max);
+
+    bounds.strayVertices = strays.size();
+    const size_t keep = std::min(strays.size(), MeshBounds::kMaxWorstStrayVertices);
+    std::partial_sort(strays.begin(), strays.begin() + keep, strays.end(),
+                      [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+                          return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+    for (size_t i = 0; i < keep; ++i) {
+        bounds.worstStrayVertices.push_back(strays[i].second);
+    }
+    if (keep > 0) {
+        bounds.maxStrayDistance = strays[0].first;
+    }
+
+    // World box per Arvo: each output axis takes the smaller and larger of
+    // every input axis's contribution
+    const glm::mat4& m = worldTransform;
+    for (int row = 0; row < 3; ++row) {
+        bounds.worldMin[row] = m[3][row];
+        bounds.worldMax[row] = m[3][row];
+        for (int column = 0; column < 3; ++column) {
+            const float a = m[column][row] * bounds.min[column];
+            const float b = m[column][row] * bounds.max[column];
+            bounds.worldMin[row] += std::min(a, b);
+            bounds.worldMax[row] += std::max(a, b);
+        }
+    }
+
+    // The sphere scales by the longest transformed axis
+    float maxScale = 0.0f;
+    for (int column = 0; column < 3; ++column) {
+        maxScale = std::max(maxScale, std::sqrt(m[column][0] * m[column][0] + m[column][1] * m[column][1] +
+                                                m[column][2] * m[column][2]));
+    }
+    const glm::vec4 worldCenter = m * glm::vec4(bounds.sphere.center.x, bounds.sphere.center.y,
+                                                bounds.sphere.center.z, 1.0f);
+    bounds.worldSphere.center = glm::vec3(worldCenter.x, worldCenter.y, worldCenter.z);
+    bounds.worldSphere.radius = bounds.sphere.radius * maxScale;
+    bounds.worldSphere = tighterOfBoxSphere(bounds.worldSphere, bounds.worldMin, bounds.worldMax);
+    return bounds;
+}
+
+SceneBounds BoundsAnalyzer::combine(const std::vector<const MeshBounds*>& meshes) {
+    SceneBounds scene;
+    const MeshBounds* largest = nullptr;
+    for (const MeshBounds* mesh : meshes) {
+        if (!mesh->valid) {
+            continue;
+        }
+        if (!scene.valid) {
+            scene.min = mesh->worldMin;
+            scene.max = mesh->worldMax;
+            scene.valid = true;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            scene.min[axis] = std::min(scene.min[axis], mesh->worldMin[axis]);
+            scene.max[axis] = std::max(scene.max[axis], mesh->worldMax[axis]);
+        }
+        if (!largest || mesh->worldSphere.radius > largest->worldSphere.radius) {
+            largest = mesh;
+        }
+    }
+    if (!scene.valid) {
+        return scene;
+    }
+
+    // Grow the largest sphere over the others
+    BoundingSphere sphere = largest->worldSphere;
+    for (const MeshBounds* mesh : meshes) {
+        if (!mesh->valid) {
+            continue;
+        }
+        const BoundingSphere& other = mesh->worldSphere;
+        const float d = glm::length(other.center - sphere.center);
+        if (d + sphere.radius <= other.radius) {
+            sphere = other;
+        } else if (d + other.radius > sphere.radius) {
+            const float grown = 0.5f * (sphere.radius + d + other.radius);
+            sphere.center += (other.center - sphere.center) * ((grown - sphere.radius) / d);
+            sphere.radius = grown;
+        }
+    }
+    scene.sphere = tighterOfBoxSphere(sphere, scene.min, scene.max);
+    return scene;
+}
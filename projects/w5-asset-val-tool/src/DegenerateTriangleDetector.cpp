@@ -0,0 +1,80 @@
+#include "DegenerateTriangleDetector.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    // Triangles per task: large enough to amortize scheduling, small enough
+    // to balance a 10M-triangle mesh across many cores
+    const size_t kTrianglesPerChunk = 1 << 16;
+
+    struct ChunkResult {
+        uint64_t nearDegenerate = 0;
+        std::vector<uint32_t> zeroArea;
+    };
+}
+
+DegenerateTriangleDetector::DegenerateTriangleDetector(float areaEpsilon, float nearDegenerateRatio)
+    : areaEpsilon(areaEpsilon), nearDegenerateRatio(nearDegenerateRatio) {}
+
+DegenerateTriangleResult DegenerateTriangleDetector::analyze(const std::vector<glm::vec3>& vertices,
+                                                             const std::vector<uint32_t>& indices,
+                                                             ThreadPool& pool) const {
+    DegenerateTriangleResult result;
+    const size_t triangleCount = indices.size() / 3;
+    const size_t vertexCount = vertices.size();
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    std::vector<ChunkResult> chunks(chunkCount);
+
+    // Compare squared quantities so no square roots are needed:
+    //   area < eps            <=>  |cross|^2 < (2 eps)^2
+    //   height / edge < ratio <=>  |cross|^2 < ratio^2 * edge^4
+    const double doubleAreaLimitSq = 4.0 * static_cast<double>(areaEpsilon) * areaEpsilon;
+    const double ratioSq = static_cast<double>(nearDegenerateRatio) * nearDegenerateRatio;
+
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        ChunkResult& out = chunks[chunk];
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min(triangleCount, begin + kTrianglesPerChunk);
+
+        for (size_t t = begin; t < end; ++t) {
+            const uint32_t i0 = indices[t * 3];
+            const uint32_t i1 = indices[t * 3 + 1];
+            const uint32_t i2 = indices[t * 3 + 2];
+
+            // Out-of-range indices are reported by the vertex data rule
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+                continue;
+            }
+            if (i0 == i1 || i1 == i2 || i0 == i2) {
+                out.zeroArea.push_back(static_cast<uint32_t>(t));
+                continue;
+            }
+
+            const glm::dvec3 a(vertices[i0]);
+            const glm::dvec3 e0 = glm::dvec3(vertices[i1]) - a;
+            const glm::dvec3 e1 = glm::dvec3(vertices[i2]) - a;
+            const glm::dvec3 e2 = e1 - e0;
+            const glm::dvec3 n = glm::cross(e0, e1);
+            const double doubleAreaSq = glm::dot(n, n);
+
+            // NaN positions fall through both tests; they are reported elsewhere
+            if (doubleAreaSq < doubleAreaLimitSq) {
+                out.zeroArea.push_back(static_cast<uint32_t>(t));
+                continue;
+            }
+
+            const double longestSq = std::max({glm::dot(e0, e0), glm::dot(e1, e1), glm::dot(e2, e2)});
+            if (doubleAreaSq < ratioSq * longestSq * longestSq) {
+                out.nearDegenerate++;
+            }
+        }
+    });
+
+    for (auto& chunk : chunks) {
+        result.nearDegenerateTriangles += chunk.nearDegenerate;
+        result.zeroAreaTriangles += chunk.zeroArea.size();
+        result.degenerateTriangles.insert(result.degenerateTriangles.end(),
+                                          chunk.zeroArea.begin(), chunk.zeroArea.end());
+    }
+    return result;
+}
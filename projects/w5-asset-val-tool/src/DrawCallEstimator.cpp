@@ -0,0 +1,223 @@
+#include "DrawCallEstimator.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    uint64_t mix64(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // xxHash64-style: four independent lanes over 32-byte stripes keep the
+    // multipliers busy, so hashing runs near memory bandwidth
+    uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+        const uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+        const uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (int lane = 0; lane < 4; ++lane) {
+                uint64_t word;
+                std::memcpy(&word, bytes + i + lane * 8, 8);
+                lanes[lane] = rotl(lanes[lane] + word * kPrime2, 31) * kPrime1;
+            }
+        }
+        uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + size;
+        for (; i < size; i += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i, std::min<size_t>(8, size - i));
+            h = rotl(h ^ (rotl(word * kPrime2, 31) * kPrime1), 27) * kPrime1;
+        }
+        return mix64(h);
+    }
+
+    template <typename T>
+    uint64_t hashStream(const std::vector<T>& stream, uint64_t h) {
+        return hashBytes(stream.data(), stream.size() * sizeof(T), h);
+    }
+
+    uint64_t geometryHash(const MeshData& mesh) {
+        uint64_t h = hashStream(mesh.vertices, 0);
+        h = hashStream(mesh.normals, h);
+        h = hashStream(mesh.uvCoords, h);
+        return hashStream(mesh.indices, h);
+    }
+
+    template <typename T>
+    bool sameStream(const std::vector<T>& a, const std::vector<T>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+    }
+
+    bool sameGeometry(const MeshData& a, const MeshData& b) {
+        return sameStream(a.vertices, b.vertices) && sameStream(a.normals, b.normals) &&
+               sameStream(a.uvCoords, b.uvCoords) && sameStream(a.indices, b.indices);
+    }
+
+    uint32_t materialOf(const MeshData& mesh) {
+        return mesh.materialIndices.empty() ? DrawBatch::kNoMaterial : mesh.materialIndices[0];
+    }
+
+    // One draw as the renderer would submit it
+    struct DrawState {
+        uint32_t format;
+        uint32_t material;
+    };
+
+    void countChanges(const std::vector<DrawState>& draws, uint64_t& formatChanges, uint64_t& materialChanges) {
+        formatChanges = 0;
+        materialChanges = 0;
+        for (size_t i = 0; i < draws.size(); ++i) {
+            if (i == 0 || draws[i].format != draws[i - 1].format) {
+                ++formatChanges;
+            }
+            if (i == 0 || draws[i].material != draws[i - 1].material || draws[i].format != draws[i - 1].format) {
+                ++materialChanges;
+            }
+        }
+    }
+}
+
+DrawCallEstimator::DrawCallEstimator(uint32_t maxBatchVertices) : maxBatchVertices(maxBatchVertices) {}
+
+DrawCallStats DrawCallEstimator::estimate(const SceneData& scene, ThreadPool& pool) const {
+    DrawCallStats stats;
+    const std::vector<MeshData>& meshes = scene.meshes;
+    stats.meshDraws = meshes.size();
+    if (meshes.empty()) {
+        return stats;
+    }
+
+    std::vector<uint64_t> hashes(meshes.size());
+    pool.parallelFor(meshes.size(), [&](size_t i) {
+        hashes[i] = geometryHash(meshes[i]);
+    }, 64);
+
+    std::vector<DrawState> sceneOrder(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        sceneOrder[i] = {vertexFormat(meshes[i]), materialOf(meshes[i])};
+    }
+    countChanges(sceneOrder, stats.formatChanges, stats.materialChanges);
+
+    // Instance groups: byte-identical geometry under the same material.
+    // Groups sharing a key are told apart by comparing against their first mesh.
+    std::vector<std::vector<uint32_t>> instanceGroups;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> groupsByKey;
+    groupsByKey.reserve(meshes.size());
+    for (uint32_t i = 0; i < meshes.size(); ++i) {
+        const uint32_t material = sceneOrder[i].material;
+        std::vector<uint32_t>& candidates = groupsByKey[hashes[i] ^ mix64(material)];
+        bool placed = false;
+        for (uint32_t group : candidates) {
+            const MeshData& first = meshes[instanceGroups[group][0]];
+            if (materialOf(first) == material && sameGeometry(first, meshes[i])) {
+                instanceGroups[group].push_back(i);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            candidates.push_back(static_cast<uint32_t>(instanceGroups.size()));
+            instanceGroups.push_back({i});
+        }
+    }
+
+    // Everything not instanced is a merge candidate, bucketed by material
+    // and vertex format in order of first appearance
+    std::vector<std::vector<uint32_t>> mergeBuckets;
+    std::unordered_map<uint64_t, uint32_t> bucketByKey;
+    std::vector<DrawState> draws;
+    for (auto& group : instanceGroups) {
+        const uint32_t first = group[0];
+        if (group.size() > 1) {
+            DrawBatch batch;
+            batch.kind = DrawBatch::Kind::Instance;
+            batch.material = sceneOrder[first].material;
+            batch.vertexFormat = sceneOrder[first].format;
+            batch.vertices = meshes[first].vertices.size();
+            batch.triangles = meshes[first].triangleCount;
+            batch.meshes = std::move(group);
+            stats.instancedMeshes += batch.meshes.size();
+            draws.push_back(sceneOrder[first]);
+            stats.batches.push_back(std::move(batch));
+            continue;
+        }
+        const uint64_t key = uint64_t(sceneOrder[first].format) << 32 | sceneOrder[first].material;
+        const auto inserted = bucketByKey.emplace(key, static_cast<uint32_t>(mergeBuckets.size()));
+        if (inserted.second) {
+            mergeBuckets.emplace_back();
+        }
+        mergeBuckets[inserted.first->second].push_back(first);
+    }
+
+    // Groups were opened in scene order, so buckets already are. Pack each,
+    // starting a new batch whenever the next mesh would pass the vertex limit.
+    for (const auto& bucket : mergeBuckets) {
+        DrawBatch batch;
+        auto flush = [&]() {
+            if (batch.meshes.empty()) {
+                return;
+            }
+            draws.push_back({batch.vertexFormat, batch.material});
+            if (batch.meshes.size() > 1) {
+                stats.mergedMeshes += batch.meshes.size();
+                stats.batches.push_back(std::move(batch));
+            }
+            batch = DrawBatch();
+        };
+        for (uint32_t m : bucket) {
+            const uint64_t vertices = meshes[m].vertices.size();
+            if (maxBatchVertices > 0 && batch.vertices + vertices > maxBatchVertices) {
+                flush();
+            }
+            batch.material = sceneOrder[m].material;
+            batch.vertexFormat = sceneOrder[m].format;
+            batch.meshes.push_back(m);
+            batch.vertices += vertices;
+            batch.triangles += meshes[m].triangleCount;
+        }
+        flush();
+    }
+    stats.estimatedDraws = draws.size();
+
+    std::sort(draws.begin(), draws.end(), [](const DrawState& a, const DrawState& b) {
+        return a.format != b.format ? a.format < b.format : a.material < b.material;
+    });
+    countChanges(draws, stats.sortedFormatChanges, stats.sortedMaterialChanges);
+
+    std::stable_sort(stats.batches.begin(), stats.batches.end(), [](const DrawBatch& a, const DrawBatch& b) {
+        return a.drawsSaved() > b.drawsSaved();
+    });
+    return stats;
+}
+
+uint32_t DrawCallEstimator::vertexFormat(const MeshData& mesh) {
+    uint32_t format = 0;
+    if (!mesh.normals.empty() && mesh.normals.size() == mesh.vertices.size()) {
+        format |= kVertexNormals;
+    }
+    if (!mesh.uvCoords.empty() && mesh.uvCoords.size() == mesh.vertices.size()) {
+        format |= kVertexUVs;
+    }
+    return format;
+}
+
+std::string DrawCallEstimator::vertexFormatName(uint32_t format) {
+    std::string name = "position";
+    if (format & kVertexNormals) {
+        name += "+normal";
+    }
+    if (format & kVertexUVs) {
+        name += "+uv";
+    }
+    return name;
+}
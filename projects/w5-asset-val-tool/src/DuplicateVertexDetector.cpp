@@ -0,0 +1,335 @@
+#include "DuplicateVertexDetector.h"
+#include "ThreadPool.h"
+#include "VertexKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+
+namespace {
+    const size_t kVerticesPerChunk = 1 << 15;
+
+    // Bounds the work per cell when thousands of vertices collapse onto one
+    // point with differing attributes; keeps the pass linear in the worst case
+    const uint32_t kMaxCandidatesPerCell = 256;
+
+    // Cell edge length in tolerances. Only vertices within one tolerance of
+    // a cell face need to look at the neighbour across it, so wide cells
+    // keep the average lookup count per vertex close to one.
+    const double kCellTolerances = 8.0;
+
+    const uint64_t kEmptySlot = 0;
+
+    struct Cell {
+        int64_t x, y, z;
+    };
+
+    // Grid coordinates of p. If 'neighbour' is given it receives, per axis,
+    // the direction (-1/+1) of an adjacent cell that is within 'reach' cell
+    // units of p, or 0 when p is far enough from both faces.
+    Cell cellOf(const glm::vec3& p, double inverseCellSize, double reach = 0.0, int neighbour[3] = nullptr) {
+        // Clamp so absurd coordinates cannot overflow the integer conversion
+        const double limit = 4.0e18;
+        int64_t coords[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const double scaled = std::clamp(p[axis] * inverseCellSize, -limit, limit);
+            const double cell = std::floor(scaled);
+            coords[axis] = static_cast<int64_t>(cell);
+            if (neighbour) {
+                const double offset = scaled - cell;
+                neighbour[axis] = offset <= reach ? -1 : (1.0 - offset <= reach ? 1 : 0);
+            }
+        }
+        return Cell{coords[0], coords[1], coords[2]};
+    }
+
+    // 64-bit mix of the cell coordinates; 0 is reserved for empty slots.
+    // Two cells sharing a hash only cost extra distance checks.
+    uint64_t hashCell(int64_t x, int64_t y, int64_t z) {
+        uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<uint64_t>(z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return h == kEmptySlot ? 1 : h;
+    }
+
+    bool isFinite(const glm::vec3& v) {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    // Occupied cells in a lock-free open-addressing hash, with every cell's
+    // vertices stored contiguously and in ascending order (counting sort by
+    // slot). Built in parallel passes; lookups happen only after build().
+    class CellIndex {
+    public:
+        explicit CellIndex(size_t vertexCount) : slotOf(vertexCount, kNoSlot) {
+            size_t capacity = 16;
+            while (capacity < vertexCount * 2) {
+                capacity <<= 1;
+            }
+            mask = capacity - 1;
+            slots = std::make_unique<Slot[]>(capacity);
+            for (size_t i = 0; i < capacity; ++i) {
+                slots[i].key.store(kEmptySlot, std::memory_order_relaxed);
+                slots[i].count.store(0, std::memory_order_relaxed);
+                slots[i].begin = 0;
+            }
+        }
+
+        // Pass 1 (parallel): claim a slot for the vertex's cell and count it
+        void insert(uint64_t key, uint32_t vertex) {
+            size_t slot = key & mask;
+            while (true) {
+                uint64_t current = slots[slot].key.load(std::memory_order_acquire);
+                if (current == kEmptySlot &&
+                    slots[slot].key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    current = key;
+                }
+                if (current == key) {
+                    slots[slot].count.fetch_add(1, std::memory_order_relaxed);
+                    slotOf[vertex] = static_cast<uint32_t>(slot);
+                    return;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        // Pass 2: turn counts into ranges and scatter the vertices into them
+        void build(ThreadPool& pool, size_t chunkSize) {
+            const size_t capacity = mask + 1;
+            uint32_t total = 0;
+            for (size_t slot = 0; slot < capacity; ++slot) {
+                slots[slot].begin = total;
+                total += slots[slot].count.exchange(0, std::memory_order_relaxed);
+            }
+
+            // Scatter order within a cell depends on scheduling; sorting each
+            // (tiny) range afterwards makes the layout deterministic
+            members.resize(total);
+            const size_t vertexCount = slotOf.size();
+            const size_t chunkCount = (vertexCount + chunkSize - 1) / chunkSize;
+            pool.parallelFor(chunkCount, [&](size_t chunk) {
+                const size_t end = std::min(vertexCount, (chunk + 1) * chunkSize);
+                for (size_t v = chunk * chunkSize; v < end; ++v) {
+                    const uint32_t slot = slotOf[v];
+                    if (slot != kNoSlot) {
+                        members[slots[slot].begin + slots[slot].count.fetch_add(1, std::memory_order_relaxed)] =
+                            static_cast<uint32_t>(v);
+                    }
+                }
+            });
+
+            const size_t slotChunks = (capacity + chunkSize - 1) / chunkSize;
+            pool.parallelFor(slotChunks, [&](size_t chunk) {
+                const size_t end = std::min(capacity, (chunk + 1) * chunkSize);
+                for (size_t slot = chunk * chunkSize; slot < end; ++slot) {
+                    const uint32_t count = slots[slot].count.load(std::memory_order_relaxed);
+                    if (count > 1) {
+                        auto first = members.begin() + slots[slot].begin;
+                        std::sort(first, first + count);
+                    }
+                }
+            });
+        }
+
+        size_t getSlotCount() const { return mask + 1; }
+
+        // Vertices of the cell in a slot as a [begin, end) range; unused
+        // slots are empty
+        std::pair<const uint32_t*, const uint32_t*> cellAt(size_t slot) const {
+            const uint32_t* first = members.data() + slots[slot].begin;
+            return {first, first + slots[slot].count.load(std::memory_order_relaxed)};
+        }
+
+        // Vertices of the cell with this key
+        std::pair<const uint32_t*, const uint32_t*> find(uint64_t key) const {
+            size_t slot = key & mask;
+            while (true) {
+                const uint64_t current = slots[slot].key.load(std::memory_order_relaxed);
+                if (current == key) {
+                    return cellAt(slot);
+                }
+                if (current == kEmptySlot) {
+                    return {nullptr, nullptr};
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+
+    private:
+        static const uint32_t kNoSlot = 0xFFFFFFFFu;
+
+        // Key and range share a 16-byte slot: one cache miss per lookup
+        struct Slot {
+            std::atomic<uint64_t> key;
+            std::atomic<uint32_t> count;
+            uint32_t begin;
+        };
+
+        size_t mask = 0;
+        std::unique_ptr<Slot[]> slots;
+        std::vector<uint32_t> slotOf;
+        std::vector<uint32_t> members;
+    };
+}
+
+DuplicateVertexDetector::DuplicateVertexDetector(float positionTolerance, float attributeTolerance)
+    : positionTolerance(positionTolerance), attributeTolerance(attributeTolerance) {}
+
+DuplicateVertexResult DuplicateVertexDetector::analyze(const std::vector<glm::vec3>& vertices,
+                                                       const std::vector<glm::vec3>& normals,
+                                                       const std::vector<glm::vec2>& uvCoords,
+                                                       const std::vector<glm::vec3>& tangents,
+                                                       const std::vector<glm::vec3>& bitangents,
+                                                       ThreadPool& pool) const {
+    return scan(vertices, normals, uvCoords, tangents, bitangents, pool, nullptr);
+}
+
+std::vector<uint32_t> DuplicateVertexDetector::buildWeldRemap(const std::vector<glm::vec3>& vertices,
+                                                              const std::vector<glm::vec3>& normals,
+                                                              const std::vector<glm::vec2>& uvCoords,
+                                                              const std::vector<glm::vec3>& tangents,
+                                                              const std::vector<glm::vec3>& bitangents,
+                                                              ThreadPool& pool) const {
+    std::vector<uint32_t> remap(vertices.size());
+    for (size_t v = 0; v < remap.size(); ++v) {
+        remap[v] = static_cast<uint32_t>(v);
+    }
+    scan(vertices, normals, uvCoords, tangents, bitangents, pool, &remap);
+    
+    // Matches always point to a lower index, so one ascending pass
+    // collapses chains onto the first vertex of each cluster
+    for (size_t v = 0; v < remap.size(); ++v) {
+        remap[v] = remap[remap[v]];
+    }
+    return remap;
+}
+
+DuplicateVertexResult DuplicateVertexDetector::scan(const std::vector<glm::vec3>& vertices,
+                                                    const std::vector<glm::vec3>& normals,
+                                                    const std::vector<glm::vec2>& uvCoords,
+                                                    const std::vector<glm::vec3>& tangents,
+                                                    const std::vector<glm::vec3>& bitangents,
+                                                    ThreadPool& pool, std::vector<uint32_t>* weldTargets) const {
+    DuplicateVertexResult result;
+    const size_t vertexCount = vertices.size();
+    if (vertexCount < 2) {
+        return result;
+    }
+
+    // Attribute streams that do not line up are reported elsewhere; ignore them
+    const bool useNormals = normals.size() == vertexCount;
+    const bool useUVs = uvCoords.size() == vertexCount;
+    std::vector<int8_t> handedness;
+    if (useNormals && tangents.size() == vertexCount && bitangents.size() == vertexCount) {
+        handedness.resize(vertexCount);
+        VertexKernels::analyzeTangents(normals.data(), tangents.data(), bitangents.data(), vertexCount,
+                                       handedness.data());
+    }
+
+    const double cellSize = std::max(kCellTolerances * positionTolerance, static_cast<double>(FLT_MIN));
+    const double inverseCellSize = 1.0 / cellSize;
+    const float toleranceSq = positionTolerance * positionTolerance;
+    const size_t chunkCount = (vertexCount + kVerticesPerChunk - 1) / kVerticesPerChunk;
+
+    CellIndex cells(vertexCount);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t begin = chunk * kVerticesPerChunk;
+        const size_t end = std::min(vertexCount, begin + kVerticesPerChunk);
+        for (size_t v = begin; v < end; ++v) {
+            if (isFinite(vertices[v])) {
+                const Cell c = cellOf(vertices[v], inverseCellSize);
+                cells.insert(hashCell(c.x, c.y, c.z), static_cast<uint32_t>(v));
+            }
+        }
+    });
+    cells.build(pool, kVerticesPerChunk);
+
+    auto attributesMatch = [&](size_t a, size_t b) {
+        if (useNormals) {
+            const glm::vec3 d = glm::abs(normals[a] - normals[b]);
+            if (!(d.x <= attributeTolerance && d.y <= attributeTolerance && d.z <= attributeTolerance)) {
+                return false;
+            }
+        }
+        if (useUVs) {
+            const glm::vec2 d = glm::abs(uvCoords[a] - uvCoords[b]);
+            if (!(d.x <= attributeTolerance && d.y <= attributeTolerance)) {
+                return false;
+            }
+        }
+        return handedness.empty() || handedness[a] == handedness[b];
+    };
+
+    // A vertex is a duplicate when some lower-numbered vertex matches it, so
+    // the first vertex of every cluster survives. Walking the table slot by
+    // slot keeps each vertex's own cell - where nearly all duplicates are -
+    // in cache: its lower-numbered members are simply the ones before it.
+    const size_t slotCount = cells.getSlotCount();
+    const size_t slotChunkCount = (slotCount + kVerticesPerChunk - 1) / kVerticesPerChunk;
+    std::vector<uint64_t> coincident(slotChunkCount, 0);
+    std::vector<uint64_t> weldable(slotChunkCount, 0);
+    pool.parallelFor(slotChunkCount, [&](size_t chunk) {
+        const size_t slotEnd = std::min(slotCount, (chunk + 1) * kVerticesPerChunk);
+        for (size_t slot = chunk * kVerticesPerChunk; slot < slotEnd; ++slot) {
+            const auto cell = cells.cellAt(slot);
+            for (const uint32_t* member = cell.first; member != cell.second; ++member) {
+                const uint32_t v = *member;
+                const glm::vec3& p = vertices[v];
+                bool isCoincident = false;
+                bool isWeldable = false;
+                
+                // Returns true once a weldable match is found
+                auto scanCell = [&](const uint32_t* first, const uint32_t* last) {
+                    last = std::min(last, first + kMaxCandidatesPerCell);
+                    for (const uint32_t* it = first; it != last && *it < v; ++it) {
+                        const glm::vec3 d = vertices[*it] - p;
+                        if (glm::dot(d, d) <= toleranceSq) {
+                            isCoincident = true;
+                            if (attributesMatch(*it, v)) {
+                                if (weldTargets) {
+                                    (*weldTargets)[v] = *it;
+                                }
+                                return true;
+                            }
+                        }
+                    }
+                    return false;
+                };
+                
+                isWeldable = scanCell(cell.first, member);
+                
+                // Neighbouring cells across the faces, edges and corners p is close to
+                if (!isWeldable) {
+                    int neighbour[3];
+                    const Cell c = cellOf(p, inverseCellSize, 1.0 / kCellTolerances, neighbour);
+                    for (int dz = 0; dz <= (neighbour[2] != 0) && !isWeldable; ++dz) {
+                        for (int dy = 0; dy <= (neighbour[1] != 0) && !isWeldable; ++dy) {
+                            for (int dx = 0; dx <= (neighbour[0] != 0) && !isWeldable; ++dx) {
+                                if (dx == 0 && dy == 0 && dz == 0) {
+                                    continue;
+                                }
+                                const auto other = cells.find(hashCell(c.x + dx * neighbour[0],
+                                                                       c.y + dy * neighbour[1],
+                                                                       c.z + dz * neighbour[2]));
+                                isWeldable = scanCell(other.first, other.second);
+                            }
+                        }
+                    }
+                }
+                coincident[chunk] += isCoincident ? 1 : 0;
+                weldable[chunk] += isWeldable ? 1 : 0;
+            }
+        }
+    });
+
+    for (size_t chunk = 0; chunk < slotChunkCount; ++chunk) {
+        result.coincidentVertices += coincident[chunk];
+        result.weldableVertices += weldable[chunk];
+    }
+    result.weldSavingsPercentage = static_cast<float>(result.weldableVertices) / vertexCount * 100.0f;
+    return result;
+}
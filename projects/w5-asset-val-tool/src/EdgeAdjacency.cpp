@@ -0,0 +1,279 @@
+#include "EdgeAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    const size_t kTrianglesPerChunk = 1 << 16;
+    const size_t kVerticesPerChunk = 1 << 16;
+    const size_t kBucketBits = 8;
+    const size_t kBucketCount = size_t(1) << kBucketBits;
+
+    uint64_t mix64(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    size_t bucketOf(uint64_t hash) {
+        return static_cast<size_t>(hash >> (64 - kBucketBits));
+    }
+
+    size_t tableCapacity(size_t entries) {
+        size_t capacity = 16;
+        while (capacity < entries * 2) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    struct HalfEdge {
+        uint64_t key;     // (low id << 32) | high id
+        uint32_t forward; // 1 when the triangle runs low -> high
+    };
+
+    // Bit pattern of a coordinate with -0 folded into +0
+    uint32_t coordinateBits(float value) {
+        value += 0.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    template <size_t N>
+    struct WeldEntry {
+        uint32_t bits[N];
+        uint32_t vertex;
+    };
+
+    template <size_t N>
+    uint64_t hashBits(const uint32_t* bits) {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < N; ++i) {
+            hash = mix64(hash ^ (uint64_t(bits[i]) << 32 | i));
+        }
+        return hash;
+    }
+
+    // Canonical id per vertex: the lowest index whose N key words (written
+    // by keyOf) are identical. Vertices are scattered into buckets by key
+    // hash chunk by chunk, then every bucket is merged by its own task.
+    template <size_t N, typename KeyOf>
+    std::vector<uint32_t> weldVertices(size_t vertexCount, KeyOf keyOf, ThreadPool& pool) {
+        const size_t chunkCount = (vertexCount + kVerticesPerChunk - 1) / kVerticesPerChunk;
+        std::vector<uint32_t> remap(vertexCount);
+
+        std::vector<std::vector<std::vector<WeldEntry<N>>>> scattered(chunkCount);
+        pool.parallelFor(chunkCount, [&](size_t chunk) {
+            auto& buckets = scattered[chunk];
+            buckets.resize(kBucketCount);
+            const size_t end = std::min(vertexCount, (chunk + 1) * kVerticesPerChunk);
+            for (size_t v = chunk * kVerticesPerChunk; v < end; ++v) {
+                WeldEntry<N> entry;
+                keyOf(v, entry.bits);
+                entry.vertex = static_cast<uint32_t>(v);
+                buckets[bucketOf(hashBits<N>(entry.bits))].push_back(entry);
+            }
+        });
+
+        // Within a bucket, entries arrive in ascending vertex order, so the
+        // first vertex seen with a key is the lowest one
+        pool.parallelFor(kBucketCount, [&](size_t bucket) {
+            size_t entries = 0;
+            for (const auto& chunk : scattered) {
+                entries += chunk[bucket].size();
+            }
+            if (entries == 0) {
+                return;
+            }
+
+            const size_t capacity = tableCapacity(entries);
+            const size_t mask = capacity - 1;
+            std::vector<const WeldEntry<N>*> table(capacity, nullptr);
+            for (const auto& chunk : scattered) {
+                for (const WeldEntry<N>& entry : chunk[bucket]) {
+                    // Low bits select the slot; the high bits already chose the bucket
+                    size_t slot = hashBits<N>(entry.bits) & mask;
+                    while (true) {
+                        const WeldEntry<N>* owner = table[slot];
+                        if (owner == nullptr) {
+                            table[slot] = &entry;
+                            remap[entry.vertex] = entry.vertex;
+                            break;
+                        }
+                        if (std::equal(entry.bits, entry.bits + N, owner->bits)) {
+                            remap[entry.vertex] = owner->vertex;
+                            break;
+                        }
+                        slot = (slot + 1) & mask;
+                    }
+                }
+            }
+        });
+        return remap;
+    }
+
+    // Small union-find used to count boundary loops
+    uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+}
+
+std::vector<uint32_t> EdgeAdjacency::weldPositions(const std::vector<glm::vec3>& vertices, ThreadPool& pool) {
+    return weldVertices<3>(vertices.size(), [&](size_t v, uint32_t* bits) {
+        bits[0] = coordinateBits(vertices[v].x);
+        bits[1] = coordinateBits(vertices[v].y);
+        bits[2] = coordinateBits(vertices[v].z);
+    }, pool);
+}
+
+std::vector<uint32_t> EdgeAdjacency::weldPositionsAndUVs(const std::vector<glm::vec3>& vertices,
+                                                         const std::vector<glm::vec2>& uvs, ThreadPool& pool) {
+    if (uvs.size() != vertices.size()) {
+        return weldPositions(vertices, pool);
+    }
+    return weldVertices<5>(vertices.size(), [&](size_t v, uint32_t* bits) {
+        bits[0] = coordinateBits(vertices[v].x);
+        bits[1] = coordinateBits(vertices[v].y);
+        bits[2] = coordinateBits(vertices[v].z);
+        bits[3] = coordinateBits(uvs[v].x);
+        bits[4] = coordinateBits(uvs[v].y);
+    }, pool);
+}
+
+void EdgeAdjacency::build(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap,
+                          size_t vertexCount, ThreadPool& pool) {
+    edges.clear();
+    const size_t triangleCount = indices.size() / 3;
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    const bool useRemap = !remap.empty();
+
+    // Pass 1: every chunk scatters its half-edges into hash buckets
+    std::vector<std::vector<std::vector<HalfEdge>>> scattered(chunkCount);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        auto& buckets = scattered[chunk];
+        buckets.resize(kBucketCount);
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            uint32_t v[3];
+            bool valid = true;
+            for (int corner = 0; corner < 3; ++corner) {
+                const uint32_t index = indices[t * 3 + corner];
+                valid = valid && index < vertexCount;
+                v[corner] = (valid && useRemap) ? remap[index] : index;
+            }
+            if (!valid || v[0] == v[1] || v[1] == v[2] || v[0] == v[2]) {
+                continue;
+            }
+
+            for (int corner = 0; corner < 3; ++corner) {
+                const uint32_t a = v[corner];
+                const uint32_t b = v[(corner + 1) % 3];
+                HalfEdge half;
+                half.key = a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+                half.forward = a < b ? 1 : 0;
+                buckets[bucketOf(mix64(half.key))].push_back(half);
+            }
+        }
+    });
+
+    // Pass 2: each bucket merges its half-edges into undirected edges
+    std::vector<std::vector<MeshEdge>> merged(kBucketCount);
+    pool.parallelFor(kBucketCount, [&](size_t bucket) {
+        size_t halfEdges = 0;
+        for (const auto& chunk : scattered) {
+            halfEdges += chunk[bucket].size();
+        }
+        if (halfEdges == 0) {
+            return;
+        }
+
+        const size_t capacity = tableCapacity(halfEdges);
+        const size_t mask = capacity - 1;
+        std::vector<uint32_t> table(capacity, UINT32_MAX);
+        auto& out = merged[bucket];
+        out.reserve(halfEdges / 2 + 1);
+
+        for (auto& chunk : scattered) {
+            for (const HalfEdge& half : chunk[bucket]) {
+                // Low bits select the slot; the high bits already chose the bucket
+                size_t slot = mix64(half.key) & mask;
+                while (true) {
+                    const uint32_t edgeIndex = table[slot];
+                    if (edgeIndex == UINT32_MAX) {
+                        table[slot] = static_cast<uint32_t>(out.size());
+                        out.push_back(MeshEdge{static_cast<uint32_t>(half.key >> 32),
+                                               static_cast<uint32_t>(half.key), 1, half.forward});
+                        break;
+                    }
+                    MeshEdge& edge = out[edgeIndex];
+                    if ((uint64_t(edge.v0) << 32 | edge.v1) == half.key) {
+                        edge.faceCount++;
+                        edge.forwardCount += half.forward;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+            std::vector<HalfEdge>().swap(chunk[bucket]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& bucket : merged) {
+        total += bucket.size();
+    }
+    edges.reserve(total);
+    for (const auto& bucket : merged) {
+        edges.insert(edges.end(), bucket.begin(), bucket.end());
+    }
+}
+
+MeshTopologyResult EdgeAdjacency::analyzeTopology() const {
+    MeshTopologyResult result;
+    result.edgeCount = edges.size();
+
+    std::unordered_map<uint32_t, uint32_t> boundaryVertices;
+    std::vector<uint32_t> parent;
+    auto node = [&](uint32_t vertex) {
+        auto inserted = boundaryVertices.emplace(vertex, static_cast<uint32_t>(parent.size()));
+        if (inserted.second) {
+            parent.push_back(inserted.first->second);
+        }
+        return inserted.first->second;
+    };
+
+    for (const MeshEdge& edge : edges) {
+        if (edge.faceCount == 1) {
+            result.boundaryEdges++;
+            const uint32_t a = findRoot(parent, node(edge.v0));
+            const uint32_t b = findRoot(parent, node(edge.v1));
+            if (a != b) {
+                parent[a] = b;
+            }
+        } else if (edge.faceCount == 2) {
+            // Consistently wound neighbours traverse a shared edge in opposite directions
+            if (edge.forwardCount != 1) {
+                result.windingFlips++;
+            }
+        } else {
+            result.nonManifoldEdges++;
+        }
+    }
+
+    for (uint32_t i = 0; i < parent.size(); ++i) {
+        if (parent[i] == i) {
+            result.boundaryLoops++;
+        }
+    }
+    result.isWatertight = result.boundaryEdges == 0 && result.nonManifoldEdges == 0;
+    return result;
+}
@@ -0,0 +1,675 @@
+#include "GeometryHasher.h"
+#include "DrawCallEstimator.h"
+#include "GpuMemoryEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+namespace {
+    const size_t kVerticesPerChunk = 1 << 16;
+    const size_t kTrianglesPerChunk = 1 << 16;
+
+    // Extents closer than this (relative to the largest) leave the axes undefined
+    const double kMinAxisGap = 0.01;
+    // Shape signature steps: log of the major variance, and extent ratios
+    const double kShapeSteps = 1000.0;
+    const float kUvTolerance = 1e-4f;
+    const uint64_t kCheckSeed = 0x2545F4914F6CDD1Dull;
+
+    uint64_t mix64(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    uint64_t floatBits(float value) {
+        value += 0.0f; // -0 and +0 hash alike
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    uint64_t vertexHash(const MeshData& mesh, size_t v, uint32_t format) {
+        uint64_t h = mix64(0x9E3779B97F4A7C15ull + format);
+        const auto feed = [&h](float a, float b) {
+            h = mix64(h ^ (floatBits(a) | floatBits(b) << 32));
+        };
+        feed(mesh.vertices[v].x, mesh.vertices[v].y);
+        feed(mesh.vertices[v].z, 0.0f);
+        if (format & kVertexNormals) {
+            feed(mesh.normals[v].x, mesh.normals[v].y);
+            feed(mesh.normals[v].z, 0.0f);
+        }
+        if (format & kVertexUVs) {
+            feed(mesh.uvCoords[v].x, mesh.uvCoords[v].y);
+        }
+        return h;
+    }
+
+    // Winding-preserving rotation puts the smallest corner first, so the
+    // hash ignores which corner the index buffer starts at
+    uint64_t triangleHash(uint64_t a, uint64_t b, uint64_t c) {
+        if (b < a && b <= c) {
+            std::swap(a, b); // (b, a, c)
+            std::swap(b, c); // (b, c, a)
+        } else if (c < a && c < b) {
+            std::swap(a, c); // (c, b, a)
+            std::swap(b, c); // (c, a, b)
+        }
+        return mix64(mix64(mix64(a) + b) + c);
+    }
+
+    bool triangleCorners(const MeshData& mesh, size_t t, uint32_t& i0, uint32_t& i1, uint32_t& i2) {
+        i0 = mesh.indices[t * 3];
+        i1 = mesh.indices[t * 3 + 1];
+        i2 = mesh.indices[t * 3 + 2];
+        const size_t vertexCount = mesh.vertices.size();
+        return i0 < vertexCount && i1 < vertexCount && i2 < vertexCount;
+    }
+
+    glm::dvec3 toDouble(const glm::vec3& v) {
+        return glm::dvec3(v.x, v.y, v.z);
+    }
+
+    // Cyclic Jacobi on a symmetric 3x3 matrix; vectors[k][i] is component k
+    // of eigenvector i
+    void symmetricEigen(double a[3][3], double values[3], double vectors[3][3]) {
+        for (int i = 0; i < 3; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                vectors[i][k] = i == k ? 1.0 : 0.0;
+            }
+        }
+        for (int sweep = 0; sweep < 32; ++sweep) {
+            const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+            const double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+            if (off <= 1e-30 * diagonal) {
+                break;
+            }
+            for (int p = 0; p < 2; ++p) {
+                for (int q = p + 1; q < 3; ++q) {
+                    if (a[p][q] == 0.0) {
+                        continue;
+                    }
+                    const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0);
+                    const double s = t * c;
+                    for (int k = 0; k < 3; ++k) {
+                        const double kp = a[k][p], kq = a[k][q];
+                        a[k][p] = c * kp - s * kq;
+                        a[k][q] = s * kp + c * kq;
+                    }
+                    for (int k = 0; k < 3; ++k) {
+                        const double pk = a[p][k], qk = a[q][k];
+                        a[p][k] = c * pk - s * qk;
+                        a[q][k] = s * pk + c * qk;
+                    }
+                    for (int k = 0; k < 3; ++k) {
+                        const double kp = vectors[k][p], kq = vectors[k][q];
+                        vectors[k][p] = c * kp - s * kq;
+                        vectors[k][q] = s * kp + c * kq;
+                    }
+                }
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            values[i] = a[i][i];
+        }
+    }
+
+    // The four axis sign choices that keep a frame right-handed
+    const double kFrameSigns[4][3] = {{1, 1, 1}, {-1, -1, 1}, {-1, 1, -1}, {1, -1, -1}};
+
+    glm::vec3 canonicalPoint(const glm::vec3& p, const GeometryHash& frame, const double signs[3]) {
+        const glm::dvec3 d = toDouble(p) - frame.center;
+        return glm::vec3(static_cast<float>(glm::dot(d, frame.axes[0]) * signs[0]),
+                         static_cast<float>(glm::dot(d, frame.axes[1]) * signs[1]),
+                         static_cast<float>(glm::dot(d, frame.axes[2]) * signs[2]));
+    }
+
+    float distanceSq(const glm::vec3& a, const glm::vec3& b) {
+        const glm::vec3 d = a - b;
+        return glm::dot(d, d);
+    }
+
+    // Triangles of a mesh in its principal frame, bucketed by centroid on a
+    // grid two tolerances wide: a counterpart's centroid is within one
+    // tolerance, so per axis only the nearer neighbouring cell can hold it
+    class CanonicalTriangles {
+    public:
+        CanonicalTriangles(const MeshData& mesh, const GeometryHash& frame, float tolerance)
+            : mesh(mesh), tolerance(tolerance), cellSize(2.0f * tolerance) {
+            const size_t triangleCount = mesh.indices.size() / 3;
+            corners.reserve(triangleCount * 3);
+            std::vector<std::pair<uint64_t, uint32_t>> keyed;
+            keyed.reserve(triangleCount);
+            for (size_t t = 0; t < triangleCount; ++t) {
+                uint32_t i0, i1, i2;
+                if (!triangleCorners(mesh, t, i0, i1, i2)) {
+                    continue;
+                }
+                const uint32_t triangle = static_cast<uint32_t>(corners.size() / 3);
+                for (uint32_t v : {i0, i1, i2}) {
+                    corners.push_back(canonicalPoint(mesh.vertices[v], frame, kFrameSigns[0]));
+                    sourceVertices.push_back(v);
+                }
+                const glm::vec3 centroid = (corners[triangle * 3] + corners[triangle * 3 + 1] +
+                                            corners[triangle * 3 + 2]) / 3.0f;
+                keyed.emplace_back(cellKey(cellOf(centroid.x), cellOf(centroid.y), cellOf(centroid.z)), triangle);
+            }
+
+            // Triangles sorted by cell; each cell maps to its run
+            std::sort(keyed.begin(), keyed.end());
+            cellTriangles.reserve(keyed.size());
+            cellRanges.reserve(keyed.size());
+            for (size_t i = 0; i < keyed.size(); ++i) {
+                if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+                    cellRanges[keyed[i].first] = {static_cast<uint32_t>(i), static_cast<uint32_t>(i)};
+                }
+                cellRanges[keyed[i].first].second++;
+                cellTriangles.push_back(keyed[i].second);
+            }
+        }
+
+        // Every triangle of other, aligned by its own frame, has a
+        // counterpart here within tolerance (and equal UVs)
+        bool matches(const MeshData& other, const GeometryHash& frame, const double signs[3]) const {
+            const bool compareUVs = !mesh.uvCoords.empty() && !other.uvCoords.empty();
+            const float toleranceSq = tolerance * tolerance;
+            const size_t triangleCount = other.indices.size() / 3;
+            for (size_t t = 0; t < triangleCount; ++t) {
+                uint32_t index[3];
+                if (!triangleCorners(other, t, index[0], index[1], index[2])) {
+                    continue;
+                }
+                glm::vec3 q[3];
+                for (int k = 0; k < 3; ++k) {
+                    q[k] = canonicalPoint(other.vertices[index[k]], frame, signs);
+                }
+                const glm::vec3 centroid = (q[0] + q[1] + q[2]) / 3.0f;
+
+                // Own cell, plus the nearer neighbour on axes where the
+                // centroid is within tolerance of the cell boundary
+                int64_t cell[3][2];
+                int count[3];
+                const float coordinates[3] = {centroid.x, centroid.y, centroid.z};
+                for (int axis = 0; axis < 3; ++axis) {
+                    const int64_t own = cellOf(coordinates[axis]);
+                    const float offset = coordinates[axis] - own * cellSize;
+                    cell[axis][0] = own;
+                    count[axis] = 1;
+                    if (offset < tolerance) {
+                        cell[axis][count[axis]++] = own - 1;
+                    } else if (offset > cellSize - tolerance) {
+                        cell[axis][count[axis]++] = own + 1;
+                    }
+                }
+
+                bool found = false;
+                for (int x = 0; x < count[0] && !found; ++x) {
+                    for (int y = 0; y < count[1] && !found; ++y) {
+                        for (int z = 0; z < count[2] && !found; ++z) {
+                            const auto range = cellRanges.find(cellKey(cell[0][x], cell[1][y], cell[2][z]));
+                            if (range == cellRanges.end()) {
+                                continue;
+                            }
+                            for (uint32_t i = range->second.first; i < range->second.second && !found; ++i) {
+                                found = sameTriangle(cellTriangles[i], q, other, index, compareUVs, toleranceSq);
+                            }
+                        }
+                    }
+                }
+                if (!found) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        int64_t cellOf(float value) const {
+            return static_cast<int64_t>(std::floor(value / cellSize));
+        }
+
+        static uint64_t cellKey(int64_t x, int64_t y, int64_t z) {
+            const auto axis = [](int64_t cell) {
+                return static_cast<uint64_t>(std::clamp<int64_t>(cell + (1 << 20), 0, (1 << 21) - 1));
+            };
+            return axis(x) | axis(y) << 21 | axis(z) << 42;
+        }
+
+        bool sameTriangle(uint32_t triangle, const glm::vec3 q[3], const MeshData& other, const uint32_t index[3],
+                          bool compareUVs, float toleranceSq) const {
+            const glm::vec3* p = &corners[triangle * 3];
+            const uint32_t* source = &sourceVertices[triangle * 3];
+            for (int rotation = 0; rotation < 3; ++rotation) {
+                bool same = true;
+                for (int k = 0; k < 3 && same; ++k) {
+                    const int r = (k + rotation) % 3;
+                    same = distanceSq(p[r], q[k]) <= toleranceSq;
+                    if (same && compareUVs) {
+                        const glm::vec2& a = mesh.uvCoords[source[r]];
+                        const glm::vec2& b = other.uvCoords[index[k]];
+                        same = std::fabs(a.x - b.x) <= kUvTolerance && std::fabs(a.y - b.y) <= kUvTolerance;
+                    }
+                }
+                if (same) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const MeshData& mesh;
+        float tolerance;
+        float cellSize;
+        std::vector<glm::vec3> corners;        // 3 per valid triangle
+        std::vector<uint32_t> sourceVertices;  // Vertex of each corner
+        std::vector<uint32_t> cellTriangles;   // Triangles grouped by centroid cell
+        std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> cellRanges; // Cell -> run in cellTriangles
+    };
+
+    uint32_t materialOf(const MeshData& mesh) {
+        return mesh.materialIndices.empty() ? DrawBatch::kNoMaterial : mesh.materialIndices[0];
+    }
+
+    // Absolute, so runs from different working directories agree
+    std::string absoluteScenePath(const std::string& sceneFile) {
+        std::error_code error;
+        const std::filesystem::path absolute = std::filesystem::absolute(sceneFile, error);
+        return (error ? std::filesystem::path(sceneFile) : absolute).lexically_normal().generic_string();
+    }
+
+    std::string keyHex(uint64_t value) {
+        return fmt::format("{:016x}", value);
+    }
+}
+
+GeometryHasher::GeometryHasher(bool matchRigid, float tolerance, uint32_t minTriangles)
+    : matchRigid(matchRigid), tolerance(std::max(tolerance, 1e-6f)), minTriangles(minTriangles) {}
+
+GeometryHash GeometryHasher::hash(const MeshData& mesh, ThreadPool& pool) const {
+    GeometryHash result;
+    const size_t vertexCount = mesh.vertices.size();
+    const size_t triangleCount = mesh.indices.size() / 3;
+    if (vertexCount == 0 || triangleCount == 0) {
+        return result;
+    }
+    const uint32_t format = DrawCallEstimator::vertexFormat(mesh);
+
+    std::vector<uint64_t> vertexHashes(vertexCount);
+    pool.parallelFor((vertexCount + kVerticesPerChunk - 1) / kVerticesPerChunk, [&](size_t chunk) {
+        const size_t end = std::min(vertexCount, (chunk + 1) * kVerticesPerChunk);
+        for (size_t v = chunk * kVerticesPerChunk; v < end; ++v) {
+            vertexHashes[v] = vertexHash(mesh, v, format);
+        }
+    });
+
+    // Pass 1: triangle hash sums, area and area-weighted centroid
+    struct HashChunk {
+        uint64_t sum = 0;
+        uint64_t check = 0;
+        uint32_t triangles = 0;
+        double area = 0.0;
+        glm::dvec3 weighted = glm::dvec3(0.0);
+    };
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    const glm::dvec3 origin = toDouble(mesh.vertices[0]); // Keeps the sums small
+    const bool measure = matchRigid;
+    std::vector<HashChunk> chunks(chunkCount);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        HashChunk& out = chunks[chunk];
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            uint32_t i0, i1, i2;
+            if (!triangleCorners(mesh, t, i0, i1, i2)) {
+                continue;
+            }
+            const uint64_t h = triangleHash(vertexHashes[i0], vertexHashes[i1], vertexHashes[i2]);
+            out.sum += h;
+            out.check += mix64(h ^ kCheckSeed);
+            out.triangles++;
+            if (measure) {
+                const glm::dvec3 p0 = toDouble(mesh.vertices[i0]) - origin;
+                const glm::dvec3 p1 = toDouble(mesh.vertices[i1]) - origin;
+                const glm::dvec3 p2 = toDouble(mesh.vertices[i2]) - origin;
+                const double area = 0.5 * glm::length(glm::cross(p1 - p0, p2 - p0));
+                out.area += area;
+                out.weighted += (p0 + p1 + p2) * (area / 3.0);
+            }
+        }
+    });
+
+    HashChunk total;
+    for (const auto& chunk : chunks) {
+        total.sum += chunk.sum;
+        total.check += chunk.check;
+        total.triangles += chunk.triangles;
+        total.area += chunk.area;
+        total.weighted += chunk.weighted;
+    }
+    result.exact.hash = mix64(total.sum ^ total.triangles);
+    result.exact.check = mix64(total.check + total.triangles);
+    result.exact.triangles = total.triangles;
+    if (!matchRigid || total.triangles == 0 || !(total.area > 0.0)) {
+        return result;
+    }
+    result.center = origin + total.weighted / total.area;
+
+    // Pass 2: second moments about the centroid, corners weighted by a third
+    // of their triangle's area
+    struct MomentChunk {
+        double m[6] = {0, 0, 0, 0, 0, 0}; // xx, xy, xz, yy, yz, zz
+    };
+    std::vector<MomentChunk> moments(chunkCount);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        MomentChunk& out = moments[chunk];
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            uint32_t i0, i1, i2;
+            if (!triangleCorners(mesh, t, i0, i1, i2)) {
+                continue;
+            }
+            const glm::dvec3 p[3] = {toDouble(mesh.vertices[i0]) - result.center,
+                                     toDouble(mesh.vertices[i1]) - result.center,
+                                     toDouble(mesh.vertices[i2]) - result.center};
+            const double weight = 0.5 * glm::length(glm::cross(p[1] - p[0], p[2] - p[0])) / 3.0;
+            for (const glm::dvec3& d : p) {
+                out.m[0] += weight * d.x * d.x;
+                out.m[1] += weight * d.x * d.y;
+                out.m[2] += weight * d.x * d.z;
+                out.m[3] += weight * d.y * d.y;
+                out.m[4] += weight * d.y * d.z;
+                out.m[5] += weight * d.z * d.z;
+            }
+        }
+    });
+    double m[6] = {0, 0, 0, 0, 0, 0};
+    for (const auto& chunk : moments) {
+        for (int k = 0; k < 6; ++k) {
+            m[k] += chunk.m[k] / total.area;
+        }
+    }
+
+    double covariance[3][3] = {{m[0], m[1], m[2]}, {m[1], m[3], m[4]}, {m[2], m[4], m[5]}};
+    double values[3], vectors[3][3];
+    symmetricEigen(covariance, values, vectors);
+    int order[3] = {0, 1, 2};
+    std::sort(order, order + 3, [&](int a, int b) { return values[a] > values[b]; });
+    const double major = values[order[0]];
+    if (!(major > 0.0) || values[order[0]] - values[order[1]] < kMinAxisGap * major ||
+        values[order[1]] - values[order[2]] < kMinAxisGap * major) {
+        return result;
+    }
+    for (int i = 0; i < 2; ++i) {
+        const int column = order[i];
+        result.axes[i] = glm::dvec3(vectors[0][column], vectors[1][column], vectors[2][column]);
+    }
+    result.axes[2] = glm::cross(result.axes[0], result.axes[1]); // Right-handed
+    result.scale = std::sqrt(major);
+    result.hasFrame = true;
+
+    uint64_t shape = mix64(uint64_t(total.triangles) << 8 | format);
+    shape = mix64(shape ^ static_cast<uint64_t>(std::llround(std::log(major) * kShapeSteps)));
+    shape = mix64(shape ^ static_cast<uint64_t>(std::llround(values[order[1]] / major * kShapeSteps)));
+    shape = mix64(shape ^ static_cast<uint64_t>(std::llround(std::max(0.0, values[order[2]]) / major * kShapeSteps)));
+    result.shape = shape;
+    return result;
+}
+
+DuplicateMeshResult GeometryHasher::analyze(const SceneData& scene, ThreadPool& pool) const {
+    DuplicateMeshResult result;
+    const std::vector<MeshData>& meshes = scene.meshes;
+    result.meshHashes.resize(meshes.size());
+    pool.parallelFor(meshes.size(), [&](size_t i) {
+        result.meshHashes[i] = hash(meshes[i], pool);
+    });
+    const std::vector<GeometryHash>& hashes = result.meshHashes;
+
+    // Exact groups, opened in scene order. Groups sharing a hash are told
+    // apart by the rest of the key.
+    std::vector<std::vector<uint32_t>> exactGroups;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> groupsByHash;
+    for (uint32_t i = 0; i < meshes.size(); ++i) {
+        const GeometryKey& key = hashes[i].exact;
+        if (key.triangles == 0 || key.triangles < minTriangles) {
+            continue;
+        }
+        std::vector<uint32_t>& candidates = groupsByHash[key.hash];
+        bool placed = false;
+        for (uint32_t group : candidates) {
+            if (hashes[exactGroups[group][0]].exact == key) {
+                exactGroups[group].push_back(i);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            candidates.push_back(static_cast<uint32_t>(exactGroups.size()));
+            exactGroups.push_back({i});
+        }
+    }
+
+    // Rigid matches merge exact groups: within a shape bucket, the first
+    // pending group is compared against all others in parallel, the matches
+    // join it and the rest stay pending for the next round
+    std::vector<uint32_t> finalGroup(exactGroups.size());
+    for (uint32_t g = 0; g < exactGroups.size(); ++g) {
+        finalGroup[g] = g;
+    }
+    if (matchRigid) {
+        std::vector<std::vector<uint32_t>> buckets;
+        std::unordered_map<uint64_t, uint32_t> bucketByShape;
+        for (uint32_t g = 0; g < exactGroups.size(); ++g) {
+            const GeometryHash& h = hashes[exactGroups[g][0]];
+            if (!h.hasFrame) {
+                continue;
+            }
+            const auto inserted = bucketByShape.emplace(h.shape, static_cast<uint32_t>(buckets.size()));
+            if (inserted.second) {
+                buckets.emplace_back();
+            }
+            buckets[inserted.first->second].push_back(g);
+        }
+
+        for (auto& pending : buckets) {
+            while (pending.size() > 1) {
+                const uint32_t reference = exactGroups[pending[0]][0];
+                const GeometryHash& frame = hashes[reference];
+                const CanonicalTriangles canonical(meshes[reference], frame,
+                                                   static_cast<float>(tolerance * frame.scale));
+                std::vector<char> matched(pending.size(), 0);
+                pool.parallelFor(pending.size() - 1, [&](size_t i) {
+                    const uint32_t other = exactGroups[pending[i + 1]][0];
+                    for (const auto& signs : kFrameSigns) {
+                        if (canonical.matches(meshes[other], hashes[other], signs)) {
+                            matched[i + 1] = 1;
+                            break;
+                        }
+                    }
+                });
+                std::vector<uint32_t> unmatched;
+                for (size_t i = 1; i < pending.size(); ++i) {
+                    if (matched[i]) {
+                        finalGroup[pending[i]] = pending[0];
+                    } else {
+                        unmatched.push_back(pending[i]);
+                    }
+                }
+                pending = std::move(unmatched);
+            }
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> members(exactGroups.size());
+    for (uint32_t g = 0; g < exactGroups.size(); ++g) {
+        auto& target = members[finalGroup[g]];
+        target.insert(target.end(), exactGroups[g].begin(), exactGroups[g].end());
+    }
+    for (auto& meshList : members) {
+        if (meshList.size() < 2) {
+            continue;
+        }
+        std::sort(meshList.begin(), meshList.end());
+        const MeshData& first = meshes[meshList[0]];
+
+        DuplicateMeshGroup group;
+        std::set<uint32_t> sources, materials;
+        uint64_t transformed = 0;
+        for (uint32_t m : meshList) {
+            const bool stored = meshes[m].sourceMesh == MeshData::kNoSourceMesh ||
+                                sources.insert(meshes[m].sourceMesh).second;
+            if (stored) {
+                group.storedCopies++;
+                if (!(hashes[m].exact == hashes[meshList[0]].exact)) {
+                    transformed++;
+                }
+            }
+            materials.insert(materialOf(meshes[m]));
+        }
+        if (group.storedCopies < 2) {
+            continue; // Node references to one mesh: already instanced by the file
+        }
+        group.meshes = std::move(meshList);
+        group.transformed = transformed > 0;
+        group.bytesSaved = (group.storedCopies - 1) * meshBytes(first);
+        group.drawsSaved = group.meshes.size() - materials.size();
+
+        result.duplicateMeshes += group.storedCopies - 1;
+        result.transformedMeshes += transformed;
+        result.bytesSaved += group.bytesSaved;
+        result.drawsSaved += group.drawsSaved;
+        result.groups.push_back(std::move(group));
+    }
+
+    std::stable_sort(result.groups.begin(), result.groups.end(), [](const DuplicateMeshGroup& a, const DuplicateMeshGroup& b) {
+        return a.bytesSaved > b.bytesSaved;
+    });
+    return result;
+}
+
+void GeometryHasher::matchIndex(const SceneData& scene, DuplicateMeshResult& result, GeometryIndex& index) const {
+    const std::string sceneFile = absoluteScenePath(scene.filePath);
+    std::unordered_map<uint64_t, std::vector<uint32_t>> seen; // This scene's keys, first mesh each
+    for (uint32_t m = 0; m < result.meshHashes.size() && m < scene.meshes.size(); ++m) {
+        const GeometryKey& key = result.meshHashes[m].exact;
+        if (key.triangles == 0 || key.triangles < minTriangles) {
+            continue;
+        }
+        std::vector<uint32_t>& firsts = seen[key.hash];
+        const bool repeated = std::any_of(firsts.begin(), firsts.end(), [&](uint32_t first) {
+            return result.meshHashes[first].exact == key;
+        });
+        if (repeated) {
+            continue;
+        }
+        firsts.push_back(m);
+
+        const GeometryIndex::Entry* known = index.find(key);
+        if (!known) {
+            index.add({key, sceneFile, scene.meshes[m].name});
+            continue;
+        }
+        if (known->file == sceneFile) {
+            continue;
+        }
+
+        // The copy this scene keeps could reference the other file's mesh
+        const uint64_t bytes = meshBytes(scene.meshes[m]);
+        auto group = std::find_if(result.groups.begin(), result.groups.end(), [m](const DuplicateMeshGroup& g) {
+            return std::find(g.meshes.begin(), g.meshes.end(), m) != g.meshes.end();
+        });
+        if (group == result.groups.end()) {
+            DuplicateMeshGroup single;
+            single.meshes = {m};
+            single.storedCopies = 1;
+            result.groups.push_back(std::move(single));
+            group = result.groups.end() - 1;
+        }
+        group->indexFile = known->file;
+        group->indexMesh = known->mesh;
+        group->bytesSaved += bytes;
+        result.bytesSaved += bytes;
+        result.indexMatches++;
+    }
+
+    std::stable_sort(result.groups.begin(), result.groups.end(), [](const DuplicateMeshGroup& a, const DuplicateMeshGroup& b) {
+        return a.bytesSaved > b.bytesSaved;
+    });
+}
+
+uint64_t GeometryHasher::meshBytes(const MeshData& mesh) {
+    return uint64_t(mesh.vertices.size()) * GpuMemoryEstimator::vertexStride(mesh) +
+           uint64_t(mesh.indices.size()) * GpuMemoryEstimator::indexSize(mesh.vertices.size());
+}
+
+void GeometryIndex::load(const std::string& path) {
+    entries.clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        nlohmann::json j;
+        file >> j;
+        for (const auto& entry : j.at("meshes")) {
+            Entry loaded;
+            loaded.key.hash = std::stoull(entry.at("hash").get<std::string>(), nullptr, 16);
+            loaded.key.check = std::stoull(entry.at("check").get<std::string>(), nullptr, 16);
+            loaded.key.triangles = entry.at("triangles");
+            loaded.file = entry.at("file");
+            loaded.mesh = entry.at("mesh");
+            add(loaded);
+        }
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to read mesh index '" + path + "': " + e.what());
+    }
+}
+
+void GeometryIndex::save(const std::string& path) const {
+    // Sorted so the file diffs cleanly between runs
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sorted.push_back(&entry.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+        return a->key.hash != b->key.hash ? a->key.hash < b->key.hash : a->key.check < b->key.check;
+    });
+
+    nlohmann::json meshes = nlohmann::json::array();
+    for (const Entry* entry : sorted) {
+        meshes.push_back({{"hash", keyHex(entry->key.hash)}, {"check", keyHex(entry->key.check)},
+                          {"triangles", entry->key.triangles}, {"file", entry->file}, {"mesh", entry->mesh}});
+    }
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create mesh index: " + path);
+    }
+    file << nlohmann::json{{"meshes", meshes}}.dump(4);
+}
+
+const GeometryIndex::Entry* GeometryIndex::find(const GeometryKey& key) const {
+    const auto range = entries.equal_range(key.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.key == key) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+void GeometryIndex::add(const Entry& entry) {
+    if (!find(entry.key)) {
+        entries.emplace(entry.key.hash, entry);
+    }
+}
@@ -0,0 +1,389 @@
+#include "GltfWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // glTF enums
+    const int kFloat = 5126;
+    const int kUnsignedShort = 5123;
+    const int kUnsignedInt = 5125;
+    const int kArrayBuffer = 34962;
+    const int kElementArrayBuffer = 34963;
+
+    const uint32_t kGlbMagic = 0x46546C67;     // "glTF"
+    const uint32_t kGlbJsonChunk = 0x4E4F534A; // "JSON"
+    const uint32_t kGlbBinChunk = 0x004E4942;  // "BIN\0"
+
+    class BufferBuilder {
+    public:
+        explicit BufferBuilder(nlohmann::json& gltf) : gltf(gltf) {}
+
+        // Appends data as a new buffer view and returns its index; image
+        // views have no target
+        size_t addView(const void* data, size_t size, int target = 0) {
+            while (bytes.size() % 4 != 0) {
+                bytes.push_back(0);
+            }
+            const size_t offset = bytes.size();
+            bytes.resize(offset + size);
+            std::memcpy(bytes.data() + offset, data, size);
+            gltf["bufferViews"].push_back({
+                {"buffer", 0},
+                {"byteOffset", offset},
+                {"byteLength", size}
+            });
+            if (target != 0) {
+                gltf["bufferViews"].back()["target"] = target;
+            }
+            return gltf["bufferViews"].size() - 1;
+        }
+
+        size_t addAccessor(size_t view, int componentType, size_t count, const char* type) {
+            gltf["accessors"].push_back({
+                {"bufferView", view},
+                {"componentType", componentType},
+                {"count", count},
+                {"type", type}
+            });
+            return gltf["accessors"].size() - 1;
+        }
+
+        std::vector<uint8_t> bytes;
+
+    private:
+        nlohmann::json& gltf;
+    };
+
+    // Percent-encodes everything but unreserved characters and '/'
+    std::string encodeURI(const std::string& path) {
+        static const char* hex = "0123456789ABCDEF";
+        std::string uri;
+        for (unsigned char c : path) {
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/') {
+                uri += static_cast<char>(c);
+            } else {
+                uri += '%';
+                uri += hex[c >> 4];
+                uri += hex[c & 15];
+            }
+        }
+        return uri;
+    }
+
+    bool writeBytes(const std::string& path, const std::vector<uint8_t>& data) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return file.good();
+    }
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+}
+
+bool GltfWriter::write(const SceneData& sceneData, const std::string& sourcePath, const std::string& outputPath) {
+    namespace fs = std::filesystem;
+    writtenBytes = 0;
+
+    const fs::path output(outputPath);
+    const fs::path sourceDirectory = fs::absolute(fs::path(sourcePath)).parent_path();
+    const fs::path outputDirectory = fs::absolute(output).parent_path();
+    std::string extension = output.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    const bool binary = extension == ".glb";
+
+    nlohmann::json gltf = {
+        {"asset", {{"version", "2.0"}, {"generator", "asset-validator --fix"}}},
+        {"scene", 0},
+        {"scenes", nlohmann::json::array({{{"nodes", nlohmann::json::array()}}})},
+        {"nodes", nlohmann::json::array()},
+        {"meshes", nlohmann::json::array()},
+        {"bufferViews", nlohmann::json::array()},
+        {"accessors", nlohmann::json::array()}
+    };
+    BufferBuilder buffer(gltf);
+
+    // Images and textures, one per distinct file. Embedded textures ("*N")
+    // are copied into the buffer; glTF only takes PNG and JPEG there, so
+    // others and raw texel arrays are left out.
+    std::map<std::string, size_t> textureIndex;
+    auto textureFor = [&](const std::string& path) -> nlohmann::json {
+        if (path.empty()) {
+            return nullptr;
+        }
+        auto it = textureIndex.find(path);
+        if (it == textureIndex.end() && path[0] == '*') {
+            const auto embedded = std::find_if(sceneData.textures.begin(), sceneData.textures.end(),
+                                               [&](const TextureData& texture) { return texture.filePath == path; });
+            if (embedded == sceneData.textures.end() || embedded->embeddedData.empty()) {
+                return nullptr;
+            }
+            const std::string format = embedded->format;
+            const char* mimeType = format == "png" ? "image/png"
+                                 : (format == "jpg" || format == "jpeg") ? "image/jpeg" : nullptr;
+            if (!mimeType) {
+                return nullptr;
+            }
+            const size_t view = buffer.addView(embedded->embeddedData.data(), embedded->embeddedData.size());
+            gltf["images"].push_back({{"bufferView", view}, {"mimeType", mimeType}});
+            gltf["textures"].push_back({{"source", gltf["images"].size() - 1}});
+            it = textureIndex.emplace(path, gltf["textures"].size() - 1).first;
+        } else if (it == textureIndex.end()) {
+            fs::path image = sourceDirectory / fs::path(path);
+            std::error_code error;
+            const fs::path relative = fs::relative(image, outputDirectory, error);
+            const std::string uri = (error || relative.empty()) ? path : relative.generic_string();
+            gltf["images"].push_back({{"uri", encodeURI(uri)}});
+            gltf["textures"].push_back({{"source", gltf["images"].size() - 1}});
+            it = textureIndex.emplace(path, gltf["textures"].size() - 1).first;
+        }
+        return {{"index", it->second}};
+    };
+
+    bool usesEmissiveStrength = false;
+    for (const auto& material : sceneData.materials) {
+        nlohmann::json pbr = {
+            {"baseColorFactor", {material.albedo.x, material.albedo.y, material.albedo.z, material.alpha}},
+            {"metallicFactor", material.metallic},
+            {"roughnessFactor", material.roughness}
+        };
+        nlohmann::json out = {{"name", material.name}};
+        if (material.alphaMode == "MASK" || material.alphaMode == "BLEND") {
+            out["alphaMode"] = material.alphaMode;
+        }
+        if (material.alphaMode == "MASK") {
+            out["alphaCutoff"] = material.alphaCutoff;
+        }
+        if (material.doubleSided) {
+            out["doubleSided"] = true;
+        }
+        // The factor is limited to [0, 1]; brighter emission moves into
+        // KHR_materials_emissive_strength
+        const float strength = std::max({material.emissive.x, material.emissive.y, material.emissive.z});
+        if (strength > 0.0f) {
+            const glm::vec3 factor = strength > 1.0f ? material.emissive / strength : material.emissive;
+            out["emissiveFactor"] = {factor.x, factor.y, factor.z};
+            if (strength > 1.0f) {
+                out["extensions"]["KHR_materials_emissive_strength"] = {{"emissiveStrength", strength}};
+                usesEmissiveStrength = true;
+            }
+        }
+        nlohmann::json texture;
+        if (!(texture = textureFor(material.albedoTexture)).is_null()) {
+            pbr["baseColorTexture"] = texture;
+        }
+        if (!(texture = textureFor(material.metallicRoughnessTexture)).is_null()) {
+            pbr["metallicRoughnessTexture"] = texture;
+        }
+        if (!(texture = textureFor(material.normalTexture)).is_null()) {
+            out["normalTexture"] = texture;
+        }
+        if (!(texture = textureFor(material.occlusionTexture)).is_null()) {
+            out["occlusionTexture"] = texture;
+        }
+        if (!(texture = textureFor(material.emissiveTexture)).is_null()) {
+            out["emissiveTexture"] = texture;
+        }
+        out["pbrMetallicRoughness"] = pbr;
+        gltf["materials"].push_back(out);
+    }
+
+    // Appends one single-primitive mesh and returns its index
+    auto addMesh = [&](const MeshData& mesh) -> size_t {
+        const size_t vertexCount = mesh.vertices.size();
+        nlohmann::json primitive = {{"attributes", nlohmann::json::object()}, {"mode", 4}};
+
+        glm::vec3 minimum(FLT_MAX), maximum(-FLT_MAX);
+        for (const auto& p : mesh.vertices) {
+            minimum = glm::min(minimum, p);
+            maximum = glm::max(maximum, p);
+        }
+        size_t view = buffer.addView(mesh.vertices.data(), vertexCount * sizeof(glm::vec3), kArrayBuffer);
+        size_t accessor = buffer.addAccessor(view, kFloat, vertexCount, "VEC3");
+        gltf["accessors"][accessor]["min"] = {minimum.x, minimum.y, minimum.z};
+        gltf["accessors"][accessor]["max"] = {maximum.x, maximum.y, maximum.z};
+        primitive["attributes"]["POSITION"] = accessor;
+
+        const bool hasNormals = mesh.normals.size() == vertexCount;
+        if (hasNormals) {
+            view = buffer.addView(mesh.normals.data(), vertexCount * sizeof(glm::vec3), kArrayBuffer);
+            primitive["attributes"]["NORMAL"] = buffer.addAccessor(view, kFloat, vertexCount, "VEC3");
+        }
+        // glTF tangents are unit XYZ plus the handedness in W, with the
+        // bitangent rebuilt as cross(normal, tangent) * w; unusable ones
+        // get an arbitrary unit direction
+        if (hasNormals && mesh.tangents.size() == vertexCount && mesh.bitangents.size() == vertexCount) {
+            std::vector<glm::vec4> tangents(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i) {
+                const glm::vec3& t = mesh.tangents[i];
+                const float length = glm::length(t);
+                const bool usable = length > 0.0f && std::isfinite(length);
+                const glm::vec3 direction = usable ? t / length : glm::vec3(1.0f, 0.0f, 0.0f);
+                const float w = glm::dot(glm::cross(mesh.normals[i], t), mesh.bitangents[i]) < 0.0f ? -1.0f : 1.0f;
+                tangents[i] = glm::vec4(direction, w);
+            }
+            view = buffer.addView(tangents.data(), vertexCount * sizeof(glm::vec4), kArrayBuffer);
+            primitive["attributes"]["TANGENT"] = buffer.addAccessor(view, kFloat, vertexCount, "VEC4");
+        }
+        // The loader's UVs already use glTF's top-left origin
+        if (mesh.uvCoords.size() == vertexCount) {
+            view = buffer.addView(mesh.uvCoords.data(), vertexCount * sizeof(glm::vec2), kArrayBuffer);
+            primitive["attributes"]["TEXCOORD_0"] = buffer.addAccessor(view, kFloat, vertexCount, "VEC2");
+        }
+
+        if (!mesh.indices.empty()) {
+            if (vertexCount <= 0xFFFF) {
+                std::vector<uint16_t> narrow(mesh.indices.begin(), mesh.indices.end());
+                view = buffer.addView(narrow.data(), narrow.size() * sizeof(uint16_t), kElementArrayBuffer);
+                primitive["indices"] = buffer.addAccessor(view, kUnsignedShort, narrow.size(), "SCALAR");
+            } else {
+                view = buffer.addView(mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t), kElementArrayBuffer);
+                primitive["indices"] = buffer.addAccessor(view, kUnsignedInt, mesh.indices.size(), "SCALAR");
+            }
+        }
+        if (!mesh.materialIndices.empty() && mesh.materialIndices[0] < sceneData.materials.size()) {
+            primitive["material"] = mesh.materialIndices[0];
+        }
+
+        gltf["meshes"].push_back({{"name", mesh.name}, {"primitives", nlohmann::json::array({primitive})}});
+        return gltf["meshes"].size() - 1;
+    };
+
+    // Appends a node for a mesh, placed by transform, and returns its index
+    auto addNode = [&](const std::string& name, size_t mesh, const glm::mat4& transform) -> size_t {
+        gltf["nodes"].push_back({{"name", name}, {"mesh", mesh}});
+        if (transform != glm::mat4(1.0f)) {
+            // Column-major, like glm
+            nlohmann::json matrix = nlohmann::json::array();
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 4; ++row) {
+                    matrix.push_back(transform[column][row]);
+                }
+            }
+            gltf["nodes"].back()["matrix"] = matrix;
+        }
+        return gltf["nodes"].size() - 1;
+    };
+
+    // Meshes sharing a source mesh are node instances of one file mesh:
+    // the first instance's geometry and levels are written once and every
+    // instance's node points at them
+    struct WrittenMesh {
+        size_t mesh;
+        std::vector<size_t> lods;
+    };
+    std::map<uint32_t, WrittenMesh> writtenBySource;
+    bool usesLods = false;
+    for (size_t m = 0; m < sceneData.meshes.size(); ++m) {
+        const MeshData& mesh = sceneData.meshes[m];
+        // An accessor needs at least one element
+        if (mesh.vertices.empty()) {
+            continue;
+        }
+        const bool instanced = mesh.sourceMesh != MeshData::kNoSourceMesh;
+        auto written = instanced ? writtenBySource.find(mesh.sourceMesh) : writtenBySource.end();
+        WrittenMesh meshes;
+        if (written != writtenBySource.end()) {
+            meshes = written->second;
+        } else {
+            meshes.mesh = addMesh(mesh);
+            if (includeLods && m < sceneData.meshLods.size()) {
+                for (const auto& lod : sceneData.meshLods[m]) {
+                    if (!lod.vertices.empty()) {
+                        meshes.lods.push_back(addMesh(lod));
+                    }
+                }
+            }
+            if (instanced) {
+                writtenBySource.emplace(mesh.sourceMesh, meshes);
+            }
+        }
+
+        const size_t node = addNode(mesh.name, meshes.mesh, mesh.worldTransform);
+        gltf["scenes"][0]["nodes"].push_back(node);
+
+        // Levels are nodes outside the scene, listed on the base node from
+        // finest to coarsest, and placed like it
+        if (!meshes.lods.empty()) {
+            nlohmann::json ids = nlohmann::json::array();
+            for (size_t lod : meshes.lods) {
+                ids.push_back(addNode(gltf["meshes"][lod]["name"].get<std::string>(), lod, mesh.worldTransform));
+            }
+            gltf["nodes"][node]["extensions"]["MSFT_lod"] = {{"ids", ids}};
+            usesLods = true;
+        }
+    }
+    if (usesLods) {
+        gltf["extensionsUsed"].push_back("MSFT_lod");
+    }
+    if (usesEmissiveStrength) {
+        gltf["extensionsUsed"].push_back("KHR_materials_emissive_strength");
+    }
+
+    // A buffer must not be empty, so a scene without geometry has none
+    while (buffer.bytes.size() % 4 != 0) {
+        buffer.bytes.push_back(0);
+    }
+    const bool hasBuffer = !buffer.bytes.empty();
+    if (hasBuffer) {
+        gltf["buffers"] = nlohmann::json::array({{{"byteLength", buffer.bytes.size()}}});
+    }
+
+    if (binary) {
+        std::string json = gltf.dump();
+        while (json.size() % 4 != 0) {
+            json += ' ';
+        }
+        const size_t binChunkSize = hasBuffer ? 8 + buffer.bytes.size() : 0;
+        std::vector<uint8_t> glb;
+        glb.reserve(20 + json.size() + binChunkSize);
+        appendU32(glb, kGlbMagic);
+        appendU32(glb, 2);
+        appendU32(glb, static_cast<uint32_t>(20 + json.size() + binChunkSize));
+        appendU32(glb, static_cast<uint32_t>(json.size()));
+        appendU32(glb, kGlbJsonChunk);
+        glb.insert(glb.end(), json.begin(), json.end());
+        if (hasBuffer) {
+            appendU32(glb, static_cast<uint32_t>(buffer.bytes.size()));
+            appendU32(glb, kGlbBinChunk);
+            glb.insert(glb.end(), buffer.bytes.begin(), buffer.bytes.end());
+        }
+
+        if (!writeBytes(outputPath, glb)) {
+            lastError = "Cannot write file: " + outputPath;
+            return false;
+        }
+        writtenBytes = glb.size();
+    } else {
+        fs::path binPath = output;
+        binPath.replace_extension(".bin");
+        if (hasBuffer) {
+            gltf["buffers"][0]["uri"] = encodeURI(binPath.filename().string());
+            if (!writeBytes(binPath.string(), buffer.bytes)) {
+                lastError = "Cannot write file: " + binPath.string();
+                return false;
+            }
+        }
+        const std::string json = gltf.dump(2);
+
+        if (!writeBytes(outputPath, std::vector<uint8_t>(json.begin(), json.end()))) {
+            lastError = "Cannot write file: " + outputPath;
+            return false;
+        }
+        writtenBytes = json.size() + buffer.bytes.size();
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+#include "GpuMemoryEstimator.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+    struct FormatInfo {
+        GpuTextureFormat format;
+        const char* name;
+        uint32_t blockWidth;
+        uint32_t blockHeight;
+        uint32_t blockBytes;
+    };
+
+    const FormatInfo kFormats[] = {
+        {GpuTextureFormat::RGBA8, "rgba8", 1, 1, 4},
+        {GpuTextureFormat::BC1, "bc1", 4, 4, 8},
+        {GpuTextureFormat::BC4, "bc4", 4, 4, 8},
+        {GpuTextureFormat::BC5, "bc5", 4, 4, 16},
+        {GpuTextureFormat::BC7, "bc7", 4, 4, 16},
+        {GpuTextureFormat::ASTC4x4, "astc_4x4", 4, 4, 16},
+        {GpuTextureFormat::ASTC6x6, "astc_6x6", 6, 6, 16},
+        {GpuTextureFormat::ASTC8x8, "astc_8x8", 8, 8, 16}
+    };
+
+    const FormatInfo& formatInfo(GpuTextureFormat format) {
+        for (const auto& info : kFormats) {
+            if (info.format == format) {
+                return info;
+            }
+        }
+        return kFormats[0];
+    }
+}
+
+GpuMemoryEstimator::GpuMemoryEstimator(GpuTextureFormat colorFormat, GpuTextureFormat normalFormat, bool mipChains)
+    : colorFormat(colorFormat), normalFormat(normalFormat), mipChains(mipChains) {}
+
+GpuMemoryEstimate GpuMemoryEstimator::estimateMesh(const MeshData& mesh) const {
+    GpuMemoryEstimate estimate;
+    estimate.vertexStride = vertexStride(mesh);
+    estimate.indexSize = indexSize(mesh.vertices.size());
+    estimate.vertexBytes = uint64_t(estimate.vertexStride) * mesh.vertices.size();
+    estimate.indexBytes = uint64_t(estimate.indexSize) * mesh.indices.size();
+    estimate.bytes = estimate.vertexBytes + estimate.indexBytes;
+    return estimate;
+}
+
+GpuMemoryEstimate GpuMemoryEstimator::estimateTexture(const TextureData& texture) const {
+    GpuMemoryEstimate estimate;
+    estimate.format = texture.isNormalMap ? normalFormat : colorFormat;
+    estimate.bytes = textureBytes(texture.width, texture.height, estimate.format, mipChains, &estimate.mipLevels);
+    return estimate;
+}
+
+uint64_t GpuMemoryEstimator::textureBytes(uint32_t width, uint32_t height, GpuTextureFormat format, bool mipChain,
+                                          uint32_t* mipLevels) {
+    const FormatInfo& info = formatInfo(format);
+    uint64_t bytes = 0;
+    uint32_t levels = 0;
+    while (width > 0 && height > 0) {
+        const uint64_t blocksWide = (width + info.blockWidth - 1) / info.blockWidth;
+        const uint64_t blocksHigh = (height + info.blockHeight - 1) / info.blockHeight;
+        bytes += blocksWide * blocksHigh * info.blockBytes;
+        ++levels;
+        if (!mipChain || (width == 1 && height == 1)) {
+            break;
+        }
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    if (mipLevels) {
+        *mipLevels = levels;
+    }
+    return bytes;
+}
+
+uint32_t GpuMemoryEstimator::vertexStride(const MeshData& mesh) {
+    uint32_t stride = sizeof(glm::vec3);
+    if (mesh.normals.size() == mesh.vertices.size()) {
+        stride += sizeof(glm::vec3);
+    }
+    if (mesh.uvCoords.size() == mesh.vertices.size()) {
+        stride += sizeof(glm::vec2);
+    }
+    if (mesh.tangents.size() == mesh.vertices.size()) {
+        stride += sizeof(glm::vec3);
+    }
+    if (mesh.bitangents.size() == mesh.vertices.size()) {
+        stride += sizeof(glm::vec3);
+    }
+    return stride;
+}
+
+GpuTextureFormat GpuMemoryEstimator::parseFormat(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (const auto& info : kFormats) {
+        if (lower == info.name) {
+            return info.format;
+        }
+    }
+    throw std::invalid_argument("Unknown GPU texture format '" + name +
+                                "' (expected rgba8, bc1, bc4, bc5, bc7, astc_4x4, astc_6x6 or astc_8x8)");
+}
+
+const char* GpuMemoryEstimator::formatName(GpuTextureFormat format) {
+    return formatInfo(format).name;
+}
@@ -0,0 +1,179 @@
+#include "HiddenGeometryAnalyzer.h"
+#include "ThreadPool.h"
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Ray casting costs far more per triangle than the linear passes, so
+    // chunks are smaller to keep the pool balanced
+    const size_t kTrianglesPerChunk = 1 << 12;
+    const int kSamplePoints = 4;
+    const float kGoldenAngle = 2.39996323f;
+
+    // Offset of ray origins off the surface, relative to the scene diagonal
+    const float kRelativeOffset = 1e-4f;
+
+    // Unit directions spread evenly over the sphere
+    std::vector<glm::vec3> fibonacciSphere(uint32_t count) {
+        std::vector<glm::vec3> result(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const float z = 1.0f - (2.0f * i + 1.0f) / count;
+            const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+            const float phi = kGoldenAngle * i;
+            result[i] = glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+        }
+        return result;
+    }
+
+    glm::vec3 toWorld(const glm::mat4& m, const glm::vec3& p) {
+        return glm::vec3(m[0][0] * p.x + m[1][0] * p.y + m[2][0] * p.z + m[3][0],
+                         m[0][1] * p.x + m[1][1] * p.y + m[2][1] * p.z + m[3][1],
+                         m[0][2] * p.x + m[1][2] * p.y + m[2][2] * p.z + m[3][2]);
+    }
+}
+
+HiddenGeometryAnalyzer::HiddenGeometryAnalyzer(uint32_t directions) : directions(directions) {}
+
+HiddenGeometryResult HiddenGeometryAnalyzer::analyze(const SceneData& scene, ThreadPool& pool) const {
+    HiddenGeometryResult result;
+    result.analyzed = true;
+    result.directions = directions;
+
+    // World-space triangle soup; triangle ids run through the meshes in
+    // scene order. Triangles with out-of-range indices or non-finite
+    // corners collapse to a degenerate one at the origin, which nothing hits.
+    std::vector<uint64_t> meshStart(scene.meshes.size() + 1, 0);
+    for (size_t m = 0; m < scene.meshes.size(); ++m) {
+        meshStart[m + 1] = meshStart[m] + scene.meshes[m].indices.size() / 3;
+    }
+    const uint64_t triangleCount = meshStart.back();
+    result.sceneTriangles = triangleCount;
+    if (triangleCount == 0 || triangleCount >= TriangleBVH::kNoTriangle) {
+        return result;
+    }
+
+    std::vector<glm::vec3> corners(triangleCount * 3);
+    pool.parallelFor(scene.meshes.size(), [&](size_t m) {
+        const MeshData& mesh = scene.meshes[m];
+        const size_t vertexCount = mesh.vertices.size();
+        glm::vec3* out = &corners[meshStart[m] * 3];
+        for (size_t t = 0; t < mesh.indices.size() / 3; ++t) {
+            bool valid = true;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t index = mesh.indices[t * 3 + k];
+                if (index >= vertexCount) {
+                    valid = false;
+                    break;
+                }
+                const glm::vec3 p = toWorld(mesh.worldTransform, mesh.vertices[index]);
+                valid = valid && std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+                out[t * 3 + k] = p;
+            }
+            if (!valid) {
+                out[t * 3] = out[t * 3 + 1] = out[t * 3 + 2] = glm::vec3(0.0f);
+            }
+        }
+    });
+
+    glm::vec3 sceneMin(std::numeric_limits<float>::max()), sceneMax(-std::numeric_limits<float>::max());
+    for (const glm::vec3& p : corners) {
+        sceneMin = glm::min(sceneMin, p);
+        sceneMax = glm::max(sceneMax, p);
+    }
+    const float offset = std::max(glm::length(sceneMax - sceneMin) * kRelativeOffset,
+                                  std::numeric_limits<float>::min());
+
+    TriangleBVH bvh;
+    bvh.build(corners, pool);
+    result.bvhNodes = static_cast<uint32_t>(bvh.getNodes().size());
+
+    const std::vector<glm::vec3> sphere = fibonacciSphere(directions);
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // 0 = not tested, 1 = visible, 2 = hidden
+    std::vector<uint8_t> state(triangleCount, 0);
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    std::vector<uint64_t> chunkRays(chunkCount, 0);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min<size_t>(triangleCount, begin + kTrianglesPerChunk);
+        uint64_t rays = 0;
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& a = corners[t * 3];
+            const glm::vec3& b = corners[t * 3 + 1];
+            const glm::vec3& c = corners[t * 3 + 2];
+            const glm::vec3 normalRaw = glm::cross(b - a, c - a);
+            const float normalLength = glm::length(normalRaw);
+            if (!(normalLength > 0.0f) || !std::isfinite(normalLength)) {
+                continue;
+            }
+            const glm::vec3 normal = normalRaw / normalLength;
+            const glm::vec3 samples[kSamplePoints] = {
+                (a + b + c) / 3.0f,
+                a * (4.0f / 6.0f) + (b + c) * (1.0f / 6.0f),
+                b * (4.0f / 6.0f) + (a + c) * (1.0f / 6.0f),
+                c * (4.0f / 6.0f) + (a + b) * (1.0f / 6.0f)
+            };
+
+            auto escapes = [&](const glm::vec3& direction) {
+                const float facing = glm::dot(direction, normal);
+                if (facing == 0.0f) {
+                    return false;
+                }
+                const glm::vec3 lift = normal * (facing > 0.0f ? offset : -offset);
+                for (const glm::vec3& sample : samples) {
+                    ++rays;
+                    if (!bvh.occluded(sample + lift, direction, 0.0f, inf, static_cast<uint32_t>(t))) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            bool visible = escapes(normal) || escapes(-normal);
+            for (size_t d = 0; d < sphere.size() && !visible; ++d) {
+                visible = escapes(sphere[d]);
+            }
+            state[t] = visible ? 1 : 2;
+        }
+        chunkRays[chunk] = rays;
+    });
+    for (uint64_t rays : chunkRays) {
+        result.raysCast += rays;
+    }
+
+    for (size_t m = 0; m < scene.meshes.size(); ++m) {
+        HiddenMeshResult mesh;
+        mesh.mesh = static_cast<uint32_t>(m);
+        mesh.triangles = meshStart[m + 1] - meshStart[m];
+        uint64_t tested = 0;
+        for (uint64_t t = meshStart[m]; t < meshStart[m + 1]; ++t) {
+            if (state[t] == 0) {
+                continue;
+            }
+            tested++;
+            if (state[t] == 2) {
+                if (mesh.hiddenSamples.size() < HiddenMeshResult::kMaxListed) {
+                    mesh.hiddenSamples.push_back(static_cast<uint32_t>(t - meshStart[m]));
+                }
+                mesh.hiddenTriangles++;
+            }
+        }
+        result.testedTriangles += tested;
+        result.hiddenTriangles += mesh.hiddenTriangles;
+        if (mesh.hiddenTriangles > 0) {
+            mesh.hiddenPercentage = 100.0f * mesh.hiddenTriangles / tested;
+            result.meshes.push_back(std::move(mesh));
+        }
+    }
+    if (result.testedTriangles > 0) {
+        result.hiddenPercentage = 100.0f * result.hiddenTriangles / result.testedTriangles;
+    }
+    std::stable_sort(result.meshes.begin(), result.meshes.end(),
+                     [](const HiddenMeshResult& a, const HiddenMeshResult& b) {
+                         return a.hiddenTriangles > b.hiddenTriangles;
+                     });
+    return result;
+}
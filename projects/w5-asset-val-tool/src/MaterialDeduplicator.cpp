@@ -0,0 +1,188 @@
+#include "MaterialDeduplicator.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // FNV-1a; canonical forms are short
+    uint64_t fnv1a(const std::string& text) {
+        uint64_t h = 0xCBF29CE484222325ull;
+        for (unsigned char c : text) {
+            h = (h ^ c) * 0x100000001B3ull;
+        }
+        return h;
+    }
+
+    std::string percentDecode(const std::string& uri) {
+        std::string decoded;
+        decoded.reserve(uri.size());
+        for (size_t i = 0; i < uri.size(); ++i) {
+            if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+                std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+                decoded += static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            } else {
+                decoded += uri[i];
+            }
+        }
+        return decoded;
+    }
+
+    // Absolute, so runs from different working directories agree
+    std::filesystem::path absoluteScenePath(const std::string& sceneFile) {
+        std::error_code error;
+        const std::filesystem::path absolute = std::filesystem::absolute(sceneFile, error);
+        return (error ? std::filesystem::path(sceneFile) : absolute).lexically_normal();
+    }
+
+    std::string canonicalPath(const std::string& texture, const std::filesystem::path& sceneFile) {
+        if (texture.empty()) {
+            return "";
+        }
+        if (texture[0] == '*') {
+            // Embedded: only the same file can share it
+            return sceneFile.generic_string() + texture;
+        }
+        std::string path = percentDecode(texture);
+        std::replace(path.begin(), path.end(), '\\', '/');
+        std::filesystem::path resolved(path);
+        if (resolved.is_relative()) {
+            resolved = sceneFile.parent_path() / resolved;
+        }
+        return resolved.lexically_normal().generic_string();
+    }
+}
+
+MaterialDeduplicator::MaterialDeduplicator(uint32_t factorSteps) : factorSteps(std::max(1u, factorSteps)) {}
+
+std::string MaterialDeduplicator::canonicalize(const MaterialData& material, const std::string& sceneFile) const {
+    const auto quantize = [&](float value) {
+        // NaN becomes 0, like a missing factor
+        const float clamped = std::isnan(value) ? 0.0f : std::clamp(value, 0.0f, 1.0f);
+        return static_cast<uint32_t>(std::lround(clamped * factorSteps));
+    };
+    // Emissive strength scales the factor past 1
+    const auto quantizeEmissive = [&](float value) {
+        const float clamped = std::isnan(value) ? 0.0f : std::clamp(value, 0.0f, 1e6f);
+        return static_cast<uint64_t>(std::llround(static_cast<double>(clamped) * factorSteps));
+    };
+    // Opaque materials ignore alpha, and only MASK uses the cutoff
+    std::string alpha = "OPAQUE";
+    if (material.alphaMode == "MASK") {
+        alpha = fmt::format("MASK,{},{}", quantize(material.alpha), quantize(material.alphaCutoff));
+    } else if (material.alphaMode == "BLEND") {
+        alpha = fmt::format("BLEND,{}", quantize(material.alpha));
+    }
+    const std::filesystem::path scene = absoluteScenePath(sceneFile);
+    return fmt::format("albedo={},{},{};alpha={};metallic={};roughness={};emissive={},{},{};double_sided={};"
+                       "albedo_tex={};normal_tex={};mr_tex={};emissive_tex={};occlusion_tex={}",
+                       quantize(material.albedo.x), quantize(material.albedo.y), quantize(material.albedo.z), alpha,
+                       quantize(material.metallic), quantize(material.roughness),
+                       quantizeEmissive(material.emissive.x), quantizeEmissive(material.emissive.y),
+                       quantizeEmissive(material.emissive.z), material.doubleSided ? 1 : 0,
+                       canonicalPath(material.albedoTexture, scene), canonicalPath(material.normalTexture, scene),
+                       canonicalPath(material.metallicRoughnessTexture, scene),
+                       canonicalPath(material.emissiveTexture, scene), canonicalPath(material.occlusionTexture, scene));
+}
+
+uint64_t MaterialDeduplicator::hashCanonical(const std::string& canonical) {
+    return fnv1a(canonical);
+}
+
+MaterialDedupResult MaterialDeduplicator::analyze(const SceneData& scene) const {
+    MaterialDedupResult result;
+    result.materialCount = static_cast<uint32_t>(scene.materials.size());
+
+    std::unordered_map<std::string, uint32_t> groupByForm;
+    for (uint32_t m = 0; m < scene.materials.size(); ++m) {
+        std::string canonical = canonicalize(scene.materials[m], scene.filePath);
+        const uint64_t hash = hashCanonical(canonical);
+        const auto inserted = groupByForm.emplace(std::move(canonical), static_cast<uint32_t>(result.groups.size()));
+        if (inserted.second) {
+            MaterialDedupGroup group;
+            group.hash = hash;
+            result.groups.push_back(std::move(group));
+        }
+        result.groups[inserted.first->second].materials.push_back(m);
+    }
+    result.uniqueMaterials = static_cast<uint32_t>(result.groups.size());
+    return result;
+}
+
+void MaterialDeduplicator::matchIndex(const SceneData& scene, MaterialDedupResult& result, MaterialIndex& index) const {
+    const std::string sceneFile = absoluteScenePath(scene.filePath).generic_string();
+    for (auto& group : result.groups) {
+        const MaterialData& kept = scene.materials[group.materials[0]];
+        const std::string canonical = canonicalize(kept, scene.filePath);
+        const MaterialIndex::Entry* known = index.find(group.hash, canonical);
+        if (known && known->file != sceneFile) {
+            group.indexFile = known->file;
+            group.indexMaterial = known->material;
+            result.indexMatches++;
+        }
+        if (!known) {
+            index.add(group.hash, {canonical, sceneFile, kept.name});
+        }
+    }
+}
+
+void MaterialIndex::load(const std::string& path) {
+    entries.clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        nlohmann::json j;
+        file >> j;
+        for (const auto& entry : j.at("materials")) {
+            const std::string canonical = entry.at("canonical");
+            add(MaterialDeduplicator::hashCanonical(canonical), {canonical, entry.at("file"), entry.at("material")});
+        }
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to read material index '" + path + "': " + e.what());
+    }
+}
+
+void MaterialIndex::save(const std::string& path) const {
+    // Sorted so the file diffs cleanly between runs
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sorted.push_back(&entry.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+        return a->canonical < b->canonical;
+    });
+
+    nlohmann::json materials = nlohmann::json::array();
+    for (const Entry* entry : sorted) {
+        materials.push_back({{"canonical", entry->canonical}, {"file", entry->file}, {"material", entry->material}});
+    }
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create material index: " + path);
+    }
+    file << nlohmann::json{{"materials", materials}}.dump(4);
+}
+
+const MaterialIndex::Entry* MaterialIndex::find(uint64_t hash, const std::string& canonical) const {
+    const auto range = entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.canonical == canonical) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+void MaterialIndex::add(uint64_t hash, const Entry& entry) {
+    if (!find(hash, entry.canonical)) {
+        entries.emplace(hash, entry);
+    }
+}
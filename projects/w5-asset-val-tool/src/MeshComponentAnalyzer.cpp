@@ -0,0 +1,210 @@
+#include "MeshComponentAnalyzer.h"
+#include "ConcurrentUnionFind.h"
+#include "EdgeAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+    const size_t kTrianglesPerChunk = 1 << 16;
+    const uint32_t kNoComponent = UINT32_MAX;
+
+    uint64_t mix64(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Triangle count and exact box bits; equal keys mean stacked shells
+    uint64_t shellKey(const MeshComponent& component) {
+        float corners[6] = {component.min.x, component.min.y, component.min.z,
+                            component.max.x, component.max.y, component.max.z};
+        uint64_t hash = mix64(component.triangles);
+        for (float corner : corners) {
+            uint32_t bits;
+            corner += 0.0f; // Fold -0 into +0
+            std::memcpy(&bits, &corner, sizeof(bits));
+            hash = mix64(hash ^ bits);
+        }
+        return hash;
+    }
+
+    bool sameShell(const MeshComponent& a, const MeshComponent& b) {
+        return a.triangles == b.triangles && a.min == b.min && a.max == b.max;
+    }
+
+    bool isFinite(const glm::vec3& p) {
+        return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+    }
+}
+
+MeshComponentAnalyzer::MeshComponentAnalyzer(uint32_t minTriangles, float minVolumeRatio)
+    : minTriangles(minTriangles), minVolumeRatio(std::max(0.0f, minVolumeRatio)) {}
+
+MeshComponentResult MeshComponentAnalyzer::analyze(const std::vector<glm::vec3>& vertices,
+                                                   const std::vector<uint32_t>& indices,
+                                                   ThreadPool& pool) const {
+    MeshComponentResult result;
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return result;
+    }
+
+    // Shells connect through welded positions; stacked copies are looked
+    // for among the pieces connected through the raw indices, since a copy
+    // on top of its original shares every position with it
+    const std::vector<uint32_t> positionId = EdgeAdjacency::weldPositions(vertices, pool);
+    ConcurrentUnionFind shells(vertexCount);
+    ConcurrentUnionFind pieces(vertexCount);
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+                continue;
+            }
+            shells.unite(positionId[i0], positionId[i1]);
+            shells.unite(positionId[i1], positionId[i2]);
+            pieces.unite(i0, i1);
+            pieces.unite(i1, i2);
+        }
+    });
+
+    // Number both by first triangle and gather their boxes
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<uint32_t> componentOf(vertexCount, kNoComponent);
+    std::vector<uint32_t> pieceOf(vertexCount, kNoComponent);
+    std::vector<MeshComponent> components;
+    std::vector<MeshComponent> pieceList;
+    std::vector<uint32_t> pieceComponent; // Shell holding each piece
+    auto open = [&](std::vector<MeshComponent>& list, uint32_t& id, size_t t) {
+        if (id == kNoComponent) {
+            id = static_cast<uint32_t>(list.size());
+            list.emplace_back();
+            list.back().firstTriangle = static_cast<uint32_t>(t);
+            list.back().min = glm::vec3(inf);
+            list.back().max = glm::vec3(-inf);
+        }
+        return &list[id];
+    };
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            continue;
+        }
+        uint32_t& componentId = componentOf[shells.find(positionId[i0])];
+        MeshComponent* component = open(components, componentId, t);
+        uint32_t& pieceId = pieceOf[pieces.find(i0)];
+        if (pieceId == kNoComponent) {
+            pieceComponent.push_back(componentId);
+        }
+        MeshComponent* piece = open(pieceList, pieceId, t);
+        for (MeshComponent* target : {component, piece}) {
+            target->triangles++;
+            for (uint32_t index : {i0, i1, i2}) {
+                if (isFinite(vertices[index])) {
+                    target->min = glm::min(target->min, vertices[index]);
+                    target->max = glm::max(target->max, vertices[index]);
+                }
+            }
+        }
+    }
+    result.componentCount = static_cast<uint32_t>(components.size());
+    if (components.empty()) {
+        return result;
+    }
+
+    glm::vec3 meshMin(inf), meshMax(-inf);
+    size_t largest = 0;
+    for (size_t c = 0; c < components.size(); ++c) {
+        MeshComponent& component = components[c];
+        if (component.min.x > component.max.x) {
+            component.min = component.max = glm::vec3(0.0f); // No finite vertex
+        } else {
+            meshMin = glm::min(meshMin, component.min);
+            meshMax = glm::max(meshMax, component.max);
+        }
+        if (component.triangles > components[largest].triangles) {
+            largest = c;
+        }
+        size_t bin = 0;
+        while ((uint64_t(2) << bin) <= component.triangles) {
+            ++bin;
+        }
+        if (result.sizeHistogram.size() <= bin) {
+            result.sizeHistogram.resize(bin + 1, 0);
+        }
+        result.sizeHistogram[bin]++;
+    }
+    result.largestTriangles = components[largest].triangles;
+
+    // Sphere volumes scale with the cube of the box diagonal
+    const double meshDiagonal = meshMin.x <= meshMax.x ? glm::length(glm::dvec3(meshMax - meshMin)) : 0.0;
+    auto volumeRatio = [&](const MeshComponent& component) {
+        const double diagonal = glm::length(glm::dvec3(component.max - component.min));
+        const double ratio = meshDiagonal > 0.0 ? diagonal / meshDiagonal : 1.0;
+        return static_cast<float>(ratio * ratio * ratio);
+    };
+
+    std::vector<MeshComponent> candidates;
+    std::vector<uint8_t> isDebris(components.size(), 0);
+    for (size_t c = 0; c < components.size(); ++c) {
+        MeshComponent& component = components[c];
+        component.volumeRatio = volumeRatio(component);
+        if (c != largest && (component.triangles < minTriangles || component.volumeRatio < minVolumeRatio)) {
+            isDebris[c] = 1;
+            result.debrisComponents++;
+            result.debrisTriangles += component.triangles;
+            candidates.push_back(component);
+        }
+    }
+
+    // A piece repeating an earlier piece's triangle count and exact box is
+    // a stacked copy, unless its shell is already going as debris
+    std::unordered_multimap<uint64_t, uint32_t> seen;
+    for (size_t p = 0; p < pieceList.size(); ++p) {
+        MeshComponent& piece = pieceList[p];
+        if (piece.min.x > piece.max.x) {
+            continue;
+        }
+        const uint64_t key = shellKey(piece);
+        auto range = seen.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (sameShell(pieceList[it->second], piece)) {
+                piece.duplicateOf = pieceList[it->second].firstTriangle;
+                break;
+            }
+        }
+        if (piece.duplicateOf == MeshComponent::kNotDuplicate) {
+            seen.emplace(key, static_cast<uint32_t>(p));
+        } else if (!isDebris[pieceComponent[p]]) {
+            piece.volumeRatio = volumeRatio(piece);
+            result.duplicateShells++;
+            result.duplicateTriangles += piece.triangles;
+            candidates.push_back(piece);
+        }
+    }
+    auto byTriangles = [](const MeshComponent& a, const MeshComponent& b) {
+        return a.triangles != b.triangles ? a.triangles > b.triangles : a.firstTriangle < b.firstTriangle;
+    };
+    const size_t keepLargest = std::min(components.size(), MeshComponentResult::kMaxListed);
+    std::partial_sort(components.begin(), components.begin() + keepLargest, components.end(), byTriangles);
+    result.largestComponents.assign(components.begin(), components.begin() + keepLargest);
+
+    const size_t keepCandidates = std::min(candidates.size(), MeshComponentResult::kMaxListed);
+    std::partial_sort(candidates.begin(), candidates.begin() + keepCandidates, candidates.end(),
+                      [](const MeshComponent& a, const MeshComponent& b) {
+                          return a.triangles != b.triangles ? a.triangles < b.triangles
+                                                            : a.firstTriangle < b.firstTriangle;
+                      });
+    result.removalCandidates.assign(candidates.begin(), candidates.begin() + keepCandidates);
+    return result;
+}
@@ -0,0 +1,234 @@
+#include "MeshOptimizer.h"
+#include "DuplicateVertexDetector.h"
+#include "GpuMemoryEstimator.h"
+#include "ThreadPool.h"
+#include <unordered_map>
+
+namespace {
+    const uint32_t kUnassigned = 0xFFFFFFFFu;
+
+    template <typename T>
+    void permute(std::vector<T>& stream, const std::vector<uint32_t>& newIndex, uint32_t newCount) {
+        if (stream.size() != newIndex.size()) {
+            stream.clear();
+            return;
+        }
+        std::vector<T> reordered(newCount);
+        for (size_t v = 0; v < newIndex.size(); ++v) {
+            if (newIndex[v] != kUnassigned) {
+                reordered[newIndex[v]] = stream[v];
+            }
+        }
+        stream.swap(reordered);
+    }
+}
+
+MeshOptimizer::MeshOptimizer(float weldPositionTolerance, float weldAttributeTolerance,
+                             VertexCacheModel cacheModel, uint32_t cacheSize)
+    : weldPositionTolerance(weldPositionTolerance), weldAttributeTolerance(weldAttributeTolerance),
+      cacheModel(cacheModel), cacheSize(cacheSize) {}
+
+uint64_t MeshOptimizer::geometryBytes(const MeshData& mesh) {
+    return GpuMemoryEstimator::vertexStride(mesh) * uint64_t(mesh.vertices.size()) +
+           GpuMemoryEstimator::indexSize(mesh.vertices.size()) * uint64_t(mesh.indices.size());
+}
+
+std::vector<uint32_t> MeshOptimizer::reorderForVertexCache(const std::vector<uint32_t>& indices,
+                                                           size_t vertexCount, uint32_t cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+
+    // Vertex -> triangle adjacency (CSR); liveTriangles counts the
+    // not-yet-emitted triangles of each vertex
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        liveTriangles[indices[i]]++;
+    }
+    std::vector<uint32_t> adjacencyBegin(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyBegin[v + 1] = adjacencyBegin[v] + liveTriangles[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyBegin.begin(), adjacencyBegin.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int corner = 0; corner < 3; ++corner) {
+                adjacency[fill[indices[t * 3 + corner]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    // A vertex is in the cache while fewer than cacheSize misses happened
+    // since it was loaded; starting the clock past cacheSize makes every
+    // first use a miss
+    std::vector<uint32_t> cachedAt(vertexCount, 0);
+    uint32_t clock = cacheSize + 1;
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    size_t cursor = 0;
+
+    uint32_t fanning = kUnassigned;
+    for (size_t v = 0; v < vertexCount && fanning == kUnassigned; ++v) {
+        if (liveTriangles[v] > 0) {
+            fanning = static_cast<uint32_t>(v);
+        }
+    }
+
+    while (fanning != kUnassigned) {
+        candidates.clear();
+        for (uint32_t a = adjacencyBegin[fanning]; a < adjacencyBegin[fanning + 1]; ++a) {
+            const uint32_t t = adjacency[a];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = 1;
+            for (int corner = 0; corner < 3; ++corner) {
+                const uint32_t v = indices[t * 3 + corner];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+                if (clock - cachedAt[v] > cacheSize) {
+                    cachedAt[v] = clock++;
+                }
+            }
+        }
+
+        // Next fan: the candidate that has been in the cache longest and
+        // whose remaining triangles will still find it there
+        fanning = kUnassigned;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if (clock - cachedAt[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = static_cast<int64_t>(clock - cachedAt[v]);
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                fanning = v;
+            }
+        }
+
+        // Dead end: a recently touched vertex, else the next one in order
+        while (fanning == kUnassigned && !deadEnd.empty()) {
+            const uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveTriangles[v] > 0) {
+                fanning = v;
+            }
+        }
+        while (fanning == kUnassigned && cursor < vertexCount) {
+            if (liveTriangles[cursor] > 0) {
+                fanning = static_cast<uint32_t>(cursor);
+            }
+            ++cursor;
+        }
+    }
+    return result;
+}
+
+MeshOptimizationResult MeshOptimizer::optimize(MeshData& mesh, ThreadPool& pool) const {
+    MeshOptimizationResult result;
+    result.meshName = mesh.name;
+    result.verticesBefore = static_cast<uint32_t>(mesh.vertices.size());
+    result.trianglesBefore = static_cast<uint32_t>(mesh.indices.size() / 3);
+    result.bytesBefore = geometryBytes(mesh);
+
+    const VertexCacheAnalyzer analyzer(cacheModel, cacheSize);
+    const uint32_t stride = GpuMemoryEstimator::vertexStride(mesh);
+    result.acmrBefore = analyzer.analyze(mesh.indices, mesh.vertices.size(), stride).acmr;
+
+    // 1. Weld, dropping triangles that are out of range or collapse
+    const DuplicateVertexDetector welder(weldPositionTolerance, weldAttributeTolerance);
+    const std::vector<uint32_t> remap = welder.buildWeldRemap(mesh.vertices, mesh.normals, mesh.uvCoords,
+                                                              mesh.tangents, mesh.bitangents, pool);
+    const size_t vertexCount = mesh.vertices.size();
+    std::vector<uint32_t> welded;
+    welded.reserve(mesh.indices.size());
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        uint32_t v[3];
+        bool valid = true;
+        for (int corner = 0; corner < 3; ++corner) {
+            valid = valid && mesh.indices[t + corner] < vertexCount;
+            v[corner] = valid ? remap[mesh.indices[t + corner]] : 0;
+        }
+        if (valid && v[0] != v[1] && v[1] != v[2] && v[0] != v[2]) {
+            welded.insert(welded.end(), v, v + 3);
+        }
+    }
+
+    // 2. Triangle order
+    std::vector<uint32_t> ordered = reorderForVertexCache(welded, vertexCount, cacheSize);
+
+    // 3. Vertex order by first use
+    std::vector<uint32_t> newIndex(vertexCount, kUnassigned);
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : ordered) {
+        if (newIndex[index] == kUnassigned) {
+            newIndex[index] = nextVertex++;
+        }
+        index = newIndex[index];
+    }
+    permute(mesh.vertices, newIndex, nextVertex);
+    permute(mesh.normals, newIndex, nextVertex);
+    permute(mesh.uvCoords, newIndex, nextVertex);
+    permute(mesh.tangents, newIndex, nextVertex);
+    permute(mesh.bitangents, newIndex, nextVertex);
+    mesh.indices.swap(ordered);
+    mesh.triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+
+    result.verticesAfter = nextVertex;
+    result.trianglesAfter = mesh.triangleCount;
+    result.bytesAfter = geometryBytes(mesh);
+    result.acmrAfter = analyzer.analyze(mesh.indices, mesh.vertices.size(), stride).acmr;
+    return result;
+}
+
+std::vector<MeshOptimizationResult> MeshOptimizer::optimizeScene(SceneData& sceneData, ThreadPool& pool) const {
+    // Meshes sharing a source mesh are node instances of one file mesh: the
+    // first is optimized and the others take its buffers, so they stay
+    // identical and the writer can keep them instanced
+    std::vector<size_t> firstInstance(sceneData.meshes.size());
+    std::unordered_map<uint32_t, size_t> firstBySource;
+    std::vector<size_t> optimized;
+    for (size_t i = 0; i < sceneData.meshes.size(); ++i) {
+        firstInstance[i] = i;
+        if (sceneData.meshes[i].sourceMesh != MeshData::kNoSourceMesh) {
+            firstInstance[i] = firstBySource.emplace(sceneData.meshes[i].sourceMesh, i).first->second;
+        }
+        if (firstInstance[i] == i) {
+            optimized.push_back(i);
+        }
+    }
+
+    std::vector<MeshOptimizationResult> results(optimized.size());
+    pool.parallelFor(optimized.size(), [&](size_t i) {
+        results[i] = optimize(sceneData.meshes[optimized[i]], pool);
+    });
+    for (size_t i = 0; i < sceneData.meshes.size(); ++i) {
+        if (firstInstance[i] != i) {
+            const MeshData& first = sceneData.meshes[firstInstance[i]];
+            MeshData& mesh = sceneData.meshes[i];
+            mesh.vertices = first.vertices;
+            mesh.normals = first.normals;
+            mesh.uvCoords = first.uvCoords;
+            mesh.tangents = first.tangents;
+            mesh.bitangents = first.bitangents;
+            mesh.indices = first.indices;
+            mesh.triangleCount = first.triangleCount;
+        }
+    }
+
+    sceneData.totalVertices = 0;
+    sceneData.totalTriangles = 0;
+    for (const auto& mesh : sceneData.meshes) {
+        sceneData.totalVertices += mesh.vertices.size();
+        sceneData.totalTriangles += mesh.triangleCount;
+    }
+    return results;
+}
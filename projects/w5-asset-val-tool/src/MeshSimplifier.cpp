@@ -0,0 +1,479 @@
+#include "MeshSimplifier.h"
+#include "EdgeAdjacency.h"
+#include "MeshOptimizer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_set>
+
+namespace {
+    const uint32_t kNone = 0xFFFFFFFFu;
+
+    // Border and seam planes relative to face planes of similar size; high
+    // enough that open edges are the last thing to move
+    const double kBorderWeight = 10.0;
+
+    // A collapse may rotate a neighbouring triangle's normal, but not by
+    // more than about 87 degrees
+    const double kFlipThreshold = 0.05;
+
+    enum class VertexKind : uint8_t {
+        Manifold,
+        Border,
+        Seam,
+        Locked
+    };
+
+    // Symmetric 4x4 plane quadric; weight is the total area (or edge
+    // length squared) it was built from, so error() is a mean squared
+    // distance in model units
+    struct Quadric {
+        double a00 = 0, a11 = 0, a22 = 0, a10 = 0, a20 = 0, a21 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double weight = 0;
+
+        void addPlane(const glm::dvec3& n, double d, double w) {
+            a00 += w * n.x * n.x;
+            a11 += w * n.y * n.y;
+            a22 += w * n.z * n.z;
+            a10 += w * n.y * n.x;
+            a20 += w * n.z * n.x;
+            a21 += w * n.z * n.y;
+            b0 += w * n.x * d;
+            b1 += w * n.y * d;
+            b2 += w * n.z * d;
+            c += w * d * d;
+            weight += w;
+        }
+
+        void add(const Quadric& q) {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22;
+            a10 += q.a10; a20 += q.a20; a21 += q.a21;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2;
+            c += q.c;
+            weight += q.weight;
+        }
+
+        // Weighted squared distance sum; divide by weight for the mean
+        double evaluate(const glm::dvec3& p) const {
+            const double rx = a00 * p.x + a10 * p.y + a20 * p.z + b0;
+            const double ry = a10 * p.x + a11 * p.y + a21 * p.z + b1;
+            const double rz = a20 * p.x + a21 * p.y + a22 * p.z + b2;
+            return rx * p.x + ry * p.y + rz * p.z + b0 * p.x + b1 * p.y + b2 * p.z + c;
+        }
+    };
+
+    // Mean squared distance of p to the planes of both quadrics
+    double mergedError(const Quadric& q0, const Quadric& q1, const glm::dvec3& p) {
+        const double weight = q0.weight + q1.weight;
+        return weight > 0 ? std::max(0.0, (q0.evaluate(p) + q1.evaluate(p)) / weight) : 0.0;
+    }
+
+    // Stable LSD radix sort of candidate order by float cost; the bit
+    // pattern of a non-negative float orders like its value
+    void sortByCost(const std::vector<float>& costs, std::vector<uint32_t>& order) {
+        const size_t count = costs.size();
+        std::vector<uint32_t> keys(count);
+        std::memcpy(keys.data(), costs.data(), count * sizeof(float));
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        std::vector<uint32_t> scratch(count);
+        for (int shift = 0; shift < 32; shift += 11) {
+            uint32_t histogram[2048] = {};
+            for (size_t i = 0; i < count; ++i) {
+                histogram[(keys[order[i]] >> shift) & 2047]++;
+            }
+            uint32_t sum = 0;
+            for (uint32_t& bucket : histogram) {
+                const uint32_t size = bucket;
+                bucket = sum;
+                sum += size;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                scratch[histogram[(keys[order[i]] >> shift) & 2047]++] = order[i];
+            }
+            order.swap(scratch);
+        }
+    }
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+    };
+
+    uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+    }
+
+    // Triangles around every canonical vertex (CSR)
+    struct VertexTriangles {
+        std::vector<uint32_t> begin;
+        std::vector<uint32_t> triangles;
+
+        void build(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& posId, size_t vertexCount) {
+            begin.assign(vertexCount + 1, 0);
+            for (uint32_t index : indices) {
+                begin[posId[index] + 1]++;
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                begin[v + 1] += begin[v];
+            }
+            triangles.resize(indices.size());
+            std::vector<uint32_t> fill(begin.begin(), begin.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) {
+                triangles[fill[posId[indices[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+    };
+}
+
+MeshSimplifier::MeshSimplifier(float maxRelativeError, uint32_t cacheSize)
+    : maxRelativeError(maxRelativeError), cacheSize(cacheSize) {}
+
+std::vector<MeshData> MeshSimplifier::buildLodChain(const MeshData& mesh, const std::vector<float>& ratios,
+                                                    ThreadPool& pool, MeshLodResult& result) const {
+    std::vector<MeshData> lods;
+    result.meshName = mesh.name;
+    const size_t vertexCount = mesh.vertices.size();
+
+    // Valid, non-degenerate triangles only
+    std::vector<uint32_t> indices;
+    indices.reserve(mesh.indices.size());
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const uint32_t i0 = mesh.indices[t], i1 = mesh.indices[t + 1], i2 = mesh.indices[t + 2];
+        if (i0 < vertexCount && i1 < vertexCount && i2 < vertexCount && i0 != i1 && i1 != i2 && i0 != i2) {
+            indices.insert(indices.end(), {i0, i1, i2});
+        }
+    }
+    const size_t baseTriangles = indices.size() / 3;
+    result.baseTriangles = static_cast<uint32_t>(baseTriangles);
+    if (baseTriangles == 0) {
+        return lods;
+    }
+
+    std::vector<float> targets;
+    for (float ratio : ratios) {
+        if (ratio > 0.0f && ratio < 1.0f) {
+            targets.push_back(ratio);
+        }
+    }
+    std::sort(targets.begin(), targets.end(), std::greater<float>());
+
+    // Attribute copies ("wedges") in use per canonical position
+    const std::vector<uint32_t> posId = EdgeAdjacency::weldPositions(mesh.vertices, pool);
+    std::vector<uint32_t> wedgeCount(vertexCount, 0);
+    {
+        std::vector<uint8_t> referenced(vertexCount, 0);
+        for (uint32_t index : indices) {
+            if (!referenced[index]) {
+                referenced[index] = 1;
+                wedgeCount[posId[index]]++;
+            }
+        }
+    }
+
+    // Classify canonical vertices. Open attribute edges over closed
+    // position edges are seams; two attribute edges per seam edge.
+    std::vector<uint8_t> borderEdges(vertexCount, 0);
+    std::vector<uint8_t> seamEdges(vertexCount, 0);
+    std::vector<uint8_t> complexVertex(vertexCount, 0);
+    std::unordered_set<uint64_t> openEdges;  // Border or non-manifold position edges
+    std::unordered_set<uint64_t> constrained; // Border and seam position edges
+    {
+        EdgeAdjacency positionEdges;
+        positionEdges.build(indices, posId, vertexCount, pool);
+        for (const MeshEdge& edge : positionEdges.getEdges()) {
+            if (edge.faceCount == 1) {
+                borderEdges[edge.v0] = static_cast<uint8_t>(std::min(255, borderEdges[edge.v0] + 1));
+                borderEdges[edge.v1] = static_cast<uint8_t>(std::min(255, borderEdges[edge.v1] + 1));
+                openEdges.insert(edgeKey(edge.v0, edge.v1));
+                constrained.insert(edgeKey(edge.v0, edge.v1));
+            } else if (edge.faceCount > 2) {
+                complexVertex[edge.v0] = complexVertex[edge.v1] = 1;
+                openEdges.insert(edgeKey(edge.v0, edge.v1));
+            }
+        }
+
+        EdgeAdjacency attributeEdges;
+        attributeEdges.build(indices, {}, vertexCount, pool);
+        for (const MeshEdge& edge : attributeEdges.getEdges()) {
+            const uint32_t a = posId[edge.v0], b = posId[edge.v1];
+            if (edge.faceCount != 1 || openEdges.count(edgeKey(a, b))) {
+                continue;
+            }
+            seamEdges[a] = static_cast<uint8_t>(std::min(255, seamEdges[a] + 1));
+            seamEdges[b] = static_cast<uint8_t>(std::min(255, seamEdges[b] + 1));
+            constrained.insert(edgeKey(a, b));
+        }
+    }
+
+    std::vector<VertexKind> kind(vertexCount, VertexKind::Locked);
+    for (size_t p = 0; p < vertexCount; ++p) {
+        if (posId[p] != p || complexVertex[p]) {
+            continue;
+        }
+        if (borderEdges[p] > 0) {
+            if (borderEdges[p] == 2 && wedgeCount[p] == 1 && seamEdges[p] == 0) {
+                kind[p] = VertexKind::Border;
+            }
+        } else if (seamEdges[p] > 0 || wedgeCount[p] > 1) {
+            if (seamEdges[p] == 4 && wedgeCount[p] == 2) {
+                kind[p] = VertexKind::Seam;
+            }
+        } else {
+            kind[p] = VertexKind::Manifold;
+        }
+    }
+
+    auto position = [&](uint32_t v) { return glm::dvec3(mesh.vertices[v]); };
+
+    // Face quadrics, plus perpendicular planes along borders and seams
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t < baseTriangles; ++t) {
+        const uint32_t p[3] = {posId[indices[t * 3]], posId[indices[t * 3 + 1]], posId[indices[t * 3 + 2]]};
+        glm::dvec3 normal = glm::cross(position(p[1]) - position(p[0]), position(p[2]) - position(p[0]));
+        const double length = std::sqrt(glm::dot(normal, normal));
+        if (!(length > 0.0)) {
+            continue;
+        }
+        normal /= length;
+        for (int corner = 0; corner < 3; ++corner) {
+            quadrics[p[corner]].addPlane(normal, -glm::dot(normal, position(p[0])), length * 0.5);
+        }
+
+        for (int corner = 0; corner < 3; ++corner) {
+            const uint32_t a = p[corner], b = p[(corner + 1) % 3];
+            if ((borderEdges[a] | seamEdges[a]) == 0 || (borderEdges[b] | seamEdges[b]) == 0 ||
+                !constrained.count(edgeKey(a, b))) {
+                continue;
+            }
+            const glm::dvec3 edge = position(b) - position(a);
+            glm::dvec3 plane = glm::cross(edge, normal);
+            const double planeLength = std::sqrt(glm::dot(plane, plane));
+            if (planeLength > 0.0) {
+                plane /= planeLength;
+                const double weight = glm::dot(edge, edge) * kBorderWeight;
+                quadrics[a].addPlane(plane, -glm::dot(plane, position(a)), weight);
+                quadrics[b].addPlane(plane, -glm::dot(plane, position(a)), weight);
+            }
+        }
+    }
+
+    glm::vec3 minimum(FLT_MAX), maximum(-FLT_MAX);
+    for (uint32_t index : indices) {
+        minimum = glm::min(minimum, mesh.vertices[index]);
+        maximum = glm::max(maximum, mesh.vertices[index]);
+    }
+    const double diagonal = std::sqrt(glm::dot(glm::dvec3(maximum - minimum), glm::dvec3(maximum - minimum)));
+    const double errorLimit = maxRelativeError > 0.0f ? maxRelativeError * diagonal
+                                                      : std::numeric_limits<double>::infinity();
+
+    // Per-pass state
+    std::vector<uint32_t> collapseTarget(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        collapseTarget[v] = static_cast<uint32_t>(v);
+    }
+    std::vector<uint8_t> passLocked(vertexCount, 0);
+    std::vector<uint32_t> touched;
+    std::vector<std::pair<uint32_t, uint32_t>> partners;
+    std::vector<uint32_t> usedWedges;
+    VertexTriangles around;
+    double maxError = 0.0;
+
+    // One round of non-overlapping collapses; returns how many were applied
+    auto runPass = [&](size_t targetTriangles) {
+        EdgeAdjacency edges;
+        edges.build(indices, posId, vertexCount, pool);
+        around.build(indices, posId, vertexCount);
+
+        std::vector<Collapse> candidates;
+        std::vector<float> costs;
+        candidates.reserve(edges.getEdges().size());
+        costs.reserve(edges.getEdges().size());
+        for (const MeshEdge& edge : edges.getEdges()) {
+            Collapse best{kNone, kNone};
+            double bestCost = std::numeric_limits<double>::infinity();
+            const uint32_t ends[2] = {edge.v0, edge.v1};
+            for (int direction = 0; direction < 2; ++direction) {
+                const uint32_t from = ends[direction], to = ends[1 - direction];
+                const VertexKind k = kind[from];
+                const bool allowed = k == VertexKind::Manifold ||
+                                     (k == VertexKind::Border && edge.faceCount == 1) ||
+                                     (k == VertexKind::Seam && edge.faceCount == 2);
+                if (!allowed) {
+                    continue;
+                }
+                const double cost = mergedError(quadrics[from], quadrics[to], position(to));
+                if (cost < bestCost) {
+                    best = Collapse{from, to};
+                    bestCost = cost;
+                }
+            }
+            if (best.from != kNone && bestCost <= errorLimit * errorLimit) {
+                candidates.push_back(best);
+                costs.push_back(static_cast<float>(bestCost));
+            }
+        }
+        std::vector<uint32_t> order;
+        sortByCost(costs, order);
+
+        size_t triangles = indices.size() / 3;
+        size_t applied = 0;
+        auto resolve = [&](uint32_t v) { return posId[collapseTarget[v]]; };
+
+        for (uint32_t candidate : order) {
+            if (triangles <= targetTriangles) {
+                break;
+            }
+            const uint32_t a = candidates[candidate].from, b = candidates[candidate].to;
+            if (passLocked[a] || passLocked[b]) {
+                continue;
+            }
+
+            // Triangles around a either contain b (they vanish, and tell us
+            // which copy of b each copy of a merges into) or must not flip
+            partners.clear();
+            usedWedges.clear();
+            bool valid = true;
+            size_t removed = 0;
+            for (uint32_t i = around.begin[a]; i < around.begin[a + 1] && valid; ++i) {
+                const uint32_t t = around.triangles[i];
+                uint32_t corner[3], p[3];
+                for (int k = 0; k < 3; ++k) {
+                    corner[k] = collapseTarget[indices[t * 3 + k]];
+                    p[k] = resolve(indices[t * 3 + k]);
+                }
+                if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2]) {
+                    continue;
+                }
+                const int at = p[0] == a ? 0 : (p[1] == a ? 1 : 2);
+                const int bt = p[0] == b ? 0 : (p[1] == b ? 1 : (p[2] == b ? 2 : -1));
+                if (std::find(usedWedges.begin(), usedWedges.end(), corner[at]) == usedWedges.end()) {
+                    usedWedges.push_back(corner[at]);
+                }
+                if (bt >= 0) {
+                    auto known = std::find_if(partners.begin(), partners.end(),
+                                              [&](const auto& pair) { return pair.first == corner[at]; });
+                    if (known == partners.end()) {
+                        partners.emplace_back(corner[at], corner[bt]);
+                    } else if (known->second != corner[bt]) {
+                        valid = false;
+                    }
+                    removed++;
+                    continue;
+                }
+
+                const glm::dvec3 p0 = position(p[0]), p1 = position(p[1]), p2 = position(p[2]);
+                const glm::dvec3 before = glm::cross(p1 - p0, p2 - p0);
+                glm::dvec3 moved[3] = {p0, p1, p2};
+                moved[at] = position(b);
+                const glm::dvec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                const double scale = std::sqrt(glm::dot(before, before) * glm::dot(after, after));
+                if (glm::dot(before, after) <= kFlipThreshold * scale) {
+                    valid = false;
+                }
+            }
+
+            // Every copy of a still in use needs a counterpart on b
+            for (uint32_t wedge : usedWedges) {
+                valid = valid && std::any_of(partners.begin(), partners.end(),
+                                             [&](const auto& pair) { return pair.first == wedge; });
+            }
+            if (!valid || removed == 0) {
+                continue;
+            }
+
+            for (const auto& pair : partners) {
+                collapseTarget[pair.first] = pair.second;
+                touched.push_back(pair.first);
+            }
+            quadrics[b].add(quadrics[a]);
+            passLocked[a] = passLocked[b] = 1;
+            touched.push_back(a);
+            touched.push_back(b);
+            triangles -= std::min(triangles, removed);
+            maxError = std::max(maxError, std::sqrt(static_cast<double>(costs[candidate])));
+            applied++;
+        }
+
+        // Rewrite the index buffer and drop collapsed triangles
+        size_t write = 0;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            const uint32_t v0 = collapseTarget[indices[t]];
+            const uint32_t v1 = collapseTarget[indices[t + 1]];
+            const uint32_t v2 = collapseTarget[indices[t + 2]];
+            if (posId[v0] != posId[v1] && posId[v1] != posId[v2] && posId[v0] != posId[v2]) {
+                indices[write++] = v0;
+                indices[write++] = v1;
+                indices[write++] = v2;
+            }
+        }
+        indices.resize(write);
+
+        for (uint32_t v : touched) {
+            collapseTarget[v] = v;
+            passLocked[v] = 0;
+        }
+        touched.clear();
+        return applied;
+    };
+
+    for (size_t level = 0; level < targets.size(); ++level) {
+        const size_t targetTriangles = static_cast<size_t>(baseTriangles * static_cast<double>(targets[level]));
+        while (indices.size() / 3 > targetTriangles && runPass(targetTriangles) > 0) {
+        }
+
+        // Snapshot: cache-ordered triangles over vertices compacted by first use
+        MeshData lod;
+        lod.name = mesh.name + "_LOD" + std::to_string(level + 1);
+        lod.materialIndices = mesh.materialIndices;
+        lod.indices = MeshOptimizer::reorderForVertexCache(indices, vertexCount, cacheSize);
+        std::vector<uint32_t> newIndex(vertexCount, kNone);
+        const bool hasNormals = mesh.normals.size() == vertexCount;
+        const bool hasUVs = mesh.uvCoords.size() == vertexCount;
+        const bool hasTangents = mesh.tangents.size() == vertexCount && mesh.bitangents.size() == vertexCount;
+        for (uint32_t& index : lod.indices) {
+            if (newIndex[index] == kNone) {
+                newIndex[index] = static_cast<uint32_t>(lod.vertices.size());
+                lod.vertices.push_back(mesh.vertices[index]);
+                if (hasNormals) {
+                    lod.normals.push_back(mesh.normals[index]);
+                }
+                if (hasUVs) {
+                    lod.uvCoords.push_back(mesh.uvCoords[index]);
+                }
+                if (hasTangents) {
+                    lod.tangents.push_back(mesh.tangents[index]);
+                    lod.bitangents.push_back(mesh.bitangents[index]);
+                }
+            }
+            index = newIndex[index];
+        }
+        lod.triangleCount = static_cast<uint32_t>(lod.indices.size() / 3);
+
+        LodLevelResult levelResult;
+        levelResult.targetRatio = targets[level];
+        levelResult.triangleCount = lod.triangleCount;
+        levelResult.vertexCount = static_cast<uint32_t>(lod.vertices.size());
+        levelResult.error = static_cast<float>(maxError);
+        levelResult.relativeError = diagonal > 0.0 ? static_cast<float>(maxError / diagonal) : 0.0f;
+        result.levels.push_back(levelResult);
+        lods.push_back(std::move(lod));
+    }
+    return lods;
+}
+
+std::vector<MeshLodResult> MeshSimplifier::buildSceneLods(SceneData& sceneData, const std::vector<float>& ratios,
+                                                          ThreadPool& pool) const {
+    std::vector<MeshLodResult> results(sceneData.meshes.size());
+    sceneData.meshLods.assign(sceneData.meshes.size(), {});
+    pool.parallelFor(sceneData.meshes.size(), [&](size_t i) {
+        sceneData.meshLods[i] = buildLodChain(sceneData.meshes[i], ratios, pool, results[i]);
+    });
+    return results;
+}
@@ -0,0 +1,437 @@
+#include "MeshletBuilder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace {
+    const uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+    const size_t kMeshletsPerChunk = 256;
+
+    // Cones whose widest normal leans further than acos(0.1) ~ 84 degrees
+    // from the axis leave no view direction that culls them reliably
+    const float kMinConeDot = 0.1f;
+
+    float lengthSquared(const glm::vec3& v) {
+        return glm::dot(v, v);
+    }
+
+    // Static kd-tree over the centroids of the triangles still unused when
+    // it is built, for the nearest unused triangle. Removing a triangle
+    // counts down the live items of every node above it, so the search
+    // skips exhausted subtrees.
+    class CentroidTree {
+    public:
+        CentroidTree(const std::vector<glm::vec3>& centroids, const std::vector<uint8_t>& used)
+            : points(centroids), leafOf(centroids.size(), kNoSlot) {
+            for (uint32_t t = 0; t < centroids.size(); ++t) {
+                if (!used[t]) {
+                    items.push_back(t);
+                }
+            }
+            nodes.reserve(2 * items.size() / kLeafSize + 1);
+            build(0, static_cast<uint32_t>(items.size()), kNoSlot);
+        }
+
+        void remove(uint32_t item) {
+            for (uint32_t node = leafOf[item]; node != kNoSlot; node = nodes[node].parent) {
+                nodes[node].live--;
+            }
+        }
+
+        // kNoSlot once every item is used, or when no distance is finite
+        uint32_t nearest(const glm::vec3& target, const std::vector<uint8_t>& used) const {
+            uint32_t best = kNoSlot;
+            float bestDistance = std::numeric_limits<float>::infinity();
+            search(0, target, used, best, bestDistance);
+            return best;
+        }
+
+    private:
+        static const uint32_t kLeafSize = 8;
+
+        struct Node {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            uint32_t parent = kNoSlot;
+            uint32_t left = kNoSlot; // kNoSlot for leaves
+            uint32_t right = kNoSlot;
+            uint32_t live = 0;
+            int axis = 0;
+            float split = 0.0f;
+        };
+
+        const std::vector<glm::vec3>& points;
+        std::vector<uint32_t> items;
+        std::vector<uint32_t> leafOf;
+        std::vector<Node> nodes;
+
+        uint32_t build(uint32_t begin, uint32_t end, uint32_t parent) {
+            const uint32_t index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            nodes[index].begin = begin;
+            nodes[index].end = end;
+            nodes[index].parent = parent;
+            nodes[index].live = end - begin;
+            if (end - begin <= kLeafSize) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    leafOf[items[i]] = index;
+                }
+                return index;
+            }
+
+            glm::vec3 boxMin = points[items[begin]], boxMax = boxMin;
+            for (uint32_t i = begin + 1; i < end; ++i) {
+                boxMin = glm::min(boxMin, points[items[i]]);
+                boxMax = glm::max(boxMax, points[items[i]]);
+            }
+            const glm::vec3 size = boxMax - boxMin;
+            const int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+            const uint32_t middle = begin + (end - begin) / 2;
+            std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+                             [&](uint32_t a, uint32_t b) { return points[a][axis] < points[b][axis]; });
+            nodes[index].axis = axis;
+            nodes[index].split = points[items[middle]][axis];
+            const uint32_t left = build(begin, middle, index);
+            const uint32_t right = build(middle, end, index);
+            nodes[index].left = left;
+            nodes[index].right = right;
+            return index;
+        }
+
+        void search(uint32_t index, const glm::vec3& target, const std::vector<uint8_t>& used, uint32_t& best,
+                    float& bestDistance) const {
+            const Node& node = nodes[index];
+            if (node.live == 0) {
+                return;
+            }
+            if (node.left == kNoSlot) {
+                for (uint32_t i = node.begin; i < node.end; ++i) {
+                    const uint32_t item = items[i];
+                    const float distance = lengthSquared(points[item] - target);
+                    if (!used[item] && distance < bestDistance) {
+                        best = item;
+                        bestDistance = distance;
+                    }
+                }
+                return;
+            }
+            const float delta = target[node.axis] - node.split;
+            search(delta < 0.0f ? node.left : node.right, target, used, best, bestDistance);
+            if (delta * delta < bestDistance) {
+                search(delta < 0.0f ? node.right : node.left, target, used, best, bestDistance);
+            }
+        }
+    };
+
+    // Ritter's sphere: seeded with the most distant pair of axis extremes,
+    // then grown to take in every point
+    void boundingSphere(const glm::vec3* points, size_t count, glm::vec3& center, float& radius) {
+        size_t minIndex[3] = {0, 0, 0};
+        size_t maxIndex[3] = {0, 0, 0};
+        for (size_t i = 1; i < count; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                if (points[i][axis] < points[minIndex[axis]][axis]) {
+                    minIndex[axis] = i;
+                }
+                if (points[i][axis] > points[maxIndex[axis]][axis]) {
+                    maxIndex[axis] = i;
+                }
+            }
+        }
+        int widest = 0;
+        float widestSquared = -1.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float d = lengthSquared(points[maxIndex[axis]] - points[minIndex[axis]]);
+            if (d > widestSquared) {
+                widestSquared = d;
+                widest = axis;
+            }
+        }
+        center = (points[minIndex[widest]] + points[maxIndex[widest]]) * 0.5f;
+        radius = std::sqrt(widestSquared) * 0.5f;
+        for (size_t i = 0; i < count; ++i) {
+            const float d = glm::length(points[i] - center);
+            if (d > radius) {
+                const float grown = (radius + d) * 0.5f;
+                center += (points[i] - center) * ((grown - radius) / d);
+                radius = grown;
+            }
+        }
+    }
+
+    void computeBounds(Meshlet& meshlet, const MeshletMesh& mesh, const std::vector<glm::vec3>& vertices) {
+        glm::vec3 points[256];
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            points[i] = vertices[mesh.vertices[meshlet.vertexOffset + i]];
+        }
+        boundingSphere(points, meshlet.vertexCount, meshlet.center, meshlet.radius);
+
+        // Unit face normals; degenerate triangles keep a zero normal and
+        // have no say in the cone
+        glm::vec3 normals[256];
+        const uint8_t* local = &mesh.triangles[meshlet.triangleOffset];
+        glm::vec3 axisSum(0.0f);
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            const glm::vec3& a = points[local[t * 3]];
+            const glm::vec3 normal = glm::cross(points[local[t * 3 + 1]] - a, points[local[t * 3 + 2]] - a);
+            const float length = glm::length(normal);
+            normals[t] = length > 0.0f && std::isfinite(length) ? normal / length : glm::vec3(0.0f);
+            axisSum += normals[t];
+        }
+
+        meshlet.coneApex = meshlet.center;
+        meshlet.coneCutoff = 1.0f;
+        const float axisLength = glm::length(axisSum);
+        if (!(axisLength > 0.0f)) {
+            return;
+        }
+        meshlet.coneAxis = axisSum / axisLength;
+        float minDot = 1.0f;
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            if (normals[t] != glm::vec3(0.0f)) {
+                minDot = std::min(minDot, glm::dot(normals[t], meshlet.coneAxis));
+            }
+        }
+        if (minDot <= kMinConeDot) {
+            return;
+        }
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+
+        // The apex backs off along the axis until every triangle's plane
+        // lies in front of it, so the test also holds for close cameras
+        float maxDistance = 0.0f;
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            if (normals[t] != glm::vec3(0.0f)) {
+                maxDistance = std::max(maxDistance, glm::dot(meshlet.center - points[local[t * 3]], normals[t]) /
+                                                        glm::dot(meshlet.coneAxis, normals[t]));
+            }
+        }
+        meshlet.coneApex = meshlet.center - meshlet.coneAxis * maxDistance;
+    }
+}
+
+MeshletBuilder::MeshletBuilder(uint32_t maxVertices, uint32_t maxTriangles)
+    : maxVertices(std::clamp<uint32_t>(maxVertices, 3, 255)),
+      maxTriangles(std::clamp<uint32_t>(maxTriangles, 1, 255)) {}
+
+MeshletMesh MeshletBuilder::build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices,
+                                  ThreadPool& pool) const {
+    MeshletMesh result;
+    const size_t vertexCount = vertices.size();
+
+    // Triangles with out-of-range or repeated indices are left out
+    std::vector<uint32_t> corners;
+    corners.reserve(indices.size());
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+        if (a < vertexCount && b < vertexCount && c < vertexCount && a != b && b != c && a != c) {
+            corners.insert(corners.end(), {a, b, c});
+        }
+    }
+    const size_t triangleCount = corners.size() / 3;
+    if (triangleCount == 0) {
+        return result;
+    }
+
+    // Vertex -> triangle adjacency; live[v] counts the unused triangles at
+    // the front of v's range
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (uint32_t v : corners) {
+        live[v]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    std::vector<uint32_t> adjacency(corners.size());
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < corners.size(); ++i) {
+            adjacency[cursor[corners[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    // Non-finite centroids go to the far corner, where no search ends up
+    std::vector<glm::vec3> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3 c = (vertices[corners[t * 3]] + vertices[corners[t * 3 + 1]] +
+                             vertices[corners[t * 3 + 2]]) / 3.0f;
+        centroids[t] = std::isfinite(c.x) && std::isfinite(c.y) && std::isfinite(c.z)
+                           ? c : glm::vec3(std::numeric_limits<float>::max());
+    }
+    std::unique_ptr<CentroidTree> tree; // Built the first time a border runs dry
+
+    std::vector<uint8_t> used(triangleCount, 0);
+    std::vector<uint32_t> slot(vertexCount, kNoSlot);
+    const size_t expectedMeshlets = triangleCount / maxTriangles + 1;
+    result.meshlets.reserve(expectedMeshlets);
+    result.vertices.reserve(expectedMeshlets * maxVertices);
+    result.triangles.reserve(triangleCount * 3 + expectedMeshlets * 3);
+
+    Meshlet current;
+    glm::vec3 positionSum(0.0f); // Over the current meshlet's vertices
+    auto newVertices = [&](uint32_t triangle) {
+        const uint32_t* tri = &corners[triangle * 3];
+        return (slot[tri[0]] == kNoSlot) + (slot[tri[1]] == kNoSlot) + (slot[tri[2]] == kNoSlot);
+    };
+    auto emit = [&](uint32_t triangle) {
+        const uint32_t* tri = &corners[triangle * 3];
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = tri[k];
+            if (slot[v] == kNoSlot) {
+                slot[v] = current.vertexCount++;
+                result.vertices.push_back(v);
+                positionSum += vertices[v];
+            }
+            result.triangles.push_back(static_cast<uint8_t>(slot[v]));
+
+            // Swap the triangle out of v's live range
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + live[v];
+            std::iter_swap(std::find(begin, end, triangle), end - 1);
+            live[v]--;
+        }
+        used[triangle] = 1;
+        if (tree) {
+            tree->remove(triangle);
+        }
+        current.triangleCount++;
+    };
+    auto close = [&]() {
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            slot[result.vertices[current.vertexOffset + i]] = kNoSlot;
+        }
+        result.triangles.resize((result.triangles.size() + 3) & ~size_t(3), 0);
+        result.meshlets.push_back(current);
+        positionSum = glm::vec3(0.0f);
+        current = Meshlet();
+        current.vertexOffset = static_cast<uint32_t>(result.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(result.triangles.size());
+    };
+
+    size_t scan = 0;
+    for (size_t emitted = 0; emitted < triangleCount; ++emitted) {
+        // Cheapest triangle on the open border: fewest new vertices, then
+        // the fewest unused triangles left around its corners
+        uint32_t best = kNoSlot;
+        uint32_t bestExtra = 3, bestLive = std::numeric_limits<uint32_t>::max();
+        bool borderEmpty = true;
+        for (uint32_t i = 0; i < current.vertexCount && bestExtra > 0; ++i) {
+            const uint32_t v = result.vertices[current.vertexOffset + i];
+            borderEmpty = borderEmpty && live[v] == 0;
+            for (uint32_t j = offsets[v]; j < offsets[v] + live[v]; ++j) {
+                const uint32_t triangle = adjacency[j];
+                const uint32_t extra = newVertices(triangle);
+                if (current.vertexCount + extra > maxVertices) {
+                    continue;
+                }
+                const uint32_t* tri = &corners[triangle * 3];
+                const uint32_t liveSum = live[tri[0]] + live[tri[1]] + live[tri[2]];
+                if (extra < bestExtra || (extra == bestExtra && liveSum < bestLive)) {
+                    best = triangle;
+                    bestExtra = extra;
+                    bestLive = liveSum;
+                }
+            }
+        }
+
+        // Nothing on the border fits. A meshlet whose piece of surface ran
+        // out continues from the unused triangle nearest its centroid, so
+        // it stays compact; a full one closes, and the next starts at the
+        // first unused triangle in index order, which is vertex-cache
+        // order after --fix and keeps meshlets side by side.
+        if (best == kNoSlot) {
+            if (current.vertexCount > 0 && borderEmpty) {
+                if (!tree) {
+                    tree = std::make_unique<CentroidTree>(centroids, used);
+                }
+                best = tree->nearest(positionSum / static_cast<float>(current.vertexCount), used);
+            }
+            if (best == kNoSlot) {
+                while (used[scan]) {
+                    ++scan;
+                }
+                best = static_cast<uint32_t>(scan);
+            }
+            if (current.vertexCount + newVertices(best) > maxVertices) {
+                close();
+            }
+        }
+        emit(best);
+        if (current.triangleCount == maxTriangles) {
+            close();
+        }
+    }
+    if (current.triangleCount > 0) {
+        close();
+    }
+
+    const size_t chunkCount = (result.meshlets.size() + kMeshletsPerChunk - 1) / kMeshletsPerChunk;
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t begin = chunk * kMeshletsPerChunk;
+        const size_t end = std::min(result.meshlets.size(), begin + kMeshletsPerChunk);
+        for (size_t m = begin; m < end; ++m) {
+            computeBounds(result.meshlets[m], result, vertices);
+        }
+    });
+    return result;
+}
+
+MeshletResult MeshletBuilder::analyze(const MeshletMesh& meshlets, const std::vector<glm::vec3>& vertices) const {
+    MeshletResult result;
+    result.meshletCount = static_cast<uint32_t>(meshlets.meshlets.size());
+    if (meshlets.meshlets.empty()) {
+        return result;
+    }
+
+    glm::vec3 boxMin(std::numeric_limits<float>::max()), boxMax(-std::numeric_limits<float>::max());
+    for (uint32_t v : meshlets.vertices) {
+        boxMin = glm::min(boxMin, vertices[v]);
+        boxMax = glm::max(boxMax, vertices[v]);
+    }
+    const float diagonal = glm::length(boxMax - boxMin);
+
+    double vertexFill = 0.0, triangleFill = 0.0, fill = 0.0, meshletCull = 0.0, triangleCull = 0.0, radius = 0.0;
+    for (const Meshlet& meshlet : meshlets.meshlets) {
+        const double vertexShare = static_cast<double>(meshlet.vertexCount) / maxVertices;
+        const double triangleShare = static_cast<double>(meshlet.triangleCount) / maxTriangles;
+        vertexFill += vertexShare;
+        triangleFill += triangleShare;
+        fill += std::max(vertexShare, triangleShare);
+        if (vertexShare < 0.5 && triangleShare < 0.5) {
+            result.underfilledMeshlets++;
+        }
+
+        result.triangles += meshlet.triangleCount;
+        result.meshletVertices += meshlet.vertexCount;
+        if (meshlet.coneCutoff < 1.0f) {
+            result.cullableMeshlets++;
+            const double cull = (1.0 - meshlet.coneCutoff) * 0.5;
+            meshletCull += cull;
+            triangleCull += cull * meshlet.triangleCount;
+        }
+        radius += meshlet.radius;
+    }
+
+    const double count = static_cast<double>(meshlets.meshlets.size());
+    result.verticesPerTriangle = static_cast<float>(static_cast<double>(result.meshletVertices) / result.triangles);
+    result.vertexFill = static_cast<float>(vertexFill / count);
+    result.triangleFill = static_cast<float>(triangleFill / count);
+    result.averageFill = static_cast<float>(fill / count);
+    result.meshletCullRate = static_cast<float>(meshletCull / count);
+    result.triangleCullRate = static_cast<float>(triangleCull / result.triangles);
+    result.averageRadius = diagonal > 0.0f ? static_cast<float>(radius / count / diagonal) : 0.0f;
+    result.dataBytes = meshlets.meshlets.size() * Meshlet::kExportedBytes + meshlets.vertices.size() * sizeof(uint32_t) +
+                       meshlets.triangles.size();
+    return result;
+}
+
+std::vector<MeshletMesh> MeshletBuilder::buildScene(const SceneData& sceneData, ThreadPool& pool) const {
+    std::vector<MeshletMesh> results(sceneData.meshes.size());
+    pool.parallelFor(sceneData.meshes.size(), [&](size_t i) {
+        results[i] = build(sceneData.meshes[i].vertices, sceneData.meshes[i].indices, pool);
+    });
+    return results;
+}
@@ -0,0 +1,95 @@
+#include "MeshletWriter.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const char kMagic[4] = {'M', 'S', 'L', 'T'};
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void appendF32(std::vector<uint8_t>& out, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        appendU32(out, bits);
+    }
+
+    void appendVec3(std::vector<uint8_t>& out, const glm::vec3& v) {
+        appendF32(out, v.x);
+        appendF32(out, v.y);
+        appendF32(out, v.z);
+    }
+
+    void pad(std::vector<uint8_t>& out) {
+        out.resize((out.size() + 3) & ~size_t(3), 0);
+    }
+}
+
+bool MeshletWriter::write(const SceneData& sceneData, const std::vector<MeshletMesh>& meshlets,
+                          uint32_t maxVertices, uint32_t maxTriangles, const std::string& outputPath) {
+    writtenBytes = 0;
+    if (meshlets.size() != sceneData.meshes.size()) {
+        lastError = "Meshlets do not match the scene's meshes";
+        return false;
+    }
+
+    size_t total = 20;
+    for (size_t m = 0; m < meshlets.size(); ++m) {
+        total += 16 + sceneData.meshes[m].name.size() + meshlets[m].meshlets.size() * Meshlet::kExportedBytes +
+                 meshlets[m].vertices.size() * sizeof(uint32_t) + meshlets[m].triangles.size() + 6;
+    }
+    std::vector<uint8_t> out;
+    out.reserve(total);
+
+    out.insert(out.end(), kMagic, kMagic + 4);
+    appendU32(out, kVersion);
+    appendU32(out, static_cast<uint32_t>(meshlets.size()));
+    appendU32(out, maxVertices);
+    appendU32(out, maxTriangles);
+
+    for (size_t m = 0; m < meshlets.size(); ++m) {
+        const std::string& name = sceneData.meshes[m].name;
+        const MeshletMesh& mesh = meshlets[m];
+        appendU32(out, static_cast<uint32_t>(name.size()));
+        out.insert(out.end(), name.begin(), name.end());
+        pad(out);
+
+        appendU32(out, static_cast<uint32_t>(mesh.meshlets.size()));
+        appendU32(out, static_cast<uint32_t>(mesh.vertices.size()));
+        appendU32(out, static_cast<uint32_t>((mesh.triangles.size() + 3) & ~size_t(3)));
+        for (const Meshlet& meshlet : mesh.meshlets) {
+            appendU32(out, meshlet.vertexOffset);
+            appendU32(out, meshlet.triangleOffset);
+            out.push_back(static_cast<uint8_t>(meshlet.vertexCount));
+            out.push_back(static_cast<uint8_t>(meshlet.triangleCount));
+            out.push_back(0);
+            out.push_back(0);
+            appendVec3(out, meshlet.center);
+            appendF32(out, meshlet.radius);
+            appendVec3(out, meshlet.coneApex);
+            appendVec3(out, meshlet.coneAxis);
+            appendF32(out, meshlet.coneCutoff);
+        }
+        for (uint32_t v : mesh.vertices) {
+            appendU32(out, v);
+        }
+        out.insert(out.end(), mesh.triangles.begin(), mesh.triangles.end());
+        pad(out);
+    }
+
+    std::ofstream file(outputPath, std::ios::binary);
+    if (!file.is_open()) {
+        lastError = "Cannot write file: " + outputPath;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!file.good()) {
+        lastError = "Cannot write file: " + outputPath;
+        return false;
+    }
+    writtenBytes = out.size();
+    return true;
+}
@@ -0,0 +1,531 @@
+#include "NameMatcher.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <map>
+
+namespace {
+    // Compilation gives up (and falls back to std::regex) past these sizes
+    const size_t kMaxNfaStates = 8192;
+    const size_t kMaxDfaStates = 2048;
+    const int kMaxRepeat = 256;
+
+    using ByteSet = std::bitset<256>;
+
+    struct Node {
+        enum Kind { Set, Concat, Alternate, Repeat, Empty };
+        Kind kind;
+        ByteSet set;
+        std::vector<int> children;
+        int min = 0;
+        int max = -1; // -1 = unbounded
+    };
+
+    // Recursive-descent parser for the regular subset of ECMAScript syntax.
+    // Any construct outside that subset makes parse() return false.
+    class Parser {
+    public:
+        Parser(const std::string& pattern, std::vector<Node>& nodes) : text(pattern), nodes(nodes) {}
+
+        bool parse(int& root) {
+            size_t end = text.size();
+            // Leading ^ and trailing $ are implied by whole-string matching
+            if (pos < end && text[pos] == '^') {
+                pos++;
+            }
+            if (end > pos && text[end - 1] == '$' && !isEscaped(end - 1)) {
+                end--;
+            }
+            limit = end;
+            return parseAlternation(root) && pos == limit;
+        }
+
+    private:
+        const std::string& text;
+        std::vector<Node>& nodes;
+        size_t pos = 0;
+        size_t limit = 0;
+
+        bool isEscaped(size_t index) const {
+            size_t backslashes = 0;
+            while (index > 0 && text[index - 1] == '\\') {
+                backslashes++;
+                index--;
+            }
+            return backslashes % 2 == 1;
+        }
+
+        bool atEnd() const { return pos >= limit; }
+
+        int add(Node node) {
+            nodes.push_back(std::move(node));
+            return static_cast<int>(nodes.size() - 1);
+        }
+
+        int addSet(const ByteSet& set) {
+            Node node;
+            node.kind = Node::Set;
+            node.set = set;
+            return add(std::move(node));
+        }
+
+        bool parseAlternation(int& out) {
+            Node alternate;
+            alternate.kind = Node::Alternate;
+            int branch;
+            if (!parseConcatenation(branch)) return false;
+            alternate.children.push_back(branch);
+            while (!atEnd() && text[pos] == '|') {
+                pos++;
+                if (!parseConcatenation(branch)) return false;
+                alternate.children.push_back(branch);
+            }
+            out = alternate.children.size() == 1 ? alternate.children[0] : add(std::move(alternate));
+            return true;
+        }
+
+        bool parseConcatenation(int& out) {
+            Node concat;
+            concat.kind = Node::Concat;
+            while (!atEnd() && text[pos] != '|' && text[pos] != ')') {
+                int term;
+                if (!parseRepeat(term)) return false;
+                concat.children.push_back(term);
+            }
+            if (concat.children.empty()) {
+                Node empty;
+                empty.kind = Node::Empty;
+                out = add(std::move(empty));
+            } else {
+                out = concat.children.size() == 1 ? concat.children[0] : add(std::move(concat));
+            }
+            return true;
+        }
+
+        bool parseRepeat(int& out) {
+            if (!parseAtom(out)) return false;
+            while (!atEnd()) {
+                int min, max;
+                const char c = text[pos];
+                if (c == '*') { min = 0; max = -1; pos++; }
+                else if (c == '+') { min = 1; max = -1; pos++; }
+                else if (c == '?') { min = 0; max = 1; pos++; }
+                else if (c == '{') { if (!parseBraces(min, max)) return false; }
+                else break;
+
+                // Lazy quantifiers accept the same set of whole strings
+                if (!atEnd() && text[pos] == '?') {
+                    pos++;
+                }
+
+                Node repeat;
+                repeat.kind = Node::Repeat;
+                repeat.children.push_back(out);
+                repeat.min = min;
+                repeat.max = max;
+                out = add(std::move(repeat));
+            }
+            return true;
+        }
+
+        bool parseNumber(int& value) {
+            const size_t start = pos;
+            value = 0;
+            while (!atEnd() && text[pos] >= '0' && text[pos] <= '9') {
+                value = value * 10 + (text[pos] - '0');
+                if (value > kMaxRepeat) return false;
+                pos++;
+            }
+            return pos > start;
+        }
+
+        bool parseBraces(int& min, int& max) {
+            pos++; // '{'
+            if (!parseNumber(min)) return false;
+            max = min;
+            if (!atEnd() && text[pos] == ',') {
+                pos++;
+                max = -1;
+                if (!atEnd() && text[pos] != '}' && !parseNumber(max)) return false;
+            }
+            if (atEnd() || text[pos] != '}') return false;
+            pos++;
+            return max == -1 || max >= min;
+        }
+
+        bool parseAtom(int& out) {
+            const char c = text[pos];
+            if (c == '(') {
+                pos++;
+                if (!atEnd() && text[pos] == '?') {
+                    // Only non-capturing groups; lookahead is not regular here
+                    if (pos + 1 >= limit || text[pos + 1] != ':') return false;
+                    pos += 2;
+                }
+                if (!parseAlternation(out)) return false;
+                if (atEnd() || text[pos] != ')') return false;
+                pos++;
+                return true;
+            }
+            if (c == '[') {
+                ByteSet set;
+                if (!parseClass(set)) return false;
+                out = addSet(set);
+                return true;
+            }
+            if (c == '.') {
+                pos++;
+                ByteSet set;
+                set.set();
+                set.reset('\n');
+                set.reset('\r');
+                out = addSet(set);
+                return true;
+            }
+            if (c == '\\') {
+                pos++;
+                ByteSet set;
+                if (!parseEscape(set)) return false;
+                out = addSet(set);
+                return true;
+            }
+            if (c == '^' || c == '$' || c == '*' || c == '+' || c == '?' || c == '{' || c == ')') {
+                return false;
+            }
+            pos++;
+            ByteSet set;
+            set.set(static_cast<unsigned char>(c));
+            out = addSet(set);
+            return true;
+        }
+
+        static ByteSet digitSet() {
+            ByteSet set;
+            for (int c = '0'; c <= '9'; ++c) set.set(c);
+            return set;
+        }
+
+        static ByteSet wordSet() {
+            ByteSet set = digitSet();
+            for (int c = 'a'; c <= 'z'; ++c) set.set(c);
+            for (int c = 'A'; c <= 'Z'; ++c) set.set(c);
+            set.set('_');
+            return set;
+        }
+
+        static ByteSet spaceSet() {
+            ByteSet set;
+            for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) set.set(static_cast<unsigned char>(c));
+            return set;
+        }
+
+        static int hexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        // Escape after the backslash. Adds its bytes to set; single
+        // characters are also reported through literal for class ranges.
+        bool parseEscape(ByteSet& set, int* literal = nullptr) {
+            if (atEnd()) return false;
+            const char c = text[pos++];
+            int value = -1;
+            switch (c) {
+                case 'd': set |= digitSet(); return true;
+                case 'D': set |= ~digitSet(); return true;
+                case 'w': set |= wordSet(); return true;
+                case 'W': set |= ~wordSet(); return true;
+                case 's': set |= spaceSet(); return true;
+                case 'S': set |= ~spaceSet(); return true;
+                case 't': value = '\t'; break;
+                case 'n': value = '\n'; break;
+                case 'r': value = '\r'; break;
+                case 'f': value = '\f'; break;
+                case 'v': value = '\v'; break;
+                case '0': value = 0; break;
+                case 'x': {
+                    if (pos + 2 > limit) return false;
+                    const int high = hexValue(text[pos]);
+                    const int low = hexValue(text[pos + 1]);
+                    if (high < 0 || low < 0) return false;
+                    value = high * 16 + low;
+                    pos += 2;
+                    break;
+                }
+                default:
+                    // Word boundaries, backreferences, \c and \u are out of scope
+                    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '1' && c <= '9')) {
+                        return false;
+                    }
+                    value = static_cast<unsigned char>(c);
+                    break;
+            }
+            set.set(static_cast<size_t>(value));
+            if (literal) *literal = value;
+            return true;
+        }
+
+        bool parseClass(ByteSet& out) {
+            pos++; // '['
+            bool negate = false;
+            if (!atEnd() && text[pos] == '^') {
+                negate = true;
+                pos++;
+            }
+            // ECMAScript reads [] and [^] as empty/any; leave those to std::regex
+            if (!atEnd() && text[pos] == ']') return false;
+
+            ByteSet set;
+            while (!atEnd() && text[pos] != ']') {
+                int low = -1;
+                if (text[pos] == '\\') {
+                    pos++;
+                    if (!atEnd() && text[pos] == 'b') return false; // Backspace in a class; rare enough to defer
+                    if (!parseEscape(set, &low)) return false;
+                } else {
+                    low = static_cast<unsigned char>(text[pos++]);
+                    set.set(static_cast<size_t>(low));
+                }
+
+                // Range a-z; a trailing '-' is a literal
+                if (low >= 0 && pos + 1 < limit && text[pos] == '-' && text[pos + 1] != ']') {
+                    pos++;
+                    int high = -1;
+                    if (text[pos] == '\\') {
+                        pos++;
+                        ByteSet unused;
+                        if (!parseEscape(unused, &high)) return false;
+                    } else {
+                        high = static_cast<unsigned char>(text[pos++]);
+                    }
+                    if (high < 0 || high < low) return false;
+                    for (int v = low; v <= high; ++v) set.set(static_cast<size_t>(v));
+                }
+            }
+            if (atEnd()) return false;
+            pos++; // ']'
+            out = negate ? ~set : set;
+            return true;
+        }
+    };
+
+    // Thompson NFA: consuming states carry a byte set and one successor,
+    // epsilon states carry any number of successors
+    struct NfaState {
+        bool consuming = false;
+        ByteSet set;
+        int next = -1;
+        std::vector<int> epsilon;
+    };
+
+    class NfaBuilder {
+    public:
+        NfaBuilder(const std::vector<Node>& nodes, std::vector<NfaState>& states) : nodes(nodes), states(states) {}
+
+        // Builds the fragment for node so that it continues into 'next' and
+        // returns its entry state. Returns -1 once the state budget is spent.
+        int build(int node, int next) {
+            if (next < 0 || states.size() > kMaxNfaStates) return -1;
+            const Node& n = nodes[node];
+            switch (n.kind) {
+                case Node::Empty:
+                    return next;
+                case Node::Set: {
+                    NfaState state;
+                    state.consuming = true;
+                    state.set = n.set;
+                    state.next = next;
+                    return add(std::move(state));
+                }
+                case Node::Concat: {
+                    int entry = next;
+                    for (auto it = n.children.rbegin(); it != n.children.rend(); ++it) {
+                        entry = build(*it, entry);
+                    }
+                    return entry;
+                }
+                case Node::Alternate: {
+                    std::vector<int> entries;
+                    for (int child : n.children) {
+                        entries.push_back(build(child, next));
+                    }
+                    if (std::find(entries.begin(), entries.end(), -1) != entries.end()) return -1;
+                    NfaState split;
+                    split.epsilon = std::move(entries);
+                    return add(std::move(split));
+                }
+                case Node::Repeat: {
+                    int tail = next;
+                    if (n.max < 0) {
+                        const int loop = add(NfaState());
+                        const int body = build(n.children[0], loop);
+                        if (body < 0) return -1;
+                        states[loop].epsilon = {body, next};
+                        tail = loop;
+                    } else {
+                        for (int i = n.min; i < n.max; ++i) {
+                            const int body = build(n.children[0], tail);
+                            if (body < 0) return -1;
+                            NfaState optional;
+                            optional.epsilon = {body, tail};
+                            tail = add(std::move(optional));
+                        }
+                    }
+                    for (int i = 0; i < n.min; ++i) {
+                        tail = build(n.children[0], tail);
+                    }
+                    return tail;
+                }
+            }
+            return -1;
+        }
+
+    private:
+        const std::vector<Node>& nodes;
+        std::vector<NfaState>& states;
+
+        int add(NfaState state) {
+            states.push_back(std::move(state));
+            return static_cast<int>(states.size() - 1);
+        }
+    };
+
+    // Consuming states reachable through epsilon moves, plus whether the
+    // match state (index 0) is among them
+    std::vector<int> closure(const std::vector<NfaState>& states, const std::vector<int>& seeds,
+                             std::vector<uint32_t>& visited, uint32_t stamp, bool& accepts) {
+        std::vector<int> result;
+        std::vector<int> stack(seeds.begin(), seeds.end());
+        accepts = false;
+        while (!stack.empty()) {
+            const int s = stack.back();
+            stack.pop_back();
+            if (visited[s] == stamp) continue;
+            visited[s] = stamp;
+            if (s == 0) {
+                accepts = true;
+            } else if (states[s].consuming) {
+                result.push_back(s);
+            } else {
+                stack.insert(stack.end(), states[s].epsilon.begin(), states[s].epsilon.end());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+NameMatcher::NameMatcher() : NameMatcher(std::string()) {}
+
+NameMatcher::NameMatcher(const std::string& pattern) : pattern(pattern), classCount(0) {
+    std::memset(byteClass, 0, sizeof(byteClass));
+    if (!compileDFA()) {
+        transitions.clear();
+        accepting.clear();
+        fallback.emplace(pattern, std::regex::ECMAScript | std::regex::optimize);
+    }
+}
+
+bool NameMatcher::matches(const std::string& name) const {
+    if (fallback) {
+        return std::regex_match(name, *fallback);
+    }
+
+    int32_t state = 0;
+    for (char c : name) {
+        state = transitions[static_cast<size_t>(state) * classCount + byteClass[static_cast<unsigned char>(c)]];
+        if (state < 0) {
+            return false;
+        }
+    }
+    return accepting[state] != 0;
+}
+
+bool NameMatcher::compileDFA() {
+    std::vector<Node> nodes;
+    int root = -1;
+    if (!Parser(pattern, nodes).parse(root)) {
+        return false;
+    }
+
+    // State 0 is the match state
+    std::vector<NfaState> states(1);
+    const int start = NfaBuilder(nodes, states).build(root, 0);
+    if (start < 0) {
+        return false;
+    }
+
+    // Bytes that no byte set tells apart share one DFA column
+    std::vector<uint32_t> classes(256, 0);
+    classCount = 1;
+    for (const auto& state : states) {
+        if (!state.consuming) continue;
+        std::map<std::pair<uint32_t, bool>, uint32_t> split;
+        for (int b = 0; b < 256; ++b) {
+            const auto key = std::make_pair(classes[b], static_cast<bool>(state.set[b]));
+            classes[b] = split.emplace(key, static_cast<uint32_t>(split.size())).first->second;
+        }
+        classCount = static_cast<uint32_t>(split.size());
+    }
+    std::vector<int> representative(classCount, -1);
+    for (int b = 0; b < 256; ++b) {
+        byteClass[b] = static_cast<uint8_t>(classes[b]);
+        if (representative[classes[b]] < 0) {
+            representative[classes[b]] = b;
+        }
+    }
+
+    // Subset construction
+    std::vector<uint32_t> visited(states.size(), 0);
+    uint32_t stamp = 0;
+    std::map<std::vector<int>, int32_t> ids;
+    std::vector<std::vector<int>> pending;
+
+    auto intern = [&](const std::vector<int>& seeds) -> int32_t {
+        bool accepts = false;
+        std::vector<int> key = closure(states, seeds, visited, ++stamp, accepts);
+        if (key.empty() && !accepts) {
+            return -1;
+        }
+        key.push_back(accepts ? -1 : -2); // Accepting flag is part of the identity
+        auto it = ids.find(key);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        const int32_t id = static_cast<int32_t>(accepting.size());
+        ids.emplace(key, id);
+        accepting.push_back(accepts ? 1 : 0);
+        key.pop_back();
+        pending.push_back(std::move(key));
+        return id;
+    };
+
+    intern({start});
+    for (size_t current = 0; current < pending.size(); ++current) {
+        if (accepting.size() > kMaxDfaStates) {
+            return false;
+        }
+        transitions.resize((current + 1) * classCount, -1);
+        for (uint32_t c = 0; c < classCount; ++c) {
+            std::vector<int> seeds;
+            for (int s : pending[current]) {
+                if (states[s].set[representative[c]]) {
+                    seeds.push_back(states[s].next);
+                }
+            }
+            if (!seeds.empty()) {
+                const int32_t target = intern(seeds);
+                transitions[current * classCount + c] = target;
+            }
+        }
+    }
+
+    // The start state always exists, even for patterns that match nothing
+    if (accepting.empty()) {
+        accepting.push_back(0);
+        transitions.assign(classCount, -1);
+    }
+    return true;
+}
@@ -0,0 +1,197 @@
+#include "QuadOverdrawAnalyzer.h"
+#include "ThreadPool.h"
+#include "VertexKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using VertexKernels::kTrianglesPerChunk;
+    using VertexKernels::kTriangleBlock;
+    using VertexKernels::fastLog2;
+
+    const float kPi = 3.14159265f;
+
+    // Projected areas (pixels at one metre) below this are degenerate
+    const float kMinArea = 1e-12f;
+
+    int binOf(float log2Distance) {
+        const float position = (log2Distance - QuadOverdrawProfile::kMinLog2Distance) *
+                               QuadOverdrawProfile::kBinsPerOctave;
+        return static_cast<int>(std::clamp(position, 0.0f, float(QuadOverdrawProfile::kBins - 1)));
+    }
+
+    float binEdge(int bin) {
+        return std::exp2(QuadOverdrawProfile::kMinLog2Distance + float(bin) / QuadOverdrawProfile::kBinsPerOctave);
+    }
+
+    // Quad cost with bins below split counted past their crossover (one
+    // quad per covered pixel) and the rest by footprint
+    QuadOverdrawSample sampleSplit(const QuadOverdrawProfile& profile, float distance, int split) {
+        QuadOverdrawSample sample;
+        sample.distance = distance;
+        if (profile.measuredTriangles == 0 || !(distance > 0.0f)) {
+            return sample;
+        }
+
+        double smallArea = 0.0, largeArea = 0.0, largePerimeter = 0.0;
+        uint64_t largeTriangles = 0, smallTriangles = 0;
+        for (int bin = 0; bin < QuadOverdrawProfile::kBins; ++bin) {
+            if (bin < split) {
+                smallArea += profile.binArea[bin];
+                smallTriangles += profile.binSmall[bin];
+            } else {
+                largeArea += profile.binArea[bin];
+                largePerimeter += profile.binPerimeter[bin];
+                largeTriangles += profile.binTriangles[bin];
+            }
+        }
+
+        const double d = distance;
+        const double covered = profile.area / (d * d);
+        const double quads = (smallArea + largeArea / 4.0) / (d * d) + largePerimeter / (kPi * d) + double(largeTriangles);
+        sample.quadEfficiency = quads > 0.0 ? static_cast<float>(std::min(1.0, covered / (4.0 * quads))) : 1.0f;
+        sample.smallTriangleShare = static_cast<float>(double(smallTriangles) / profile.measuredTriangles);
+        sample.pixelsPerTriangle = static_cast<float>(covered / profile.measuredTriangles);
+        return sample;
+    }
+
+    struct ChunkResult {
+        uint64_t measured = 0;
+        double area = 0.0;
+        std::vector<double> binArea;
+        std::vector<double> binPerimeter;
+        std::vector<uint32_t> binTriangles;
+        std::vector<uint32_t> binSmall;
+    };
+}
+
+QuadOverdrawAnalyzer::QuadOverdrawAnalyzer(uint32_t screenHeight, float verticalFovDegrees) {
+    const float fov = std::clamp(verticalFovDegrees, 1.0f, 179.0f) * kPi / 180.0f;
+    pixelsPerMetre = static_cast<float>(std::max(1u, screenHeight)) / (2.0f * std::tan(fov * 0.5f));
+}
+
+QuadOverdrawProfile QuadOverdrawAnalyzer::profile(const std::vector<glm::vec3>& vertices,
+                                                  const std::vector<uint32_t>& indices,
+                                                  const glm::mat4& worldTransform, ThreadPool& pool) const {
+    QuadOverdrawProfile result;
+    result.binArea.assign(QuadOverdrawProfile::kBins, 0.0);
+    result.binPerimeter.assign(QuadOverdrawProfile::kBins, 0.0);
+    result.binTriangles.assign(QuadOverdrawProfile::kBins, 0);
+    result.binSmall.assign(QuadOverdrawProfile::kBins, 0);
+    if (vertices.empty()) {
+        return result;
+    }
+
+    // Average scale of the node transform: cube root of the volume scale
+    const glm::mat4& m = worldTransform;
+    const glm::vec3 c0(m[0][0], m[0][1], m[0][2]), c1(m[1][0], m[1][1], m[1][2]), c2(m[2][0], m[2][1], m[2][2]);
+    const float scale = std::cbrt(std::fabs(glm::dot(c0, glm::cross(c1, c2))));
+    // Orientation averages: half the area, pi/4 of the length
+    const float areaScale = scale * scale * pixelsPerMetre * pixelsPerMetre * 0.5f;
+    const float lengthScale = scale * pixelsPerMetre * kPi / 4.0f;
+
+    const size_t triangleCount = indices.size() / 3;
+    const size_t vertexCount = vertices.size();
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    std::vector<ChunkResult> chunks(chunkCount);
+
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        ChunkResult& out = chunks[chunk];
+        out.binArea.assign(QuadOverdrawProfile::kBins, 0.0);
+        out.binPerimeter.assign(QuadOverdrawProfile::kBins, 0.0);
+        out.binTriangles.assign(QuadOverdrawProfile::kBins, 0);
+        out.binSmall.assign(QuadOverdrawProfile::kBins, 0);
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min(triangleCount, begin + kTrianglesPerChunk);
+
+        // Structure-of-arrays scratch for one block
+        VertexKernels::TriangleBlock tri;
+        float area[kTriangleBlock], perimeter[kTriangleBlock], crossLog[kTriangleBlock], smallLog[kTriangleBlock];
+        bool measured[kTriangleBlock];
+
+        for (size_t first = begin; first < end; first += kTriangleBlock) {
+            tri.gather(indices.data(), first, end, vertices.data(), vertexCount);
+
+            // Branch-free projection: pixel area and perimeter at one metre,
+            // then the log2 crossover and small-triangle distances
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                const float cx = tri.e0y[k] * tri.e1z[k] - tri.e0z[k] * tri.e1y[k];
+                const float cy = tri.e0z[k] * tri.e1x[k] - tri.e0x[k] * tri.e1z[k];
+                const float cz = tri.e0x[k] * tri.e1y[k] - tri.e0y[k] * tri.e1x[k];
+                const float e2x = tri.e1x[k] - tri.e0x[k], e2y = tri.e1y[k] - tri.e0y[k], e2z = tri.e1z[k] - tri.e0z[k];
+                const float e0Sq = tri.e0x[k] * tri.e0x[k] + tri.e0y[k] * tri.e0y[k] + tri.e0z[k] * tri.e0z[k];
+                const float e1Sq = tri.e1x[k] * tri.e1x[k] + tri.e1y[k] * tri.e1y[k] + tri.e1z[k] * tri.e1z[k];
+                area[k] = 0.5f * std::sqrt(cx * cx + cy * cy + cz * cz) * areaScale;
+                perimeter[k] = (std::sqrt(e0Sq) + std::sqrt(e1Sq) + std::sqrt(e2x * e2x + e2y * e2y + e2z * e2z)) *
+                               lengthScale;
+                // Footprint quads A/4 + P/pi + 1 reach A (pixels) at d* with
+                // d*^2 + (P0/pi) d* = 3/4 A0; the rationalized root stays
+                // accurate for slivers
+                const float b = perimeter[k] / kPi;
+                const float crossover = 1.5f * area[k] / (std::sqrt(b * b + 3.0f * area[k]) + b);
+                crossLog[k] = fastLog2(crossover);
+                smallLog[k] = fastLog2(0.5f * std::sqrt(area[k])); // Area under 4 pixels beyond here
+                // NaN fails the comparisons, as does an overflowed area
+                measured[k] = area[k] > kMinArea && area[k] < 1e30f && perimeter[k] < 1e30f;
+            }
+
+            for (size_t k = 0; k < tri.count; ++k) {
+                if (!tri.valid[k] || !measured[k]) {
+                    continue;
+                }
+                const int bin = binOf(crossLog[k]);
+                out.measured++;
+                out.area += area[k];
+                out.binArea[bin] += area[k];
+                out.binPerimeter[bin] += perimeter[k];
+                out.binTriangles[bin]++;
+                out.binSmall[binOf(smallLog[k])]++;
+            }
+        }
+    });
+
+    for (const ChunkResult& chunk : chunks) {
+        result.measuredTriangles += chunk.measured;
+        result.area += chunk.area;
+        for (int bin = 0; bin < QuadOverdrawProfile::kBins; ++bin) {
+            result.binArea[bin] += chunk.binArea[bin];
+            result.binPerimeter[bin] += chunk.binPerimeter[bin];
+            result.binTriangles[bin] += chunk.binTriangles[bin];
+            result.binSmall[bin] += chunk.binSmall[bin];
+        }
+    }
+    return result;
+}
+
+QuadOverdrawSample QuadOverdrawAnalyzer::sample(const QuadOverdrawProfile& profile, float distance) {
+    if (!(distance > 0.0f)) {
+        return sampleSplit(profile, distance, 0);
+    }
+    // Bins past the distance's own bin centre count as already crossed over
+    const float position = (std::log2(distance) - QuadOverdrawProfile::kMinLog2Distance) *
+                           QuadOverdrawProfile::kBinsPerOctave;
+    const int split = static_cast<int>(std::clamp(std::floor(position + 0.5f), 0.0f, float(QuadOverdrawProfile::kBins)));
+    return sampleSplit(profile, distance, split);
+}
+
+float QuadOverdrawAnalyzer::transitionDistance(const QuadOverdrawProfile& profile, float minEfficiency) {
+    if (profile.measuredTriangles == 0) {
+        return 0.0f;
+    }
+    // Bin edges split the triangles exactly
+    float previous = sampleSplit(profile, binEdge(0), 0).quadEfficiency;
+    if (previous < minEfficiency) {
+        return binEdge(0);
+    }
+    for (int edge = 1; edge <= QuadOverdrawProfile::kBins; ++edge) {
+        const float efficiency = sampleSplit(profile, binEdge(edge), edge).quadEfficiency;
+        if (efficiency < minEfficiency) {
+            // Interpolate in log distance between the two edges
+            const float t = (previous - minEfficiency) / (previous - efficiency);
+            return std::exp2(QuadOverdrawProfile::kMinLog2Distance +
+                             (float(edge - 1) + t) / QuadOverdrawProfile::kBinsPerOctave);
+        }
+        previous = efficiency;
+    }
+    return 0.0f;
+}
@@ -0,0 +1,1471 @@
+#include "Reporter.h"
+#include <fmt/core.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+// JSON serialization
+
+void to_json(nlohmann::json& j, const Severity& severity) {
+    switch (severity) {
+        case Severity::INFO:     j = "info"; break;
+        case Severity::WARNING:  j = "warning"; break;
+        case Severity::ERROR:    j = "error"; break;
+        case Severity::CRITICAL: j = "critical"; break;
+    }
+}
+
+void to_json(nlohmann::json& j, const ValidationIssue& issue) {
+    j = nlohmann::json{
+        {"severity", issue.severity},
+        {"category", issue.category},
+        {"message", issue.message},
+        {"location", issue.location},
+        {"suggestion", issue.suggestion}
+    };
+}
+
+void to_json(nlohmann::json& j, const PositionStreamStats& stats) {
+    j = nlohmann::json{
+        {"min", {stats.min.x, stats.min.y, stats.min.z}},
+        {"max", {stats.max.x, stats.max.y, stats.max.z}},
+        {"non_finite", stats.nonFiniteCount}
+    };
+}
+
+void to_json(nlohmann::json& j, const NormalStreamStats& stats) {
+    j = nlohmann::json{
+        {"non_finite", stats.nonFiniteCount},
+        {"length_deviation_limits", kNormalDeviationLimits},
+        {"length_deviation_histogram", stats.deviationHistogram}
+    };
+}
+
+void to_json(nlohmann::json& j, const UVStreamStats& stats) {
+    j = nlohmann::json{
+        {"min", {stats.min.x, stats.min.y}},
+        {"max", {stats.max.x, stats.max.y}},
+        {"out_of_range", stats.outOfRangeCount},
+        {"non_finite", stats.nonFiniteCount}
+    };
+}
+
+void to_json(nlohmann::json& j, const TexelDensityResult& result) {
+    j = nlohmann::json{
+        {"texture_size", {result.textureWidth, result.textureHeight}},
+        {"measured_triangles", result.measuredTriangles},
+        {"world_area", result.worldArea},
+        {"texel_area", result.texelArea},
+        {"min", result.minDensity},
+        {"median", result.medianDensity},
+        {"max", result.maxDensity},
+        {"histogram_bin_octaves", TexelDensityResult::kHistogramBinOctaves},
+        {"histogram", result.histogram},
+        {"outlier_triangles", result.outlierTriangles},
+        {"worst_triangles", result.worstTriangles},
+        {"mip_bias", result.mipBias},
+        {"streaming_priority", result.streamingPriority}
+    };
+}
+
+void to_json(nlohmann::json& j, const TangentFrameResult& result) {
+    j = nlohmann::json{
+        {"checked_triangles", result.checkedTriangles},
+        {"winding_mismatches", result.windingMismatchTriangles},
+        {"worst_winding_triangles", result.worstWindingTriangles}
+    };
+    if (result.hasTangents) {
+        j["tangents"] = {
+            {"non_finite", result.tangentStats.nonFiniteCount},
+            {"zero_length", result.tangentStats.zeroLengthCount},
+            {"mirrored", result.tangentStats.mirroredCount},
+            {"mixed_handedness_triangles", result.mixedHandednessTriangles},
+            {"mixed_handedness_samples", result.mixedHandednessSamples}
+        };
+    }
+}
+
+void to_json(nlohmann::json& j, const UVIslandSample& island) {
+    j = nlohmann::json{
+        {"first_triangle", island.firstTriangle},
+        {"triangles", island.triangles},
+        {"texels", island.texels}
+    };
+}
+
+void to_json(nlohmann::json& j, const UVIslandResult& result) {
+    j = nlohmann::json{
+        {"islands", result.islandCount},
+        {"position_vertices", result.positionVertices},
+        {"uv_vertices", result.uvVertices},
+        {"seam_vertices", result.seamVertices},
+        {"seam_edges", result.seamEdges},
+        {"seam_length", result.seamLength},
+        {"texture_width", result.textureWidth},
+        {"texture_height", result.textureHeight},
+        {"tiny_islands", result.tinyIslands},
+        {"tiny_island_triangles", result.tinyIslandTriangles},
+        {"smallest_islands", result.smallestIslands}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshComponent& component) {
+    j = nlohmann::json{
+        {"first_triangle", component.firstTriangle},
+        {"triangles", component.triangles},
+        {"min", {component.min.x, component.min.y, component.min.z}},
+        {"max", {component.max.x, component.max.y, component.max.z}},
+        {"volume_ratio", component.volumeRatio}
+    };
+    if (component.duplicateOf != MeshComponent::kNotDuplicate) {
+        j["duplicate_of"] = component.duplicateOf;
+    }
+}
+
+void to_json(nlohmann::json& j, const SelfIntersection& intersection) {
+    j = nlohmann::json{
+        {"triangle_a", intersection.triangleA},
+        {"triangle_b", intersection.triangleB},
+        {"location", {intersection.location.x, intersection.location.y, intersection.location.z}},
+        {"coplanar", intersection.coplanar}
+    };
+}
+
+void to_json(nlohmann::json& j, const SelfIntersectionResult& result) {
+    j = nlohmann::json{
+        {"candidate_pairs", result.candidatePairs},
+        {"intersecting_pairs", result.intersectingPairs},
+        {"coplanar_pairs", result.coplanarPairs},
+        {"intersecting_triangles", result.intersectingTriangles},
+        {"min", {result.min.x, result.min.y, result.min.z}},
+        {"max", {result.max.x, result.max.y, result.max.z}},
+        {"intersections", result.intersections}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshComponentResult& result) {
+    j = nlohmann::json{
+        {"components", result.componentCount},
+        {"largest_triangles", result.largestTriangles},
+        {"size_histogram", result.sizeHistogram},
+        {"debris_components", result.debrisComponents},
+        {"debris_triangles", result.debrisTriangles},
+        {"duplicate_shells", result.duplicateShells},
+        {"duplicate_triangles", result.duplicateTriangles},
+        {"largest", result.largestComponents},
+        {"removal_candidates", result.removalCandidates}
+    };
+}
+
+void to_json(nlohmann::json& j, const QuadOverdrawSample& sample) {
+    j = nlohmann::json{
+        {"distance", sample.distance},
+        {"quad_efficiency", sample.quadEfficiency},
+        {"small_triangle_share", sample.smallTriangleShare},
+        {"pixels_per_triangle", sample.pixelsPerTriangle}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshletResult& result) {
+    j = nlohmann::json{
+        {"meshlets", result.meshletCount},
+        {"triangles", result.triangles},
+        {"meshlet_vertices", result.meshletVertices},
+        {"vertices_per_triangle", result.verticesPerTriangle},
+        {"vertex_fill", result.vertexFill},
+        {"triangle_fill", result.triangleFill},
+        {"average_fill", result.averageFill},
+        {"underfilled_meshlets", result.underfilledMeshlets},
+        {"cullable_meshlets", result.cullableMeshlets},
+        {"meshlet_cull_rate", result.meshletCullRate},
+        {"triangle_cull_rate", result.triangleCullRate},
+        {"average_radius", result.averageRadius},
+        {"data_bytes", result.dataBytes}
+    };
+}
+
+void to_json(nlohmann::json& j, const QuadOverdrawResult& result) {
+    j = nlohmann::json{
+        {"measured_triangles", result.measuredTriangles},
+        {"references", result.references},
+        {"lod_distance", result.lodDistance}
+    };
+}
+
+void to_json(nlohmann::json& j, const BoundingSphere& sphere) {
+    j = nlohmann::json{
+        {"center", {sphere.center.x, sphere.center.y, sphere.center.z}},
+        {"radius", sphere.radius}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshBounds& bounds) {
+    if (!bounds.valid) {
+        j = nullptr;
+        return;
+    }
+    j = nlohmann::json{
+        {"min", {bounds.min.x, bounds.min.y, bounds.min.z}},
+        {"max", {bounds.max.x, bounds.max.y, bounds.max.z}},
+        {"sphere", bounds.sphere},
+        {"world", {
+            {"min", {bounds.worldMin.x, bounds.worldMin.y, bounds.worldMin.z}},
+            {"max", {bounds.worldMax.x, bounds.worldMax.y, bounds.worldMax.z}},
+            {"sphere", bounds.worldSphere}
+        }},
+        {"core_radius", bounds.coreRadius},
+        {"stray_vertices", bounds.strayVertices},
+        {"max_stray_distance", bounds.maxStrayDistance},
+        {"worst_stray_vertices", bounds.worstStrayVertices}
+    };
+}
+
+void to_json(nlohmann::json& j, const SceneBounds& bounds) {
+    if (!bounds.valid) {
+        j = nullptr;
+        return;
+    }
+    j = nlohmann::json{
+        {"min", {bounds.min.x, bounds.min.y, bounds.min.z}},
+        {"max", {bounds.max.x, bounds.max.y, bounds.max.z}},
+        {"sphere", bounds.sphere}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshValidationResult& result) {
+    nlohmann::json caches = nlohmann::json::array();
+    for (const auto& cache : result.vertexCaches) {
+        caches.push_back({
+            {"model", VertexCacheAnalyzer::modelName(cache.model)},
+            {"cache_size", cache.cacheSize},
+            {"acmr", cache.acmr},
+            {"atvr", cache.atvr},
+            {"fetch_overfetch", cache.overfetch}
+        });
+    }
+    j = nlohmann::json{
+        {"name", result.meshName},
+        {"vertex_count", result.vertexCount},
+        {"triangle_count", result.triangleCount},
+        {"material_count", result.materialCount},
+        {"has_valid_uvs", result.hasValidUVs},
+        {"positions", result.positionStats},
+        {"normals", result.normalStats},
+        {"uvs", result.uvStats},
+        {"degenerate_triangles", {
+            {"zero_area", result.zeroAreaTriangles},
+            {"near_degenerate", result.nearDegenerateTriangles},
+            {"triangles", result.degenerateTriangles}
+        }},
+        {"duplicate_vertices", {
+            {"coincident", result.coincidentVertices},
+            {"weldable", result.weldableVertices}
+        }},
+        {"topology", {
+            {"boundary_edges", result.boundaryEdges},
+            {"boundary_loops", result.boundaryLoops},
+            {"non_manifold_edges", result.nonManifoldEdges},
+            {"winding_flips", result.windingFlips},
+            {"watertight", result.isWatertight}
+        }},
+        {"connected_components", result.components},
+        {"self_intersections", result.selfIntersections},
+        {"vertex_cache", {
+            {"acmr", result.acmr},
+            {"atvr", result.atvr},
+            {"fetch_overfetch", result.vertexFetchOverfetch},
+            {"caches", caches}
+        }},
+        {"meshlets", result.meshlets},
+        {"quad_overdraw", result.quadOverdraw},
+        {"uv_overlap", {
+            {"percentage", result.uvOverlapPercentage},
+            {"triangles", result.overlappingTriangles}
+        }},
+        {"uv_islands", result.uvIslands},
+        {"texel_density", result.texelDensity},
+        {"bounds", result.bounds},
+        {"tangent_frames", result.tangentFrames},
+        {"issues", result.issues}
+    };
+}
+
+void to_json(nlohmann::json& j, const MaterialValidationResult& result) {
+    j = nlohmann::json{
+        {"name", result.materialName},
+        {"textures", result.textures},
+        {"has_valid_textures", result.hasValidTextures},
+        {"texel_density", {
+            {"density", result.texelDensity},
+            {"spread", result.texelDensitySpread}
+        }},
+        {"issues", result.issues}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshOptimizationResult& result) {
+    j = nlohmann::json{
+        {"name", result.meshName},
+        {"vertices", {{"before", result.verticesBefore}, {"after", result.verticesAfter}}},
+        {"triangles", {{"before", result.trianglesBefore}, {"after", result.trianglesAfter}}},
+        {"acmr", {{"before", result.acmrBefore}, {"after", result.acmrAfter}}},
+        {"bytes", {{"before", result.bytesBefore}, {"after", result.bytesAfter}}}
+    };
+}
+
+void to_json(nlohmann::json& j, const LodLevelResult& result) {
+    j = nlohmann::json{
+        {"target_ratio", result.targetRatio},
+        {"triangles", result.triangleCount},
+        {"vertices", result.vertexCount},
+        {"error", result.error},
+        {"relative_error", result.relativeError}
+    };
+}
+
+void to_json(nlohmann::json& j, const MeshLodResult& result) {
+    j = nlohmann::json{
+        {"name", result.meshName},
+        {"base_triangles", result.baseTriangles},
+        {"levels", result.levels}
+    };
+}
+
+void to_json(nlohmann::json& j, const GpuMemoryEntry& entry) {
+    j = nlohmann::json{
+        {"name", entry.name},
+        {"kind", entry.kind},
+        {"bytes", entry.estimate.bytes}
+    };
+    if (entry.kind == "mesh") {
+        j["vertex_bytes"] = entry.estimate.vertexBytes;
+        j["index_bytes"] = entry.estimate.indexBytes;
+        j["vertex_stride"] = entry.estimate.vertexStride;
+        j["index_size"] = entry.estimate.indexSize;
+        j["instances"] = entry.instances;
+    } else {
+        j["width"] = entry.width;
+        j["height"] = entry.height;
+        j["format"] = GpuMemoryEstimator::formatName(entry.estimate.format);
+        j["mip_levels"] = entry.estimate.mipLevels;
+    }
+}
+
+void to_json(nlohmann::json& j, const GpuMemoryResult& result) {
+    j = nlohmann::json{
+        {"mesh_bytes", result.meshBytes},
+        {"texture_bytes", result.textureBytes},
+        {"total_bytes", result.totalBytes},
+        {"entries", result.entries}
+    };
+}
+
+void to_json(nlohmann::json& j, const ProfileVerdict& verdict) {
+    j = nlohmann::json{
+        {"name", verdict.name},
+        {"valid", verdict.isValid},
+        {"stopped_early", verdict.stoppedEarly},
+        {"critical", verdict.criticalCount},
+        {"errors", verdict.errorCount},
+        {"warnings", verdict.warningCount},
+        {"info", verdict.infoCount},
+        {"failures", verdict.failures},
+        {"metrics_computed", verdict.metricsComputed},
+        {"metrics_reused", verdict.metricsReused}
+    };
+}
+
+void to_json(nlohmann::json& j, const DuplicateMeshGroup& group) {
+    j = nlohmann::json{
+        {"meshes", group.meshes},
+        {"transformed", group.transformed},
+        {"stored_copies", group.storedCopies},
+        {"bytes_saved", group.bytesSaved},
+        {"draws_saved", group.drawsSaved}
+    };
+    if (!group.indexFile.empty()) {
+        j["index_file"] = group.indexFile;
+        j["index_mesh"] = group.indexMesh;
+    }
+}
+
+void to_json(nlohmann::json& j, const DuplicateMeshResult& result) {
+    j = nlohmann::json{
+        {"duplicate_meshes", result.duplicateMeshes},
+        {"transformed_meshes", result.transformedMeshes},
+        {"bytes_saved", result.bytesSaved},
+        {"draws_saved", result.drawsSaved},
+        {"index_matches", result.indexMatches},
+        {"groups", result.groups}
+    };
+}
+
+void to_json(nlohmann::json& j, const MaterialDedupGroup& group) {
+    j = nlohmann::json{
+        {"hash", fmt::format("{:016x}", group.hash)},
+        {"materials", group.materials}
+    };
+    if (!group.indexFile.empty()) {
+        j["index_file"] = group.indexFile;
+        j["index_material"] = group.indexMaterial;
+    }
+}
+
+void to_json(nlohmann::json& j, const MaterialDedupResult& result) {
+    nlohmann::json candidates = nlohmann::json::array();
+    for (const auto& group : result.groups) {
+        if (group.materials.size() > 1 || !group.indexFile.empty()) {
+            candidates.push_back(group);
+        }
+    }
+    j = nlohmann::json{
+        {"materials", result.materialCount},
+        {"unique", result.uniqueMaterials},
+        {"index_matches", result.indexMatches},
+        {"estimated_reduction", result.materialCount - result.uniqueMaterials + result.indexMatches},
+        {"candidates", candidates}
+    };
+}
+
+void to_json(nlohmann::json& j, const DrawBatch& batch) {
+    j = nlohmann::json{
+        {"kind", batch.kind == DrawBatch::Kind::Instance ? "instance" : "merge"},
+        {"material", batch.material == DrawBatch::kNoMaterial ? nlohmann::json(nullptr) : nlohmann::json(batch.material)},
+        {"vertex_format", DrawCallEstimator::vertexFormatName(batch.vertexFormat)},
+        {"meshes", batch.meshes},
+        {"vertices", batch.vertices},
+        {"triangles", batch.triangles},
+        {"draws_saved", batch.drawsSaved()}
+    };
+}
+
+void to_json(nlohmann::json& j, const DrawCallStats& stats) {
+    j = nlohmann::json{
+        {"mesh_draws", stats.meshDraws},
+        {"estimated_draws", stats.estimatedDraws},
+        {"instanced_meshes", stats.instancedMeshes},
+        {"merged_meshes", stats.mergedMeshes},
+        {"state_changes", {
+            {"material", stats.materialChanges},
+            {"vertex_format", stats.formatChanges},
+            {"sorted_material", stats.sortedMaterialChanges},
+            {"sorted_vertex_format", stats.sortedFormatChanges}
+        }},
+        {"batches", stats.batches}
+    };
+}
+
+void to_json(nlohmann::json& j, const HiddenMeshResult& result) {
+    j = nlohmann::json{
+        {"mesh", result.mesh},
+        {"triangles", result.triangles},
+        {"hidden_triangles", result.hiddenTriangles},
+        {"hidden_percentage", result.hiddenPercentage},
+        {"hidden_samples", result.hiddenSamples}
+    };
+}
+
+void to_json(nlohmann::json& j, const HiddenGeometryResult& result) {
+    j = nlohmann::json{
+        {"scene_triangles", result.sceneTriangles},
+        {"tested_triangles", result.testedTriangles},
+        {"hidden_triangles", result.hiddenTriangles},
+        {"hidden_percentage", result.hiddenPercentage},
+        {"directions", result.directions},
+        {"rays_cast", result.raysCast},
+        {"bvh_nodes", result.bvhNodes},
+        {"meshes", result.meshes}
+    };
+}
+
+void to_json(nlohmann::json& j, const RuleCostResult& result) {
+    j = nlohmann::json{
+        {"rule", result.ruleName},
+        {"scope", result.scope},
+        {"cost_tier", result.costTier},
+        {"data", result.data},
+        {"invocations", result.invocations},
+        {"items_processed", result.itemsProcessed},
+        {"total_ms", result.totalMs}
+    };
+}
+
+void to_json(nlohmann::json& j, const ValidationResult& result) {
+    j = nlohmann::json{
+        {"file", result.filePath},
+        {"valid", result.isValid},
+        {"global_issues", result.globalIssues},
+        {"meshes", result.meshResults},
+        {"materials", result.materialResults},
+        {"scene_bounds", result.sceneBounds},
+        {"gpu_memory", result.gpuMemory},
+        {"draw_calls", result.drawCalls},
+        {"duplicate_meshes", result.duplicateMeshes},
+        {"material_dedup", result.materialDedup},
+        {"rule_costs", result.ruleCosts}
+    };
+    if (result.hiddenGeometry.analyzed) {
+        j["hidden_geometry"] = result.hiddenGeometry;
+    }
+    if (!result.profiles.empty()) {
+        j["profiles"] = result.profiles;
+    }
+    if (!result.optimizedFilePath.empty()) {
+        j["optimization"] = {
+            {"output", result.optimizedFilePath},
+            {"output_bytes", result.optimizedFileSize},
+            {"meshes", result.optimizationResults}
+        };
+    }
+    if (!result.lodResults.empty()) {
+        j["lods"] = result.lodResults;
+    }
+    if (result.stoppedEarly) {
+        j["stopped_early"] = true;
+    }
+}
+
+// Reporter
+
+Reporter::Reporter() : verboseOutput(false), includeStatistics(true), includeSuggestions(true) {}
+
+Reporter::~Reporter() = default;
+
+bool Reporter::generateReport(const ValidationResult& result, const std::string& outputPath, ReportFormat format) {
+    switch (format) {
+        case ReportFormat::JSON:    return generateJSONReport(result, outputPath);
+        case ReportFormat::HTML:    return generateHTMLReport(result, outputPath);
+        case ReportFormat::CONSOLE: return generateConsoleReport(result);
+    }
+    lastError = "Unknown report format";
+    return false;
+}
+
+bool Reporter::generateJSONReport(const ValidationResult& result, const std::string& outputPath) {
+    try {
+        return writeToFile(createJSONReport(result).dump(4), outputPath);
+    } catch (const std::exception& e) {
+        lastError = "Failed to create JSON report: " + std::string(e.what());
+        return false;
+    }
+}
+
+bool Reporter::generateHTMLReport(const ValidationResult& result, const std::string& outputPath) {
+    return writeToFile(createHTMLReport(result), outputPath);
+}
+
+bool Reporter::generateTexelDensityHints(const ValidationResult& result, const std::string& outputPath,
+                                         float targetDensity) {
+    nlohmann::json meshes = nlohmann::json::array();
+    for (const auto& mesh : result.meshResults) {
+        const TexelDensityResult& density = mesh.texelDensity;
+        if (density.measuredTriangles == 0) {
+            continue;
+        }
+        meshes.push_back({
+            {"mesh", mesh.meshName},
+            {"texture_size", {density.textureWidth, density.textureHeight}},
+            {"texel_density", density.medianDensity},
+            {"mip_bias", density.mipBias},
+            {"streaming_priority", density.streamingPriority}
+        });
+    }
+    
+    const nlohmann::json hints = {
+        {"source", result.filePath},
+        {"target_texel_density", targetDensity},
+        {"meshes", meshes}
+    };
+    try {
+        return writeToFile(hints.dump(4), outputPath);
+    } catch (const std::exception& e) {
+        lastError = "Failed to create texel density hints: " + std::string(e.what());
+        return false;
+    }
+}
+
+bool Reporter::generateConsoleReport(const ValidationResult& result) {
+    printConsoleSummary(result);
+    printConsoleProfiles(result);
+    if (includeStatistics && !result.stoppedEarly) {
+        printConsoleStatistics(result);
+    }
+    printConsoleIssues(result.globalIssues, "Scene Issues");
+    printConsoleMeshDetails(result.meshResults);
+    printConsoleMaterialDetails(result.materialResults);
+    printConsoleBounds(result);
+    printConsoleGpuMemory(result);
+    printConsoleDrawCalls(result);
+    printConsoleHiddenGeometry(result);
+    printConsoleDuplicateMeshes(result);
+    printConsoleMaterialDedup(result);
+    printConsoleOptimization(result);
+    printConsoleLods(result);
+    if (verboseOutput) {
+        printConsoleRuleCosts(result);
+    }
+    return true;
+}
+
+// JSON report helpers
+
+nlohmann::json Reporter::createJSONReport(const ValidationResult& result) {
+    nlohmann::json report = result;
+    report["timestamp"] = getCurrentTimestamp();
+
+    addIssueSummaryToJSON(report, result);
+    if (includeStatistics && !result.stoppedEarly) {
+        addStatisticsToJSON(report, result);
+    }
+
+    if (!includeSuggestions) {
+        auto stripSuggestions = [](nlohmann::json& issues) {
+            for (auto& issue : issues) {
+                issue.erase("suggestion");
+            }
+        };
+        stripSuggestions(report["global_issues"]);
+        for (auto& mesh : report["meshes"]) {
+            stripSuggestions(mesh["issues"]);
+        }
+        for (auto& material : report["materials"]) {
+            stripSuggestions(material["issues"]);
+        }
+    }
+
+    return report;
+}
+
+void Reporter::addStatisticsToJSON(nlohmann::json& report, const ValidationResult& result) {
+    report["statistics"] = {
+        {"total_vertices", result.totalVertices},
+        {"total_triangles", result.totalTriangles},
+        {"total_meshes", result.totalMeshes},
+        {"total_materials", result.totalMaterials},
+        {"total_textures", result.totalTextures}
+    };
+}
+
+void Reporter::addIssueSummaryToJSON(nlohmann::json& report, const ValidationResult& result) {
+    IssueSummary summary = calculateIssueSummary(result);
+    report["summary"] = {
+        {"info", summary.infoCount},
+        {"warnings", summary.warningCount},
+        {"errors", summary.errorCount},
+        {"critical", summary.criticalCount},
+        {"total", summary.getTotalCount()}
+    };
+}
+
+// HTML report helpers
+
+std::string Reporter::createHTMLReport(const ValidationResult& result) {
+    std::string html = generateHTMLHeader("Validation Report - " + result.filePath);
+    html += generateHTMLSummary(result);
+    html += generateHTMLProfiles(result);
+    if (includeStatistics && !result.stoppedEarly) {
+        html += generateHTMLStatistics(result);
+    }
+    html += generateHTMLIssueTable(result.globalIssues, "Scene Issues");
+    html += generateHTMLMeshDetails(result.meshResults);
+    html += generateHTMLMaterialDetails(result.materialResults);
+    html += generateHTMLTexelDensity(result);
+    html += generateHTMLBounds(result);
+    html += generateHTMLGpuMemory(result);
+    html += generateHTMLDrawCalls(result);
+    html += generateHTMLHiddenGeometry(result);
+    html += generateHTMLDuplicateMeshes(result);
+    html += generateHTMLMaterialDedup(result);
+    html += generateHTMLOptimization(result);
+    html += generateHTMLLods(result);
+    html += generateHTMLRuleCosts(result);
+    html += generateHTMLFooter();
+    return html;
+}
+
+std::string Reporter::generateHTMLHeader(const std::string& title) {
+    return fmt::format(
+        "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>{}</title>\n"
+        "<style>\n"
+        "body {{ font-family: sans-serif; margin: 2em; }}\n"
+        "table {{ border-collapse: collapse; margin-bottom: 1.5em; }}\n"
+        "th, td {{ border: 1px solid #ccc; padding: 4px 8px; text-align: left; }}\n"
+        "th {{ background: #f0f0f0; }}\n"
+        "</style>\n</head>\n<body>\n<h1>{}</h1>\n",
+        escapeHTML(title), escapeHTML(title));
+}
+
+std::string Reporter::generateHTMLSummary(const ValidationResult& result) {
+    IssueSummary summary = calculateIssueSummary(result);
+    return fmt::format(
+        "<h2>Summary</h2>\n<p>Status: <strong style=\"color:{}\">{}</strong></p>\n"
+        "<p>{} critical, {} errors, {} warnings, {} info</p>\n{}<p>Generated {}</p>\n",
+        result.isValid ? "#2e7d32" : "#c62828", result.isValid ? "PASSED" : "FAILED",
+        summary.criticalCount, summary.errorCount, summary.warningCount, summary.infoCount,
+        result.stoppedEarly ? "<p>Stopped at the error budget; remaining rules were skipped</p>\n" : "",
+        getCurrentTimestamp());
+}
+
+std::string Reporter::generateHTMLProfiles(const ValidationResult& result) {
+    if (result.profiles.empty()) {
+        return "";
+    }
+
+    std::string html = "<h2>Profiles</h2>\n<p>Details below are for the first profile</p>\n<table>\n"
+                       "<tr><th>Profile</th><th>Status</th><th>Critical</th><th>Errors</th><th>Warnings</th>"
+                       "<th>Info</th><th>Metrics Reused</th></tr>\n";
+    for (const auto& verdict : result.profiles) {
+        html += fmt::format("<tr><td>{}</td><td style=\"color:{}\">{}</td><td>{}</td><td>{}</td><td>{}</td>"
+                            "<td>{}</td><td>{} of {}</td></tr>\n",
+                            escapeHTML(verdict.name), verdict.isValid ? "#2e7d32" : "#c62828",
+                            verdict.isValid ? "PASSED" : "FAILED", verdict.criticalCount, verdict.errorCount,
+                            verdict.warningCount, verdict.infoCount, verdict.metricsReused,
+                            verdict.metricsComputed + verdict.metricsReused);
+    }
+    html += "</table>\n";
+    for (const auto& verdict : result.profiles) {
+        if (!verdict.failures.empty()) {
+            html += generateHTMLIssueTable(verdict.failures, "Failures: " + verdict.name);
+        }
+    }
+    return html;
+}
+
+std::string Reporter::generateHTMLStatistics(const ValidationResult& result) {
+    return fmt::format(
+        "<h2>Statistics</h2>\n<table>\n"
+        "<tr><th>Vertices</th><td>{}</td></tr>\n"
+        "<tr><th>Triangles</th><td>{}</td></tr>\n"
+        "<tr><th>Meshes</th><td>{}</td></tr>\n"
+        "<tr><th>Materials</th><td>{}</td></tr>\n"
+        "<tr><th>Textures</th><td>{}</td></tr>\n"
+        "</table>\n",
+        result.totalVertices, result.totalTriangles, result.totalMeshes,
+        result.totalMaterials, result.totalTextures);
+}
+
+std::string Reporter::generateHTMLIssueTable(const std::vector<ValidationIssue>& issues, const std::string& title) {
+    if (issues.empty()) {
+        return "";
+    }
+
+    std::string html = fmt::format("<h3>{}</h3>\n<table>\n<tr><th>Severity</th><th>Category</th>"
+                                   "<th>Message</th><th>Location</th>{}</tr>\n",
+                                   escapeHTML(title), includeSuggestions ? "<th>Suggestion</th>" : "");
+    for (const auto& issue : issues) {
+        nlohmann::json severity = issue.severity;
+        html += fmt::format("<tr><td style=\"color:{}\">{} {}</td><td>{}</td><td>{}</td><td>{}</td>",
+                            getSeverityColor(issue.severity), getSeverityIcon(issue.severity),
+                            severity.get<std::string>(), escapeHTML(issue.category),
+                            escapeHTML(issue.message), escapeHTML(issue.location));
+        if (includeSuggestions) {
+            html += fmt::format("<td>{}</td>", escapeHTML(issue.suggestion));
+        }
+        html += "</tr>\n";
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLMeshDetails(const std::vector<MeshValidationResult>& meshResults) {
+    if (meshResults.empty()) {
+        return "";
+    }
+
+    std::string html = "<h2>Meshes</h2>\n<table>\n<tr><th>Name</th><th>Vertices</th><th>Triangles</th>"
+                       "<th>Valid UVs</th><th>UV Overlap</th><th>UV Islands</th><th>Seam Vertices</th><th>Issues</th></tr>\n";
+    for (const auto& mesh : meshResults) {
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{:.2f}%</td><td>{}</td><td>{}</td>"
+                            "<td>{}</td></tr>\n",
+                            escapeHTML(mesh.meshName), mesh.vertexCount, mesh.triangleCount,
+                            mesh.hasValidUVs ? "yes" : "no", mesh.uvOverlapPercentage, mesh.uvIslands.islandCount,
+                            mesh.uvIslands.seamVertices, mesh.issues.size());
+    }
+    html += "</table>\n";
+
+    for (const auto& mesh : meshResults) {
+        html += generateHTMLIssueTable(mesh.issues, "Mesh: " + mesh.meshName);
+    }
+    return html;
+}
+
+std::string Reporter::generateHTMLMaterialDetails(const std::vector<MaterialValidationResult>& materialResults) {
+    if (materialResults.empty()) {
+        return "";
+    }
+
+    std::string html = "<h2>Materials</h2>\n<table>\n<tr><th>Name</th><th>Textures</th>"
+                       "<th>Valid Textures</th><th>Issues</th></tr>\n";
+    for (const auto& material : materialResults) {
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td></tr>\n",
+                            escapeHTML(material.materialName), material.textures.size(),
+                            material.hasValidTextures ? "yes" : "no", material.issues.size());
+    }
+    html += "</table>\n";
+
+    for (const auto& material : materialResults) {
+        html += generateHTMLIssueTable(material.issues, "Material: " + material.materialName);
+    }
+    return html;
+}
+
+std::string Reporter::generateHTMLTexelDensity(const ValidationResult& result) {
+    std::string rows;
+    for (const auto& mesh : result.meshResults) {
+        const TexelDensityResult& density = mesh.texelDensity;
+        if (density.measuredTriangles == 0) {
+            continue;
+        }
+        rows += fmt::format("<tr><td>{}</td><td>{}x{}</td><td>{:.1f}</td><td>{:.1f} &ndash; {:.1f}</td>"
+                            "<td>{} / {}</td><td>{:+.2f}</td><td>{:.2f}</td></tr>\n",
+                            escapeHTML(mesh.meshName), density.textureWidth, density.textureHeight,
+                            density.medianDensity, density.minDensity, density.maxDensity,
+                            density.outlierTriangles, density.measuredTriangles, density.mipBias,
+                            density.streamingPriority);
+    }
+    if (rows.empty()) {
+        return "";
+    }
+
+    return "<h2>Texel Density</h2>\n<table>\n"
+           "<tr><th>Mesh</th><th>Texture</th><th>Median (texels/m)</th><th>Range</th>"
+           "<th>Outliers</th><th>Mip Bias</th><th>Streaming Priority</th></tr>\n" +
+           rows + "</table>\n";
+}
+
+std::string Reporter::generateHTMLBounds(const ValidationResult& result) {
+    if (!result.sceneBounds.valid) {
+        return "";
+    }
+
+    auto vec = [](const glm::vec3& v) { return fmt::format("({:.3f}, {:.3f}, {:.3f})", v.x, v.y, v.z); };
+    std::string html = "<h2>Bounds</h2>\n<table>\n"
+                       "<tr><th>Mesh</th><th>World Min</th><th>World Max</th><th>Sphere Center</th>"
+                       "<th>Sphere Radius</th><th>Stray Vertices</th></tr>\n";
+    html += fmt::format("<tr><td><strong>Scene</strong></td><td>{}</td><td>{}</td><td>{}</td><td>{:.3f}</td>"
+                        "<td></td></tr>\n",
+                        vec(result.sceneBounds.min), vec(result.sceneBounds.max),
+                        vec(result.sceneBounds.sphere.center), result.sceneBounds.sphere.radius);
+    for (const auto& mesh : result.meshResults) {
+        const MeshBounds& bounds = mesh.bounds;
+        if (!bounds.valid) {
+            continue;
+        }
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{:.3f}</td><td>{}</td></tr>\n",
+                            escapeHTML(mesh.meshName), vec(bounds.worldMin), vec(bounds.worldMax),
+                            vec(bounds.worldSphere.center), bounds.worldSphere.radius, bounds.strayVertices);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLGpuMemory(const ValidationResult& result) {
+    const GpuMemoryResult& memory = result.gpuMemory;
+    if (memory.entries.empty()) {
+        return "";
+    }
+
+    std::string html = fmt::format("<h2>GPU Memory</h2>\n<p>Total {} (meshes {}, textures {})</p>\n<table>\n"
+                                   "<tr><th>Asset</th><th>Kind</th><th>Size</th><th>Share</th><th>Layout</th></tr>\n",
+                                   formatFileSize(memory.totalBytes), formatFileSize(memory.meshBytes),
+                                   formatFileSize(memory.textureBytes));
+    for (const auto& entry : memory.entries) {
+        const GpuMemoryEstimate& estimate = entry.estimate;
+        const std::string layout = entry.kind == "mesh"
+            ? fmt::format("{}-byte vertices, {}-bit indices{}", estimate.vertexStride, estimate.indexSize * 8,
+                          entry.instances > 1 ? fmt::format(", {} instances", entry.instances) : "")
+            : fmt::format("{}x{} {}, {} mips", entry.width, entry.height,
+                          GpuMemoryEstimator::formatName(estimate.format), estimate.mipLevels);
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{:.1f}%</td><td>{}</td></tr>\n",
+                            escapeHTML(entry.name), entry.kind, formatFileSize(estimate.bytes),
+                            memory.totalBytes > 0 ? 100.0 * estimate.bytes / memory.totalBytes : 0.0, layout);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLDrawCalls(const ValidationResult& result) {
+    const DrawCallStats& draws = result.drawCalls;
+    if (draws.meshDraws == 0) {
+        return "";
+    }
+
+    std::string html = fmt::format("<h2>Draw Calls</h2>\n<p>{} draws with {} material changes as submitted; "
+                                   "{} draws with {} material changes after batching</p>\n",
+                                   draws.meshDraws, draws.materialChanges, draws.estimatedDraws,
+                                   draws.sortedMaterialChanges);
+    if (draws.batches.empty()) {
+        return html;
+    }
+    html += "<table>\n<tr><th>Batch</th><th>Material</th><th>Vertex Format</th><th>Meshes</th>"
+            "<th>Vertices</th><th>Draws Saved</th></tr>\n";
+    for (const auto& batch : draws.batches) {
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td></tr>\n",
+                            batch.kind == DrawBatch::Kind::Instance ? "instance" : "merge",
+                            batch.material == DrawBatch::kNoMaterial ? std::string("-") : std::to_string(batch.material),
+                            DrawCallEstimator::vertexFormatName(batch.vertexFormat), batch.meshes.size(),
+                            batch.vertices, batch.drawsSaved());
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLHiddenGeometry(const ValidationResult& result) {
+    const HiddenGeometryResult& hidden = result.hiddenGeometry;
+    if (!hidden.analyzed || hidden.testedTriangles == 0) {
+        return "";
+    }
+
+    std::string html = fmt::format("<h2>Hidden Geometry</h2>\n<p>{} of {} triangles ({:.1f}%) cannot be seen from "
+                                   "any direction ({} rays, {} directions per sample)</p>\n",
+                                   hidden.hiddenTriangles, hidden.testedTriangles, hidden.hiddenPercentage,
+                                   hidden.raysCast, hidden.directions + 2);
+    if (hidden.meshes.empty()) {
+        return html;
+    }
+    html += "<table>\n<tr><th>Mesh</th><th>Triangles</th><th>Hidden</th><th>Hidden %</th></tr>\n";
+    for (const auto& mesh : hidden.meshes) {
+        const std::string name = mesh.mesh < result.meshResults.size()
+            ? escapeHTML(result.meshResults[mesh.mesh].meshName) : std::to_string(mesh.mesh);
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{:.1f}</td></tr>\n",
+                            name, mesh.triangles, mesh.hiddenTriangles, mesh.hiddenPercentage);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLDuplicateMeshes(const ValidationResult& result) {
+    const DuplicateMeshResult& duplicates = result.duplicateMeshes;
+    if (duplicates.groups.empty()) {
+        return "";
+    }
+
+    auto meshName = [&](uint32_t m) {
+        return m < result.meshResults.size() ? escapeHTML(result.meshResults[m].meshName) : std::to_string(m);
+    };
+    std::string html = fmt::format("<h2>Duplicate Meshes</h2>\n<p>{} meshes copy other meshes ({} after a rigid "
+                                   "transform), {} match meshes of other files: instancing saves {} and {} draws</p>\n"
+                                   "<table>\n<tr><th>Source</th><th>Meshes</th><th>Match</th><th>Stored Copies</th>"
+                                   "<th>Memory Saved</th><th>Draws Saved</th><th>Indexed As</th></tr>\n",
+                                   duplicates.duplicateMeshes, duplicates.transformedMeshes, duplicates.indexMatches,
+                                   formatFileSize(duplicates.bytesSaved), duplicates.drawsSaved);
+    for (const auto& group : duplicates.groups) {
+        const std::string indexed = group.indexFile.empty()
+            ? std::string()
+            : escapeHTML(group.indexMesh) + " (" + escapeHTML(group.indexFile) + ")";
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td></tr>\n",
+                            meshName(group.meshes[0]), group.meshes.size(), group.transformed ? "rigid" : "exact",
+                            group.storedCopies, formatFileSize(group.bytesSaved), group.drawsSaved, indexed);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLMaterialDedup(const ValidationResult& result) {
+    const MaterialDedupResult& dedup = result.materialDedup;
+    const uint32_t reduction = dedup.materialCount - dedup.uniqueMaterials + dedup.indexMatches;
+    if (reduction == 0) {
+        return "";
+    }
+
+    auto materialName = [&](uint32_t m) {
+        return m < result.materialResults.size() ? escapeHTML(result.materialResults[m].materialName) : std::to_string(m);
+    };
+    std::string html = fmt::format("<h2>Material Deduplication</h2>\n<p>{} materials, {} distinct, {} already in the "
+                                   "material index: about {} fewer materials</p>\n<table>\n"
+                                   "<tr><th>Keep</th><th>Duplicates</th><th>Indexed As</th></tr>\n",
+                                   dedup.materialCount, dedup.uniqueMaterials, dedup.indexMatches, reduction);
+    for (const auto& group : dedup.groups) {
+        if (group.materials.size() < 2 && group.indexFile.empty()) {
+            continue;
+        }
+        std::string duplicates;
+        for (size_t i = 1; i < group.materials.size(); ++i) {
+            duplicates += (i > 1 ? ", " : "") + materialName(group.materials[i]);
+        }
+        const std::string indexed = group.indexFile.empty()
+            ? std::string()
+            : escapeHTML(group.indexMaterial) + " (" + escapeHTML(group.indexFile) + ")";
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td></tr>\n", materialName(group.materials[0]),
+                            duplicates, indexed);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLOptimization(const ValidationResult& result) {
+    if (result.optimizedFilePath.empty()) {
+        return "";
+    }
+
+    std::string html = fmt::format("<h2>Optimization</h2>\n<p>Wrote {} ({})</p>\n<table>\n"
+                                   "<tr><th>Mesh</th><th>Vertices</th><th>Triangles</th><th>ACMR</th>"
+                                   "<th>Geometry Size</th></tr>\n",
+                                   escapeHTML(result.optimizedFilePath), formatFileSize(result.optimizedFileSize));
+    for (const auto& mesh : result.optimizationResults) {
+        html += fmt::format("<tr><td>{}</td><td>{} &rarr; {}</td><td>{} &rarr; {}</td>"
+                            "<td>{:.3f} &rarr; {:.3f}</td><td>{} &rarr; {}</td></tr>\n",
+                            escapeHTML(mesh.meshName), mesh.verticesBefore, mesh.verticesAfter,
+                            mesh.trianglesBefore, mesh.trianglesAfter, mesh.acmrBefore, mesh.acmrAfter,
+                            formatFileSize(mesh.bytesBefore), formatFileSize(mesh.bytesAfter));
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLLods(const ValidationResult& result) {
+    if (result.lodResults.empty()) {
+        return "";
+    }
+
+    std::string html = "<h2>Levels of Detail</h2>\n<table>\n"
+                       "<tr><th>Mesh</th><th>Target</th><th>Triangles</th><th>Vertices</th>"
+                       "<th>Error</th><th>Relative Error</th></tr>\n";
+    for (const auto& mesh : result.lodResults) {
+        for (const auto& level : mesh.levels) {
+            html += fmt::format("<tr><td>{}</td><td>{:.0f}%</td><td>{} / {}</td><td>{}</td>"
+                                "<td>{:.6f}</td><td>{:.4f}%</td></tr>\n",
+                                escapeHTML(mesh.meshName), level.targetRatio * 100.0f, level.triangleCount,
+                                mesh.baseTriangles, level.vertexCount, level.error, level.relativeError * 100.0f);
+        }
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLRuleCosts(const ValidationResult& result) {
+    if (result.ruleCosts.empty()) {
+        return "";
+    }
+
+    std::string html = "<h2>Rule Costs</h2>\n<table>\n"
+                       "<tr><th>Rule</th><th>Scope</th><th>Tier</th><th>Data</th><th>Runs</th>"
+                       "<th>Items</th><th>Time (ms)</th></tr>\n";
+    for (const RuleCostResult* rule : sortRuleCosts(result)) {
+        html += fmt::format("<tr><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td><td>{}</td>"
+                            "<td>{:.3f}</td></tr>\n",
+                            escapeHTML(rule->ruleName), rule->scope, rule->costTier, rule->data,
+                            rule->invocations, rule->itemsProcessed, rule->totalMs);
+    }
+    html += "</table>\n";
+    return html;
+}
+
+std::string Reporter::generateHTMLFooter() {
+    return "</body>\n</html>\n";
+}
+
+// Console report helpers
+
+void Reporter::printConsoleSummary(const ValidationResult& result) {
+    IssueSummary summary = calculateIssueSummary(result);
+    fmt::print("=== Validation Report: {} ===\n", result.filePath);
+    fmt::print("Status: {}\n", result.isValid ? "PASSED" : "FAILED");
+    fmt::print("Issues: {} critical, {} errors, {} warnings, {} info\n",
+               summary.criticalCount, summary.errorCount, summary.warningCount, summary.infoCount);
+    if (result.stoppedEarly) {
+        fmt::print("Stopped at the error budget; remaining rules were skipped\n");
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleProfiles(const ValidationResult& result) {
+    if (result.profiles.empty()) {
+        return;
+    }
+
+    fmt::print("Profiles (details below are for '{}'):\n", result.profiles[0].name);
+    for (const auto& verdict : result.profiles) {
+        fmt::print("  {:<16} {}  {} critical, {} errors, {} warnings; {} of {} metrics reused\n", verdict.name,
+                   verdict.isValid ? "PASSED" : "FAILED", verdict.criticalCount, verdict.errorCount,
+                   verdict.warningCount, verdict.metricsReused, verdict.metricsComputed + verdict.metricsReused);
+        const size_t shown = verboseOutput ? verdict.failures.size() : std::min<size_t>(verdict.failures.size(), 5);
+        for (size_t i = 0; i < shown; ++i) {
+            const ValidationIssue& issue = verdict.failures[i];
+            fmt::print("    [{}] {}: {}\n", issue.location.empty() ? "scene" : issue.location, issue.category,
+                       issue.message);
+        }
+        if (shown < verdict.failures.size()) {
+            fmt::print("    ... {} more failures (--verbose lists all)\n", verdict.failures.size() - shown);
+        }
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleStatistics(const ValidationResult& result) {
+    fmt::print("Statistics:\n");
+    fmt::print("  Vertices:  {}\n", result.totalVertices);
+    fmt::print("  Triangles: {}\n", result.totalTriangles);
+    fmt::print("  Meshes:    {}\n", result.totalMeshes);
+    fmt::print("  Materials: {}\n", result.totalMaterials);
+    fmt::print("  Textures:  {}\n\n", result.totalTextures);
+}
+
+void Reporter::printConsoleIssues(const std::vector<ValidationIssue>& issues, const std::string& title) {
+    if (issues.empty()) {
+        return;
+    }
+
+    fmt::print("{}:\n", title);
+    for (const auto& issue : issues) {
+        if (!verboseOutput && issue.severity == Severity::INFO) {
+            continue;
+        }
+        fmt::print("  {} [{}] {}", getSeverityIcon(issue.severity), issue.category, issue.message);
+        if (!issue.location.empty()) {
+            fmt::print(" ({})", issue.location);
+        }
+        fmt::print("\n");
+        if (includeSuggestions && !issue.suggestion.empty()) {
+            fmt::print("      -> {}\n", issue.suggestion);
+        }
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleMeshDetails(const std::vector<MeshValidationResult>& meshResults) {
+    for (const auto& mesh : meshResults) {
+        if (!verboseOutput && mesh.issues.empty()) {
+            continue;
+        }
+        fmt::print("Mesh '{}': {} vertices, {} triangles", mesh.meshName, mesh.vertexCount, mesh.triangleCount);
+        if (mesh.uvOverlapPercentage > 0.0f) {
+            fmt::print(", {:.2f}% UV overlap ({} triangles)", mesh.uvOverlapPercentage,
+                       mesh.overlappingTriangles.size());
+        }
+        if (mesh.meshlets.meshletCount > 0) {
+            fmt::print(", {} meshlets ({:.0f}% triangle fill, {:.0f}% cone-culled)", mesh.meshlets.meshletCount,
+                       mesh.meshlets.triangleFill * 100.0f, mesh.meshlets.triangleCullRate * 100.0f);
+        }
+        if (mesh.quadOverdraw.lodDistance > 0.0f) {
+            fmt::print(", LOD beyond {:.1f} m", mesh.quadOverdraw.lodDistance);
+        }
+        if (mesh.components.componentCount > 1) {
+            fmt::print(", {} components", mesh.components.componentCount);
+            if (mesh.components.debrisComponents > 0) {
+                fmt::print(" ({} debris)", mesh.components.debrisComponents);
+            }
+        }
+        if (mesh.selfIntersections.intersectingTriangles > 0) {
+            fmt::print(", {} self-intersecting triangles", mesh.selfIntersections.intersectingTriangles);
+        }
+        if (mesh.uvIslands.islandCount > 0) {
+            fmt::print(", {} UV islands ({} seam vertices)", mesh.uvIslands.islandCount,
+                       mesh.uvIslands.seamVertices);
+        }
+        if (mesh.texelDensity.measuredTriangles > 0) {
+            fmt::print(", {:.1f} texels/m (mip bias {:+.2f})", mesh.texelDensity.medianDensity,
+                       mesh.texelDensity.mipBias);
+        }
+        fmt::print("\n");
+        printConsoleIssues(mesh.issues, "  Issues");
+    }
+}
+
+void Reporter::printConsoleMaterialDetails(const std::vector<MaterialValidationResult>& materialResults) {
+    for (const auto& material : materialResults) {
+        if (!verboseOutput && material.issues.empty()) {
+            continue;
+        }
+        fmt::print("Material '{}': {} textures", material.materialName, material.textures.size());
+        if (material.texelDensity > 0.0f) {
+            fmt::print(", {:.1f} texels/m ({:.1f}x spread)", material.texelDensity, material.texelDensitySpread);
+        }
+        fmt::print("\n");
+        printConsoleIssues(material.issues, "  Issues");
+    }
+}
+
+void Reporter::printConsoleBounds(const ValidationResult& result) {
+    if (!result.sceneBounds.valid) {
+        return;
+    }
+
+    const SceneBounds& bounds = result.sceneBounds;
+    const glm::vec3 size = bounds.max - bounds.min;
+    fmt::print("Scene bounds: ({:.3f}, {:.3f}, {:.3f}) to ({:.3f}, {:.3f}, {:.3f}), {:.3f} x {:.3f} x {:.3f}\n",
+               bounds.min.x, bounds.min.y, bounds.min.z, bounds.max.x, bounds.max.y, bounds.max.z,
+               size.x, size.y, size.z);
+    fmt::print("Bounding sphere: center ({:.3f}, {:.3f}, {:.3f}), radius {:.3f}\n\n",
+               bounds.sphere.center.x, bounds.sphere.center.y, bounds.sphere.center.z, bounds.sphere.radius);
+}
+
+void Reporter::printConsoleGpuMemory(const ValidationResult& result) {
+    const GpuMemoryResult& memory = result.gpuMemory;
+    if (memory.entries.empty()) {
+        return;
+    }
+
+    fmt::print("GPU memory: {} (meshes {}, textures {})\n", formatFileSize(memory.totalBytes),
+               formatFileSize(memory.meshBytes), formatFileSize(memory.textureBytes));
+    const size_t shown = verboseOutput ? memory.entries.size() : std::min<size_t>(memory.entries.size(), 5);
+    for (size_t i = 0; i < shown; ++i) {
+        const GpuMemoryEntry& entry = memory.entries[i];
+        fmt::print("  {:<8} {:<32} {:>10} {:>5.1f}%\n", entry.kind, entry.name, formatFileSize(entry.estimate.bytes),
+                   memory.totalBytes > 0 ? 100.0 * entry.estimate.bytes / memory.totalBytes : 0.0);
+    }
+    if (shown < memory.entries.size()) {
+        fmt::print("  ... {} more (--verbose lists all)\n", memory.entries.size() - shown);
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleDrawCalls(const ValidationResult& result) {
+    const DrawCallStats& draws = result.drawCalls;
+    if (draws.meshDraws == 0) {
+        return;
+    }
+
+    fmt::print("Draw calls: {} ({} material, {} vertex format changes)\n", draws.meshDraws,
+               draws.materialChanges, draws.formatChanges);
+    fmt::print("  After batching: {} ({} material, {} vertex format changes); {} meshes instanced, {} merged\n",
+               draws.estimatedDraws, draws.sortedMaterialChanges, draws.sortedFormatChanges,
+               draws.instancedMeshes, draws.mergedMeshes);
+    const size_t shown = verboseOutput ? draws.batches.size() : std::min<size_t>(draws.batches.size(), 5);
+    for (size_t i = 0; i < shown; ++i) {
+        const DrawBatch& batch = draws.batches[i];
+        fmt::print("  {:<8} {} meshes, {}, saves {} draws\n",
+                   batch.kind == DrawBatch::Kind::Instance ? "instance" : "merge", batch.meshes.size(),
+                   DrawCallEstimator::vertexFormatName(batch.vertexFormat), batch.drawsSaved());
+    }
+    if (shown < draws.batches.size()) {
+        fmt::print("  ... {} more batches (--verbose lists all)\n", draws.batches.size() - shown);
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleHiddenGeometry(const ValidationResult& result) {
+    const HiddenGeometryResult& hidden = result.hiddenGeometry;
+    if (!hidden.analyzed || hidden.testedTriangles == 0) {
+        return;
+    }
+
+    fmt::print("Hidden geometry: {} of {} triangles ({:.1f}%) removable; {} rays over {} BVH nodes\n",
+               hidden.hiddenTriangles, hidden.testedTriangles, hidden.hiddenPercentage, hidden.raysCast,
+               hidden.bvhNodes);
+    const size_t shown = verboseOutput ? hidden.meshes.size() : std::min<size_t>(hidden.meshes.size(), 5);
+    for (size_t i = 0; i < shown; ++i) {
+        const HiddenMeshResult& mesh = hidden.meshes[i];
+        fmt::print("  {}: {} of {} triangles ({:.1f}%)\n",
+                   mesh.mesh < result.meshResults.size() ? result.meshResults[mesh.mesh].meshName
+                                                         : std::to_string(mesh.mesh),
+                   mesh.hiddenTriangles, mesh.triangles, mesh.hiddenPercentage);
+    }
+    if (shown < hidden.meshes.size()) {
+        fmt::print("  ... {} more meshes (--verbose lists all)\n", hidden.meshes.size() - shown);
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleDuplicateMeshes(const ValidationResult& result) {
+    const DuplicateMeshResult& duplicates = result.duplicateMeshes;
+    if (duplicates.groups.empty()) {
+        return;
+    }
+
+    fmt::print("Duplicate meshes: {} copies ({} transformed), {} in other files; instancing saves {} and {} draws\n",
+               duplicates.duplicateMeshes, duplicates.transformedMeshes, duplicates.indexMatches,
+               formatFileSize(duplicates.bytesSaved), duplicates.drawsSaved);
+    const size_t shown = verboseOutput ? duplicates.groups.size() : std::min<size_t>(duplicates.groups.size(), 5);
+    for (size_t i = 0; i < shown; ++i) {
+        const DuplicateMeshGroup& group = duplicates.groups[i];
+        const uint32_t source = group.meshes[0];
+        fmt::print("  {} x{} ({}){}: saves {}\n",
+                   source < result.meshResults.size() ? result.meshResults[source].meshName : std::to_string(source),
+                   group.meshes.size(), group.transformed ? "rigid" : "exact",
+                   group.indexFile.empty() ? "" : ", also in " + group.indexFile, formatFileSize(group.bytesSaved));
+    }
+    if (shown < duplicates.groups.size()) {
+        fmt::print("  ... {} more groups (--verbose lists all)\n", duplicates.groups.size() - shown);
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleMaterialDedup(const ValidationResult& result) {
+    const MaterialDedupResult& dedup = result.materialDedup;
+    const uint32_t reduction = dedup.materialCount - dedup.uniqueMaterials + dedup.indexMatches;
+    if (reduction == 0) {
+        return;
+    }
+
+    fmt::print("Material dedup: {} materials, {} distinct, {} already indexed; about {} fewer materials\n",
+               dedup.materialCount, dedup.uniqueMaterials, dedup.indexMatches, reduction);
+    if (verboseOutput) {
+        for (const auto& group : dedup.groups) {
+            if (!group.indexFile.empty()) {
+                fmt::print("  material {} matches '{}' in {}\n", group.materials[0], group.indexMaterial,
+                           group.indexFile);
+            }
+        }
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleOptimization(const ValidationResult& result) {
+    if (result.optimizedFilePath.empty()) {
+        return;
+    }
+
+    fmt::print("Optimized output: {} ({})\n", result.optimizedFilePath, formatFileSize(result.optimizedFileSize));
+    for (const auto& mesh : result.optimizationResults) {
+        fmt::print("  Mesh '{}': ACMR {:.3f} -> {:.3f}, {} -> {} vertices, {} -> {}\n",
+                   mesh.meshName, mesh.acmrBefore, mesh.acmrAfter, mesh.verticesBefore, mesh.verticesAfter,
+                   formatFileSize(mesh.bytesBefore), formatFileSize(mesh.bytesAfter));
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleLods(const ValidationResult& result) {
+    if (result.lodResults.empty()) {
+        return;
+    }
+
+    fmt::print("Levels of detail:\n");
+    for (const auto& mesh : result.lodResults) {
+        fmt::print("  Mesh '{}' ({} triangles):\n", mesh.meshName, mesh.baseTriangles);
+        for (const auto& level : mesh.levels) {
+            fmt::print("    {:>3.0f}%: {} triangles, {} vertices, error {:.6f} ({:.4f}% of bounds)\n",
+                       level.targetRatio * 100.0f, level.triangleCount, level.vertexCount,
+                       level.error, level.relativeError * 100.0f);
+        }
+    }
+    fmt::print("\n");
+}
+
+void Reporter::printConsoleRuleCosts(const ValidationResult& result) {
+    if (result.ruleCosts.empty()) {
+        return;
+    }
+
+    fmt::print("Rule costs:\n");
+    fmt::print("  {:<24} {:<9} {:<9} {:>6} {:>12} {:>10}\n", "rule", "scope", "tier", "runs", "items", "ms");
+    for (const RuleCostResult* rule : sortRuleCosts(result)) {
+        fmt::print("  {:<24} {:<9} {:<9} {:>6} {:>12} {:>10.3f}\n", rule->ruleName, rule->scope,
+                   rule->costTier, rule->invocations, rule->itemsProcessed, rule->totalMs);
+    }
+    fmt::print("\n");
+}
+
+// Utility functions
+
+std::vector<const RuleCostResult*> Reporter::sortRuleCosts(const ValidationResult& result) {
+    std::vector<const RuleCostResult*> sorted;
+    for (const auto& rule : result.ruleCosts) {
+        sorted.push_back(&rule);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const RuleCostResult* a, const RuleCostResult* b) {
+        return a->totalMs > b->totalMs;
+    });
+    return sorted;
+}
+
+std::string Reporter::getSeverityColor(Severity severity) {
+    switch (severity) {
+        case Severity::INFO:     return "#1565c0";
+        case Severity::WARNING:  return "#ef6c00";
+        case Severity::ERROR:    return "#c62828";
+        case Severity::CRITICAL: return "#6a1b9a";
+    }
+    return "#000000";
+}
+
+std::string Reporter::getSeverityIcon(Severity severity) {
+    switch (severity) {
+        case Severity::INFO:     return "ℹ";
+        case Severity::WARNING:  return "⚠";
+        case Severity::ERROR:    return "✗";
+        case Severity::CRITICAL: return "‼";
+    }
+    return "?";
+}
+
+std::string Reporter::formatFileSize(uint64_t bytes) {
+    const char* units[] = {"B", "KB", "MB", "GB"};
+    double size = static_cast<double>(bytes);
+    int unit = 0;
+    while (size >= 1024.0 && unit < 3) {
+        size /= 1024.0;
+        unit++;
+    }
+    return unit == 0 ? fmt::format("{} B", bytes) : fmt::format("{:.1f} {}", size, units[unit]);
+}
+
+std::string Reporter::getCurrentTimestamp() {
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm localTime{};
+#ifdef _WIN32
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
+    std::ostringstream stream;
+    stream << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S");
+    return stream.str();
+}
+
+// Issue summary helpers
+
+void Reporter::IssueSummary::addIssue(Severity severity) {
+    switch (severity) {
+        case Severity::INFO:     infoCount++; break;
+        case Severity::WARNING:  warningCount++; break;
+        case Severity::ERROR:    errorCount++; break;
+        case Severity::CRITICAL: criticalCount++; break;
+    }
+}
+
+uint32_t Reporter::IssueSummary::getTotalCount() const {
+    return infoCount + warningCount + errorCount + criticalCount;
+}
+
+Reporter::IssueSummary Reporter::calculateIssueSummary(const ValidationResult& result) {
+    IssueSummary summary;
+    for (const auto& issue : result.globalIssues) {
+        summary.addIssue(issue.severity);
+    }
+    for (const auto& mesh : result.meshResults) {
+        for (const auto& issue : mesh.issues) {
+            summary.addIssue(issue.severity);
+        }
+    }
+    for (const auto& material : result.materialResults) {
+        for (const auto& issue : material.issues) {
+            summary.addIssue(issue.severity);
+        }
+    }
+    return summary;
+}
+
+// File I/O helpers
+
+bool Reporter::writeToFile(const std::string& content, const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        lastError = "Cannot open output file: " + filePath;
+        return false;
+    }
+    file << content;
+    if (!file) {
+        lastError = "Failed to write output file: " + filePath;
+        return false;
+    }
+    return true;
+}
+
+std::string Reporter::escapeHTML(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '&':  escaped += "&amp;"; break;
+            case '<':  escaped += "&lt;"; break;
+            case '>':  escaped += "&gt;"; break;
+            case '"':  escaped += "&quot;"; break;
+            case '\'': escaped += "&#39;"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
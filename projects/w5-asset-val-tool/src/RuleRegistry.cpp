@@ -0,0 +1,140 @@
+#include "RuleRegistry.h"
+#include <stdexcept>
+
+void RuleRegistry::add(const RuleDescriptor& rule) {
+    if (rule.name.empty()) {
+        throw std::invalid_argument("Rule name must not be empty");
+    }
+    if (find(rule.name)) {
+        throw std::invalid_argument("Duplicate rule name: " + rule.name);
+    }
+
+    const int functionCount = (rule.sceneRule != nullptr) + (rule.scenePass != nullptr) +
+                              (rule.meshRule != nullptr) + (rule.materialRule != nullptr) +
+                              (rule.textureRule != nullptr);
+    bool matchesScope = false;
+    switch (rule.scope) {
+        case RuleScope::Scene:    matchesScope = rule.sceneRule != nullptr || rule.scenePass != nullptr; break;
+        case RuleScope::Mesh:     matchesScope = rule.meshRule != nullptr; break;
+        case RuleScope::Material: matchesScope = rule.materialRule != nullptr; break;
+        case RuleScope::Texture:  matchesScope = rule.textureRule != nullptr; break;
+    }
+    if (functionCount != 1 || !matchesScope) {
+        throw std::invalid_argument("Rule '" + rule.name + "' needs exactly one function, matching its " +
+                                    scopeName(rule.scope) + " scope");
+    }
+    rules.push_back(rule);
+}
+
+const RuleDescriptor* RuleRegistry::find(const std::string& name) const {
+    for (const auto& rule : rules) {
+        if (rule.name == name) {
+            return &rule;
+        }
+    }
+    return nullptr;
+}
+
+const char* RuleRegistry::scopeName(RuleScope scope) {
+    switch (scope) {
+        case RuleScope::Scene:    return "scene";
+        case RuleScope::Mesh:     return "mesh";
+        case RuleScope::Material: return "material";
+        case RuleScope::Texture:  return "texture";
+    }
+    return "unknown";
+}
+
+const char* RuleRegistry::costName(RuleCost cost) {
+    switch (cost) {
+        case RuleCost::Metadata: return "metadata";
+        case RuleCost::Linear:   return "linear";
+        case RuleCost::Heavy:    return "heavy";
+    }
+    return "unknown";
+}
+
+std::string RuleRegistry::dataNames(uint32_t data) {
+    static const struct {
+        uint32_t bit;
+        const char* name;
+    } names[] = {
+        {RuleData::Positions, "positions"},
+        {RuleData::Normals, "normals"},
+        {RuleData::UVs, "uvs"},
+        {RuleData::Indices, "indices"},
+        {RuleData::Materials, "materials"},
+        {RuleData::Textures, "textures"},
+        {RuleData::Tangents, "tangents"}
+    };
+    std::string result;
+    for (const auto& entry : names) {
+        if (data & entry.bit) {
+            if (!result.empty()) {
+                result += '+';
+            }
+            result += entry.name;
+        }
+    }
+    return result.empty() ? "metadata" : result;
+}
+
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, SceneRule rule,
+                            RuleEnabled enabled) {
+    RuleDescriptor descriptor;
+    descriptor.name = name;
+    descriptor.scope = RuleScope::Scene;
+    descriptor.data = data;
+    descriptor.cost = cost;
+    descriptor.sceneRule = rule;
+    descriptor.enabled = enabled;
+    return descriptor;
+}
+
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, ScenePass rule,
+                            RuleEnabled enabled) {
+    RuleDescriptor descriptor;
+    descriptor.name = name;
+    descriptor.scope = RuleScope::Scene;
+    descriptor.data = data;
+    descriptor.cost = cost;
+    descriptor.scenePass = rule;
+    descriptor.enabled = enabled;
+    return descriptor;
+}
+
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, MeshRule rule,
+                            RuleEnabled enabled) {
+    RuleDescriptor descriptor;
+    descriptor.name = name;
+    descriptor.scope = RuleScope::Mesh;
+    descriptor.data = data;
+    descriptor.cost = cost;
+    descriptor.meshRule = rule;
+    descriptor.enabled = enabled;
+    return descriptor;
+}
+
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, MaterialRule rule,
+                            RuleEnabled enabled) {
+    RuleDescriptor descriptor;
+    descriptor.name = name;
+    descriptor.scope = RuleScope::Material;
+    descriptor.data = data;
+    descriptor.cost = cost;
+    descriptor.materialRule = rule;
+    descriptor.enabled = enabled;
+    return descriptor;
+}
+
+RuleDescriptor describeRule(const std::string& name, uint32_t data, RuleCost cost, TextureRule rule,
+                            RuleEnabled enabled) {
+    RuleDescriptor descriptor;
+    descriptor.name = name;
+    descriptor.scope = RuleScope::Texture;
+    descriptor.data = data;
+    descriptor.cost = cost;
+    descriptor.textureRule = rule;
+    descriptor.enabled = enabled;
+    return descriptor;
+}
@@ -0,0 +1,402 @@
+#include "SelfIntersectionAnalyzer.h"
+#include "EdgeAdjacency.h"
+#include "ThreadPool.h"
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const size_t kTrianglesPerChunk = 1 << 16;
+
+    // The traversal's first levels are expanded until there are this many
+    // independent node pairs to hand out
+    const size_t kMinTasks = 4096;
+    const int kMaxExpandRounds = 32;
+
+    // Nearly parallel planes are treated as one plane
+    const float kMinPlaneSine = 1e-6f;
+
+    struct NodePair {
+        uint32_t a;
+        uint32_t b; // a == b: the node against itself
+    };
+
+    bool boxesOverlap(const BVHNode& a, const BVHNode& b) {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+               a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    float boxArea(const BVHNode& node) {
+        const glm::vec3 d = node.max - node.min;
+        return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    // Pushes the child pairs of a node pair that can still hold
+    // intersections; false for a pair of leaves, which is tested directly
+    template <typename Push>
+    bool splitPair(const std::vector<BVHNode>& nodes, const NodePair& pair, Push&& push) {
+        const BVHNode& a = nodes[pair.a];
+        if (pair.a == pair.b) {
+            if (a.isLeaf()) {
+                return false;
+            }
+            push(NodePair{a.first, a.first});
+            push(NodePair{a.first + 1, a.first + 1});
+            if (boxesOverlap(nodes[a.first], nodes[a.first + 1])) {
+                push(NodePair{a.first, a.first + 1});
+            }
+            return true;
+        }
+        const BVHNode& b = nodes[pair.b];
+        if (a.isLeaf() && b.isLeaf()) {
+            return false;
+        }
+        // Descend the larger node, or the only inner one
+        if (!a.isLeaf() && (b.isLeaf() || boxArea(a) >= boxArea(b))) {
+            for (uint32_t child = a.first; child < a.first + 2; ++child) {
+                if (boxesOverlap(nodes[child], b)) {
+                    push(NodePair{child, pair.b});
+                }
+            }
+        } else {
+            for (uint32_t child = b.first; child < b.first + 2; ++child) {
+                if (boxesOverlap(a, nodes[child])) {
+                    push(NodePair{pair.a, child});
+                }
+            }
+        }
+        return true;
+    }
+
+    // Strictly on both sides of a plane, given the corners' snapped distances
+    bool straddles(const float* d) {
+        return (d[0] > 0.0f || d[1] > 0.0f || d[2] > 0.0f) && (d[0] < 0.0f || d[1] < 0.0f || d[2] < 0.0f);
+    }
+
+    // Where a triangle straddling a plane crosses it: the two points its
+    // edges from the corner alone on its side cross at, ordered along line
+    void planeCrossing(const glm::vec3* p, const float* d, const glm::vec3& line, float t[2], glm::vec3 x[2]) {
+        int lone = 0;
+        if (d[0] * d[1] > 0.0f) {
+            lone = 2;
+        } else if (d[0] * d[2] > 0.0f) {
+            lone = 1;
+        } else if (d[1] * d[2] > 0.0f || d[0] != 0.0f) {
+            lone = 0;
+        } else if (d[1] != 0.0f) {
+            lone = 1;
+        } else {
+            lone = 2;
+        }
+        for (int k = 0; k < 2; ++k) {
+            const int other = (lone + 1 + k) % 3;
+            x[k] = p[lone] + (p[other] - p[lone]) * (d[lone] / (d[lone] - d[other]));
+            t[k] = glm::dot(line, x[k]);
+        }
+        if (t[0] > t[1]) {
+            std::swap(t[0], t[1]);
+            std::swap(x[0], x[1]);
+        }
+    }
+
+    // Distance of q from the line through p and r, positive on the left
+    float sideOf(const glm::vec2& p, const glm::vec2& r, const glm::vec2& q) {
+        const glm::vec2 e = r - p;
+        const float length = std::sqrt(e.x * e.x + e.y * e.y);
+        return length > 0.0f ? (e.x * (q.y - p.y) - e.y * (q.x - p.x)) / length : 0.0f;
+    }
+
+    bool strictlyInside(const glm::vec2& q, const glm::vec2* t, float eps) {
+        const float d0 = sideOf(t[0], t[1], q), d1 = sideOf(t[1], t[2], q), d2 = sideOf(t[2], t[0], q);
+        return (d0 > eps && d1 > eps && d2 > eps) || (d0 < -eps && d1 < -eps && d2 < -eps);
+    }
+
+    bool oppositeSides(float a, float b, float eps) {
+        return (a > eps && b < -eps) || (a < -eps && b > eps);
+    }
+
+    // Coplanar overlap: in the plane's dominant projection, an edge of one
+    // properly crosses an edge of the other, or a corner or the centroid
+    // of one lies inside the other (which catches identical triangles)
+    bool coplanarOverlap(const glm::vec3* a, const glm::vec3* b, const glm::vec3& normal, float eps) {
+        int axis = 0;
+        if (std::fabs(normal.y) > std::fabs(normal[axis])) {
+            axis = 1;
+        }
+        if (std::fabs(normal.z) > std::fabs(normal[axis])) {
+            axis = 2;
+        }
+        const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        glm::vec2 pa[3], pb[3];
+        for (int k = 0; k < 3; ++k) {
+            pa[k] = glm::vec2(a[k][u], a[k][v]);
+            pb[k] = glm::vec2(b[k][u], b[k][v]);
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            const glm::vec2& p = pa[i];
+            const glm::vec2& r = pa[(i + 1) % 3];
+            for (int j = 0; j < 3; ++j) {
+                const glm::vec2& q = pb[j];
+                const glm::vec2& s = pb[(j + 1) % 3];
+                if (oppositeSides(sideOf(p, r, q), sideOf(p, r, s), eps) &&
+                    oppositeSides(sideOf(q, s, p), sideOf(q, s, r), eps)) {
+                    return true;
+                }
+            }
+        }
+        const glm::vec2 centroidA = (pa[0] + pa[1] + pa[2]) / 3.0f;
+        const glm::vec2 centroidB = (pb[0] + pb[1] + pb[2]) / 3.0f;
+        if (strictlyInside(centroidA, pb, eps) || strictlyInside(centroidB, pa, eps)) {
+            return true;
+        }
+        for (int k = 0; k < 3; ++k) {
+            if (strictlyInside(pa[k], pb, eps) || strictlyInside(pb[k], pa, eps)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    enum class Contact { None, Crossing, Coplanar };
+
+    // Moller's interval test with distances snapped to the plane within eps
+    Contact intersectTriangles(const glm::vec3* a, const glm::vec3& normalA, const glm::vec3* b,
+                               const glm::vec3& normalB, float eps, glm::vec3& location) {
+        float db[3], da[3];
+        for (int k = 0; k < 3; ++k) {
+            db[k] = glm::dot(normalA, b[k] - a[0]);
+            db[k] = std::fabs(db[k]) < eps ? 0.0f : db[k];
+        }
+        if (db[0] == 0.0f && db[1] == 0.0f && db[2] == 0.0f) {
+            location = (a[0] + a[1] + a[2]) / 3.0f;
+            return coplanarOverlap(a, b, normalA, eps) ? Contact::Coplanar : Contact::None;
+        }
+        // A triangle only touching the other's plane rests on it
+        if (!straddles(db)) {
+            return Contact::None;
+        }
+        for (int k = 0; k < 3; ++k) {
+            da[k] = glm::dot(normalB, a[k] - b[0]);
+            da[k] = std::fabs(da[k]) < eps ? 0.0f : da[k];
+        }
+        if (!straddles(da)) {
+            return Contact::None;
+        }
+
+        const glm::vec3 line = glm::cross(normalA, normalB);
+        const float sine = glm::length(line);
+        if (sine < kMinPlaneSine) {
+            location = (a[0] + a[1] + a[2]) / 3.0f;
+            return coplanarOverlap(a, b, normalA, eps) ? Contact::Coplanar : Contact::None;
+        }
+        const glm::vec3 direction = line / sine;
+        float ta[2], tb[2];
+        glm::vec3 xa[2], xb[2];
+        planeCrossing(a, da, direction, ta, xa);
+        planeCrossing(b, db, direction, tb, xb);
+        const float from = std::max(ta[0], tb[0]);
+        const float to = std::min(ta[1], tb[1]);
+        if (to - from <= eps) {
+            return Contact::None;
+        }
+        const glm::vec3& start = ta[0] > tb[0] ? xa[0] : xb[0];
+        const glm::vec3& end = ta[1] < tb[1] ? xa[1] : xb[1];
+        location = (start + end) * 0.5f;
+        return Contact::Crossing;
+    }
+
+    struct TaskResult {
+        uint64_t candidates = 0;
+        std::vector<SelfIntersection> found;
+    };
+}
+
+SelfIntersectionAnalyzer::SelfIntersectionAnalyzer(float relativeTolerance)
+    : relativeTolerance(std::max(relativeTolerance, 0.0f)) {}
+
+SelfIntersectionResult SelfIntersectionAnalyzer::analyze(const std::vector<glm::vec3>& vertices,
+                                                         const std::vector<uint32_t>& indices,
+                                                         ThreadPool& pool) const {
+    SelfIntersectionResult result;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || triangleCount >= TriangleBVH::kNoTriangle) {
+        return result;
+    }
+
+    glm::vec3 meshMin(std::numeric_limits<float>::max()), meshMax(-std::numeric_limits<float>::max());
+    for (const glm::vec3& p : vertices) {
+        if (std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z)) {
+            meshMin = glm::min(meshMin, p);
+            meshMax = glm::max(meshMax, p);
+        }
+    }
+    if (meshMin.x > meshMax.x) {
+        return result;
+    }
+    const float eps = relativeTolerance * glm::length(meshMax - meshMin);
+
+    // Triangles with out-of-range indices or non-finite corners collapse
+    // to a degenerate one at the origin and are skipped with the other
+    // zero-area ones
+    const std::vector<uint32_t> welded = EdgeAdjacency::weldPositions(vertices, pool);
+    const size_t vertexCount = vertices.size();
+    std::vector<glm::vec3> corners(triangleCount * 3);
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            bool valid = i0 < vertexCount && i1 < vertexCount && i2 < vertexCount;
+            if (valid) {
+                const glm::vec3 sum = vertices[i0] + vertices[i1] + vertices[i2];
+                // Any inf or NaN corner makes the sum non-finite, save for
+                // overflow, which is as unusable
+                valid = std::isfinite(sum.x) && std::isfinite(sum.y) && std::isfinite(sum.z);
+            }
+            corners[t * 3] = valid ? vertices[i0] : glm::vec3(0.0f);
+            corners[t * 3 + 1] = valid ? vertices[i1] : glm::vec3(0.0f);
+            corners[t * 3 + 2] = valid ? vertices[i2] : glm::vec3(0.0f);
+        }
+    });
+
+    TriangleBVH bvh;
+    bvh.build(std::move(corners), pool);
+    const std::vector<BVHNode>& nodes = bvh.getNodes();
+
+    // Unit normals and welded corners in leaf order; a zero normal marks a
+    // triangle that is skipped
+    std::vector<glm::vec3> normals(triangleCount);
+    std::vector<uint32_t> keys(triangleCount * 3);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t slot = chunk * kTrianglesPerChunk; slot < end; ++slot) {
+            const uint32_t t = bvh.triangleAt(static_cast<uint32_t>(slot));
+            const glm::vec3* p = bvh.cornersAt(static_cast<uint32_t>(slot));
+            const glm::vec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+            const float length = glm::length(normal);
+            normals[slot] = length > 0.0f && std::isfinite(length) ? normal / length : glm::vec3(0.0f);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t index = indices[size_t(t) * 3 + k];
+                keys[slot * 3 + k] = index < vertexCount ? welded[index] : index;
+            }
+        }
+    });
+
+    auto sharedVertices = [&](uint32_t a, uint32_t b) {
+        const uint32_t* ka = &keys[size_t(a) * 3];
+        const uint32_t* kb = &keys[size_t(b) * 3];
+        int shared = 0;
+        for (int i = 0; i < 3; ++i) {
+            shared += ka[i] == kb[0] || ka[i] == kb[1] || ka[i] == kb[2];
+        }
+        return shared;
+    };
+
+    auto testLeaves = [&](const NodePair& pair, TaskResult& out) {
+        const BVHNode& a = nodes[pair.a];
+        const BVHNode& b = nodes[pair.b];
+        for (uint32_t i = a.first; i < a.first + a.count; ++i) {
+            if (normals[i] == glm::vec3(0.0f)) {
+                continue;
+            }
+            const glm::vec3* pa = bvh.cornersAt(i);
+            const glm::vec3 minA = glm::min(glm::min(pa[0], pa[1]), pa[2]);
+            const glm::vec3 maxA = glm::max(glm::max(pa[0], pa[1]), pa[2]);
+            for (uint32_t j = pair.a == pair.b ? i + 1 : b.first; j < b.first + b.count; ++j) {
+                if (normals[j] == glm::vec3(0.0f)) {
+                    continue;
+                }
+                // Neighbours touch by construction; a triangle on the same
+                // three positions is a duplicate face
+                const int shared = sharedVertices(i, j);
+                if (shared > 0 && shared < 3) {
+                    continue;
+                }
+                const glm::vec3* pb = bvh.cornersAt(j);
+                const glm::vec3 minB = glm::min(glm::min(pb[0], pb[1]), pb[2]);
+                const glm::vec3 maxB = glm::max(glm::max(pb[0], pb[1]), pb[2]);
+                if (minA.x > maxB.x || minB.x > maxA.x || minA.y > maxB.y || minB.y > maxA.y ||
+                    minA.z > maxB.z || minB.z > maxA.z) {
+                    continue;
+                }
+                out.candidates++;
+                SelfIntersection hit;
+                Contact contact = Contact::Coplanar;
+                if (shared == 3) {
+                    hit.location = (pa[0] + pa[1] + pa[2]) / 3.0f;
+                } else {
+                    contact = intersectTriangles(pa, normals[i], pb, normals[j], eps, hit.location);
+                }
+                if (contact == Contact::None) {
+                    continue;
+                }
+                const uint32_t ta = bvh.triangleAt(i), tb = bvh.triangleAt(j);
+                hit.triangleA = std::min(ta, tb);
+                hit.triangleB = std::max(ta, tb);
+                hit.coplanar = contact == Contact::Coplanar;
+                out.found.push_back(hit);
+            }
+        }
+    };
+
+    // Expand the self-traversal breadth-first into independent node pairs
+    std::vector<NodePair> tasks = {NodePair{0, 0}};
+    for (int round = 0; round < kMaxExpandRounds && tasks.size() < kMinTasks; ++round) {
+        std::vector<NodePair> next;
+        next.reserve(tasks.size() * 3);
+        bool expanded = false;
+        for (const NodePair& pair : tasks) {
+            if (splitPair(nodes, pair, [&](const NodePair& child) { next.push_back(child); })) {
+                expanded = true;
+            } else {
+                next.push_back(pair);
+            }
+        }
+        tasks.swap(next);
+        if (!expanded) {
+            break;
+        }
+    }
+
+    std::vector<TaskResult> taskResults(tasks.size());
+    pool.parallelFor(tasks.size(), [&](size_t task) {
+        TaskResult& out = taskResults[task];
+        std::vector<NodePair> stack = {tasks[task]};
+        while (!stack.empty()) {
+            const NodePair pair = stack.back();
+            stack.pop_back();
+            if (!splitPair(nodes, pair, [&](const NodePair& child) { stack.push_back(child); })) {
+                testLeaves(pair, out);
+            }
+        }
+    });
+
+    // Every leaf pair is visited once, so pairs are unique; sorting makes
+    // the listing independent of the task split
+    std::vector<SelfIntersection> found;
+    for (TaskResult& task : taskResults) {
+        result.candidatePairs += task.candidates;
+        found.insert(found.end(), task.found.begin(), task.found.end());
+    }
+    std::sort(found.begin(), found.end(), [](const SelfIntersection& a, const SelfIntersection& b) {
+        return a.triangleA != b.triangleA ? a.triangleA < b.triangleA : a.triangleB < b.triangleB;
+    });
+
+    std::vector<uint8_t> involved(triangleCount, 0);
+    for (const SelfIntersection& hit : found) {
+        if (result.intersectingPairs == 0) {
+            result.min = result.max = hit.location;
+        }
+        result.min = glm::min(result.min, hit.location);
+        result.max = glm::max(result.max, hit.location);
+        result.intersectingPairs++;
+        result.coplanarPairs += hit.coplanar ? 1 : 0;
+        result.intersectingTriangles += !involved[hit.triangleA] + !involved[hit.triangleB];
+        involved[hit.triangleA] = involved[hit.triangleB] = 1;
+    }
+    found.resize(std::min(found.size(), SelfIntersectionResult::kMaxListed));
+    result.intersections = std::move(found);
+    return result;
+}
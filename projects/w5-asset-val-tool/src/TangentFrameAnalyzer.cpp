@@ -0,0 +1,132 @@
+#include "TangentFrameAnalyzer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using VertexKernels::kTrianglesPerChunk;
+    using VertexKernels::kTriangleBlock;
+
+    // Faces and normal sums below these (squared) have no direction
+    const float kMinFaceCrossSq = 1e-24f;
+    const float kMinNormalSumSq = 1e-12f;
+
+    struct ChunkResult {
+        uint64_t checked = 0;
+        std::vector<std::pair<float, uint32_t>> mismatches; // (cosine, triangle)
+        uint64_t mixed = 0;
+        std::vector<uint32_t> mixedSamples;
+    };
+}
+
+TangentFrameAnalyzer::TangentFrameAnalyzer(float maxNormalFaceAngle)
+    : minCosine(std::cos(std::clamp(maxNormalFaceAngle, 0.0f, 180.0f) * 3.14159265f / 180.0f)) {}
+
+TangentFrameResult TangentFrameAnalyzer::analyze(const MeshData& mesh, ThreadPool& pool) const {
+    TangentFrameResult result;
+    const size_t vertexCount = mesh.vertices.size();
+    if (vertexCount == 0 || mesh.normals.size() != vertexCount) {
+        return result;
+    }
+
+    std::vector<int8_t> handedness;
+    result.hasTangents = mesh.tangents.size() == vertexCount && mesh.bitangents.size() == vertexCount;
+    if (result.hasTangents) {
+        handedness.resize(vertexCount);
+        result.tangentStats = VertexKernels::analyzeTangents(mesh.normals.data(), mesh.tangents.data(),
+                                                             mesh.bitangents.data(), vertexCount,
+                                                             handedness.data());
+    }
+
+    const std::vector<glm::vec3>& vertices = mesh.vertices;
+    const std::vector<glm::vec3>& normals = mesh.normals;
+    const std::vector<uint32_t>& indices = mesh.indices;
+    const size_t triangleCount = indices.size() / 3;
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    const bool checkHandedness = result.hasTangents;
+    const float limit = minCosine;
+    std::vector<ChunkResult> chunks(chunkCount);
+
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        ChunkResult& out = chunks[chunk];
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min(triangleCount, begin + kTrianglesPerChunk);
+
+        // Structure-of-arrays scratch for one block
+        VertexKernels::TriangleBlock tri;
+        float ax[kTriangleBlock], ay[kTriangleBlock], az[kTriangleBlock], cosine[kTriangleBlock];
+        int h0[kTriangleBlock], h1[kTriangleBlock], h2[kTriangleBlock], mixed[kTriangleBlock];
+        bool measured[kTriangleBlock];
+
+        for (size_t first = begin; first < end; first += kTriangleBlock) {
+            tri.gather(indices.data(), first, end, vertices.data(), vertexCount);
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                const uint32_t i0 = tri.i0[k], i1 = tri.i1[k], i2 = tri.i2[k];
+                ax[k] = normals[i0].x + normals[i1].x + normals[i2].x;
+                ay[k] = normals[i0].y + normals[i1].y + normals[i2].y;
+                az[k] = normals[i0].z + normals[i1].z + normals[i2].z;
+                h0[k] = checkHandedness ? handedness[i0] : 0;
+                h1[k] = checkHandedness ? handedness[i1] : 0;
+                h2[k] = checkHandedness ? handedness[i2] : 0;
+            }
+
+            // Branch-free face/normal cosine and handedness mix
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                const float cx = tri.e0y[k] * tri.e1z[k] - tri.e0z[k] * tri.e1y[k];
+                const float cy = tri.e0z[k] * tri.e1x[k] - tri.e0x[k] * tri.e1z[k];
+                const float cz = tri.e0x[k] * tri.e1y[k] - tri.e0y[k] * tri.e1x[k];
+                const float crossSq = cx * cx + cy * cy + cz * cz;
+                const float sumSq = ax[k] * ax[k] + ay[k] * ay[k] + az[k] * az[k];
+                cosine[k] = (cx * ax[k] + cy * ay[k] + cz * az[k]) / std::sqrt(crossSq * sumSq);
+                // NaN fails every comparison, including an overflowed product's
+                measured[k] = crossSq > kMinFaceCrossSq && sumSq > kMinNormalSumSq && std::fabs(cosine[k]) <= 1.5f;
+                const int positive = (h0[k] > 0) | (h1[k] > 0) | (h2[k] > 0);
+                const int negative = (h0[k] < 0) | (h1[k] < 0) | (h2[k] < 0);
+                mixed[k] = positive & negative;
+            }
+
+            for (size_t k = 0; k < tri.count; ++k) {
+                if (!tri.valid[k]) {
+                    continue;
+                }
+                const uint32_t t = static_cast<uint32_t>(first + k);
+                if (mixed[k]) {
+                    out.mixed++;
+                    if (out.mixedSamples.size() < TangentFrameResult::kMaxWorstTriangles) {
+                        out.mixedSamples.push_back(t);
+                    }
+                }
+                if (!measured[k]) {
+                    continue;
+                }
+                out.checked++;
+                if (cosine[k] < limit) {
+                    out.mismatches.emplace_back(cosine[k], t);
+                }
+            }
+        }
+    });
+
+    std::vector<std::pair<float, uint32_t>> mismatches;
+    for (auto& chunk : chunks) {
+        result.checkedTriangles += chunk.checked;
+        result.mixedHandednessTriangles += chunk.mixed;
+        for (uint32_t t : chunk.mixedSamples) {
+            if (result.mixedHandednessSamples.size() < TangentFrameResult::kMaxWorstTriangles) {
+                result.mixedHandednessSamples.push_back(t);
+            }
+        }
+        mismatches.insert(mismatches.end(), chunk.mismatches.begin(), chunk.mismatches.end());
+    }
+    result.windingMismatchTriangles = mismatches.size();
+
+    const size_t keep = std::min(mismatches.size(), TangentFrameResult::kMaxWorstTriangles);
+    std::partial_sort(mismatches.begin(), mismatches.begin() + keep, mismatches.end(),
+                      [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+                          return a.first != b.first ? a.first < b.first : a.second < b.second;
+                      });
+    for (size_t i = 0; i < keep; ++i) {
+        result.worstWindingTriangles.push_back(mismatches[i].second);
+    }
+    return result;
+}
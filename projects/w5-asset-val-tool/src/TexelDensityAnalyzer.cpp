@@ -0,0 +1,197 @@
+#include "TexelDensityAnalyzer.h"
+#include "ThreadPool.h"
+#include "VertexKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    using VertexKernels::kTrianglesPerChunk;
+    using VertexKernels::kTriangleBlock;
+    using VertexKernels::fastLog2;
+
+    // Areas below these are treated as unmapped or degenerate (twice the
+    // area, squared for the world side)
+    const float kMinUVCross = 1e-12f;
+    const float kMinWorldCrossSq = 1e-24f;
+
+    // Report histogram: half octaves from 2^0 to 2^16 texels per metre
+    const int kHistogramBins = 32;
+
+    // Median histogram: 1/16 octave from 2^-8 to 2^24, weighted by area
+    const float kMedianMinLog2 = -8.0f;
+    const int kMedianBinsPerOctave = 16;
+    const int kMedianBins = 32 * kMedianBinsPerOctave;
+
+    struct ChunkResult {
+        uint64_t measured = 0;
+        double worldArea = 0.0;
+        double uvArea = 0.0;
+        float minLog = std::numeric_limits<float>::infinity();
+        float maxLog = -std::numeric_limits<float>::infinity();
+        std::vector<uint32_t> histogram;
+        std::vector<double> medianWeights;
+        std::vector<std::pair<float, uint32_t>> outliers; // (deviation, triangle)
+    };
+}
+
+TexelDensityAnalyzer::TexelDensityAnalyzer(float referenceDensity, float maxRatio)
+    : referenceDensity(referenceDensity), maxRatio(maxRatio) {}
+
+TexelDensityResult TexelDensityAnalyzer::analyze(const std::vector<glm::vec3>& vertices,
+                                                 const std::vector<glm::vec2>& uvs,
+                                                 const std::vector<uint32_t>& indices,
+                                                 const glm::mat4& worldTransform,
+                                                 uint32_t textureWidth, uint32_t textureHeight,
+                                                 ThreadPool& pool) const {
+    TexelDensityResult result;
+    result.textureWidth = textureWidth;
+    result.textureHeight = textureHeight;
+    result.histogram.assign(kHistogramBins, 0);
+    if (vertices.empty() || textureWidth == 0 || textureHeight == 0 || uvs.size() != vertices.size()) {
+        return result;
+    }
+
+    const size_t triangleCount = indices.size() / 3;
+    const size_t vertexCount = vertices.size();
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    const float logTexels = std::log2(static_cast<float>(textureWidth) * static_cast<float>(textureHeight));
+    std::vector<ChunkResult> chunks(chunkCount);
+
+    // (A e0) x (A e1) = cof(A) (e0 x e1); the cofactor's columns are the
+    // cross products of A's columns
+    const glm::mat4& m = worldTransform;
+    const glm::vec3 a0(m[0][0], m[0][1], m[0][2]), a1(m[1][0], m[1][1], m[1][2]), a2(m[2][0], m[2][1], m[2][2]);
+    const glm::vec3 c0 = glm::cross(a1, a2), c1 = glm::cross(a2, a0), c2 = glm::cross(a0, a1);
+
+    // log2 density per triangle, NaN where unmeasured
+    std::vector<float> logDensity(triangleCount);
+
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        ChunkResult& out = chunks[chunk];
+        out.histogram.assign(kHistogramBins, 0);
+        out.medianWeights.assign(kMedianBins, 0.0);
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min(triangleCount, begin + kTrianglesPerChunk);
+
+        // Structure-of-arrays scratch for one block
+        VertexKernels::TriangleBlock tri;
+        float du0[kTriangleBlock], dv0[kTriangleBlock], du1[kTriangleBlock], dv1[kTriangleBlock];
+        float worldCrossSq[kTriangleBlock], uvCross[kTriangleBlock], logD[kTriangleBlock];
+
+        for (size_t first = begin; first < end; first += kTriangleBlock) {
+            tri.gather(indices.data(), first, end, vertices.data(), vertexCount);
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                const glm::vec2& t0 = uvs[tri.i0[k]];
+                du0[k] = uvs[tri.i1[k]].x - t0.x;
+                dv0[k] = uvs[tri.i1[k]].y - t0.y;
+                du1[k] = uvs[tri.i2[k]].x - t0.x;
+                dv1[k] = uvs[tri.i2[k]].y - t0.y;
+            }
+
+            // Branch-free area and density math
+            for (size_t k = 0; k < kTriangleBlock; ++k) {
+                const float lx = tri.e0y[k] * tri.e1z[k] - tri.e0z[k] * tri.e1y[k];
+                const float ly = tri.e0z[k] * tri.e1x[k] - tri.e0x[k] * tri.e1z[k];
+                const float lz = tri.e0x[k] * tri.e1y[k] - tri.e0y[k] * tri.e1x[k];
+                const float cx = c0.x * lx + c1.x * ly + c2.x * lz;
+                const float cy = c0.y * lx + c1.y * ly + c2.y * lz;
+                const float cz = c0.z * lx + c1.z * ly + c2.z * lz;
+                worldCrossSq[k] = cx * cx + cy * cy + cz * cz;
+                uvCross[k] = std::fabs(du0[k] * dv1[k] - dv0[k] * du1[k]);
+                // density^2 = uvArea * texels / worldArea; the factors of 2 cancel
+                logD[k] = 0.5f * (fastLog2(uvCross[k]) + logTexels) - 0.25f * fastLog2(worldCrossSq[k]);
+            }
+
+            for (size_t k = 0; k < tri.count; ++k) {
+                const size_t t = first + k;
+                // NaN areas fail both comparisons
+                const bool measured = tri.valid[k] && uvCross[k] > kMinUVCross && worldCrossSq[k] > kMinWorldCrossSq &&
+                                      uvCross[k] <= std::numeric_limits<float>::max() &&
+                                      worldCrossSq[k] <= std::numeric_limits<float>::max();
+                if (!measured) {
+                    logDensity[t] = std::numeric_limits<float>::quiet_NaN();
+                    continue;
+                }
+                const float logValue = logD[k];
+                logDensity[t] = logValue;
+                const double worldArea = 0.5 * std::sqrt(static_cast<double>(worldCrossSq[k]));
+                out.measured++;
+                out.worldArea += worldArea;
+                out.uvArea += 0.5 * uvCross[k];
+                out.minLog = std::min(out.minLog, logValue);
+                out.maxLog = std::max(out.maxLog, logValue);
+                const int bin = static_cast<int>(std::floor(logValue / TexelDensityResult::kHistogramBinOctaves));
+                out.histogram[std::clamp(bin, 0, kHistogramBins - 1)]++;
+                const int medianBin = static_cast<int>(std::floor((logValue - kMedianMinLog2) * kMedianBinsPerOctave));
+                out.medianWeights[std::clamp(medianBin, 0, kMedianBins - 1)] += worldArea;
+            }
+        }
+    });
+
+    float minLog = std::numeric_limits<float>::infinity();
+    float maxLog = -std::numeric_limits<float>::infinity();
+    double uvArea = 0.0;
+    std::vector<double> medianWeights(kMedianBins, 0.0);
+    for (const auto& chunk : chunks) {
+        result.measuredTriangles += chunk.measured;
+        result.worldArea += chunk.worldArea;
+        uvArea += chunk.uvArea;
+        minLog = std::min(minLog, chunk.minLog);
+        maxLog = std::max(maxLog, chunk.maxLog);
+        for (int b = 0; b < kHistogramBins; ++b) {
+            result.histogram[b] += chunk.histogram[b];
+        }
+        for (int b = 0; b < kMedianBins; ++b) {
+            medianWeights[b] += chunk.medianWeights[b];
+        }
+    }
+    if (result.measuredTriangles == 0) {
+        return result;
+    }
+    result.texelArea = uvArea * textureWidth * textureHeight;
+
+    // Area-weighted median from the fine histogram, clamped to the range
+    // actually seen
+    double remaining = 0.5 * result.worldArea;
+    int medianBin = 0;
+    while (medianBin < kMedianBins - 1 && remaining > medianWeights[medianBin]) {
+        remaining -= medianWeights[medianBin];
+        ++medianBin;
+    }
+    const float medianLog = std::clamp(kMedianMinLog2 + (medianBin + 0.5f) / kMedianBinsPerOctave, minLog, maxLog);
+    result.minDensity = std::exp2(minLog);
+    result.maxDensity = std::exp2(maxLog);
+    result.medianDensity = std::exp2(medianLog);
+
+    // Outliers against the reference, chunk by chunk
+    const float referenceLog = referenceDensity > 0.0f ? std::log2(referenceDensity) : medianLog;
+    const float limitLog = std::log2(std::max(maxRatio, 1.0f));
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        auto& outliers = chunks[chunk].outliers;
+        const size_t begin = chunk * kTrianglesPerChunk;
+        const size_t end = std::min(triangleCount, begin + kTrianglesPerChunk);
+        for (size_t t = begin; t < end; ++t) {
+            // NaN (unmeasured) compares false
+            const float deviation = std::fabs(logDensity[t] - referenceLog);
+            if (deviation > limitLog) {
+                outliers.emplace_back(deviation, static_cast<uint32_t>(t));
+            }
+        }
+    });
+
+    std::vector<std::pair<float, uint32_t>> outliers;
+    for (auto& chunk : chunks) {
+        result.outlierTriangles += chunk.outliers.size();
+        outliers.insert(outliers.end(), chunk.outliers.begin(), chunk.outliers.end());
+    }
+    const size_t keep = std::min(outliers.size(), TexelDensityResult::kMaxWorstTriangles);
+    std::partial_sort(outliers.begin(), outliers.begin() + keep, outliers.end(),
+                      [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+                          return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+    for (size_t i = 0; i < keep; ++i) {
+        result.worstTriangles.push_back(outliers[i].second);
+    }
+    return result;
+}
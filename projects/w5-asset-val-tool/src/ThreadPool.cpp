@@ -0,0 +1,178 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    // Identifies the pool/worker the current thread belongs to, so nested
+    // parallelFor calls push onto the caller's own deque.
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // The calling thread is the last participant, so spawn one fewer worker
+    const size_t workerCount = threadCount - 1;
+    queues.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t grainSize) {
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+
+    // Nothing to share the work with: run inline without task overhead
+    if (workers.empty() || count <= grainSize) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    TaskGroup group;
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+    group.pending.store(chunkCount, std::memory_order_relaxed);
+
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const size_t begin = chunk * grainSize;
+        const size_t end = std::min(count, begin + grainSize);
+
+        Task task;
+        task.group = &group;
+        task.run = [&fn, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                fn(i);
+            }
+        };
+        push(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_all();
+
+    // Help out instead of blocking until every chunk of this loop is done
+    while (group.pending.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.error) {
+        std::rethrow_exception(group.error);
+    }
+}
+
+void ThreadPool::workerLoop(size_t workerIndex) {
+    currentPool = this;
+    currentWorker = workerIndex;
+
+    while (true) {
+        if (tryRunOne()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() {
+            return stopping || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+
+        if (stopping && queuedTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::push(Task task) {
+    // Workers keep their own tasks local; external callers spread round-robin
+    const size_t queueIndex = (currentPool == this)
+        ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+    queuedTasks.fetch_add(1, std::memory_order_release);
+    queues[queueIndex]->tasks.push_back(std::move(task));
+}
+
+bool ThreadPool::tryRunOne() {
+    Task task;
+    const bool isWorker = (currentPool == this);
+    const size_t home = isWorker ? currentWorker : nextQueue.load(std::memory_order_relaxed) % queues.size();
+
+    if ((isWorker && popLocal(home, task)) || steal(home, task)) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::popLocal(size_t queueIndex, Task& task) {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    // LIFO on the owner's side keeps recently split work hot in cache
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::steal(size_t thiefIndex, Task& task) {
+    const size_t queueCount = queues.size();
+    for (size_t offset = 1; offset <= queueCount; ++offset) {
+        WorkQueue& victim = *queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+
+        // FIFO on the thief's side takes the oldest, usually largest, chunk
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task& task) {
+    TaskGroup* group = task.group;
+    try {
+        task.run();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->errorMutex);
+        if (!group->error) {
+            group->error = std::current_exception();
+        }
+    }
+
+    // The group lives on the waiting caller's stack: touch it last
+    group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,371 @@
+#include "TriangleBVH.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const int kBins = 16;
+    const uint32_t kMinSplitTriangles = 3;  // Nodes with fewer are always leaves
+    const uint32_t kMaxLeafTriangles = 8;   // Nodes with more are always split
+    const float kTraversalCost = 1.0f;      // Relative to one triangle test
+    const size_t kParallelSubtree = 1 << 14; // Subtrees above this many triangles become tasks
+    const size_t kParallelBinning = 1 << 16; // Nodes above this bin in chunks
+    const size_t kBinningChunk = 1 << 15;
+    const uint32_t kMaxSahDepth = 48;       // Deeper nodes split at the median, bounding the depth
+    const int kStackSize = 128;
+
+    struct Box {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::infinity());
+        glm::vec3 max = glm::vec3(-std::numeric_limits<float>::infinity());
+
+        void grow(const glm::vec3& p) {
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+        void grow(const Box& other) {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+        float area() const {
+            const glm::vec3 d = max - min;
+            return d.x < 0.0f ? 0.0f : 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+    };
+
+    // SAH bin for a centroid offset scaled to [0, kBins). Shared code gets
+    // whatever corners callers pass: NaN offsets land in bin 0 and
+    // infinite ones at the ends instead of indexing out of bounds.
+    int binIndex(float offset) {
+        if (!(offset > 0.0f)) {
+            return 0;
+        }
+        return offset < float(kBins - 1) ? static_cast<int>(offset) : kBins - 1;
+    }
+
+    // Median order along an axis, NaN centroids first
+    float sortKey(float center) {
+        return std::isnan(center) ? -std::numeric_limits<float>::infinity() : center;
+    }
+
+    struct Bin {
+        Box box;
+        uint32_t count = 0;
+    };
+
+    // Triangle and centroid bounds of one range
+    struct Extent {
+        Box bounds;
+        Box centroids;
+
+        void merge(const Extent& other) {
+            bounds.grow(other.bounds);
+            centroids.grow(other.centroids);
+        }
+    };
+
+    // Per-axis bins of one range
+    struct Bins {
+        Bin bins[3][kBins];
+
+        void merge(const Bins& other) {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int b = 0; b < kBins; ++b) {
+                    bins[axis][b].box.grow(other.bins[axis][b].box);
+                    bins[axis][b].count += other.bins[axis][b].count;
+                }
+            }
+        }
+    };
+
+    struct Builder {
+        const std::vector<Box>& boxes;
+        const std::vector<glm::vec3>& centers;
+        std::vector<uint32_t>& order;
+        std::vector<BVHNode>& nodes;
+        ThreadPool& pool;
+        std::atomic<uint32_t> used{1};
+
+        Builder(const std::vector<Box>& boxes, const std::vector<glm::vec3>& centers, std::vector<uint32_t>& order,
+                std::vector<BVHNode>& nodes, ThreadPool& pool)
+            : boxes(boxes), centers(centers), order(order), nodes(nodes), pool(pool) {}
+
+        // Runs fn over [begin, end) in chunks, in parallel for large ranges,
+        // merging per-chunk stats in order
+        template <typename Stats, typename Fn>
+        Stats gather(uint32_t begin, uint32_t end, Fn fn) {
+            const size_t count = end - begin;
+            if (count <= kParallelBinning) {
+                Stats stats;
+                fn(begin, end, stats);
+                return stats;
+            }
+            const size_t chunks = (count + kBinningChunk - 1) / kBinningChunk;
+            std::vector<Stats> partial(chunks);
+            pool.parallelFor(chunks, [&](size_t chunk) {
+                const uint32_t from = begin + static_cast<uint32_t>(chunk * kBinningChunk);
+                const uint32_t to = static_cast<uint32_t>(std::min<size_t>(end, from + kBinningChunk));
+                fn(from, to, partial[chunk]);
+            });
+            Stats stats = partial[0];
+            for (size_t chunk = 1; chunk < chunks; ++chunk) {
+                stats.merge(partial[chunk]);
+            }
+            return stats;
+        }
+
+        void makeLeaf(uint32_t node, uint32_t begin, uint32_t end) {
+            nodes[node].first = begin;
+            nodes[node].count = end - begin;
+        }
+
+        void buildNode(uint32_t node, uint32_t begin, uint32_t end, uint32_t depth) {
+            const uint32_t count = end - begin;
+            const Extent extent = gather<Extent>(begin, end, [&](uint32_t from, uint32_t to, Extent& stats) {
+                for (uint32_t i = from; i < to; ++i) {
+                    stats.bounds.grow(boxes[order[i]]);
+                    if (!std::isnan(centers[order[i]].x)) {
+                        stats.centroids.grow(centers[order[i]]);
+                    }
+                }
+            });
+            nodes[node].min = extent.bounds.min;
+            nodes[node].max = extent.bounds.max;
+            if (count < kMinSplitTriangles) {
+                makeLeaf(node, begin, end);
+                return;
+            }
+
+            const glm::vec3 low = extent.centroids.min;
+            const glm::vec3 size = extent.centroids.max - extent.centroids.min;
+            glm::vec3 scale(0.0f);
+            for (int axis = 0; axis < 3; ++axis) {
+                if (size[axis] > 0.0f) {
+                    scale[axis] = kBins * (1.0f - 1e-6f) / size[axis];
+                }
+            }
+            auto binOf = [&](uint32_t triangle, int axis) {
+                return binIndex((centers[triangle][axis] - low[axis]) * scale[axis]);
+            };
+
+            // Binned SAH over the three axes
+            int bestAxis = -1;
+            int bestSplit = 0;
+            float bestCost = std::numeric_limits<float>::infinity();
+            if (depth < kMaxSahDepth && (scale.x > 0.0f || scale.y > 0.0f || scale.z > 0.0f)) {
+                const Bins binned = gather<Bins>(begin, end, [&](uint32_t from, uint32_t to, Bins& stats) {
+                    // Flat axes all land in bin 0 and are skipped below
+                    for (uint32_t i = from; i < to; ++i) {
+                        const uint32_t triangle = order[i];
+                        const Box& box = boxes[triangle];
+                        const glm::vec3 offset = (centers[triangle] - low) * scale;
+                        const int bin[3] = {binIndex(offset.x), binIndex(offset.y), binIndex(offset.z)};
+                        for (int axis = 0; axis < 3; ++axis) {
+                            stats.bins[axis][bin[axis]].box.grow(box);
+                            stats.bins[axis][bin[axis]].count++;
+                        }
+                    }
+                });
+                const float parentArea = std::max(extent.bounds.area(), std::numeric_limits<float>::min());
+                for (int axis = 0; axis < 3; ++axis) {
+                    if (scale[axis] == 0.0f) {
+                        continue;
+                    }
+                    // Right-to-left sweep, then left-to-right evaluating each boundary
+                    float rightArea[kBins];
+                    uint32_t rightCount[kBins];
+                    Box right;
+                    uint32_t rightTotal = 0;
+                    for (int b = kBins - 1; b > 0; --b) {
+                        right.grow(binned.bins[axis][b].box);
+                        rightTotal += binned.bins[axis][b].count;
+                        rightArea[b] = right.area();
+                        rightCount[b] = rightTotal;
+                    }
+                    Box left;
+                    uint32_t leftTotal = 0;
+                    for (int b = 1; b < kBins; ++b) {
+                        left.grow(binned.bins[axis][b - 1].box);
+                        leftTotal += binned.bins[axis][b - 1].count;
+                        if (leftTotal == 0 || rightCount[b] == 0) {
+                            continue;
+                        }
+                        const float cost = kTraversalCost +
+                                           (left.area() * leftTotal + rightArea[b] * rightCount[b]) / parentArea;
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestSplit = b;
+                        }
+                    }
+                }
+            }
+
+            // A leaf costs one test per triangle
+            if (count <= kMaxLeafTriangles && !(bestCost < float(count))) {
+                makeLeaf(node, begin, end);
+                return;
+            }
+
+            uint32_t middle = begin + count / 2;
+            if (bestAxis >= 0) {
+                middle = static_cast<uint32_t>(
+                    std::partition(order.begin() + begin, order.begin() + end,
+                                   [&](uint32_t triangle) { return binOf(triangle, bestAxis) < bestSplit; }) -
+                    order.begin());
+            } else {
+                // No usable split (coincident centroids or too deep): median
+                // along the widest centroid axis
+                int axis = 0;
+                if (size.y > size[axis]) {
+                    axis = 1;
+                }
+                if (size.z > size[axis]) {
+                    axis = 2;
+                }
+                std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                                 [&](uint32_t a, uint32_t b) {
+                                     const float ka = sortKey(centers[a][axis]), kb = sortKey(centers[b][axis]);
+                                     return ka != kb ? ka < kb : a < b;
+                                 });
+            }
+
+            const uint32_t left = used.fetch_add(2, std::memory_order_relaxed);
+            nodes[node].first = left;
+            nodes[node].count = 0;
+            if (count > kParallelSubtree) {
+                pool.parallelFor(2, [&](size_t child) {
+                    if (child == 0) {
+                        buildNode(left, begin, middle, depth + 1);
+                    } else {
+                        buildNode(left + 1, middle, end, depth + 1);
+                    }
+                });
+            } else {
+                buildNode(left, begin, middle, depth + 1);
+                buildNode(left + 1, middle, end, depth + 1);
+            }
+        }
+    };
+
+    // Slab test. A ray parallel to an axis meets the slab everywhere or
+    // nowhere; testing that directly avoids the 0 * inf of an origin on a
+    // face, which flat boxes of axis-aligned geometry hit all the time.
+    bool hitsBox(const BVHNode& node, const glm::vec3& origin, const glm::vec3& inverse, float tMin, float tMax) {
+        float nearT = tMin, farT = tMax;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (std::isinf(inverse[axis])) {
+                if (origin[axis] < node.min[axis] || origin[axis] > node.max[axis]) {
+                    return false;
+                }
+                continue;
+            }
+            const float t0 = (node.min[axis] - origin[axis]) * inverse[axis];
+            const float t1 = (node.max[axis] - origin[axis]) * inverse[axis];
+            nearT = std::max(nearT, std::min(t0, t1));
+            farT = std::min(farT, std::max(t0, t1));
+        }
+        return nearT <= farT;
+    }
+
+    // Two-sided Moller-Trumbore
+    bool hitsTriangle(const glm::vec3* corner, const glm::vec3& origin, const glm::vec3& direction,
+                      float tMin, float tMax) {
+        const glm::vec3 e1 = corner[1] - corner[0];
+        const glm::vec3 e2 = corner[2] - corner[0];
+        const glm::vec3 p = glm::cross(direction, e2);
+        const float det = glm::dot(e1, p);
+        if (det == 0.0f || !std::isfinite(det)) {
+            return false;
+        }
+        const float inverse = 1.0f / det;
+        const glm::vec3 s = origin - corner[0];
+        const float u = glm::dot(s, p) * inverse;
+        if (u < 0.0f || u > 1.0f) {
+            return false;
+        }
+        const glm::vec3 q = glm::cross(s, e1);
+        const float v = glm::dot(direction, q) * inverse;
+        if (v < 0.0f || u + v > 1.0f) {
+            return false;
+        }
+        const float t = glm::dot(e2, q) * inverse;
+        return t > tMin && t < tMax;
+    }
+}
+
+void TriangleBVH::build(std::vector<glm::vec3> triangleCorners, ThreadPool& pool) {
+    nodes.clear();
+    order.clear();
+    corners.clear();
+    const size_t triangleCount = triangleCorners.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    std::vector<Box> boxes(triangleCount);
+    std::vector<glm::vec3> centers(triangleCount);
+    order.resize(triangleCount);
+    const size_t chunks = (triangleCount + kBinningChunk - 1) / kBinningChunk;
+    pool.parallelFor(chunks, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kBinningChunk);
+        for (size_t t = chunk * kBinningChunk; t < end; ++t) {
+            Box& box = boxes[t];
+            box.grow(triangleCorners[t * 3]);
+            box.grow(triangleCorners[t * 3 + 1]);
+            box.grow(triangleCorners[t * 3 + 2]);
+            centers[t] = (box.min + box.max) * 0.5f;
+            if (!std::isfinite(centers[t].x) || !std::isfinite(centers[t].y) || !std::isfinite(centers[t].z)) {
+                // Left out of the centroid bounds; lands in bin 0 on every axis
+                centers[t] = glm::vec3(std::numeric_limits<float>::quiet_NaN());
+            }
+            order[t] = static_cast<uint32_t>(t);
+        }
+    });
+
+    // A binary tree with at least one triangle per leaf has at most 2n - 1 nodes
+    nodes.resize(triangleCount * 2 - 1);
+    Builder builder(boxes, centers, order, nodes, pool);
+    builder.buildNode(0, 0, static_cast<uint32_t>(triangleCount), 0);
+    nodes.resize(builder.used.load());
+
+    corners.resize(triangleCorners.size());
+    pool.parallelFor(chunks, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kBinningChunk);
+        for (size_t slot = chunk * kBinningChunk; slot < end; ++slot) {
+            const size_t t = order[slot];
+            corners[slot * 3] = triangleCorners[t * 3];
+            corners[slot * 3 + 1] = triangleCorners[t * 3 + 1];
+            corners[slot * 3 + 2] = triangleCorners[t * 3 + 2];
+        }
+    });
+}
+
+bool TriangleBVH::occluded(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax,
+                           uint32_t ignore) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    const glm::vec3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    uint32_t stack[kStackSize];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVHNode& node = nodes[stack[--top]];
+        if (!hitsBox(node, origin, inverse, tMin, tMax)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            for (uint32_t slot = node.first; slot < node.first + node.count; ++slot) {
+                if (order[slot] != ignore && hitsTriangle(cornersAt(slot), origin, direction, tMin, tMax)) {
+                    return true;
+                }
+            }
+        } else {
+            stack[top++] = node.first + 1;
+            stack[top++] = node.first;
+        }
+    }
+    return false;
+}
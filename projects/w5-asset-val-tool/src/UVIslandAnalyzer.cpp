@@ -0,0 +1,163 @@
+#include "UVIslandAnalyzer.h"
+#include "ConcurrentUnionFind.h"
+#include "EdgeAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const size_t kTrianglesPerChunk = 1 << 16;
+    const size_t kEdgesPerChunk = 1 << 16;
+    const uint32_t kNoIsland = UINT32_MAX;
+
+    uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+    }
+
+    struct IslandTotals {
+        uint32_t firstTriangle = 0;
+        uint32_t triangles = 0;
+        double uvArea = 0.0;
+    };
+
+    struct SeamChunk {
+        uint64_t sides = 0;
+        double length = 0.0;
+    };
+}
+
+UVIslandAnalyzer::UVIslandAnalyzer(float minIslandTexels)
+    : minIslandTexels(std::max(0.0f, minIslandTexels)) {}
+
+UVIslandResult UVIslandAnalyzer::analyze(const std::vector<glm::vec3>& vertices,
+                                         const std::vector<glm::vec2>& uvs,
+                                         const std::vector<uint32_t>& indices,
+                                         uint32_t textureWidth, uint32_t textureHeight,
+                                         ThreadPool& pool) const {
+    UVIslandResult result;
+    result.textureWidth = textureWidth;
+    result.textureHeight = textureHeight;
+    const size_t vertexCount = vertices.size();
+    if (uvs.size() != vertexCount || indices.size() < 3) {
+        return result;
+    }
+
+    const std::vector<uint32_t> positionId = EdgeAdjacency::weldPositions(vertices, pool);
+    const std::vector<uint32_t> uvId = EdgeAdjacency::weldPositionsAndUVs(vertices, uvs, pool);
+
+    // Islands: union the welded corners of every triangle
+    const size_t triangleCount = indices.size() / 3;
+    const size_t chunkCount = (triangleCount + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+    ConcurrentUnionFind sets(vertexCount);
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        const size_t end = std::min(triangleCount, (chunk + 1) * kTrianglesPerChunk);
+        for (size_t t = chunk * kTrianglesPerChunk; t < end; ++t) {
+            const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+                continue;
+            }
+            sets.unite(uvId[i0], uvId[i1]);
+            sets.unite(uvId[i1], uvId[i2]);
+        }
+    });
+
+    // Number islands by first triangle and total their area, in one
+    // sequential pass once every union has finished
+    std::vector<uint32_t> islandOf(vertexCount, kNoIsland);
+    std::vector<uint8_t> usedPosition(vertexCount, 0);
+    std::vector<uint8_t> usedUV(vertexCount, 0);
+    std::vector<IslandTotals> islands;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            continue;
+        }
+        const uint32_t root = sets.find(uvId[i0]);
+        uint32_t& island = islandOf[root];
+        if (island == kNoIsland) {
+            island = static_cast<uint32_t>(islands.size());
+            islands.emplace_back();
+            islands.back().firstTriangle = static_cast<uint32_t>(t);
+        }
+        IslandTotals& totals = islands[island];
+        totals.triangles++;
+        const glm::vec2 e0 = uvs[i1] - uvs[i0];
+        const glm::vec2 e1 = uvs[i2] - uvs[i0];
+        const double area = 0.5 * std::fabs(double(e0.x) * e1.y - double(e0.y) * e1.x);
+        if (std::isfinite(area)) {
+            totals.uvArea += area;
+        }
+        for (uint32_t index : {i0, i1, i2}) {
+            usedPosition[positionId[index]] = 1;
+            usedUV[uvId[index]] = 1;
+        }
+    }
+    result.islandCount = static_cast<uint32_t>(islands.size());
+    for (size_t v = 0; v < vertexCount; ++v) {
+        result.positionVertices += usedPosition[v];
+        result.uvVertices += usedUV[v];
+    }
+    result.seamVertices = result.uvVertices - result.positionVertices;
+
+    if (textureWidth > 0 && textureHeight > 0) {
+        const double texelsPerUnit = double(textureWidth) * textureHeight;
+        std::vector<UVIslandSample> tiny;
+        for (const IslandTotals& island : islands) {
+            const double texels = island.uvArea * texelsPerUnit;
+            if (texels < minIslandTexels) {
+                result.tinyIslandTriangles += island.triangles;
+                tiny.push_back(UVIslandSample{island.firstTriangle, island.triangles, static_cast<float>(texels)});
+            }
+        }
+        result.tinyIslands = static_cast<uint32_t>(tiny.size());
+        const size_t keep = std::min(tiny.size(), UVIslandResult::kMaxSmallestIslands);
+        std::partial_sort(tiny.begin(), tiny.begin() + keep, tiny.end(),
+                          [](const UVIslandSample& a, const UVIslandSample& b) {
+                              return a.texels != b.texels ? a.texels < b.texels : a.firstTriangle < b.firstTriangle;
+                          });
+        result.smallestIslands.assign(tiny.begin(), tiny.begin() + keep);
+    }
+
+    // Seams: UV-space boundary edges that are interior in position space
+    EdgeAdjacency positionEdges;
+    positionEdges.build(indices, positionId, vertexCount, pool);
+    std::vector<uint64_t> openEdges;
+    for (const MeshEdge& edge : positionEdges.getEdges()) {
+        if (edge.faceCount == 1) {
+            openEdges.push_back(uint64_t(edge.v0) << 32 | edge.v1);
+        }
+    }
+    std::sort(openEdges.begin(), openEdges.end());
+
+    EdgeAdjacency uvEdges;
+    uvEdges.build(indices, uvId, vertexCount, pool);
+    const std::vector<MeshEdge>& edges = uvEdges.getEdges();
+    const size_t edgeChunks = (edges.size() + kEdgesPerChunk - 1) / kEdgesPerChunk;
+    std::vector<SeamChunk> seams(edgeChunks);
+    pool.parallelFor(edgeChunks, [&](size_t chunk) {
+        SeamChunk& out = seams[chunk];
+        const size_t end = std::min(edges.size(), (chunk + 1) * kEdgesPerChunk);
+        for (size_t e = chunk * kEdgesPerChunk; e < end; ++e) {
+            const MeshEdge& edge = edges[e];
+            const uint32_t p0 = positionId[edge.v0];
+            const uint32_t p1 = positionId[edge.v1];
+            if (edge.faceCount != 1 || p0 == p1 ||
+                std::binary_search(openEdges.begin(), openEdges.end(), edgeKey(p0, p1))) {
+                continue;
+            }
+            out.sides++;
+            out.length += glm::length(vertices[edge.v1] - vertices[edge.v0]);
+        }
+    });
+
+    // Both islands along a seam hold one side of it
+    uint64_t sides = 0;
+    double length = 0.0;
+    for (const SeamChunk& chunk : seams) {
+        sides += chunk.sides;
+        length += chunk.length;
+    }
+    result.seamEdges = (sides + 1) / 2;
+    result.seamLength = length / 2.0;
+    return result;
+}
@@ -0,0 +1,206 @@
+#include "UVOverlapDetector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Vertices are snapped to 1/256th of a texel so edge functions are exact
+    constexpr int64_t kSubTexelBits = 8;
+    constexpr int64_t kSubTexel = int64_t(1) << kSubTexelBits;
+    constexpr int64_t kHalfTexel = kSubTexel / 2;
+
+    constexpr uint32_t kEmptyTexel = 0xFFFFFFFFu;
+    constexpr uint32_t kOverlapBit = 0x80000000u;
+
+    struct SnappedTriangle {
+        int64_t x[3];
+        int64_t y[3];
+    };
+
+    struct TexelRect {
+        int64_t minX, minY, maxX, maxY; // Half-open texel range [min, max)
+    };
+
+    int64_t floorDiv(int64_t a, int64_t b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    // Far out-of-range UVs are clamped: they are reported by the range check,
+    // and the clamp keeps the fixed-point products well inside 64 bits.
+    bool snapTriangle(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c,
+                      uint32_t resolution, SnappedTriangle& tri) {
+        const glm::vec2* uv[3] = {&a, &b, &c};
+        const double scale = static_cast<double>(resolution) * kSubTexel;
+        for (int i = 0; i < 3; ++i) {
+            if (!std::isfinite(uv[i]->x) || !std::isfinite(uv[i]->y)) {
+                return false;
+            }
+            tri.x[i] = std::llround(std::clamp(static_cast<double>(uv[i]->x), -1.0, 2.0) * scale);
+            tri.y[i] = std::llround(std::clamp(static_cast<double>(uv[i]->y), -1.0, 2.0) * scale);
+        }
+
+        // Normalize to counter-clockwise so "inside" is always E >= 0
+        const int64_t area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) -
+                             (tri.y[1] - tri.y[0]) * (tri.x[2] - tri.x[0]);
+        if (area == 0) {
+            return false; // Degenerate in UV space: covers no texel centers
+        }
+        if (area < 0) {
+            std::swap(tri.x[1], tri.x[2]);
+            std::swap(tri.y[1], tri.y[2]);
+        }
+        return true;
+    }
+
+    // Calls visit(texelIndex) for every texel whose center lies inside the
+    // triangle. Stops early and returns false as soon as visit returns false.
+    template <typename Visit>
+    bool rasterize(const SnappedTriangle& tri, const TexelRect& grid, Visit&& visit) {
+        const int64_t minX = std::min({tri.x[0], tri.x[1], tri.x[2]});
+        const int64_t maxX = std::max({tri.x[0], tri.x[1], tri.x[2]});
+        const int64_t minY = std::min({tri.y[0], tri.y[1], tri.y[2]});
+        const int64_t maxY = std::max({tri.y[0], tri.y[1], tri.y[2]});
+
+        // Texels whose centers fall in the bounding box, clipped to the grid
+        const int64_t startX = std::max(grid.minX, floorDiv(minX - kHalfTexel + kSubTexel - 1, kSubTexel));
+        const int64_t endX = std::min(grid.maxX - 1, floorDiv(maxX - kHalfTexel, kSubTexel));
+        const int64_t startY = std::max(grid.minY, floorDiv(minY - kHalfTexel + kSubTexel - 1, kSubTexel));
+        const int64_t endY = std::min(grid.maxY - 1, floorDiv(maxY - kHalfTexel, kSubTexel));
+        if (startX > endX || startY > endY) {
+            return true;
+        }
+
+        const int64_t gridWidth = grid.maxX - grid.minX;
+        const int64_t originX = startX * kSubTexel + kHalfTexel;
+        const int64_t originY = startY * kSubTexel + kHalfTexel;
+
+        // Edge functions at the first texel center plus per-texel steps.
+        // A shared edge is walked in opposite directions by its two
+        // triangles, so the top-left bias hands it to exactly one of them.
+        int64_t rowEdge[3], stepX[3], stepY[3];
+        for (int e = 0; e < 3; ++e) {
+            const int a = e;
+            const int b = (e + 1) % 3;
+            const int64_t dx = tri.x[b] - tri.x[a];
+            const int64_t dy = tri.y[b] - tri.y[a];
+            const bool topLeft = (dy < 0) || (dy == 0 && dx < 0);
+
+            rowEdge[e] = dx * (originY - tri.y[a]) - dy * (originX - tri.x[a]) - (topLeft ? 0 : 1);
+            stepX[e] = -dy * kSubTexel;
+            stepY[e] = dx * kSubTexel;
+        }
+
+        for (int64_t y = startY; y <= endY; ++y) {
+            int64_t edge0 = rowEdge[0];
+            int64_t edge1 = rowEdge[1];
+            int64_t edge2 = rowEdge[2];
+            const size_t rowOffset = static_cast<size_t>((y - grid.minY) * gridWidth - grid.minX);
+
+            for (int64_t x = startX; x <= endX; ++x) {
+                if ((edge0 | edge1 | edge2) >= 0) {
+                    if (!visit(rowOffset + static_cast<size_t>(x))) {
+                        return false;
+                    }
+                }
+                edge0 += stepX[0];
+                edge1 += stepX[1];
+                edge2 += stepX[2];
+            }
+
+            rowEdge[0] += stepY[0];
+            rowEdge[1] += stepY[1];
+            rowEdge[2] += stepY[2];
+        }
+        return true;
+    }
+}
+
+UVOverlapDetector::UVOverlapDetector(uint32_t resolution)
+    : resolution(std::clamp<uint32_t>(resolution, 16, 16384)) {}
+
+UVOverlapResult UVOverlapDetector::analyze(const std::vector<glm::vec2>& uvCoords,
+                                           const std::vector<uint32_t>& indices) const {
+    UVOverlapResult result;
+    const size_t triangleCount = std::min<size_t>(indices.size() / 3, kOverlapBit - 1);
+    if (uvCoords.empty() || triangleCount == 0) {
+        return result;
+    }
+
+    // Snap every triangle once; invalid ones get an empty entry
+    std::vector<SnappedTriangle> triangles(triangleCount);
+    std::vector<uint8_t> valid(triangleCount, 0);
+    glm::vec2 uvMin(1.0f);
+    glm::vec2 uvMax(0.0f);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3];
+        const uint32_t i1 = indices[t * 3 + 1];
+        const uint32_t i2 = indices[t * 3 + 2];
+        if (i0 >= uvCoords.size() || i1 >= uvCoords.size() || i2 >= uvCoords.size()) {
+            continue;
+        }
+        if (snapTriangle(uvCoords[i0], uvCoords[i1], uvCoords[i2], resolution, triangles[t])) {
+            valid[t] = 1;
+            uvMin = glm::min(uvMin, glm::min(uvCoords[i0], glm::min(uvCoords[i1], uvCoords[i2])));
+            uvMax = glm::max(uvMax, glm::max(uvCoords[i0], glm::max(uvCoords[i1], uvCoords[i2])));
+        }
+    }
+
+    // Only allocate the part of the 0-1 square the mesh actually touches
+    const double res = static_cast<double>(resolution);
+    TexelRect grid;
+    grid.minX = static_cast<int64_t>(std::floor(std::clamp<double>(uvMin.x, 0.0, 1.0) * res));
+    grid.minY = static_cast<int64_t>(std::floor(std::clamp<double>(uvMin.y, 0.0, 1.0) * res));
+    grid.maxX = static_cast<int64_t>(std::ceil(std::clamp<double>(uvMax.x, 0.0, 1.0) * res));
+    grid.maxY = static_cast<int64_t>(std::ceil(std::clamp<double>(uvMax.y, 0.0, 1.0) * res));
+    if (grid.maxX <= grid.minX || grid.maxY <= grid.minY) {
+        return result;
+    }
+
+    // Pass 1: record the first owner of each texel and flag texels that a
+    // second, different triangle also covers
+    std::vector<uint32_t> owners(static_cast<size_t>((grid.maxX - grid.minX) * (grid.maxY - grid.minY)), kEmptyTexel);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (!valid[t]) {
+            continue;
+        }
+        const uint32_t id = static_cast<uint32_t>(t);
+        rasterize(triangles[t], grid, [&](size_t texel) {
+            uint32_t& owner = owners[texel];
+            if (owner == kEmptyTexel) {
+                owner = id;
+            } else if ((owner & ~kOverlapBit) != id) {
+                owner |= kOverlapBit;
+            }
+            return true;
+        });
+    }
+
+    for (uint32_t owner : owners) {
+        if (owner != kEmptyTexel) {
+            result.coveredTexels++;
+            if (owner & kOverlapBit) {
+                result.overlappingTexels++;
+            }
+        }
+    }
+
+    if (result.overlappingTexels == 0) {
+        return result;
+    }
+    result.overlapPercentage = static_cast<float>(
+        100.0 * static_cast<double>(result.overlappingTexels) / static_cast<double>(result.coveredTexels));
+
+    // Pass 2: a triangle is offending if any texel it covers is shared
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (!valid[t]) {
+            continue;
+        }
+        const bool clean = rasterize(triangles[t], grid, [&](size_t texel) {
+            return (owners[texel] & kOverlapBit) == 0 || owners[texel] == kEmptyTexel;
+        });
+        if (!clean) {
+            result.overlappingTriangles.push_back(static_cast<uint32_t>(t));
+        }
+    }
+
+    return result;
+}
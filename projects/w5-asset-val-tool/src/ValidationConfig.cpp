@@ -0,0 +1,608 @@
+#include "ValidationConfig.h"
+#include <fstream>
+#include <fmt/core.h>
+
+ValidationConfig ValidationConfig::loadFromFile(const std::string& configPath) {
+    ValidationConfig config;
+    
+    try {
+        std::ifstream file(configPath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open config file: " + configPath);
+        }
+        
+        nlohmann::json j;
+        file >> j;
+        
+        from_json(j, config);
+        
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "Warning: Failed to load config from '{}': {}\n", configPath, e.what());
+        fmt::print(stderr, "Using default configuration\n");
+    }
+    
+    return config;
+}
+
+void ValidationConfig::saveToFile(const std::string& configPath) const {
+    try {
+        std::ofstream file(configPath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot create config file: " + configPath);
+        }
+        
+        nlohmann::json j;
+        to_json(j, *this);
+        
+        file << j.dump(4);
+        
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to save config to '" + configPath + "': " + e.what());
+    }
+}
+
+std::regex ValidationConfig::getMeshNameRegex() const {
+    return std::regex(meshNamePattern);
+}
+
+std::regex ValidationConfig::getMaterialNameRegex() const {
+    return std::regex(materialNamePattern);
+}
+
+std::regex ValidationConfig::getTextureNameRegex() const {
+    return std::regex(textureNamePattern);
+}
+
+void to_json(nlohmann::json& j, const ValidationConfig& config) {
+    j = nlohmann::json{
+        {"polygon_limits", {
+            {"max_triangles_per_mesh", config.maxTrianglesPerMesh},
+            {"max_vertices_per_mesh", config.maxVerticesPerMesh},
+            {"max_total_triangles", config.maxTotalTriangles}
+        }},
+        {"texture_limits", {
+            {"max_texture_width", config.maxTextureWidth},
+            {"max_texture_height", config.maxTextureHeight},
+            {"require_power_of_two", config.requirePowerOfTwo},
+            {"allowed_texture_formats", config.allowedTextureFormats}
+        }},
+        {"uv_validation", {
+            {"check_uv_range", config.checkUVRange},
+            {"check_uv_overlaps", config.checkUVOverlaps},
+            {"uv_tolerance", config.uvTolerance},
+            {"uv_overlap_resolution", config.uvOverlapResolution},
+            {"max_uv_overlap_percentage", config.maxUVOverlapPercentage},
+            {"check_uv_islands", config.checkUVIslands},
+            {"max_seam_vertex_ratio", config.maxSeamVertexRatio},
+            {"min_island_texels", config.minIslandTexels},
+            {"max_tiny_islands", config.maxTinyIslands},
+            {"island_atlas_size", config.islandAtlasSize}
+        }},
+        {"geometry_validation", {
+            {"check_degenerate_triangles", config.checkDegenerateTriangles},
+            {"degenerate_area_epsilon", config.degenerateAreaEpsilon},
+            {"near_degenerate_ratio", config.nearDegenerateRatio},
+            {"check_duplicate_vertices", config.checkDuplicateVertices},
+            {"weld_position_tolerance", config.weldPositionTolerance},
+            {"weld_attribute_tolerance", config.weldAttributeTolerance},
+            {"check_topology", config.checkTopology},
+            {"require_watertight", config.requireWatertight},
+            {"check_connected_components", config.checkConnectedComponents},
+            {"min_component_triangles", config.minComponentTriangles},
+            {"min_component_volume_ratio", config.minComponentVolumeRatio},
+            {"max_debris_components", config.maxDebrisComponents},
+            {"check_self_intersections", config.checkSelfIntersections},
+            {"self_intersection_tolerance", config.selfIntersectionTolerance},
+            {"max_self_intersections", config.maxSelfIntersections}
+        }},
+        {"spatial_bounds", {
+            {"check_bounds", config.checkBounds},
+            {"max_scene_extent", config.maxSceneExtent},
+            {"min_scene_extent", config.minSceneExtent},
+            {"max_origin_offset", config.maxOriginOffset},
+            {"stray_vertex_factor", config.strayVertexFactor}
+        }},
+        {"vertex_cache", {
+            {"check_vertex_cache", config.checkVertexCache},
+            {"models", config.vertexCacheModels},
+            {"cache_sizes", config.vertexCacheSizes},
+            {"model", config.vertexCacheModel},
+            {"cache_size", config.vertexCacheSize},
+            {"max_acmr", config.maxACMR},
+            {"max_atvr", config.maxATVR},
+            {"max_vertex_fetch_overfetch", config.maxVertexFetchOverfetch}
+        }},
+        {"meshlets", {
+            {"check_meshlets", config.checkMeshlets},
+            {"max_vertices", config.meshletMaxVertices},
+            {"max_triangles", config.meshletMaxTriangles},
+            {"min_triangle_fill", config.minMeshletTriangleFill}
+        }},
+        {"duplicate_meshes", {
+            {"check_duplicate_meshes", config.checkDuplicateMeshes},
+            {"match_rigid_transforms", config.matchRigidDuplicates},
+            {"rigid_tolerance", config.rigidDuplicateTolerance},
+            {"min_triangles", config.minDuplicateTriangles},
+            {"max_suggestions", config.maxDuplicateSuggestions}
+        }},
+        {"material_dedup", {
+            {"check_material_dedup", config.checkMaterialDedup},
+            {"factor_steps", config.materialFactorSteps}
+        }},
+        {"tangent_frames", {
+            {"check_tangent_frames", config.checkTangentFrames},
+            {"max_normal_face_angle", config.maxNormalFaceAngle}
+        }},
+        {"gpu_memory", {
+            {"check_gpu_memory", config.checkGpuMemory},
+            {"texture_format", config.textureFormat},
+            {"normal_texture_format", config.normalTextureFormat},
+            {"mip_chains", config.mipChains},
+            {"max_mesh_memory_mb", config.maxMeshMemoryMB},
+            {"max_texture_memory_mb", config.maxTextureMemoryMB},
+            {"max_total_memory_mb", config.maxTotalMemoryMB}
+        }},
+        {"draw_calls", {
+            {"check_draw_calls", config.checkDrawCalls},
+            {"max_draw_calls", config.maxDrawCalls},
+            {"max_batch_vertices", config.maxBatchVertices},
+            {"max_batch_suggestions", config.maxBatchSuggestions}
+        }},
+        {"quad_overdraw", {
+            {"check_quad_overdraw", config.checkQuadOverdraw},
+            {"screen_height", config.quadScreenHeight},
+            {"vertical_fov", config.quadVerticalFov},
+            {"reference_distances", config.quadReferenceDistances},
+            {"min_quad_efficiency", config.minQuadEfficiency}
+        }},
+        {"hidden_geometry", {
+            {"check_hidden_geometry", config.checkHiddenGeometry},
+            {"visibility_directions", config.visibilityDirections},
+            {"max_hidden_percentage", config.maxHiddenPercentage}
+        }},
+        {"lod_generation", {
+            {"generate_lods", config.generateLODs},
+            {"ratios", config.lodRatios},
+            {"max_relative_error", config.lodMaxRelativeError},
+            {"write_lods", config.writeLODs}
+        }},
+        {"texel_density", {
+            {"check_texel_density", config.checkTexelDensity},
+            {"target_texel_density", config.targetTexelDensity},
+            {"max_density_ratio", config.maxDensityRatio},
+            {"max_outlier_percentage", config.maxOutlierPercentage}
+        }},
+        {"naming_conventions", {
+            {"enforce_naming_conventions", config.enforceNamingConventions},
+            {"mesh_name_pattern", config.meshNamePattern},
+            {"material_name_pattern", config.materialNamePattern},
+            {"texture_name_pattern", config.textureNamePattern}
+        }},
+        {"rules", {
+            {"disabled", config.disabledRules}
+        }},
+        {"material_validation", {
+            {"require_albedo_texture", config.requireAlbedoTexture},
+            {"require_normal_texture", config.requireNormalTexture},
+            {"require_metallic_roughness_texture", config.requireMetallicRoughnessTexture}
+        }},
+        {"file_validation", {
+            {"check_file_exists", config.checkFileExists},
+            {"validate_texture_files", config.validateTextureFiles}
+        }},
+        {"performance", {
+            {"enable_detailed_logging", config.enableDetailedLogging},
+            {"generate_suggestions", config.generateSuggestions},
+            {"thread_count", config.threadCount},
+            {"fail_fast", config.failFast},
+            {"max_errors", config.maxErrors}
+        }}
+    };
+}
+
+void from_json(const nlohmann::json& j, ValidationConfig& config) {
+    // Polygon limits
+    if (j.contains("polygon_limits")) {
+        const auto& poly = j["polygon_limits"];
+        if (poly.contains("max_triangles_per_mesh")) {
+            config.maxTrianglesPerMesh = poly["max_triangles_per_mesh"];
+        }
+        if (poly.contains("max_vertices_per_mesh")) {
+            config.maxVerticesPerMesh = poly["max_vertices_per_mesh"];
+        }
+        if (poly.contains("max_total_triangles")) {
+            config.maxTotalTriangles = poly["max_total_triangles"];
+        }
+    }
+    
+    // Texture limits
+    if (j.contains("texture_limits")) {
+        const auto& tex = j["texture_limits"];
+        if (tex.contains("max_texture_width")) {
+            config.maxTextureWidth = tex["max_texture_width"];
+        }
+        if (tex.contains("max_texture_height")) {
+            config.maxTextureHeight = tex["max_texture_height"];
+        }
+        if (tex.contains("require_power_of_two")) {
+            config.requirePowerOfTwo = tex["require_power_of_two"];
+        }
+        if (tex.contains("allowed_texture_formats")) {
+            config.allowedTextureFormats = tex["allowed_texture_formats"];
+        }
+    }
+    
+    // UV validation
+    if (j.contains("uv_validation")) {
+        const auto& uv = j["uv_validation"];
+        if (uv.contains("check_uv_range")) {
+            config.checkUVRange = uv["check_uv_range"];
+        }
+        if (uv.contains("check_uv_overlaps")) {
+            config.checkUVOverlaps = uv["check_uv_overlaps"];
+        }
+        if (uv.contains("uv_tolerance")) {
+            config.uvTolerance = uv["uv_tolerance"];
+        }
+        if (uv.contains("uv_overlap_resolution")) {
+            config.uvOverlapResolution = uv["uv_overlap_resolution"];
+        }
+        if (uv.contains("max_uv_overlap_percentage")) {
+            config.maxUVOverlapPercentage = uv["max_uv_overlap_percentage"];
+        }
+        if (uv.contains("check_uv_islands")) {
+            config.checkUVIslands = uv["check_uv_islands"];
+        }
+        if (uv.contains("max_seam_vertex_ratio")) {
+            config.maxSeamVertexRatio = uv["max_seam_vertex_ratio"];
+        }
+        if (uv.contains("min_island_texels")) {
+            config.minIslandTexels = uv["min_island_texels"];
+        }
+        if (uv.contains("max_tiny_islands")) {
+            config.maxTinyIslands = uv["max_tiny_islands"];
+        }
+        if (uv.contains("island_atlas_size")) {
+            config.islandAtlasSize = uv["island_atlas_size"];
+        }
+    }
+    
+    // Geometry validation
+    if (j.contains("geometry_validation")) {
+        const auto& geometry = j["geometry_validation"];
+        if (geometry.contains("check_degenerate_triangles")) {
+            config.checkDegenerateTriangles = geometry["check_degenerate_triangles"];
+        }
+        if (geometry.contains("degenerate_area_epsilon")) {
+            config.degenerateAreaEpsilon = geometry["degenerate_area_epsilon"];
+        }
+        if (geometry.contains("near_degenerate_ratio")) {
+            config.nearDegenerateRatio = geometry["near_degenerate_ratio"];
+        }
+        if (geometry.contains("check_duplicate_vertices")) {
+            config.checkDuplicateVertices = geometry["check_duplicate_vertices"];
+        }
+        if (geometry.contains("weld_position_tolerance")) {
+            config.weldPositionTolerance = geometry["weld_position_tolerance"];
+        }
+        if (geometry.contains("weld_attribute_tolerance")) {
+            config.weldAttributeTolerance = geometry["weld_attribute_tolerance"];
+        }
+        if (geometry.contains("check_topology")) {
+            config.checkTopology = geometry["check_topology"];
+        }
+        if (geometry.contains("require_watertight")) {
+            config.requireWatertight = geometry["require_watertight"];
+        }
+        if (geometry.contains("check_connected_components")) {
+            config.checkConnectedComponents = geometry["check_connected_components"];
+        }
+        if (geometry.contains("min_component_triangles")) {
+            config.minComponentTriangles = geometry["min_component_triangles"];
+        }
+        if (geometry.contains("min_component_volume_ratio")) {
+            config.minComponentVolumeRatio = geometry["min_component_volume_ratio"];
+        }
+        if (geometry.contains("max_debris_components")) {
+            config.maxDebrisComponents = geometry["max_debris_components"];
+        }
+        if (geometry.contains("check_self_intersections")) {
+            config.checkSelfIntersections = geometry["check_self_intersections"];
+        }
+        if (geometry.contains("self_intersection_tolerance")) {
+            config.selfIntersectionTolerance = geometry["self_intersection_tolerance"];
+        }
+        if (geometry.contains("max_self_intersections")) {
+            config.maxSelfIntersections = geometry["max_self_intersections"];
+        }
+    }
+    
+    // Spatial extent
+    if (j.contains("spatial_bounds")) {
+        const auto& bounds = j["spatial_bounds"];
+        if (bounds.contains("check_bounds")) {
+            config.checkBounds = bounds["check_bounds"];
+        }
+        if (bounds.contains("max_scene_extent")) {
+            config.maxSceneExtent = bounds["max_scene_extent"];
+        }
+        if (bounds.contains("min_scene_extent")) {
+            config.minSceneExtent = bounds["min_scene_extent"];
+        }
+        if (bounds.contains("max_origin_offset")) {
+            config.maxOriginOffset = bounds["max_origin_offset"];
+        }
+        if (bounds.contains("stray_vertex_factor")) {
+            config.strayVertexFactor = bounds["stray_vertex_factor"];
+        }
+    }
+    
+    // GPU vertex pipeline efficiency
+    if (j.contains("vertex_cache")) {
+        const auto& cache = j["vertex_cache"];
+        if (cache.contains("check_vertex_cache")) {
+            config.checkVertexCache = cache["check_vertex_cache"];
+        }
+        if (cache.contains("models")) {
+            config.vertexCacheModels = cache["models"].get<std::vector<std::string>>();
+        }
+        if (cache.contains("cache_sizes")) {
+            config.vertexCacheSizes = cache["cache_sizes"].get<std::vector<uint32_t>>();
+        }
+        if (cache.contains("model")) {
+            config.vertexCacheModel = cache["model"];
+        }
+        if (cache.contains("cache_size")) {
+            config.vertexCacheSize = cache["cache_size"];
+        }
+        if (cache.contains("max_acmr")) {
+            config.maxACMR = cache["max_acmr"];
+        }
+        if (cache.contains("max_atvr")) {
+            config.maxATVR = cache["max_atvr"];
+        }
+        if (cache.contains("max_vertex_fetch_overfetch")) {
+            config.maxVertexFetchOverfetch = cache["max_vertex_fetch_overfetch"];
+        }
+    }
+    
+    // Meshlets
+    if (j.contains("meshlets")) {
+        const auto& meshlets = j["meshlets"];
+        if (meshlets.contains("check_meshlets")) {
+            config.checkMeshlets = meshlets["check_meshlets"];
+        }
+        if (meshlets.contains("max_vertices")) {
+            config.meshletMaxVertices = meshlets["max_vertices"];
+        }
+        if (meshlets.contains("max_triangles")) {
+            config.meshletMaxTriangles = meshlets["max_triangles"];
+        }
+        if (meshlets.contains("min_triangle_fill")) {
+            config.minMeshletTriangleFill = meshlets["min_triangle_fill"];
+        }
+    }
+    
+    // Duplicate geometry
+    if (j.contains("duplicate_meshes")) {
+        const auto& duplicates = j["duplicate_meshes"];
+        if (duplicates.contains("check_duplicate_meshes")) {
+            config.checkDuplicateMeshes = duplicates["check_duplicate_meshes"];
+        }
+        if (duplicates.contains("match_rigid_transforms")) {
+            config.matchRigidDuplicates = duplicates["match_rigid_transforms"];
+        }
+        if (duplicates.contains("rigid_tolerance")) {
+            config.rigidDuplicateTolerance = duplicates["rigid_tolerance"];
+        }
+        if (duplicates.contains("min_triangles")) {
+            config.minDuplicateTriangles = duplicates["min_triangles"];
+        }
+        if (duplicates.contains("max_suggestions")) {
+            config.maxDuplicateSuggestions = duplicates["max_suggestions"];
+        }
+    }
+    
+    // Material deduplication
+    if (j.contains("material_dedup")) {
+        const auto& dedup = j["material_dedup"];
+        if (dedup.contains("check_material_dedup")) {
+            config.checkMaterialDedup = dedup["check_material_dedup"];
+        }
+        if (dedup.contains("factor_steps")) {
+            config.materialFactorSteps = dedup["factor_steps"];
+        }
+    }
+    
+    // Normal and tangent frames
+    if (j.contains("tangent_frames")) {
+        const auto& frames = j["tangent_frames"];
+        if (frames.contains("check_tangent_frames")) {
+            config.checkTangentFrames = frames["check_tangent_frames"];
+        }
+        if (frames.contains("max_normal_face_angle")) {
+            config.maxNormalFaceAngle = frames["max_normal_face_angle"];
+        }
+    }
+    
+    // GPU memory budgets
+    if (j.contains("gpu_memory")) {
+        const auto& memory = j["gpu_memory"];
+        if (memory.contains("check_gpu_memory")) {
+            config.checkGpuMemory = memory["check_gpu_memory"];
+        }
+        if (memory.contains("texture_format")) {
+            config.textureFormat = memory["texture_format"];
+        }
+        if (memory.contains("normal_texture_format")) {
+            config.normalTextureFormat = memory["normal_texture_format"];
+        }
+        if (memory.contains("mip_chains")) {
+            config.mipChains = memory["mip_chains"];
+        }
+        if (memory.contains("max_mesh_memory_mb")) {
+            config.maxMeshMemoryMB = memory["max_mesh_memory_mb"];
+        }
+        if (memory.contains("max_texture_memory_mb")) {
+            config.maxTextureMemoryMB = memory["max_texture_memory_mb"];
+        }
+        if (memory.contains("max_total_memory_mb")) {
+            config.maxTotalMemoryMB = memory["max_total_memory_mb"];
+        }
+    }
+    
+    // Draw calls and batching
+    if (j.contains("draw_calls")) {
+        const auto& draws = j["draw_calls"];
+        if (draws.contains("check_draw_calls")) {
+            config.checkDrawCalls = draws["check_draw_calls"];
+        }
+        if (draws.contains("max_draw_calls")) {
+            config.maxDrawCalls = draws["max_draw_calls"];
+        }
+        if (draws.contains("max_batch_vertices")) {
+            config.maxBatchVertices = draws["max_batch_vertices"];
+        }
+        if (draws.contains("max_batch_suggestions")) {
+            config.maxBatchSuggestions = draws["max_batch_suggestions"];
+        }
+    }
+    
+    // Small triangles and quad overdraw
+    if (j.contains("quad_overdraw")) {
+        const auto& quads = j["quad_overdraw"];
+        if (quads.contains("check_quad_overdraw")) {
+            config.checkQuadOverdraw = quads["check_quad_overdraw"];
+        }
+        if (quads.contains("screen_height")) {
+            config.quadScreenHeight = quads["screen_height"];
+        }
+        if (quads.contains("vertical_fov")) {
+            config.quadVerticalFov = quads["vertical_fov"];
+        }
+        if (quads.contains("reference_distances")) {
+            config.quadReferenceDistances = quads["reference_distances"].get<std::vector<float>>();
+        }
+        if (quads.contains("min_quad_efficiency")) {
+            config.minQuadEfficiency = quads["min_quad_efficiency"];
+        }
+    }
+    
+    // Hidden geometry
+    if (j.contains("hidden_geometry")) {
+        const auto& hidden = j["hidden_geometry"];
+        if (hidden.contains("check_hidden_geometry")) {
+            config.checkHiddenGeometry = hidden["check_hidden_geometry"];
+        }
+        if (hidden.contains("visibility_directions")) {
+            config.visibilityDirections = hidden["visibility_directions"];
+        }
+        if (hidden.contains("max_hidden_percentage")) {
+            config.maxHiddenPercentage = hidden["max_hidden_percentage"];
+        }
+    }
+    
+    // LOD generation
+    if (j.contains("lod_generation")) {
+        const auto& lod = j["lod_generation"];
+        if (lod.contains("generate_lods")) {
+            config.generateLODs = lod["generate_lods"];
+        }
+        if (lod.contains("ratios")) {
+            config.lodRatios = lod["ratios"].get<std::vector<float>>();
+        }
+        if (lod.contains("max_relative_error")) {
+            config.lodMaxRelativeError = lod["max_relative_error"];
+        }
+        if (lod.contains("write_lods")) {
+            config.writeLODs = lod["write_lods"];
+        }
+    }
+    
+    // Texel density
+    if (j.contains("texel_density")) {
+        const auto& density = j["texel_density"];
+        if (density.contains("check_texel_density")) {
+            config.checkTexelDensity = density["check_texel_density"];
+        }
+        if (density.contains("target_texel_density")) {
+            config.targetTexelDensity = density["target_texel_density"];
+        }
+        if (density.contains("max_density_ratio")) {
+            config.maxDensityRatio = density["max_density_ratio"];
+        }
+        if (density.contains("max_outlier_percentage")) {
+            config.maxOutlierPercentage = density["max_outlier_percentage"];
+        }
+    }
+    
+    // Naming conventions
+    if (j.contains("naming_conventions")) {
+        const auto& naming = j["naming_conventions"];
+        if (naming.contains("enforce_naming_conventions")) {
+            config.enforceNamingConventions = naming["enforce_naming_conventions"];
+        }
+        if (naming.contains("mesh_name_pattern")) {
+            config.meshNamePattern = naming["mesh_name_pattern"];
+        }
+        if (naming.contains("material_name_pattern")) {
+            config.materialNamePattern = naming["material_name_pattern"];
+        }
+        if (naming.contains("texture_name_pattern")) {
+            config.textureNamePattern = naming["texture_name_pattern"];
+        }
+    }
+    
+    // Rule selection
+    if (j.contains("rules")) {
+        const auto& rules = j["rules"];
+        if (rules.contains("disabled")) {
+            config.disabledRules = rules["disabled"].get<std::vector<std::string>>();
+        }
+    }
+    
+    // Material validation
+    if (j.contains("material_validation")) {
+        const auto& mat = j["material_validation"];
+        if (mat.contains("require_albedo_texture")) {
+            config.requireAlbedoTexture = mat["require_albedo_texture"];
+        }
+        if (mat.contains("require_normal_texture")) {
+            config.requireNormalTexture = mat["require_normal_texture"];
+        }
+        if (mat.contains("require_metallic_roughness_texture")) {
+            config.requireMetallicRoughnessTexture = mat["require_metallic_roughness_texture"];
+        }
+    }
+    
+    // File validation
+    if (j.contains("file_validation")) {
+        const auto& file = j["file_validation"];
+        if (file.contains("check_file_exists")) {
+            config.checkFileExists = file["check_file_exists"];
+        }
+        if (file.contains("validate_texture_files")) {
+            config.validateTextureFiles = file["validate_texture_files"];
+        }
+    }
+    
+    // Performance
+    if (j.contains("performance")) {
+        const auto& perf = j["performance"];
+        if (perf.contains("enable_detailed_logging")) {
+            config.enableDetailedLogging = perf["enable_detailed_logging"];
+        }
+        if (perf.contains("generate_suggestions")) {
+            config.generateSuggestions = perf["generate_suggestions"];
+        }
+        if (perf.contains("thread_count")) {
+            config.threadCount = perf["thread_count"];
+        }
+        if (perf.contains("fail_fast")) {
+            config.failFast = perf["fail_fast"];
+        }
+        if (perf.contains("max_errors")) {
+            config.maxErrors = perf["max_errors"];
+        }
+    }
+}
\ No newline at end of file
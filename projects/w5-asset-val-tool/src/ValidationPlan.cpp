@@ -0,0 +1,122 @@
+#include "ValidationPlan.h"
+#include <algorithm>
+#include <cctype>
+#include <functional>
+
+namespace {
+    uint64_t megabytesToBytes(float megabytes) {
+        return megabytes > 0.0f ? static_cast<uint64_t>(static_cast<double>(megabytes) * 1024.0 * 1024.0) : 0;
+    }
+}
+
+ValidationPlan::ValidationPlan(const ValidationConfig& config)
+    : maxTrianglesPerMesh(config.maxTrianglesPerMesh),
+      maxVerticesPerMesh(config.maxVerticesPerMesh),
+      maxTotalTriangles(config.maxTotalTriangles),
+      maxTextureWidth(config.maxTextureWidth),
+      maxTextureHeight(config.maxTextureHeight),
+      checkUVRange(config.checkUVRange),
+      uvTolerance(config.uvTolerance),
+      uvOverlapResolution(config.uvOverlapResolution),
+      maxUVOverlapPercentage(config.maxUVOverlapPercentage),
+      maxSeamVertexRatio(config.maxSeamVertexRatio),
+      minIslandTexels(config.minIslandTexels),
+      maxTinyIslands(config.maxTinyIslands),
+      islandAtlasSize(std::max(1u, config.islandAtlasSize)),
+      degenerateAreaEpsilon(config.degenerateAreaEpsilon),
+      nearDegenerateRatio(config.nearDegenerateRatio),
+      weldPositionTolerance(config.weldPositionTolerance),
+      weldAttributeTolerance(config.weldAttributeTolerance),
+      requireWatertight(config.requireWatertight),
+      minComponentTriangles(config.minComponentTriangles),
+      minComponentVolumeRatio(config.minComponentVolumeRatio),
+      maxDebrisComponents(config.maxDebrisComponents),
+      selfIntersectionTolerance(config.selfIntersectionTolerance),
+      maxSelfIntersections(config.maxSelfIntersections),
+      maxSceneExtent(config.maxSceneExtent),
+      minSceneExtent(config.minSceneExtent),
+      maxOriginOffset(config.maxOriginOffset),
+      strayVertexFactor(config.strayVertexFactor),
+      vertexCacheModel(VertexCacheAnalyzer::parseModel(config.vertexCacheModel)),
+      vertexCacheSize(config.vertexCacheSize),
+      maxACMR(config.maxACMR),
+      maxATVR(config.maxATVR),
+      maxVertexFetchOverfetch(config.maxVertexFetchOverfetch),
+      meshletMaxVertices(config.meshletMaxVertices),
+      meshletMaxTriangles(config.meshletMaxTriangles),
+      minMeshletTriangleFill(config.minMeshletTriangleFill),
+      findDuplicateMeshes(config.checkDuplicateMeshes),
+      matchRigidDuplicates(config.matchRigidDuplicates),
+      rigidDuplicateTolerance(config.rigidDuplicateTolerance),
+      minDuplicateTriangles(config.minDuplicateTriangles),
+      maxDuplicateSuggestions(config.maxDuplicateSuggestions),
+      dedupMaterials(config.checkMaterialDedup),
+      materialFactorSteps(std::max(1u, config.materialFactorSteps)),
+      maxNormalFaceAngle(config.maxNormalFaceAngle),
+      textureFormat(GpuMemoryEstimator::parseFormat(config.textureFormat)),
+      normalTextureFormat(GpuMemoryEstimator::parseFormat(config.normalTextureFormat)),
+      mipChains(config.mipChains),
+      maxMeshMemoryBytes(megabytesToBytes(config.maxMeshMemoryMB)),
+      maxTextureMemoryBytes(megabytesToBytes(config.maxTextureMemoryMB)),
+      maxTotalMemoryBytes(megabytesToBytes(config.maxTotalMemoryMB)),
+      maxDrawCalls(config.maxDrawCalls),
+      maxBatchVertices(config.maxBatchVertices),
+      maxBatchSuggestions(config.maxBatchSuggestions),
+      quadScreenHeight(config.quadScreenHeight),
+      quadVerticalFov(config.quadVerticalFov),
+      minQuadEfficiency(config.minQuadEfficiency),
+      visibilityDirections(config.visibilityDirections),
+      maxHiddenPercentage(config.maxHiddenPercentage),
+      lodMaxRelativeError(config.lodMaxRelativeError),
+      targetTexelDensity(std::max(config.targetTexelDensity, 0.0f)),
+      maxDensityRatio(std::max(config.maxDensityRatio, 1.0f)),
+      maxOutlierPercentage(config.maxOutlierPercentage),
+      meshNameMatcher(config.meshNamePattern),
+      materialNameMatcher(config.materialNamePattern),
+      textureNameMatcher(config.textureNamePattern),
+      requireAlbedoTexture(config.requireAlbedoTexture),
+      requireNormalTexture(config.requireNormalTexture),
+      requireMetallicRoughnessTexture(config.requireMetallicRoughnessTexture),
+      errorBudget(config.failFast ? 1 : config.maxErrors) {
+    // Normalize formats the same way AssetLoader normalizes extensions
+    for (std::string format : config.allowedTextureFormats) {
+        if (!format.empty() && format[0] == '.') {
+            format.erase(0, 1);
+        }
+        std::transform(format.begin(), format.end(), format.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        allowedTextureFormats.insert(std::move(format));
+    }
+
+    for (float distance : config.quadReferenceDistances) {
+        if (distance > 0.0f) {
+            quadReferenceDistances.push_back(distance);
+        }
+    }
+    std::sort(quadReferenceDistances.begin(), quadReferenceDistances.end());
+    quadReferenceDistances.erase(std::unique(quadReferenceDistances.begin(), quadReferenceDistances.end()),
+                                 quadReferenceDistances.end());
+
+    for (const std::string& name : config.vertexCacheModels) {
+        const VertexCacheModel model = VertexCacheAnalyzer::parseModel(name);
+        if (std::find(vertexCacheModels.begin(), vertexCacheModels.end(), model) == vertexCacheModels.end()) {
+            vertexCacheModels.push_back(model);
+        }
+    }
+    for (uint32_t size : config.vertexCacheSizes) {
+        if (size > 0) {
+            vertexCacheSizes.push_back(size);
+        }
+    }
+    std::sort(vertexCacheSizes.begin(), vertexCacheSizes.end());
+    vertexCacheSizes.erase(std::unique(vertexCacheSizes.begin(), vertexCacheSizes.end()), vertexCacheSizes.end());
+
+    // Ratios outside (0, 1) would produce no level or a copy of the base
+    for (float ratio : config.lodRatios) {
+        if (ratio > 0.0f && ratio < 1.0f) {
+            lodRatios.push_back(ratio);
+        }
+    }
+    std::sort(lodRatios.begin(), lodRatios.end(), std::greater<float>());
+    lodRatios.erase(std::unique(lodRatios.begin(), lodRatios.end()), lodRatios.end());
+}
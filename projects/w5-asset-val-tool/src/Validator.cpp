@@ -1,50 +1,427 @@
 #include "Validator.h"
 #include <fmt/core.h>
 #include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 #include <cmath>
+#include <iterator>
+#include <chrono>
 
-Validator::Validator() = default;
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    // Runs rules[begin, end) until the budget (if any) is spent, timing
+    // each one when the run collects counters. invoke(rule) applies one
+    // rule and appends to issues; items(rule) is the work it covered.
+    template <typename Items, typename Invoke>
+    void runRules(const ValidationPlan& plan, const std::vector<uint32_t>& rules, size_t begin, size_t end,
+                  const RuleRun& run, const std::vector<ValidationIssue>& issues, Items items, Invoke invoke) {
+        for (size_t r = begin; r < end; ++r) {
+            if (run.budget && run.budget->exhausted()) {
+                return;
+            }
+            const RuleDescriptor& rule = plan.rules[rules[r]];
+            const size_t before = issues.size();
+            if (run.counters) {
+                const auto start = Clock::now();
+                invoke(rule);
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+                RuleCounters& counters = run.counters[rules[r]];
+                counters.nanoseconds.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+                counters.invocations.fetch_add(1, std::memory_order_relaxed);
+                counters.items.fetch_add(items(rule), std::memory_order_relaxed);
+            } else {
+                invoke(rule);
+            }
+            if (run.budget) {
+                run.budget->spend(issues, before);
+            }
+        }
+    }
+    
+    // A metric through the plan's cache in a multi-profile run, computed
+    // directly otherwise. params are every input of the analysis besides
+    // the asset itself.
+    template <typename T, typename Compute, typename... Params>
+    T cachedMetric(const ValidationPlan& plan, const void* asset, const char* name, Compute&& compute,
+                   const Params&... params) {
+        if (!plan.metrics) {
+            return compute();
+        }
+        std::string key = name;
+        ((key += fmt::format("|{}", params)), ...);
+        return plan.metrics->get<T>(asset, key, compute);
+    }
+    
+    uint64_t oneItem(const RuleDescriptor& /*rule*/) {
+        return 1;
+    }
+    
+    // A mesh rule covers triangles if it reads indices, vertices if it reads
+    // a vertex stream, and just the mesh otherwise
+    uint64_t meshItems(const RuleDescriptor& rule, const MeshData& mesh) {
+        if (rule.data & RuleData::Indices) {
+            return mesh.indices.size() / 3;
+        }
+        if (rule.data & (RuleData::Positions | RuleData::Normals | RuleData::UVs | RuleData::Tangents)) {
+            return mesh.vertices.size();
+        }
+        return 1;
+    }
+    
+    bool namingEnabled(const ValidationConfig& config) {
+        return config.enforceNamingConventions;
+    }
+    
+    bool gpuMemoryEnabled(const ValidationConfig& config) {
+        return config.checkGpuMemory;
+    }
+    
+    std::string formatMegabytes(uint64_t bytes) {
+        return fmt::format("{:.2f} MB", bytes / (1024.0 * 1024.0));
+    }
+    
+    // The texture a mesh's density is measured against: the first one its
+    // first material has, base color preferred
+    const TextureData* mainTexture(const SceneData& sceneData, const MeshData& mesh,
+                                   const std::unordered_map<std::string, const TextureData*>& texturesByPath) {
+        if (mesh.materialIndices.empty() || mesh.materialIndices[0] >= sceneData.materials.size()) {
+            return nullptr;
+        }
+        const MaterialData& material = sceneData.materials[mesh.materialIndices[0]];
+        for (const std::string* path : {&material.albedoTexture, &material.normalTexture,
+                                        &material.metallicRoughnessTexture, &material.emissiveTexture,
+                                        &material.occlusionTexture}) {
+            if (path->empty()) {
+                continue;
+            }
+            auto it = texturesByPath.find(*path);
+            return it != texturesByPath.end() ? it->second : nullptr;
+        }
+        return nullptr;
+    }
+}
+
+void ErrorBudget::spend(const std::vector<ValidationIssue>& issues, size_t from) {
+    uint32_t found = 0;
+    for (size_t i = from; i < issues.size(); ++i) {
+        if (issues[i].severity == Severity::ERROR || issues[i].severity == Severity::CRITICAL) {
+            ++found;
+        }
+    }
+    if (found > 0 && errors.fetch_add(found, std::memory_order_relaxed) + found >= limit) {
+        stopped.store(true, std::memory_order_relaxed);
+    }
+}
+
+Validator::Validator()
+    : registry(createBuiltinRegistry()), plan(compilePlan(config, registry)),
+      threadPool(std::make_unique<ThreadPool>(config.threadCount)) {}
 
-Validator::Validator(const ValidationConfig& config) : config(config) {}
+Validator::Validator(const ValidationConfig& config)
+    : config(config), registry(createBuiltinRegistry()), plan(compilePlan(config, registry)),
+      threadPool(std::make_unique<ThreadPool>(config.threadCount)) {}
 
 Validator::~Validator() = default;
 
+void Validator::setConfig(const ValidationConfig& config) {
+    // Only respawn the workers when the requested thread count changes
+    if (!threadPool || config.threadCount != this->config.threadCount) {
+        threadPool = std::make_unique<ThreadPool>(config.threadCount);
+    }
+    plan = compilePlan(config, registry);
+    this->config = config;
+}
+
+void Validator::registerRule(const RuleDescriptor& rule) {
+    registry.add(rule);
+    plan = compilePlan(config, registry);
+}
+
+RuleRegistry Validator::createBuiltinRegistry() {
+    const uint32_t positions = RuleData::Positions, normals = RuleData::Normals, uvs = RuleData::UVs,
+                   indices = RuleData::Indices, textures = RuleData::Textures, tangents = RuleData::Tangents;
+    RuleRegistry builtins;
+    
+    builtins.add(describeRule("scene_limits", 0, RuleCost::Metadata, &Validator::validateSceneLimits));
+    builtins.add(describeRule("naming_conventions", 0, RuleCost::Metadata, &Validator::validateNamingConventions,
+                              namingEnabled));
+    
+    // Scene passes, after every per-asset rule
+    builtins.add(describeRule("scene_texel_density", 0, RuleCost::Metadata, &Validator::resolveTexelDensity,
+                              [](const ValidationConfig& c) { return c.checkTexelDensity; }));
+    builtins.add(describeRule("scene_bounds", 0, RuleCost::Metadata, &Validator::resolveSceneBounds,
+                              [](const ValidationConfig& c) { return c.checkBounds; }));
+    builtins.add(describeRule("scene_gpu_memory", textures, RuleCost::Metadata, &Validator::resolveGpuMemory,
+                              gpuMemoryEnabled));
+    builtins.add(describeRule("material_dedup", RuleData::Materials, RuleCost::Metadata,
+                              &Validator::resolveMaterialDedup,
+                              [](const ValidationConfig& c) { return c.checkMaterialDedup; }));
+    builtins.add(describeRule("duplicate_meshes", positions | indices, RuleCost::Linear,
+                              &Validator::resolveDuplicateMeshes,
+                              [](const ValidationConfig& c) { return c.checkDuplicateMeshes; }));
+    builtins.add(describeRule("draw_calls", positions | indices, RuleCost::Linear, &Validator::resolveDrawCalls,
+                              [](const ValidationConfig& c) { return c.checkDrawCalls; }));
+    builtins.add(describeRule("hidden_geometry", positions | indices, RuleCost::Heavy,
+                              &Validator::resolveHiddenGeometry,
+                              [](const ValidationConfig& c) { return c.checkHiddenGeometry; }));
+    
+    // Mesh rules: registration order is the order within each tier
+    builtins.add(describeRule("polygon_count", 0, RuleCost::Metadata, &Validator::validatePolygonCount));
+    builtins.add(describeRule("mesh_naming", 0, RuleCost::Metadata, &Validator::validateMeshNaming,
+                              namingEnabled));
+    builtins.add(describeRule("mesh_gpu_memory", 0, RuleCost::Metadata, &Validator::validateMeshGpuMemory,
+                              gpuMemoryEnabled));
+    builtins.add(describeRule("uv_coordinates", uvs, RuleCost::Linear, &Validator::validateUVCoordinates,
+                              [](const ValidationConfig& c) { return c.checkUVRange || c.checkUVOverlaps; }));
+    builtins.add(describeRule("vertex_data", positions | normals, RuleCost::Linear, &Validator::validateVertexData));
+    builtins.add(describeRule("tangent_frames", positions | normals | tangents | indices, RuleCost::Linear,
+                              &Validator::validateTangentFrames,
+                              [](const ValidationConfig& c) { return c.checkTangentFrames; }));
+    builtins.add(describeRule("bounds", positions, RuleCost::Linear, &Validator::validateBounds,
+                              [](const ValidationConfig& c) { return c.checkBounds; }));
+    builtins.add(describeRule("degenerate_triangles", positions | indices, RuleCost::Linear,
+                              &Validator::validateDegenerateTriangles,
+                              [](const ValidationConfig& c) { return c.checkDegenerateTriangles; }));
+    builtins.add(describeRule("duplicate_vertices", positions | normals | uvs | tangents, RuleCost::Linear,
+                              &Validator::validateDuplicateVertices,
+                              [](const ValidationConfig& c) { return c.checkDuplicateVertices; }));
+    builtins.add(describeRule("topology", positions | indices, RuleCost::Linear, &Validator::validateTopology,
+                              [](const ValidationConfig& c) { return c.checkTopology; }));
+    builtins.add(describeRule("connected_components", positions | indices, RuleCost::Linear,
+                              &Validator::validateConnectedComponents,
+                              [](const ValidationConfig& c) { return c.checkConnectedComponents; }));
+    builtins.add(describeRule("self_intersections", positions | indices, RuleCost::Heavy,
+                              &Validator::validateSelfIntersections,
+                              [](const ValidationConfig& c) { return c.checkSelfIntersections; }));
+    builtins.add(describeRule("vertex_cache", indices, RuleCost::Linear, &Validator::validateVertexCache,
+                              [](const ValidationConfig& c) { return c.checkVertexCache; }));
+    builtins.add(describeRule("meshlets", positions | indices, RuleCost::Linear, &Validator::validateMeshlets,
+                              [](const ValidationConfig& c) { return c.checkMeshlets; }));
+    builtins.add(describeRule("texel_density", positions | uvs | indices, RuleCost::Linear,
+                              &Validator::validateTexelDensity,
+                              [](const ValidationConfig& c) { return c.checkTexelDensity; }));
+    builtins.add(describeRule("quad_overdraw", positions | indices, RuleCost::Linear,
+                              &Validator::validateQuadOverdraw,
+                              [](const ValidationConfig& c) { return c.checkQuadOverdraw; }));
+    builtins.add(describeRule("uv_islands", positions | uvs | indices, RuleCost::Linear,
+                              &Validator::validateUVIslands,
+                              [](const ValidationConfig& c) { return c.checkUVIslands; }));
+    builtins.add(describeRule("uv_overlaps", uvs | indices, RuleCost::Heavy, &Validator::validateUVOverlaps,
+                              [](const ValidationConfig& c) { return c.checkUVOverlaps; }));
+    
+    builtins.add(describeRule("material_properties", 0, RuleCost::Metadata, &Validator::validateMaterialProperties));
+    builtins.add(describeRule("material_textures", textures, RuleCost::Metadata,
+                              &Validator::validateMaterialTextures));
+    builtins.add(describeRule("material_naming", 0, RuleCost::Metadata, &Validator::validateMaterialNaming,
+                              namingEnabled));
+    
+    builtins.add(describeRule("texture_resolution", 0, RuleCost::Metadata, &Validator::validateTextureResolution));
+    builtins.add(describeRule("texture_format", 0, RuleCost::Metadata, &Validator::validateTextureFormat));
+    builtins.add(describeRule("texture_power_of_two", 0, RuleCost::Metadata, &Validator::validateTexturePowerOfTwo,
+                              [](const ValidationConfig& c) { return c.requirePowerOfTwo; }));
+    builtins.add(describeRule("texture_naming", 0, RuleCost::Metadata, &Validator::validateTextureNaming,
+                              namingEnabled));
+    builtins.add(describeRule("texture_gpu_memory", 0, RuleCost::Metadata, &Validator::validateTextureGpuMemory,
+                              gpuMemoryEnabled));
+    return builtins;
+}
+
+std::shared_ptr<const ValidationPlan> Validator::compilePlan(const ValidationConfig& config,
+                                                             const RuleRegistry& registry,
+                                                             std::shared_ptr<MetricCache> metrics) {
+    auto compiled = std::make_shared<ValidationPlan>(config);
+    compiled->metrics = std::move(metrics);
+    
+    const std::unordered_set<std::string> disabled(config.disabledRules.begin(), config.disabledRules.end());
+    for (const auto& rule : registry.getRules()) {
+        if ((rule.enabled && !rule.enabled(config)) || disabled.count(rule.name)) {
+            continue;
+        }
+        compiled->rules.push_back(rule);
+    }
+    
+    // Cheapest tier first; stable, so registration order breaks ties
+    std::vector<uint32_t> order(compiled->rules.size());
+    for (uint32_t r = 0; r < order.size(); ++r) {
+        order[r] = r;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return compiled->rules[a].cost < compiled->rules[b].cost;
+    });
+    for (uint32_t r : order) {
+        const RuleDescriptor& rule = compiled->rules[r];
+        switch (rule.scope) {
+            case RuleScope::Scene:
+                (rule.scenePass ? compiled->scenePasses : compiled->sceneRules).push_back(r);
+                break;
+            case RuleScope::Mesh:     compiled->meshRules.push_back(r); break;
+            case RuleScope::Material: compiled->materialRules.push_back(r); break;
+            case RuleScope::Texture:  compiled->textureRules.push_back(r); break;
+        }
+        if (rule.scope == RuleScope::Mesh && rule.cost == RuleCost::Metadata) {
+            compiled->meshMetadataRuleCount++;
+        }
+    }
+    
+    return compiled;
+}
+
 ValidationResult Validator::validate(const SceneData& sceneData) {
+    // Hold our own reference so a concurrent setConfig cannot retire the
+    // plan while workers are still reading it
+    const std::shared_ptr<const ValidationPlan> activePlan = plan;
+    return runPlan(*activePlan, sceneData);
+}
+
+ValidationResult Validator::validateProfiles(const SceneData& sceneData,
+                                             const std::vector<ValidationProfile>& profiles) {
+    if (profiles.empty()) {
+        return validate(sceneData);
+    }
+    
+    const auto metrics = std::make_shared<MetricCache>();
+    ValidationResult primary;
+    std::vector<ProfileVerdict> verdicts;
+    for (size_t p = 0; p < profiles.size(); ++p) {
+        const uint64_t computedBefore = metrics->computedCount();
+        const uint64_t reusedBefore = metrics->reusedCount();
+        const std::shared_ptr<const ValidationPlan> profilePlan = compilePlan(profiles[p].config, registry, metrics);
+        ValidationResult result = runPlan(*profilePlan, sceneData);
+        
+        ProfileVerdict verdict;
+        verdict.name = profiles[p].name;
+        verdict.isValid = result.isValid;
+        verdict.stoppedEarly = result.stoppedEarly;
+        const auto count = [&verdict](const std::vector<ValidationIssue>& issues) {
+            for (const auto& issue : issues) {
+                switch (issue.severity) {
+                    case Severity::CRITICAL: verdict.criticalCount++; break;
+                    case Severity::ERROR:    verdict.errorCount++; break;
+                    case Severity::WARNING:  verdict.warningCount++; break;
+                    case Severity::INFO:     verdict.infoCount++; break;
+                }
+                if (issue.severity == Severity::ERROR || issue.severity == Severity::CRITICAL) {
+                    verdict.failures.push_back(issue);
+                }
+            }
+        };
+        count(result.globalIssues);
+        for (const auto& meshResult : result.meshResults) {
+            count(meshResult.issues);
+        }
+        for (const auto& materialResult : result.materialResults) {
+            count(materialResult.issues);
+        }
+        verdict.metricsComputed = metrics->computedCount() - computedBefore;
+        verdict.metricsReused = metrics->reusedCount() - reusedBefore;
+        verdicts.push_back(std::move(verdict));
+        
+        if (p == 0) {
+            primary = std::move(result);
+        }
+    }
+    
+    primary.isValid = std::all_of(verdicts.begin(), verdicts.end(),
+                                  [](const ProfileVerdict& verdict) { return verdict.isValid; });
+    primary.profiles = std::move(verdicts);
+    return primary;
+}
+
+ValidationResult Validator::runPlan(const ValidationPlan& activePlan, const SceneData& sceneData) {
     ValidationResult result;
     result.filePath = sceneData.filePath;
     
-    // Validate scene-level limits
-    validateSceneLimits(sceneData, result.globalIssues);
+    const size_t meshCount = sceneData.meshes.size();
+    const size_t materialCount = sceneData.materials.size();
+    const size_t textureCount = sceneData.textures.size();
+    
+    result.meshResults.resize(meshCount);
+    result.materialResults.resize(materialCount);
+    std::vector<std::vector<ValidationIssue>> textureIssues(textureCount);
     
-    // Validate naming conventions
-    if (config.enforceNamingConventions) {
-        validateNamingConventions(sceneData, result.globalIssues);
+    // Texel density needs the texture size, which a mesh rule cannot see
+    std::unordered_map<std::string, const TextureData*> texturesByPath;
+    for (const auto& texture : sceneData.textures) {
+        texturesByPath.emplace(texture.filePath, &texture);
+    }
+    for (size_t i = 0; i < meshCount; ++i) {
+        if (const TextureData* texture = mainTexture(sceneData, sceneData.meshes[i], texturesByPath)) {
+            result.meshResults[i].texelDensity.textureWidth = texture->width;
+            result.meshResults[i].texelDensity.textureHeight = texture->height;
+        }
     }
     
-    // Validate each mesh
-    result.meshResults.reserve(sceneData.meshes.size());
-    for (const auto& mesh : sceneData.meshes) {
-        MeshValidationResult meshResult;
-        validateMesh(mesh, meshResult);
-        result.meshResults.push_back(std::move(meshResult));
+    // Per-rule time and work for the cost table
+    std::vector<RuleCounters> counters(activePlan.rules.size());
+    RuleRun run;
+    run.counters = counters.data();
+    
+    std::unique_ptr<ErrorBudget> budget;
+    if (activePlan.errorBudget > 0) {
+        budget = std::make_unique<ErrorBudget>(activePlan.errorBudget);
+        run.budget = budget.get();
+        validateWithBudget(activePlan, sceneData, result, textureIssues, run);
+        result.stoppedEarly = budget->exhausted();
+    } else {
+        // Scene-level rules
+        runRules(activePlan, activePlan.sceneRules, 0, activePlan.sceneRules.size(), run, result.globalIssues,
+                 oneItem, [&](const RuleDescriptor& rule) {
+            rule.sceneRule(activePlan, sceneData, result.globalIssues);
+        });
+        
+        // Validate meshes, materials and textures as one batch of tasks. Every
+        // task owns a pre-sized slot, so no locking is needed and the results
+        // come out in scene order regardless of which worker ran them.
+        threadPool->parallelFor(meshCount + materialCount + textureCount, [&](size_t i) {
+            if (i < meshCount) {
+                applyMeshMetadataRules(activePlan, *threadPool, sceneData.meshes[i], result.meshResults[i], run);
+                applyMeshGeometryRules(activePlan, *threadPool, sceneData.meshes[i], result.meshResults[i], run);
+            } else if (i < meshCount + materialCount) {
+                const size_t m = i - meshCount;
+                applyMaterialRules(activePlan, sceneData.materials[m], result.materialResults[m], run);
+            } else {
+                const size_t t = i - meshCount - materialCount;
+                applyTextureRules(activePlan, sceneData.textures[t], textureIssues[t], run);
+            }
+        });
     }
     
-    // Validate each material
-    result.materialResults.reserve(sceneData.materials.size());
-    for (const auto& material : sceneData.materials) {
-        MaterialValidationResult materialResult;
-        validateMaterial(material, materialResult);
-        result.materialResults.push_back(std::move(materialResult));
+    // Scene passes aggregate every mesh; after an early stop the per-mesh
+    // results are partial and the run is already failed
+    if (!result.stoppedEarly) {
+        runRules(activePlan, activePlan.scenePasses, 0, activePlan.scenePasses.size(), run, result.globalIssues,
+                 oneItem, [&](const RuleDescriptor& rule) {
+            rule.scenePass(activePlan, *threadPool, sceneData, result);
+        });
+        result.stoppedEarly = budget && budget->exhausted();
     }
     
-    // Validate each texture
-    for (const auto& texture : sceneData.textures) {
-        validateTexture(texture, result.globalIssues);
+    result.ruleCosts.reserve(activePlan.rules.size());
+    for (size_t r = 0; r < activePlan.rules.size(); ++r) {
+        const RuleDescriptor& rule = activePlan.rules[r];
+        RuleCostResult cost;
+        cost.ruleName = rule.name;
+        cost.scope = RuleRegistry::scopeName(rule.scope);
+        cost.costTier = RuleRegistry::costName(rule.cost);
+        cost.data = RuleRegistry::dataNames(rule.data);
+        cost.invocations = counters[r].invocations.load();
+        cost.itemsProcessed = counters[r].items.load();
+        cost.totalMs = counters[r].nanoseconds.load() / 1e6;
+        result.ruleCosts.push_back(cost);
+    }
+    
+    // Merge texture issues in texture order, exactly as a serial run would
+    for (auto& issues : textureIssues) {
+        result.globalIssues.insert(result.globalIssues.end(),
+                                   std::make_move_iterator(issues.begin()),
+                                   std::make_move_iterator(issues.end()));
     }
     
-    // Calculate statistics
-    calculateStatistics(sceneData, result);
+    // Statistics describe a complete run only
+    if (!result.stoppedEarly) {
+        calculateStatistics(sceneData, result);
+    }
     
     // Determine overall validation result
     for (const auto& issue : result.globalIssues) {
@@ -81,33 +458,394 @@ ValidationResult Validator::validate(const SceneData& sceneData) {
     return result;
 }
 
+void Validator::validateWithBudget(const ValidationPlan& plan, const SceneData& sceneData, ValidationResult& result,
+                                   std::vector<std::vector<ValidationIssue>>& textureIssues, const RuleRun& run) {
+    ErrorBudget& budget = *run.budget;
+    const size_t meshCount = sceneData.meshes.size();
+    const size_t materialCount = sceneData.materials.size();
+    const size_t textureCount = sceneData.textures.size();
+    
+    // 1. Scene budgets: a single pass over counts the loader already has
+    runRules(plan, plan.sceneRules, 0, plan.sceneRules.size(), run, result.globalIssues, oneItem,
+             [&](const RuleDescriptor& rule) { rule.sceneRule(plan, sceneData, result.globalIssues); });
+    
+    // 2. Everything that does not touch vertex data
+    if (!budget.exhausted()) {
+        threadPool->parallelFor(meshCount + materialCount + textureCount, [&](size_t i) {
+            if (budget.exhausted()) {
+                return;
+            }
+            if (i < meshCount) {
+                applyMeshMetadataRules(plan, *threadPool, sceneData.meshes[i], result.meshResults[i], run);
+            } else if (i < meshCount + materialCount) {
+                const size_t m = i - meshCount;
+                applyMaterialRules(plan, sceneData.materials[m], result.materialResults[m], run);
+            } else {
+                const size_t t = i - meshCount - materialCount;
+                applyTextureRules(plan, sceneData.textures[t], textureIssues[t], run);
+            }
+        });
+    }
+    
+    // 3. Vertex data, mesh by mesh
+    if (!budget.exhausted()) {
+        threadPool->parallelFor(meshCount, [&](size_t i) {
+            if (!budget.exhausted()) {
+                applyMeshGeometryRules(plan, *threadPool, sceneData.meshes[i], result.meshResults[i], run);
+            }
+        });
+    }
+}
+
+void Validator::resolveTexelDensity(const ValidationPlan& plan, ThreadPool& /*pool*/, const SceneData& sceneData,
+                                    ValidationResult& result) {
+    double sceneWorldArea = 0.0;
+    double sceneTexelArea = 0.0;
+    double largestWorldArea = 0.0;
+    for (const auto& mesh : result.meshResults) {
+        sceneWorldArea += mesh.texelDensity.worldArea;
+        sceneTexelArea += mesh.texelDensity.texelArea;
+        largestWorldArea = std::max(largestWorldArea, mesh.texelDensity.worldArea);
+    }
+    if (sceneWorldArea <= 0.0) {
+        return;
+    }
+    
+    // Hints are relative to the studio target, or to the scene's
+    // area-weighted density when there is none
+    const double reference = plan.targetTexelDensity > 0.0f ? plan.targetTexelDensity
+                                                            : std::sqrt(sceneTexelArea / sceneWorldArea);
+    
+    struct MaterialDensity {
+        double worldArea = 0.0;
+        double texelArea = 0.0;
+        float minMedian = 0.0f;
+        float maxMedian = 0.0f;
+    };
+    std::vector<MaterialDensity> materials(result.materialResults.size());
+    
+    for (size_t i = 0; i < result.meshResults.size(); ++i) {
+        TexelDensityResult& density = result.meshResults[i].texelDensity;
+        if (density.measuredTriangles == 0) {
+            continue;
+        }
+        density.mipBias = static_cast<float>(std::log2(density.medianDensity / reference));
+        density.streamingPriority = static_cast<float>(density.worldArea / largestWorldArea);
+        
+        const MeshData& mesh = sceneData.meshes[i];
+        if (mesh.materialIndices.empty() || mesh.materialIndices[0] >= materials.size()) {
+            continue;
+        }
+        MaterialDensity& material = materials[mesh.materialIndices[0]];
+        if (material.worldArea == 0.0) {
+            material.minMedian = material.maxMedian = density.medianDensity;
+        }
+        material.worldArea += density.worldArea;
+        material.texelArea += density.texelArea;
+        material.minMedian = std::min(material.minMedian, density.medianDensity);
+        material.maxMedian = std::max(material.maxMedian, density.medianDensity);
+    }
+    
+    for (size_t m = 0; m < materials.size(); ++m) {
+        const MaterialDensity& density = materials[m];
+        if (density.worldArea <= 0.0) {
+            continue;
+        }
+        MaterialValidationResult& material = result.materialResults[m];
+        material.texelDensity = static_cast<float>(std::sqrt(density.texelArea / density.worldArea));
+        material.texelDensitySpread = density.maxMedian / density.minMedian;
+        if (material.texelDensitySpread > plan.maxDensityRatio) {
+            material.issues.emplace_back(Severity::WARNING, "texture", 
+                                         fmt::format("Texel density varies {:.1f}x across the meshes using it ({:.1f} to {:.1f} texels/m)", 
+                                                   material.texelDensitySpread, density.minMedian, density.maxMedian),
+                                         material.materialName, "Rescale UV islands so meshes sharing the material get a consistent texel density");
+        }
+    }
+}
+
+void Validator::resolveSceneBounds(const ValidationPlan& plan, ThreadPool& /*pool*/, const SceneData& /*sceneData*/,
+                                   ValidationResult& result) {
+    std::vector<const MeshBounds*> meshBounds;
+    meshBounds.reserve(result.meshResults.size());
+    for (const auto& mesh : result.meshResults) {
+        meshBounds.push_back(&mesh.bounds);
+    }
+    result.sceneBounds = BoundsAnalyzer::combine(meshBounds);
+    if (!result.sceneBounds.valid) {
+        return;
+    }
+    
+    const glm::vec3 size = result.sceneBounds.max - result.sceneBounds.min;
+    const float extent = std::max(size.x, std::max(size.y, size.z));
+    if (plan.maxSceneExtent > 0.0f && extent > plan.maxSceneExtent) {
+        result.globalIssues.emplace_back(Severity::ERROR, "geometry", 
+                                         fmt::format("Scene extends {:.2f} units, above the {:.2f} limit ({:.2f} x {:.2f} x {:.2f})", 
+                                                   extent, plan.maxSceneExtent, size.x, size.y, size.z),
+                                         "", "Check the export units (centimetres instead of metres?) and look for stray vertices");
+    }
+    if (plan.minSceneExtent > 0.0f && extent < plan.minSceneExtent) {
+        result.globalIssues.emplace_back(Severity::WARNING, "geometry", 
+                                         fmt::format("Scene extends only {:.4f} units, below the {:.4f} minimum", 
+                                                   extent, plan.minSceneExtent),
+                                         "", "Check the export units and scale; glTF scenes are in metres");
+    }
+    
+    const glm::vec3 center = (result.sceneBounds.min + result.sceneBounds.max) * 0.5f;
+    const float offset = glm::length(center);
+    if (plan.maxOriginOffset > 0.0f && offset > plan.maxOriginOffset) {
+        result.globalIssues.emplace_back(Severity::WARNING, "geometry", 
+                                         fmt::format("Scene centre ({:.2f}, {:.2f}, {:.2f}) is {:.2f} units from the origin, above the {:.2f} limit", 
+                                                   center.x, center.y, center.z, offset, plan.maxOriginOffset),
+                                         "", "Move the asset to the origin; large offsets cost float precision and break pivots");
+    }
+}
+
+void Validator::resolveGpuMemory(const ValidationPlan& plan, ThreadPool& /*pool*/, const SceneData& sceneData,
+                                 ValidationResult& result) {
+    const GpuMemoryEstimator estimator(plan.textureFormat, plan.normalTextureFormat, plan.mipChains);
+    GpuMemoryResult& memory = result.gpuMemory;
+    // Instances of one file mesh share its buffers: one entry for all
+    std::unordered_map<uint32_t, size_t> entryBySource;
+    for (const auto& mesh : sceneData.meshes) {
+        if (mesh.sourceMesh != MeshData::kNoSourceMesh) {
+            const auto inserted = entryBySource.emplace(mesh.sourceMesh, memory.entries.size());
+            if (!inserted.second) {
+                memory.entries[inserted.first->second].instances++;
+                continue;
+            }
+        }
+        GpuMemoryEntry entry;
+        entry.name = mesh.name;
+        entry.kind = "mesh";
+        entry.estimate = estimator.estimateMesh(mesh);
+        memory.meshBytes += entry.estimate.bytes;
+        memory.entries.push_back(std::move(entry));
+    }
+    for (const auto& texture : sceneData.textures) {
+        if (texture.width == 0 || texture.height == 0) {
+            continue; // Missing file: nothing known to estimate
+        }
+        GpuMemoryEntry entry;
+        entry.name = texture.name;
+        entry.kind = "texture";
+        entry.width = texture.width;
+        entry.height = texture.height;
+        entry.estimate = estimator.estimateTexture(texture);
+        memory.textureBytes += entry.estimate.bytes;
+        memory.entries.push_back(std::move(entry));
+    }
+    memory.totalBytes = memory.meshBytes + memory.textureBytes;
+    
+    // Largest first; stable so equal sizes keep scene order
+    std::stable_sort(memory.entries.begin(), memory.entries.end(),
+                     [](const GpuMemoryEntry& a, const GpuMemoryEntry& b) {
+                         return a.estimate.bytes > b.estimate.bytes;
+                     });
+    
+    if (plan.maxTotalMemoryBytes > 0 && memory.totalBytes > plan.maxTotalMemoryBytes) {
+        const GpuMemoryEntry& largest = memory.entries.front();
+        result.globalIssues.emplace_back(Severity::ERROR, "performance", 
+                                         fmt::format("Estimated GPU memory {} exceeds the {} budget (meshes {}, textures {}); largest is {} '{}' at {}", 
+                                                   formatMegabytes(memory.totalBytes),
+                                                   formatMegabytes(plan.maxTotalMemoryBytes),
+                                                   formatMegabytes(memory.meshBytes),
+                                                   formatMegabytes(memory.textureBytes), largest.kind,
+                                                   largest.name, formatMegabytes(largest.estimate.bytes)),
+                                         "", "Start with the largest contributors: downscale textures, use smaller block formats or reduce geometry");
+    }
+}
+
+void Validator::resolveDuplicateMeshes(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                       ValidationResult& result) {
+    result.duplicateMeshes = cachedMetric<DuplicateMeshResult>(plan, &sceneData, "duplicate_meshes", [&]() {
+        const GeometryHasher hasher(plan.matchRigidDuplicates, plan.rigidDuplicateTolerance, plan.minDuplicateTriangles);
+        return hasher.analyze(sceneData, pool);
+    }, plan.matchRigidDuplicates, plan.rigidDuplicateTolerance, plan.minDuplicateTriangles);
+    const DuplicateMeshResult& duplicates = result.duplicateMeshes;
+    if (duplicates.duplicateMeshes == 0) {
+        return;
+    }
+    
+    result.globalIssues.emplace_back(Severity::WARNING, "performance", 
+                                     fmt::format("{} meshes are copies of other meshes' geometry ({} after a rigid transform); instancing them would save {} of vertex/index memory and {} draws", 
+                                               duplicates.duplicateMeshes, duplicates.transformedMeshes,
+                                               formatMegabytes(duplicates.bytesSaved), duplicates.drawsSaved),
+                                     "Scene", "Keep one mesh per shape and place the copies as instances");
+    
+    const size_t suggestions = std::min<size_t>(duplicates.groups.size(), plan.maxDuplicateSuggestions);
+    for (size_t i = 0; i < suggestions; ++i) {
+        const DuplicateMeshGroup& group = duplicates.groups[i];
+        const MeshData& first = sceneData.meshes[group.meshes[0]];
+        result.globalIssues.emplace_back(Severity::INFO, "performance", 
+                                         fmt::format("{} meshes repeat the {} triangles of '{}'{}; instancing saves {}", 
+                                                   group.meshes.size(), first.triangleCount, first.name,
+                                                   group.transformed ? " up to rotation and translation" : "",
+                                                   formatMegabytes(group.bytesSaved)),
+                                         first.name, 
+                                         group.transformed ? "Replace the copies with instances of it carrying their transforms"
+                                                           : "Replace the copies with instances of it");
+    }
+}
+
+void Validator::resolveMaterialDedup(const ValidationPlan& plan, ThreadPool& /*pool*/, const SceneData& sceneData,
+                                     ValidationResult& result) {
+    const MaterialDeduplicator deduplicator(plan.materialFactorSteps);
+    result.materialDedup = deduplicator.analyze(sceneData);
+    const MaterialDedupResult& dedup = result.materialDedup;
+    if (dedup.uniqueMaterials == dedup.materialCount) {
+        return;
+    }
+    
+    result.globalIssues.emplace_back(Severity::WARNING, "material", 
+                                     fmt::format("{} of {} materials duplicate another up to name; deduplicating leaves {}", 
+                                               dedup.materialCount - dedup.uniqueMaterials, dedup.materialCount,
+                                               dedup.uniqueMaterials),
+                                     "Scene", "Reference one shared material instead of per-mesh copies");
+    for (const auto& group : dedup.groups) {
+        if (group.materials.size() < 2) {
+            continue;
+        }
+        std::string names;
+        for (size_t i = 1; i < group.materials.size(); ++i) {
+            names += fmt::format("{}'{}'", names.empty() ? "" : ", ", sceneData.materials[group.materials[i]].name);
+        }
+        const std::string& kept = sceneData.materials[group.materials[0]].name;
+        result.globalIssues.emplace_back(Severity::INFO, "material", 
+                                         fmt::format("Materials {} are identical to '{}'", names, kept),
+                                         kept, fmt::format("Replace them with '{}'", kept));
+    }
+}
+
+void Validator::resolveDrawCalls(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                 ValidationResult& result) {
+    result.drawCalls = cachedMetric<DrawCallStats>(plan, &sceneData, "draw_calls", [&]() {
+        return DrawCallEstimator(plan.maxBatchVertices).estimate(sceneData, pool);
+    }, plan.maxBatchVertices);
+    const DrawCallStats& draws = result.drawCalls;
+    
+    if (plan.maxDrawCalls > 0 && draws.meshDraws > plan.maxDrawCalls) {
+        result.globalIssues.emplace_back(Severity::WARNING, "performance", 
+                                         fmt::format("Scene submits {} draw calls ({} material changes), above the {} budget; instancing and merging could bring it to {} ({} material changes)", 
+                                                   draws.meshDraws, draws.materialChanges, plan.maxDrawCalls,
+                                                   draws.estimatedDraws, draws.sortedMaterialChanges),
+                                         "Scene", 
+                                         draws.estimatedDraws > plan.maxDrawCalls
+                                             ? "Batching alone does not fit the budget: also reduce the number of materials"
+                                             : "Apply the suggested instancing and merges");
+    }
+    
+    const auto materialName = [&](uint32_t material) -> std::string {
+        return material < sceneData.materials.size() ? sceneData.materials[material].name : "(none)";
+    };
+    const size_t suggestions = std::min<size_t>(draws.batches.size(), plan.maxBatchSuggestions);
+    for (size_t i = 0; i < suggestions; ++i) {
+        const DrawBatch& batch = draws.batches[i];
+        const std::string& first = sceneData.meshes[batch.meshes[0]].name;
+        if (batch.kind == DrawBatch::Kind::Instance) {
+            result.globalIssues.emplace_back(Severity::INFO, "performance", 
+                                             fmt::format("{} meshes share the geometry of '{}' and material '{}' and could become 1 instanced draw", 
+                                                       batch.meshes.size(), first, materialName(batch.material)),
+                                             first, "Draw them as instances of one mesh");
+        } else {
+            result.globalIssues.emplace_back(Severity::INFO, "performance", 
+                                             fmt::format("{} meshes share material '{}' and {} vertices and could become 1 draw ({} vertices merged)", 
+                                                       batch.meshes.size(), materialName(batch.material),
+                                                       DrawCallEstimator::vertexFormatName(batch.vertexFormat),
+                                                       batch.vertices),
+                                             first, "Merge the static meshes into one");
+        }
+    }
+}
+
+void Validator::resolveHiddenGeometry(const ValidationPlan& plan, ThreadPool& pool, const SceneData& sceneData,
+                                      ValidationResult& result) {
+    result.hiddenGeometry = cachedMetric<HiddenGeometryResult>(plan, &sceneData, "hidden_geometry", [&]() {
+        return HiddenGeometryAnalyzer(plan.visibilityDirections).analyze(sceneData, pool);
+    }, plan.visibilityDirections);
+    const HiddenGeometryResult& hidden = result.hiddenGeometry;
+    
+    for (const HiddenMeshResult& mesh : hidden.meshes) {
+        if (mesh.hiddenPercentage <= plan.maxHiddenPercentage || mesh.mesh >= result.meshResults.size()) {
+            continue;
+        }
+        std::string triangles;
+        for (uint32_t triangle : mesh.hiddenSamples) {
+            triangles += fmt::format("{}{}", triangles.empty() ? "" : ", ", triangle);
+        }
+        const std::string& name = sceneData.meshes[mesh.mesh].name;
+        result.meshResults[mesh.mesh].issues.emplace_back(Severity::WARNING, "geometry", 
+                                                          fmt::format("{} of {} triangles ({:.1f}%) cannot be seen from any direction (e.g. triangles {})", 
+                                                                    mesh.hiddenTriangles, mesh.triangles,
+                                                                    mesh.hiddenPercentage, triangles),
+                                                          name, mesh.hiddenTriangles == mesh.triangles
+                                                              ? "The mesh is fully enclosed by other geometry: delete it"
+                                                              : "Delete the interior faces");
+    }
+    if (hidden.hiddenTriangles > 0) {
+        result.globalIssues.emplace_back(hidden.hiddenPercentage > plan.maxHiddenPercentage ? Severity::WARNING : Severity::INFO,
+                                         "geometry", 
+                                         fmt::format("{} of {} triangles ({:.1f}%) in {} meshes are hidden inside other geometry and removable", 
+                                                   hidden.hiddenTriangles, hidden.testedTriangles,
+                                                   hidden.hiddenPercentage, hidden.meshes.size()),
+                                         "Scene", "Strip interior faces from CAD and kitbash imports before export");
+    }
+}
+
 void Validator::validateMesh(const MeshData& mesh, MeshValidationResult& result) {
+    applyMeshRules(*plan, *threadPool, mesh, result);
+}
+
+void Validator::validateMaterial(const MaterialData& material, MaterialValidationResult& result) {
+    applyMaterialRules(*plan, material, result, RuleRun());
+}
+
+void Validator::validateTexture(const TextureData& texture, std::vector<ValidationIssue>& issues) {
+    applyTextureRules(*plan, texture, issues, RuleRun());
+}
+
+void Validator::applyMeshRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                               MeshValidationResult& result) {
+    applyMeshMetadataRules(plan, pool, mesh, result, RuleRun());
+    applyMeshGeometryRules(plan, pool, mesh, result, RuleRun());
+}
+
+void Validator::applyMeshMetadataRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                       MeshValidationResult& result, const RuleRun& run) {
     result.meshName = mesh.name;
     result.vertexCount = mesh.vertices.size();
     result.triangleCount = mesh.triangleCount;
     result.materialCount = mesh.materialIndices.size();
     
-    // Validate polygon count
-    validatePolygonCount(mesh, result.issues);
-    
-    // Validate UV coordinates
-    if (config.checkUVRange || config.checkUVOverlaps) {
-        validateUVCoordinates(mesh, result.issues);
-    }
-    
-    // Validate vertex data
-    validateVertexData(mesh, result.issues);
+    runRules(plan, plan.meshRules, 0, plan.meshMetadataRuleCount, run, result.issues,
+             [&](const RuleDescriptor& rule) { return meshItems(rule, mesh); },
+             [&](const RuleDescriptor& rule) { rule.meshRule(plan, pool, mesh, result); });
+}
+
+void Validator::applyMeshGeometryRules(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                       MeshValidationResult& result, const RuleRun& run) {
+    // One SIMD pass per vertex stream feeds every per-vertex rule
+    result.positionStats = cachedMetric<PositionStreamStats>(plan, &mesh, "positions", [&]() {
+        return VertexKernels::analyzePositions(mesh.vertices.data(), mesh.vertices.size());
+    });
+    result.normalStats = cachedMetric<NormalStreamStats>(plan, &mesh, "normals", [&]() {
+        return VertexKernels::analyzeNormals(mesh.normals.data(), mesh.normals.size());
+    });
+    result.uvStats = cachedMetric<UVStreamStats>(plan, &mesh, "uvs", [&]() {
+        return VertexKernels::analyzeUVs(mesh.uvCoords.data(), mesh.uvCoords.size(), plan.uvTolerance);
+    }, plan.uvTolerance);
     
-    // Validate mesh naming
-    if (config.enforceNamingConventions) {
-        validateMeshNaming(mesh.name, result.issues);
-    }
+    runRules(plan, plan.meshRules, plan.meshMetadataRuleCount, plan.meshRules.size(), run, result.issues,
+             [&](const RuleDescriptor& rule) { return meshItems(rule, mesh); },
+             [&](const RuleDescriptor& rule) { rule.meshRule(plan, pool, mesh, result); });
     
     // Set UV validation flag
-    result.hasValidUVs = checkUVRange(mesh.uvCoords);
+    result.hasValidUVs = result.uvStats.outOfRangeCount == 0 &&
+                         result.uvStats.nonFiniteCount == 0 &&
+                         result.uvOverlapPercentage <= plan.maxUVOverlapPercentage;
 }
 
-void Validator::validateMaterial(const MaterialData& material, MaterialValidationResult& result) {
+void Validator::applyMaterialRules(const ValidationPlan& plan, const MaterialData& material,
+                                   MaterialValidationResult& result, const RuleRun& run) {
     result.materialName = material.name;
     
     // Collect all textures
@@ -127,16 +865,8 @@ void Validator::validateMaterial(const MaterialData& material, MaterialValidatio
         result.textures.push_back(material.occlusionTexture);
     }
     
-    // Validate material properties
-    validateMaterialProperties(material, result.issues);
-    
-    // Validate material textures
-    validateMaterialTextures(material, result.issues);
-    
-    // Validate material naming
-    if (config.enforceNamingConventions) {
-        validateMaterialNaming(material.name, result.issues);
-    }
+    runRules(plan, plan.materialRules, 0, plan.materialRules.size(), run, result.issues, oneItem,
+             [&](const RuleDescriptor& rule) { rule.materialRule(plan, material, result); });
     
     result.hasValidTextures = true;
     for (const auto& issue : result.issues) {
@@ -147,25 +877,14 @@ void Validator::validateMaterial(const MaterialData& material, MaterialValidatio
     }
 }
 
-void Validator::validateTexture(const TextureData& texture, std::vector<ValidationIssue>& issues) {
-    // Validate texture resolution
-    validateTextureResolution(texture, issues);
-    
-    // Validate texture format
-    validateTextureFormat(texture, issues);
-    
-    // Validate power of two
-    if (config.requirePowerOfTwo) {
-        validateTexturePowerOfTwo(texture, issues);
-    }
-    
-    // Validate texture naming
-    if (config.enforceNamingConventions) {
-        validateTextureNaming(texture.name, issues);
-    }
+void Validator::applyTextureRules(const ValidationPlan& plan, const TextureData& texture,
+                                  std::vector<ValidationIssue>& issues, const RuleRun& run) {
+    runRules(plan, plan.textureRules, 0, plan.textureRules.size(), run, issues, oneItem,
+             [&](const RuleDescriptor& rule) { rule.textureRule(plan, texture, issues); });
 }
 
-void Validator::validateNamingConventions(const SceneData& sceneData, std::vector<ValidationIssue>& issues) {
+void Validator::validateNamingConventions(const ValidationPlan& /*plan*/, const SceneData& sceneData,
+                                          std::vector<ValidationIssue>& issues) {
     // Mesh names are validated per-mesh
     // Material names are validated per-material
     // Texture names are validated per-texture
@@ -190,41 +909,38 @@ void Validator::validateNamingConventions(const SceneData& sceneData, std::vecto
     }
 }
 
-void Validator::validateSceneLimits(const SceneData& sceneData, std::vector<ValidationIssue>& issues) {
+void Validator::validateSceneLimits(const ValidationPlan& plan, const SceneData& sceneData,
+                                    std::vector<ValidationIssue>& issues) {
     // Check total triangle count
-    if (sceneData.totalTriangles > config.maxTotalTriangles) {
+    if (sceneData.totalTriangles > plan.maxTotalTriangles) {
         issues.emplace_back(Severity::ERROR, "performance", 
                            fmt::format("Total triangle count ({}) exceeds limit ({})", 
-                                     sceneData.totalTriangles, config.maxTotalTriangles),
+                                     sceneData.totalTriangles, plan.maxTotalTriangles),
                            "Scene", 
-                           fmt::format("Reduce total triangles to under {}", config.maxTotalTriangles));
-    }
-    
-    // Check mesh count
-    if (sceneData.meshes.size() > 1000) { // Arbitrary large limit
-        issues.emplace_back(Severity::WARNING, "performance", 
-                           fmt::format("High mesh count: {}", sceneData.meshes.size()),
-                           "Scene", "Consider merging meshes to improve performance");
+                           fmt::format("Reduce total triangles to under {}", plan.maxTotalTriangles));
     }
 }
 
-void Validator::validatePolygonCount(const MeshData& mesh, std::vector<ValidationIssue>& issues) {
+void Validator::validatePolygonCount(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                     MeshValidationResult& result) {
+    auto& issues = result.issues;
+    
     // Check triangle count
-    if (mesh.triangleCount > config.maxTrianglesPerMesh) {
+    if (mesh.triangleCount > plan.maxTrianglesPerMesh) {
         issues.emplace_back(Severity::ERROR, "geometry", 
                            fmt::format("Triangle count ({}) exceeds limit ({})", 
-                                     mesh.triangleCount, config.maxTrianglesPerMesh),
+                                     mesh.triangleCount, plan.maxTrianglesPerMesh),
                            mesh.name, 
-                           fmt::format("Reduce triangles to under {}", config.maxTrianglesPerMesh));
+                           fmt::format("Reduce triangles to under {}", plan.maxTrianglesPerMesh));
     }
     
     // Check vertex count
-    if (mesh.vertices.size() > config.maxVerticesPerMesh) {
+    if (mesh.vertices.size() > plan.maxVerticesPerMesh) {
         issues.emplace_back(Severity::ERROR, "geometry", 
                            fmt::format("Vertex count ({}) exceeds limit ({})", 
-                                     mesh.vertices.size(), config.maxVerticesPerMesh),
+                                     mesh.vertices.size(), plan.maxVerticesPerMesh),
                            mesh.name, 
-                           fmt::format("Reduce vertices to under {}", config.maxVerticesPerMesh));
+                           fmt::format("Reduce vertices to under {}", plan.maxVerticesPerMesh));
     }
     
     // Warn about very low poly meshes
@@ -235,7 +951,11 @@ void Validator::validatePolygonCount(const MeshData& mesh, std::vector<Validatio
     }
 }
 
-void Validator::validateUVCoordinates(const MeshData& mesh, std::vector<ValidationIssue>& issues) {
+void Validator::validateUVCoordinates(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                      MeshValidationResult& result) {
+    auto& issues = result.issues;
+    const UVStreamStats& uvStats = result.uvStats;
+    
     if (mesh.uvCoords.empty()) {
         issues.emplace_back(Severity::WARNING, "uv", 
                            "Mesh has no UV coordinates",
@@ -243,11 +963,659 @@ void Validator::validateUVCoordinates(const MeshData& mesh, std::vector<Validati
         return;
     }
     
-    if (config.checkUVRange) {
-        bool validRange = checkUVRange(mesh.uvCoords);
-        if (!validRange) {
+    if (plan.checkUVRange) {
+        if (uvStats.nonFiniteCount > 0) {
+            issues.emplace_back(Severity::ERROR, "uv", 
+                               fmt::format("{} UV coordinates are NaN or infinite", uvStats.nonFiniteCount),
+                               mesh.name, "Re-export the mesh with valid UV coordinates");
+        }
+        if (uvStats.outOfRangeCount > 0) {
             issues.emplace_back(Severity::WARNING, "uv", 
-                               "UV coordinates outside 0-1 range detected",
+                               fmt::format("{} UV coordinates outside 0-1 range detected (range [{:.3f}, {:.3f}] - [{:.3f}, {:.3f}])", 
+                                         uvStats.outOfRangeCount, uvStats.min.x, uvStats.min.y,
+                                         uvStats.max.x, uvStats.max.y),
                                mesh.name, "Ensure UV coordinates are within 0-1 range");
         }
-    }
\ No newline at end of file
+    }
+}
+
+void Validator::validateVertexData(const ValidationPlan& /*plan*/, ThreadPool& /*pool*/, const MeshData& mesh,
+                                   MeshValidationResult& result) {
+    auto& issues = result.issues;
+    const PositionStreamStats& positionStats = result.positionStats;
+    const NormalStreamStats& normalStats = result.normalStats;
+    
+    // Attribute streams must line up with the position stream
+    if (!mesh.normals.empty() && mesh.normals.size() != mesh.vertices.size()) {
+        issues.emplace_back(Severity::ERROR, "geometry", 
+                           fmt::format("Normal count ({}) does not match vertex count ({})", 
+                                     mesh.normals.size(), mesh.vertices.size()),
+                           mesh.name, "Re-export the mesh with one normal per vertex");
+    }
+    if (!mesh.uvCoords.empty() && mesh.uvCoords.size() != mesh.vertices.size()) {
+        issues.emplace_back(Severity::ERROR, "geometry", 
+                           fmt::format("UV count ({}) does not match vertex count ({})", 
+                                     mesh.uvCoords.size(), mesh.vertices.size()),
+                           mesh.name, "Re-export the mesh with one UV per vertex");
+    }
+    
+    if (!mesh.indices.empty()) {
+        const uint32_t maxIndex = *std::max_element(mesh.indices.begin(), mesh.indices.end());
+        if (maxIndex >= mesh.vertices.size()) {
+            issues.emplace_back(Severity::CRITICAL, "geometry", 
+                               fmt::format("Index {} is out of range for {} vertices", 
+                                         maxIndex, mesh.vertices.size()),
+                               mesh.name, "The index buffer is corrupt; re-export the mesh");
+        }
+    }
+    
+    if (positionStats.nonFiniteCount > 0) {
+        issues.emplace_back(Severity::ERROR, "geometry", 
+                           fmt::format("{} vertex positions are NaN or infinite", positionStats.nonFiniteCount),
+                           mesh.name, "Remove or fix the invalid vertices before export");
+    }
+    
+    if (mesh.normals.empty()) {
+        issues.emplace_back(Severity::WARNING, "geometry", 
+                           "Mesh has no normals",
+                           mesh.name, "Export normals to avoid generating them at load time");
+        return;
+    }
+    
+    if (normalStats.nonFiniteCount > 0) {
+        issues.emplace_back(Severity::ERROR, "geometry", 
+                           fmt::format("{} normals are NaN or infinite", normalStats.nonFiniteCount),
+                           mesh.name, "Recalculate normals before export");
+    }
+    
+    // Everything past the 1% bin is visibly wrong in lighting
+    uint64_t nonUnitNormals = 0;
+    for (size_t bin = 2; bin < kNormalDeviationBins; ++bin) {
+        nonUnitNormals += normalStats.deviationHistogram[bin];
+    }
+    if (nonUnitNormals > 0) {
+        issues.emplace_back(Severity::WARNING, "geometry", 
+                           fmt::format("{} normals deviate from unit length by more than {}%", 
+                                     nonUnitNormals, kNormalDeviationLimits[1] * 100.0f),
+                           mesh.name, "Normalize normals before export");
+    }
+}
+
+void Validator::validateTangentFrames(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                      MeshValidationResult& result) {
+    auto& issues = result.issues;
+    result.tangentFrames = cachedMetric<TangentFrameResult>(plan, &mesh, "tangent_frames", [&]() {
+        return TangentFrameAnalyzer(plan.maxNormalFaceAngle).analyze(mesh, pool);
+    }, plan.maxNormalFaceAngle);
+    const TangentFrameResult& frames = result.tangentFrames;
+    
+    if (frames.windingMismatchTriangles > 0) {
+        issues.emplace_back(Severity::WARNING, "geometry", 
+                           fmt::format("{} triangles ({:.2f}%) have vertex normals more than {:.0f} degrees from the face winding", 
+                                     frames.windingMismatchTriangles,
+                                     100.0 * frames.windingMismatchTriangles / std::max<uint64_t>(frames.checkedTriangles, 1),
+                                     plan.maxNormalFaceAngle),
+                           mesh.name, "Check for flipped faces or inverted normals and recalculate normals");
+    }
+    
+    if (!frames.hasTangents) {
+        return;
+    }
+    if (frames.tangentStats.nonFiniteCount > 0) {
+        issues.emplace_back(Severity::ERROR, "geometry", 
+                           fmt::format("{} tangents or bitangents are NaN or infinite", frames.tangentStats.nonFiniteCount),
+                           mesh.name, "Regenerate tangents (MikkTSpace) before export");
+    }
+    if (frames.tangentStats.zeroLengthCount > 0) {
+        issues.emplace_back(Severity::WARNING, "geometry", 
+                           fmt::format("{} tangents have zero length", frames.tangentStats.zeroLengthCount),
+                           mesh.name, "Fix collapsed or unmapped UVs, then regenerate tangents");
+    }
+    if (frames.mixedHandednessTriangles > 0) {
+        issues.emplace_back(Severity::WARNING, "geometry", 
+                           fmt::format("{} triangles mix mirrored and unmirrored tangent frames", 
+                                     frames.mixedHandednessTriangles),
+                           mesh.name, "Split vertices along UV mirror seams so every triangle has one handedness");
+    }
+}
+
+void Validator::validateBounds(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                               MeshValidationResult& result) {
+    // The box comes from the position stream pass that ran before the rules
+    result.bounds = cachedMetric<MeshBounds>(plan, &mesh, "bounds", [&]() {
+        return BoundsAnalyzer(plan.strayVertexFactor).analyze(mesh.vertices, result.positionStats, mesh.worldTransform);
+    }, plan.strayVertexFactor);
+    
+    if (result.bounds.strayVertices > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} stray vertices, up to {:.2f} units from the mesh centre ({:.0f}x the {:.3f} radius holding 99% of vertices)", 
+                                             result.bounds.strayVertices, result.bounds.maxStrayDistance,
+                                             result.bounds.maxStrayDistance / result.bounds.coreRadius,
+                                             result.bounds.coreRadius),
+                                   mesh.name, "Delete or snap stray vertices; they inflate the bounds used for culling and shadows");
+    }
+}
+
+void Validator::validateDegenerateTriangles(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                            MeshValidationResult& result) {
+    DegenerateTriangleResult degenerate = cachedMetric<DegenerateTriangleResult>(plan, &mesh, "degenerate_triangles", [&]() {
+        DegenerateTriangleDetector detector(plan.degenerateAreaEpsilon, plan.nearDegenerateRatio);
+        return detector.analyze(mesh.vertices, mesh.indices, pool);
+    }, plan.degenerateAreaEpsilon, plan.nearDegenerateRatio);
+    
+    result.zeroAreaTriangles = degenerate.zeroAreaTriangles;
+    result.nearDegenerateTriangles = degenerate.nearDegenerateTriangles;
+    result.degenerateTriangles = std::move(degenerate.degenerateTriangles);
+    
+    if (result.zeroAreaTriangles > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} zero-area triangles", result.zeroAreaTriangles),
+                                   mesh.name, "Remove degenerate triangles; they cost vertex work but draw nothing");
+    }
+    if (result.nearDegenerateTriangles > 0) {
+        result.issues.emplace_back(Severity::INFO, "geometry", 
+                                   fmt::format("{} needle or sliver triangles (height below {} of the longest edge)", 
+                                             result.nearDegenerateTriangles, plan.nearDegenerateRatio),
+                                   mesh.name, "Collapse thin triangles to reduce shading waste and precision artifacts");
+    }
+}
+
+void Validator::validateDuplicateVertices(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                          MeshValidationResult& result) {
+    const DuplicateVertexResult duplicates = cachedMetric<DuplicateVertexResult>(plan, &mesh, "duplicate_vertices", [&]() {
+        DuplicateVertexDetector detector(plan.weldPositionTolerance, plan.weldAttributeTolerance);
+        return detector.analyze(mesh.vertices, mesh.normals, mesh.uvCoords, mesh.tangents, mesh.bitangents, pool);
+    }, plan.weldPositionTolerance, plan.weldAttributeTolerance);
+    
+    result.coincidentVertices = duplicates.coincidentVertices;
+    result.weldableVertices = duplicates.weldableVertices;
+    
+    if (duplicates.weldableVertices > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} duplicate vertices could be welded ({:.1f}% of {} vertices)", 
+                                             duplicates.weldableVertices, duplicates.weldSavingsPercentage,
+                                             mesh.vertices.size()),
+                                   mesh.name, "Weld vertices that share position, normal and UV");
+    }
+}
+
+void Validator::validateTopology(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                 MeshValidationResult& result) {
+    if (mesh.indices.size() < 3) {
+        return;
+    }
+    
+    // Weld by position first so UV seams and hard edges do not read as open borders
+    const MeshTopologyResult topology = cachedMetric<MeshTopologyResult>(plan, &mesh, "topology", [&]() {
+        EdgeAdjacency adjacency;
+        adjacency.build(mesh.indices, EdgeAdjacency::weldPositions(mesh.vertices, pool), mesh.vertices.size(), pool);
+        return adjacency.analyzeTopology();
+    });
+    
+    result.boundaryEdges = topology.boundaryEdges;
+    result.boundaryLoops = topology.boundaryLoops;
+    result.nonManifoldEdges = topology.nonManifoldEdges;
+    result.windingFlips = topology.windingFlips;
+    result.isWatertight = topology.isWatertight;
+    
+    if (topology.boundaryEdges > 0) {
+        result.issues.emplace_back(plan.requireWatertight ? Severity::ERROR : Severity::INFO, "geometry", 
+                                   fmt::format("{} open boundary loops ({} boundary edges)", 
+                                             topology.boundaryLoops, topology.boundaryEdges),
+                                   mesh.name, "Close holes if the mesh is meant to be solid");
+    }
+    if (topology.nonManifoldEdges > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} non-manifold edges shared by three or more triangles", 
+                                             topology.nonManifoldEdges),
+                                   mesh.name, "Split or remove the extra faces; baking and simplification need manifold edges");
+    }
+    if (topology.windingFlips > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} edges between triangles with opposite winding", 
+                                             topology.windingFlips),
+                                   mesh.name, "Unify face orientation; flipped faces break back-face culling and normals");
+    }
+}
+
+void Validator::validateConnectedComponents(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                            MeshValidationResult& result) {
+    if (mesh.indices.size() < 3) {
+        return;
+    }
+    
+    result.components = cachedMetric<MeshComponentResult>(plan, &mesh, "connected_components", [&]() {
+        MeshComponentAnalyzer analyzer(plan.minComponentTriangles, plan.minComponentVolumeRatio);
+        return analyzer.analyze(mesh.vertices, mesh.indices, pool);
+    }, plan.minComponentTriangles, plan.minComponentVolumeRatio);
+    const MeshComponentResult& components = result.components;
+    
+    if (components.debrisComponents > plan.maxDebrisComponents) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} of {} connected components ({} triangles) are debris: fewer than {} triangles or under {:g} of the mesh's bounding volume", 
+                                             components.debrisComponents, components.componentCount,
+                                             components.debrisTriangles, plan.minComponentTriangles,
+                                             plan.minComponentVolumeRatio),
+                                   mesh.name, "Delete floating fragments and interior leftovers; they cost vertex work without adding visible surface");
+    }
+    if (components.duplicateShells > 0) {
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} connected components ({} triangles) repeat an earlier component's triangle count and bounds", 
+                                             components.duplicateShells, components.duplicateTriangles),
+                                   mesh.name, "Delete the stacked duplicate shells");
+    }
+    if (components.componentCount > 1) {
+        result.issues.emplace_back(Severity::INFO, "geometry", 
+                                   fmt::format("{} connected components; the largest has {} of {} triangles", 
+                                             components.componentCount, components.largestTriangles,
+                                             mesh.indices.size() / 3),
+                                   mesh.name);
+    }
+}
+
+void Validator::validateSelfIntersections(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                          MeshValidationResult& result) {
+    if (mesh.indices.size() < 6) {
+        return;
+    }
+    
+    result.selfIntersections = cachedMetric<SelfIntersectionResult>(plan, &mesh, "self_intersections", [&]() {
+        return SelfIntersectionAnalyzer(plan.selfIntersectionTolerance).analyze(mesh.vertices, mesh.indices, pool);
+    }, plan.selfIntersectionTolerance);
+    const SelfIntersectionResult& intersections = result.selfIntersections;
+    
+    if (intersections.intersectingTriangles > plan.maxSelfIntersections) {
+        std::string locations;
+        for (size_t i = 0; i < std::min<size_t>(intersections.intersections.size(), 3); ++i) {
+            const SelfIntersection& hit = intersections.intersections[i];
+            locations += fmt::format("{}triangles {} and {} at ({:.3g}, {:.3g}, {:.3g})", locations.empty() ? "" : "; ",
+                                     hit.triangleA, hit.triangleB, hit.location.x, hit.location.y, hit.location.z);
+        }
+        result.issues.emplace_back(Severity::WARNING, "geometry", 
+                                   fmt::format("{} triangles intersect other triangles of the mesh ({} pairs, {} coplanar), e.g. {}", 
+                                             intersections.intersectingTriangles, intersections.intersectingPairs,
+                                             intersections.coplanarPairs, locations),
+                                   mesh.name, intersections.coplanarPairs == intersections.intersectingPairs
+                                       ? "Delete the duplicated or overlapping faces"
+                                       : "Separate or boolean-union the interpenetrating parts before baking or physics cooking");
+    }
+}
+
+void Validator::validateVertexCache(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                    MeshValidationResult& result) {
+    if (mesh.indices.size() < 3) {
+        return;
+    }
+    
+    // Interleaved layout of the streams this mesh actually carries
+    const uint32_t stride = GpuMemoryEstimator::vertexStride(mesh);
+    result.vertexCaches.clear();
+    for (VertexCacheModel model : plan.vertexCacheModels) {
+        for (uint32_t size : plan.vertexCacheSizes) {
+            result.vertexCaches.push_back(cachedMetric<VertexCacheResult>(plan, &mesh, "vertex_cache", [&]() {
+                return VertexCacheAnalyzer(model, size).analyze(mesh.indices, mesh.vertices.size(), stride);
+            }, static_cast<int>(model), size));
+        }
+    }
+    if (result.vertexCaches.empty()) {
+        return;
+    }
+    
+    // Each limit is checked against the cache that does worst on it
+    auto worst = [&](float VertexCacheResult::*metric) -> const VertexCacheResult& {
+        return *std::max_element(result.vertexCaches.begin(), result.vertexCaches.end(),
+                                 [&](const VertexCacheResult& a, const VertexCacheResult& b) {
+            return a.*metric < b.*metric;
+        });
+    };
+    auto cacheName = [](const VertexCacheResult& cache) {
+        return fmt::format("{}-entry {} cache", cache.cacheSize, VertexCacheAnalyzer::modelName(cache.model));
+    };
+    const VertexCacheResult& acmr = worst(&VertexCacheResult::acmr);
+    const VertexCacheResult& atvr = worst(&VertexCacheResult::atvr);
+    const VertexCacheResult& overfetch = worst(&VertexCacheResult::overfetch);
+    result.acmr = acmr.acmr;
+    result.atvr = atvr.atvr;
+    result.vertexFetchOverfetch = overfetch.overfetch;
+    
+    // ACMR / ATVR is unique vertices per triangle, the best ACMR any order reaches
+    if (plan.maxACMR > 0.0f && acmr.acmr > plan.maxACMR) {
+        result.issues.emplace_back(Severity::WARNING, "performance", 
+                                   fmt::format("ACMR {:.3f} exceeds limit {:.3f} ({}; {:.3f} at best for this mesh)", 
+                                             acmr.acmr, plan.maxACMR, cacheName(acmr),
+                                             acmr.atvr > 0.0f ? acmr.acmr / acmr.atvr : 0.0f),
+                                   mesh.name, "Reorder triangles for vertex cache locality (Tipsify/Forsyth)");
+    }
+    if (plan.maxATVR > 0.0f && atvr.atvr > plan.maxATVR) {
+        result.issues.emplace_back(Severity::WARNING, "performance", 
+                                   fmt::format("ATVR {:.3f} exceeds limit {:.3f} ({})", 
+                                             atvr.atvr, plan.maxATVR, cacheName(atvr)),
+                                   mesh.name, "Reorder triangles for vertex cache locality (Tipsify/Forsyth)");
+    }
+    if (plan.maxVertexFetchOverfetch > 0.0f && overfetch.overfetch > plan.maxVertexFetchOverfetch) {
+        result.issues.emplace_back(Severity::WARNING, "performance", 
+                                   fmt::format("Vertex fetch overfetch {:.2f}x exceeds limit {:.2f}x ({})", 
+                                             overfetch.overfetch, plan.maxVertexFetchOverfetch, cacheName(overfetch)),
+                                   mesh.name, "Reorder vertices in the order the index buffer first uses them");
+    }
+}
+
+void Validator::validateMeshlets(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                 MeshValidationResult& result) {
+    if (mesh.indices.size() < 3) {
+        return;
+    }
+    
+    result.meshlets = cachedMetric<MeshletResult>(plan, &mesh, "meshlets", [&]() {
+        MeshletBuilder builder(plan.meshletMaxVertices, plan.meshletMaxTriangles);
+        return builder.analyze(builder.build(mesh.vertices, mesh.indices, pool), mesh.vertices);
+    }, plan.meshletMaxVertices, plan.meshletMaxTriangles);
+    const MeshletResult& meshlets = result.meshlets;
+    
+    // A mesh of a few meshlets is mostly its last, partial one
+    if (meshlets.meshletCount >= 4 && meshlets.triangleFill < plan.minMeshletTriangleFill) {
+        result.issues.emplace_back(Severity::WARNING, "performance", 
+                                   fmt::format("Meshlets hold {:.0f}% of their {} triangles on average ({} meshlets, "
+                                             "{:.2f} vertices per triangle, {:.0f}% vertex fill)", 
+                                             meshlets.triangleFill * 100.0f, plan.meshletMaxTriangles,
+                                             meshlets.meshletCount, meshlets.verticesPerTriangle,
+                                             meshlets.vertexFill * 100.0f),
+                                   mesh.name, "Weld vertices split by hard edges or UV seams; meshlets run out of "
+                                              "vertices long before triangles");
+    }
+}
+
+void Validator::validateUVOverlaps(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                   MeshValidationResult& result) {
+    if (mesh.uvCoords.empty()) {
+        return;
+    }
+    
+    UVOverlapResult overlaps = cachedMetric<UVOverlapResult>(plan, &mesh, "uv_overlaps", [&]() {
+        UVOverlapDetector detector(plan.uvOverlapResolution);
+        return detector.analyze(mesh.uvCoords, mesh.indices);
+    }, plan.uvOverlapResolution);
+    
+    result.uvOverlapPercentage = overlaps.overlapPercentage;
+    result.overlappingTriangles = std::move(overlaps.overlappingTriangles);
+    
+    if (overlaps.overlapPercentage > plan.maxUVOverlapPercentage) {
+        result.issues.emplace_back(Severity::WARNING, "uv", 
+                                   fmt::format("UV overlap of {:.2f}% ({} triangles) exceeds limit ({:.2f}%)", 
+                                             overlaps.overlapPercentage, result.overlappingTriangles.size(),
+                                             plan.maxUVOverlapPercentage),
+                                   mesh.name, "Separate overlapping UV islands, or relax the limit for mirrored/stacked UVs");
+    }
+}
+
+void Validator::validateQuadOverdraw(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                     MeshValidationResult& result) {
+    if (mesh.indices.size() < 3) {
+        return;
+    }
+    
+    // The profile holds every distance; profiles differing only in
+    // reference distances or the efficiency floor share it
+    const QuadOverdrawProfile profile = cachedMetric<QuadOverdrawProfile>(plan, &mesh, "quad_overdraw", [&]() {
+        const QuadOverdrawAnalyzer analyzer(plan.quadScreenHeight, plan.quadVerticalFov);
+        return analyzer.profile(mesh.vertices, mesh.indices, mesh.worldTransform, pool);
+    }, plan.quadScreenHeight, plan.quadVerticalFov);
+    if (profile.measuredTriangles == 0) {
+        return;
+    }
+    
+    QuadOverdrawResult& quads = result.quadOverdraw;
+    quads.measuredTriangles = profile.measuredTriangles;
+    for (float distance : plan.quadReferenceDistances) {
+        quads.references.push_back(QuadOverdrawAnalyzer::sample(profile, distance));
+    }
+    quads.lodDistance = QuadOverdrawAnalyzer::transitionDistance(profile, plan.minQuadEfficiency);
+    
+    // The nearest reference distance that is already too dense is the one to report
+    for (const QuadOverdrawSample& sample : quads.references) {
+        if (sample.quadEfficiency >= plan.minQuadEfficiency) {
+            continue;
+        }
+        result.issues.emplace_back(Severity::WARNING, "performance", 
+                                   fmt::format("Quad efficiency {:.0f}% at {:g} m on a {}p view: {:.1f} pixels per triangle, {:.0f}% of triangles smaller than a 2x2 quad", 
+                                             sample.quadEfficiency * 100.0f, sample.distance, plan.quadScreenHeight,
+                                             sample.pixelsPerTriangle, sample.smallTriangleShare * 100.0f),
+                                   mesh.name, fmt::format("Switch to a coarser LOD beyond {:.1f} m, or reduce the triangle density", 
+                                                          quads.lodDistance));
+        break;
+    }
+    if (quads.lodDistance > 0.0f) {
+        result.issues.emplace_back(Severity::INFO, "performance", 
+                                   fmt::format("Recommended LOD transition at {:.1f} m, where quad efficiency falls below {:.0f}%", 
+                                             quads.lodDistance, plan.minQuadEfficiency * 100.0f),
+                                   mesh.name);
+    }
+}
+
+void Validator::validateUVIslands(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                  MeshValidationResult& result) {
+    if (mesh.uvCoords.size() != mesh.vertices.size() || mesh.indices.size() < 3) {
+        return;
+    }
+    
+    // Tiny islands are measured against the mesh's own texture when it has one
+    uint32_t width = result.texelDensity.textureWidth;
+    uint32_t height = result.texelDensity.textureHeight;
+    if (width == 0 || height == 0) {
+        width = height = plan.islandAtlasSize;
+    }
+    
+    result.uvIslands = cachedMetric<UVIslandResult>(plan, &mesh, "uv_islands", [&]() {
+        UVIslandAnalyzer analyzer(plan.minIslandTexels);
+        return analyzer.analyze(mesh.vertices, mesh.uvCoords, mesh.indices, width, height, pool);
+    }, plan.minIslandTexels, width, height);
+    const UVIslandResult& islands = result.uvIslands;
+    if (islands.positionVertices == 0) {
+        return;
+    }
+    
+    const float seamRatio = static_cast<float>(islands.seamVertices) / islands.positionVertices;
+    if (plan.maxSeamVertexRatio > 0.0f && seamRatio > plan.maxSeamVertexRatio) {
+        result.issues.emplace_back(Severity::WARNING, "uv", 
+                                   fmt::format("UV seams split {} vertices (+{:.0f}% over {} positions) along {} edges in {} islands", 
+                                             islands.seamVertices, seamRatio * 100.0f, islands.positionVertices,
+                                             islands.seamEdges, islands.islandCount),
+                                   mesh.name, "Merge islands across seams that do not need a cut, or place seams on hard edges that split vertices anyway");
+    }
+    if (islands.tinyIslands > plan.maxTinyIslands) {
+        result.issues.emplace_back(Severity::WARNING, "uv", 
+                                   fmt::format("{} UV islands ({} triangles) cover fewer than {:.0f} texels at {}x{}", 
+                                             islands.tinyIslands, islands.tinyIslandTriangles, plan.minIslandTexels,
+                                             islands.textureWidth, islands.textureHeight),
+                                   mesh.name, "Merge tiny islands into their neighbours or scale them up; each one costs atlas padding and seam vertices");
+    }
+}
+
+void Validator::validateTexelDensity(const ValidationPlan& plan, ThreadPool& pool, const MeshData& mesh,
+                                     MeshValidationResult& result) {
+    // validate() fills in the texture size up front; without one there is
+    // nothing to measure against
+    const uint32_t width = result.texelDensity.textureWidth;
+    const uint32_t height = result.texelDensity.textureHeight;
+    if (width == 0 || height == 0 || mesh.uvCoords.size() != mesh.vertices.size()) {
+        return;
+    }
+    
+    result.texelDensity = cachedMetric<TexelDensityResult>(plan, &mesh, "texel_density", [&]() {
+        TexelDensityAnalyzer analyzer(plan.targetTexelDensity, plan.maxDensityRatio);
+        return analyzer.analyze(mesh.vertices, mesh.uvCoords, mesh.indices, mesh.worldTransform, width, height, pool);
+    }, plan.targetTexelDensity, plan.maxDensityRatio, width, height);
+    const TexelDensityResult& density = result.texelDensity;
+    if (density.measuredTriangles == 0) {
+        return;
+    }
+    
+    if (plan.targetTexelDensity > 0.0f && (density.medianDensity > plan.targetTexelDensity * plan.maxDensityRatio ||
+                                           density.medianDensity < plan.targetTexelDensity / plan.maxDensityRatio)) {
+        result.issues.emplace_back(Severity::WARNING, "texture", 
+                                   fmt::format("Median texel density {:.1f} texels/m is more than {:.1f}x from the target {:.1f} ({}x{} texture)", 
+                                             density.medianDensity, plan.maxDensityRatio, plan.targetTexelDensity,
+                                             width, height),
+                                   mesh.name, density.medianDensity > plan.targetTexelDensity
+                                       ? "Shrink the UV layout or use a smaller texture"
+                                       : "Enlarge the UV layout or use a larger texture");
+    }
+    
+    const float outlierPercentage = 100.0f * density.outlierTriangles / density.measuredTriangles;
+    if (outlierPercentage > plan.maxOutlierPercentage) {
+        result.issues.emplace_back(Severity::WARNING, "uv", 
+                                   fmt::format("{:.2f}% of triangles ({}) differ from the {} texel density by more than {:.1f}x", 
+                                             outlierPercentage, density.outlierTriangles,
+                                             plan.targetTexelDensity > 0.0f ? "target" : "mesh median",
+                                             plan.maxDensityRatio),
+                                   mesh.name, "Rescale the stretched or squashed UV islands");
+    }
+}
+
+void Validator::validateMeshNaming(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                   MeshValidationResult& result) {
+    if (!plan.meshNameMatcher.matches(mesh.name)) {
+        result.issues.emplace_back(Severity::WARNING, "naming", 
+                                   fmt::format("Mesh name '{}' does not match pattern '{}'", 
+                                             mesh.name, plan.meshNameMatcher.getPattern()),
+                                   mesh.name, "Rename the mesh to follow the naming convention");
+    }
+}
+
+void Validator::validateMeshGpuMemory(const ValidationPlan& plan, ThreadPool& /*pool*/, const MeshData& mesh,
+                                      MeshValidationResult& result) {
+    if (plan.maxMeshMemoryBytes == 0) {
+        return;
+    }
+    
+    const GpuMemoryEstimator estimator(plan.textureFormat, plan.normalTextureFormat, plan.mipChains);
+    const GpuMemoryEstimate estimate = estimator.estimateMesh(mesh);
+    if (estimate.bytes > plan.maxMeshMemoryBytes) {
+        result.issues.emplace_back(Severity::ERROR, "performance", 
+                                   fmt::format("Mesh needs {} of GPU memory ({} vertex, {} index), above the {} budget", 
+                                             formatMegabytes(estimate.bytes), formatMegabytes(estimate.vertexBytes),
+                                             formatMegabytes(estimate.indexBytes),
+                                             formatMegabytes(plan.maxMeshMemoryBytes)),
+                                   mesh.name, "Reduce the vertex count or split the mesh");
+    }
+}
+
+void Validator::validateMaterialProperties(const ValidationPlan& /*plan*/, const MaterialData& material,
+                                           MaterialValidationResult& result) {
+    for (int c = 0; c < 3; ++c) {
+        if (!(material.albedo[c] >= 0.0f && material.albedo[c] <= 1.0f)) {
+            result.issues.emplace_back(Severity::WARNING, "material", 
+                                       fmt::format("Albedo color ({:.3f}, {:.3f}, {:.3f}) is outside 0-1 range", 
+                                                 material.albedo.x, material.albedo.y, material.albedo.z),
+                                       material.name, "Clamp the base color to 0-1");
+            break;
+        }
+    }
+    
+    if (!(material.metallic >= 0.0f && material.metallic <= 1.0f)) {
+        result.issues.emplace_back(Severity::WARNING, "material", 
+                                   fmt::format("Metallic factor {:.3f} is outside 0-1 range", material.metallic),
+                                   material.name, "Clamp the metallic factor to 0-1");
+    }
+    if (!(material.roughness >= 0.0f && material.roughness <= 1.0f)) {
+        result.issues.emplace_back(Severity::WARNING, "material", 
+                                   fmt::format("Roughness factor {:.3f} is outside 0-1 range", material.roughness),
+                                   material.name, "Clamp the roughness factor to 0-1");
+    }
+}
+
+void Validator::validateMaterialTextures(const ValidationPlan& plan, const MaterialData& material,
+                                         MaterialValidationResult& result) {
+    if (plan.requireAlbedoTexture && material.albedoTexture.empty()) {
+        result.issues.emplace_back(Severity::ERROR, "material", 
+                                   "Missing required albedo texture",
+                                   material.name, "Assign a base color texture");
+    }
+    if (plan.requireNormalTexture && material.normalTexture.empty()) {
+        result.issues.emplace_back(Severity::ERROR, "material", 
+                                   "Missing required normal texture",
+                                   material.name, "Assign a normal map");
+    }
+    if (plan.requireMetallicRoughnessTexture && material.metallicRoughnessTexture.empty()) {
+        result.issues.emplace_back(Severity::ERROR, "material", 
+                                   "Missing required metallic-roughness texture",
+                                   material.name, "Assign a metallic-roughness texture");
+    }
+}
+
+void Validator::validateMaterialNaming(const ValidationPlan& plan, const MaterialData& material,
+                                       MaterialValidationResult& result) {
+    if (!plan.materialNameMatcher.matches(material.name)) {
+        result.issues.emplace_back(Severity::WARNING, "naming", 
+                                   fmt::format("Material name '{}' does not match pattern '{}'", 
+                                             material.name, plan.materialNameMatcher.getPattern()),
+                                   material.name, "Rename the material to follow the naming convention");
+    }
+}
+
+void Validator::validateTextureResolution(const ValidationPlan& plan, const TextureData& texture,
+                                          std::vector<ValidationIssue>& issues) {
+    if (texture.width > plan.maxTextureWidth || texture.height > plan.maxTextureHeight) {
+        issues.emplace_back(Severity::ERROR, "texture", 
+                           fmt::format("Texture resolution {}x{} exceeds limit {}x{}", 
+                                     texture.width, texture.height, plan.maxTextureWidth, plan.maxTextureHeight),
+                           texture.name, 
+                           fmt::format("Downscale the texture to at most {}x{}", 
+                                     plan.maxTextureWidth, plan.maxTextureHeight));
+    }
+}
+
+void Validator::validateTextureFormat(const ValidationPlan& plan, const TextureData& texture,
+                                      std::vector<ValidationIssue>& issues) {
+    if (plan.allowedTextureFormats.count(texture.format) == 0) {
+        issues.emplace_back(Severity::ERROR, "texture", 
+                           fmt::format("Texture format '{}' is not allowed", texture.format),
+                           texture.name, "Convert the texture to an allowed format");
+    }
+}
+
+void Validator::validateTexturePowerOfTwo(const ValidationPlan& /*plan*/, const TextureData& texture,
+                                          std::vector<ValidationIssue>& issues) {
+    // Unknown dimensions are reported by the loader, not here
+    if (texture.width == 0 || texture.height == 0) {
+        return;
+    }
+    if (!isPowerOfTwo(texture.width) || !isPowerOfTwo(texture.height)) {
+        issues.emplace_back(Severity::WARNING, "texture", 
+                           fmt::format("Texture dimensions {}x{} are not powers of two", 
+                                     texture.width, texture.height),
+                           texture.name, "Resize to power-of-two dimensions for mipmapping and compression");
+    }
+}
+
+void Validator::validateTextureNaming(const ValidationPlan& plan, const TextureData& texture,
+                                      std::vector<ValidationIssue>& issues) {
+    if (!plan.textureNameMatcher.matches(texture.name)) {
+        issues.emplace_back(Severity::WARNING, "naming", 
+                           fmt::format("Texture name '{}' does not match pattern '{}'", 
+                                     texture.name, plan.textureNameMatcher.getPattern()),
+                           texture.name, "Rename the texture to follow the naming convention");
+    }
+}
+
+void Validator::validateTextureGpuMemory(const ValidationPlan& plan, const TextureData& texture,
+                                         std::vector<ValidationIssue>& issues) {
+    if (plan.maxTextureMemoryBytes == 0) {
+        return;
+    }
+    
+    const GpuMemoryEstimator estimator(plan.textureFormat, plan.normalTextureFormat, plan.mipChains);
+    const GpuMemoryEstimate estimate = estimator.estimateTexture(texture);
+    if (estimate.bytes > plan.maxTextureMemoryBytes) {
+        issues.emplace_back(Severity::ERROR, "performance", 
+                            fmt::format("Texture needs {} of GPU memory as {} ({}x{}, {} mips), above the {} budget", 
+                                      formatMegabytes(estimate.bytes), GpuMemoryEstimator::formatName(estimate.format),
+                                      texture.width, texture.height, estimate.mipLevels,
+                                      formatMegabytes(plan.maxTextureMemoryBytes)),
+                            texture.name, "Downscale the texture or use a smaller block format");
+    }
+}
+
+bool Validator::isPowerOfTwo(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "VertexCacheAnalyzer.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+    const uint32_t kFetchLineBytes = 64;
+    const uint32_t kFetchCacheLines = (128 * 1024) / kFetchLineBytes;
+
+    // Direct-mapped; stores line + 1 so zero means empty
+    class FetchCache {
+    public:
+        explicit FetchCache(uint32_t stride) : stride(stride), lines(kFetchCacheLines, 0) {}
+
+        void fetch(uint32_t vertex) {
+            const uint64_t first = uint64_t(vertex) * stride / kFetchLineBytes;
+            const uint64_t last = (uint64_t(vertex) * stride + stride - 1) / kFetchLineBytes;
+            for (uint64_t line = first; line <= last; ++line) {
+                uint64_t& slot = lines[line % kFetchCacheLines];
+                if (slot != line + 1) {
+                    slot = line + 1;
+                    fetchedBytes += kFetchLineBytes;
+                }
+            }
+        }
+
+        uint64_t fetchedBytes = 0;
+
+    private:
+        uint32_t stride;
+        std::vector<uint64_t> lines;
+    };
+}
+
+VertexCacheAnalyzer::VertexCacheAnalyzer(VertexCacheModel model, uint32_t cacheSize)
+    : model(model), cacheSize(cacheSize) {}
+
+VertexCacheModel VertexCacheAnalyzer::parseModel(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "fifo") {
+        return VertexCacheModel::FIFO;
+    }
+    if (lower == "lru") {
+        return VertexCacheModel::LRU;
+    }
+    throw std::invalid_argument("Unknown vertex cache model '" + name + "' (expected fifo or lru)");
+}
+
+const char* VertexCacheAnalyzer::modelName(VertexCacheModel model) {
+    return model == VertexCacheModel::LRU ? "lru" : "fifo";
+}
+
+VertexCacheResult VertexCacheAnalyzer::analyze(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                               uint32_t vertexStride) const {
+    VertexCacheResult result;
+    result.model = model;
+    result.cacheSize = cacheSize;
+    const size_t triangleCount = indices.size() / 3;
+    FetchCache fetchCache(vertexStride);
+    std::vector<bool> referenced(vertexCount, false);
+    uint64_t validTriangles = 0;
+
+    // FIFO: a vertex is resident while fewer than cacheSize misses happened
+    // since it was loaded, so one timestamp per vertex replaces the queue
+    std::vector<uint64_t> loadedAt(model == VertexCacheModel::FIFO ? vertexCount : 0, 0);
+
+    // LRU: most recently used first; caches are at most a few dozen entries
+    std::vector<uint32_t> recent;
+    recent.reserve(cacheSize);
+
+    auto access = [&](uint32_t vertex) {
+        bool hit;
+        if (model == VertexCacheModel::FIFO) {
+            hit = loadedAt[vertex] != 0 && result.transformedVertices - loadedAt[vertex] < cacheSize;
+        } else {
+            auto it = std::find(recent.begin(), recent.end(), vertex);
+            hit = it != recent.end();
+            if (hit) {
+                std::rotate(recent.begin(), it, it + 1);
+            } else if (cacheSize > 0) {
+                if (recent.size() < cacheSize) {
+                    recent.push_back(vertex);
+                }
+                std::rotate(recent.begin(), recent.end() - 1, recent.end());
+                recent.front() = vertex;
+            }
+        }
+        if (!hit) {
+            result.transformedVertices++;
+            if (model == VertexCacheModel::FIFO) {
+                loadedAt[vertex] = result.transformedVertices;
+            }
+            fetchCache.fetch(vertex);
+        }
+        if (!referenced[vertex]) {
+            referenced[vertex] = true;
+            result.uniqueVertices++;
+        }
+    };
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3];
+        const uint32_t i1 = indices[t * 3 + 1];
+        const uint32_t i2 = indices[t * 3 + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            continue;
+        }
+        access(i0);
+        access(i1);
+        access(i2);
+        validTriangles++;
+    }
+
+    result.fetchedBytes = fetchCache.fetchedBytes;
+    if (validTriangles > 0) {
+        result.acmr = static_cast<float>(result.transformedVertices) / validTriangles;
+        result.atvr = static_cast<float>(result.transformedVertices) / result.uniqueVertices;
+        result.overfetch = static_cast<float>(result.fetchedBytes) /
+                           (static_cast<float>(result.uniqueVertices) * vertexStride);
+    }
+    return result;
+}
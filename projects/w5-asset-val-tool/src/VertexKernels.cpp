@@ -0,0 +1,248 @@
+#include "VertexKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(VERTEX_KERNELS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "Kernels expect tightly packed glm::vec2");
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "Kernels expect tightly packed glm::vec3");
+
+namespace VertexKernels {
+
+namespace {
+    bool cpuSupports(InstructionSet instructionSet) {
+#if defined(VERTEX_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+        switch (instructionSet) {
+            case InstructionSet::Scalar: return true;
+            case InstructionSet::SSE41:  return __builtin_cpu_supports("sse4.1");
+            case InstructionSet::AVX2:   return __builtin_cpu_supports("avx2");
+        }
+        return false;
+#elif defined(VERTEX_KERNELS_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] & (1 << 19)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        switch (instructionSet) {
+            case InstructionSet::Scalar: return true;
+            case InstructionSet::SSE41:  return sse41;
+            case InstructionSet::AVX2:   return avx2;
+        }
+        return false;
+#else
+        return instructionSet == InstructionSet::Scalar;
+#endif
+    }
+
+    InstructionSet resolve(InstructionSet requested) {
+        return cpuSupports(requested) ? requested : getBestInstructionSet();
+    }
+
+    // Classify |length - 1| into the shared histogram layout
+    size_t deviationBin(float deviation) {
+        size_t bin = 0;
+        while (bin < kNormalDeviationBins - 1 && deviation >= kNormalDeviationLimits[bin]) {
+            bin++;
+        }
+        return bin;
+    }
+}
+
+InstructionSet getBestInstructionSet() {
+    static const InstructionSet best = []() {
+        if (cpuSupports(InstructionSet::AVX2)) return InstructionSet::AVX2;
+        if (cpuSupports(InstructionSet::SSE41)) return InstructionSet::SSE41;
+        return InstructionSet::Scalar;
+    }();
+    return best;
+}
+
+const char* getInstructionSetName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar: return "scalar";
+        case InstructionSet::SSE41:  return "sse4.1";
+        case InstructionSet::AVX2:   return "avx2";
+    }
+    return "unknown";
+}
+
+UVStreamStats analyzeUVs(const glm::vec2* uvs, size_t count, float tolerance, InstructionSet instructionSet) {
+    detail::UVAccumulator acc;
+    const float* data = reinterpret_cast<const float*>(uvs);
+
+    switch (resolve(instructionSet)) {
+#if defined(VERTEX_KERNELS_X86)
+        case InstructionSet::AVX2:  detail::accumulateUVsAVX2(data, count, tolerance, acc); break;
+        case InstructionSet::SSE41: detail::accumulateUVsSSE41(data, count, tolerance, acc); break;
+#endif
+        default:                    detail::accumulateUVsScalar(data, count, tolerance, acc); break;
+    }
+
+    UVStreamStats stats;
+    stats.outOfRangeCount = acc.outOfRange;
+    stats.nonFiniteCount = acc.nonFinite;
+    if (acc.nonFinite < count) {
+        stats.min = glm::vec2(acc.min[0], acc.min[1]);
+        stats.max = glm::vec2(acc.max[0], acc.max[1]);
+    }
+    return stats;
+}
+
+PositionStreamStats analyzePositions(const glm::vec3* positions, size_t count, InstructionSet instructionSet) {
+    detail::Vec3Accumulator acc;
+    const float* data = reinterpret_cast<const float*>(positions);
+
+    switch (resolve(instructionSet)) {
+#if defined(VERTEX_KERNELS_X86)
+        case InstructionSet::AVX2:  detail::accumulatePositionsAVX2(data, count, acc); break;
+        case InstructionSet::SSE41: detail::accumulatePositionsSSE41(data, count, acc); break;
+#endif
+        default:                    detail::accumulatePositionsScalar(data, count, acc); break;
+    }
+
+    PositionStreamStats stats;
+    stats.nonFiniteCount = acc.nonFinite;
+    if (acc.nonFinite < count) {
+        stats.min = glm::vec3(acc.min[0], acc.min[1], acc.min[2]);
+        stats.max = glm::vec3(acc.max[0], acc.max[1], acc.max[2]);
+    }
+    return stats;
+}
+
+NormalStreamStats analyzeNormals(const glm::vec3* normals, size_t count, InstructionSet instructionSet) {
+    detail::Vec3Accumulator acc;
+    const float* data = reinterpret_cast<const float*>(normals);
+
+    switch (resolve(instructionSet)) {
+#if defined(VERTEX_KERNELS_X86)
+        case InstructionSet::AVX2:  detail::accumulateNormalsAVX2(data, count, acc); break;
+        case InstructionSet::SSE41: detail::accumulateNormalsSSE41(data, count, acc); break;
+#endif
+        default:                    detail::accumulateNormalsScalar(data, count, acc); break;
+    }
+
+    NormalStreamStats stats;
+    stats.nonFiniteCount = acc.nonFinite;
+    stats.deviationHistogram = acc.histogram;
+    return stats;
+}
+
+TangentStreamStats analyzeTangents(const glm::vec3* normals, const glm::vec3* tangents,
+                                   const glm::vec3* bitangents, size_t count, int8_t* handedness,
+                                   InstructionSet instructionSet) {
+    detail::TangentAccumulator acc;
+    const float* n = reinterpret_cast<const float*>(normals);
+    const float* t = reinterpret_cast<const float*>(tangents);
+    const float* b = reinterpret_cast<const float*>(bitangents);
+
+    switch (resolve(instructionSet)) {
+#if defined(VERTEX_KERNELS_X86)
+        case InstructionSet::AVX2:  detail::accumulateTangentsAVX2(n, t, b, count, handedness, acc); break;
+        case InstructionSet::SSE41: detail::accumulateTangentsSSE41(n, t, b, count, handedness, acc); break;
+#endif
+        default:                    detail::accumulateTangentsScalar(n, t, b, count, handedness, acc); break;
+    }
+
+    TangentStreamStats stats;
+    stats.nonFiniteCount = acc.nonFinite;
+    stats.zeroLengthCount = acc.zeroLength;
+    stats.mirroredCount = acc.mirrored;
+    return stats;
+}
+
+namespace detail {
+
+UVAccumulator::UVAccumulator() : min{FLT_MAX, FLT_MAX}, max{-FLT_MAX, -FLT_MAX} {}
+
+Vec3Accumulator::Vec3Accumulator() : min{FLT_MAX, FLT_MAX, FLT_MAX}, max{-FLT_MAX, -FLT_MAX, -FLT_MAX} {}
+
+void accumulateUVsScalar(const float* uvs, size_t count, float tolerance, UVAccumulator& acc) {
+    const float low = -tolerance;
+    const float high = 1.0f + tolerance;
+    for (size_t i = 0; i < count; ++i) {
+        const float u = uvs[i * 2];
+        const float v = uvs[i * 2 + 1];
+        if (!std::isfinite(u) || !std::isfinite(v)) {
+            acc.nonFinite++;
+            continue;
+        }
+        acc.min[0] = std::min(acc.min[0], u);
+        acc.min[1] = std::min(acc.min[1], v);
+        acc.max[0] = std::max(acc.max[0], u);
+        acc.max[1] = std::max(acc.max[1], v);
+        if (u < low || u > high || v < low || v > high) {
+            acc.outOfRange++;
+        }
+    }
+}
+
+void accumulatePositionsScalar(const float* positions, size_t count, Vec3Accumulator& acc) {
+    for (size_t i = 0; i < count; ++i) {
+        const float* p = positions + i * 3;
+        if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+            acc.nonFinite++;
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            acc.min[c] = std::min(acc.min[c], p[c]);
+            acc.max[c] = std::max(acc.max[c], p[c]);
+        }
+    }
+}
+
+void accumulateNormalsScalar(const float* normals, size_t count, Vec3Accumulator& acc) {
+    for (size_t i = 0; i < count; ++i) {
+        const float* n = normals + i * 3;
+        if (!std::isfinite(n[0]) || !std::isfinite(n[1]) || !std::isfinite(n[2])) {
+            acc.nonFinite++;
+            continue;
+        }
+        // Same operation order as the SIMD kernels so bins match exactly
+        const float lengthSq = (n[0] * n[0] + n[1] * n[1]) + n[2] * n[2];
+        acc.histogram[deviationBin(std::fabs(std::sqrt(lengthSq) - 1.0f))]++;
+    }
+}
+
+void accumulateTangentsScalar(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                              int8_t* handedness, TangentAccumulator& acc) {
+    for (size_t i = 0; i < count; ++i) {
+        const float* n = normals + i * 3;
+        const float* t = tangents + i * 3;
+        const float* b = bitangents + i * 3;
+        handedness[i] = 0;
+        if (!std::isfinite(t[0]) || !std::isfinite(t[1]) || !std::isfinite(t[2]) ||
+            !std::isfinite(b[0]) || !std::isfinite(b[1]) || !std::isfinite(b[2])) {
+            acc.nonFinite++;
+            continue;
+        }
+        if ((t[0] * t[0] + t[1] * t[1]) + t[2] * t[2] < kMinTangentLengthSq) {
+            acc.zeroLength++;
+            continue;
+        }
+        // dot(cross(n, t), b); a NaN normal or zero bitangent leaves 0
+        const float cx = n[1] * t[2] - n[2] * t[1];
+        const float cy = n[2] * t[0] - n[0] * t[2];
+        const float cz = n[0] * t[1] - n[1] * t[0];
+        const float h = (cx * b[0] + cy * b[1]) + cz * b[2];
+        if (h > 0.0f) {
+            handedness[i] = 1;
+        } else if (h < 0.0f) {
+            handedness[i] = -1;
+            acc.mirrored++;
+        }
+    }
+}
+
+} // namespace detail
+} // namespace VertexKernels
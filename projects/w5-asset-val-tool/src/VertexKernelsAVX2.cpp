@@ -0,0 +1,211 @@
+// AVX2 variants of the vertex stream kernels. This file is compiled with
+// AVX2 enabled and is only ever called after a runtime CPU check.
+#include "VertexKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <immintrin.h>
+
+namespace VertexKernels {
+namespace detail {
+
+namespace {
+    inline uint64_t countBits(unsigned bits) {
+        uint64_t count = 0;
+        for (; bits; bits &= bits - 1) {
+            count++;
+        }
+        return count;
+    }
+
+    // All-ones in every lane whose exponent bits are all set (NaN or Inf)
+    inline __m256 nonFiniteMask(__m256 v) {
+        const __m256i exponent = _mm256_set1_epi32(0x7F800000);
+        const __m256i bits = _mm256_and_si256(_mm256_castps_si256(v), exponent);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(bits, exponent));
+    }
+
+    inline float reduceMin(__m256 v) {
+        __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+
+    inline float reduceMax(__m256 v) {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+
+    // Split 8 packed xyz vertices into one register per component. Lanes
+    // hold vertices in the order 0,3,6,1,4,7,2,5 - all three components use
+    // the same order, which is all the reductions below need.
+    inline void loadXYZ8(const float* p, __m256& x, __m256& y, __m256& z) {
+        const __m256 m0 = _mm256_loadu_ps(p);
+        const __m256 m1 = _mm256_loadu_ps(p + 8);
+        const __m256 m2 = _mm256_loadu_ps(p + 16);
+        x = _mm256_blend_ps(_mm256_blend_ps(m0, m1, 0x92), m2, 0x24);
+        y = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(m0, m1, 0x24), m2, 0x49),
+                                     _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0));
+        z = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(m0, m1, 0x49), m2, 0x92),
+                                     _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1));
+    }
+}
+
+void accumulateUVsAVX2(const float* uvs, size_t count, float tolerance, UVAccumulator& acc) {
+    const __m256 low = _mm256_set1_ps(-tolerance);
+    const __m256 high = _mm256_set1_ps(1.0f + tolerance);
+    const __m256 posMax = _mm256_set1_ps(FLT_MAX);
+    const __m256 negMax = _mm256_set1_ps(-FLT_MAX);
+    __m256 vmin = posMax;
+    __m256 vmax = negMax;
+
+    // Four interleaved uv pairs per register: even lanes u, odd lanes v
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256 uv = _mm256_loadu_ps(uvs + i * 2);
+
+        // A vertex is non-finite if either component is: OR each lane pair
+        __m256 bad = nonFiniteMask(uv);
+        bad = _mm256_or_ps(bad, _mm256_permute_ps(bad, 0xB1));
+
+        vmin = _mm256_min_ps(vmin, _mm256_blendv_ps(uv, posMax, bad));
+        vmax = _mm256_max_ps(vmax, _mm256_blendv_ps(uv, negMax, bad));
+
+        const __m256 outside = _mm256_andnot_ps(bad, _mm256_or_ps(_mm256_cmp_ps(uv, low, _CMP_LT_OQ),
+                                                                  _mm256_cmp_ps(uv, high, _CMP_GT_OQ)));
+        const unsigned outsideBits = static_cast<unsigned>(_mm256_movemask_ps(outside));
+        const unsigned badBits = static_cast<unsigned>(_mm256_movemask_ps(bad));
+        acc.outOfRange += countBits((outsideBits | (outsideBits >> 1)) & 0x55u);
+        acc.nonFinite += countBits(badBits & 0x55u);
+    }
+
+    // Fold even/odd lanes into the u/v accumulators
+    alignas(32) float mins[8];
+    alignas(32) float maxs[8];
+    _mm256_store_ps(mins, vmin);
+    _mm256_store_ps(maxs, vmax);
+    for (int lane = 0; lane < 8; ++lane) {
+        acc.min[lane & 1] = std::min(acc.min[lane & 1], mins[lane]);
+        acc.max[lane & 1] = std::max(acc.max[lane & 1], maxs[lane]);
+    }
+
+    accumulateUVsScalar(uvs + i * 2, count - i, tolerance, acc);
+}
+
+void accumulatePositionsAVX2(const float* positions, size_t count, Vec3Accumulator& acc) {
+    const __m256 posMax = _mm256_set1_ps(FLT_MAX);
+    const __m256 negMax = _mm256_set1_ps(-FLT_MAX);
+    __m256 minX = posMax, minY = posMax, minZ = posMax;
+    __m256 maxX = negMax, maxY = negMax, maxZ = negMax;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x, y, z;
+        loadXYZ8(positions + i * 3, x, y, z);
+
+        const __m256 bad = _mm256_or_ps(nonFiniteMask(x), _mm256_or_ps(nonFiniteMask(y), nonFiniteMask(z)));
+        minX = _mm256_min_ps(minX, _mm256_blendv_ps(x, posMax, bad));
+        minY = _mm256_min_ps(minY, _mm256_blendv_ps(y, posMax, bad));
+        minZ = _mm256_min_ps(minZ, _mm256_blendv_ps(z, posMax, bad));
+        maxX = _mm256_max_ps(maxX, _mm256_blendv_ps(x, negMax, bad));
+        maxY = _mm256_max_ps(maxY, _mm256_blendv_ps(y, negMax, bad));
+        maxZ = _mm256_max_ps(maxZ, _mm256_blendv_ps(z, negMax, bad));
+        acc.nonFinite += countBits(static_cast<unsigned>(_mm256_movemask_ps(bad)));
+    }
+
+    acc.min[0] = std::min(acc.min[0], reduceMin(minX));
+    acc.min[1] = std::min(acc.min[1], reduceMin(minY));
+    acc.min[2] = std::min(acc.min[2], reduceMin(minZ));
+    acc.max[0] = std::max(acc.max[0], reduceMax(maxX));
+    acc.max[1] = std::max(acc.max[1], reduceMax(maxY));
+    acc.max[2] = std::max(acc.max[2], reduceMax(maxZ));
+
+    accumulatePositionsScalar(positions + i * 3, count - i, acc);
+}
+
+void accumulateNormalsAVX2(const float* normals, size_t count, Vec3Accumulator& acc) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 limits[kNormalDeviationBins - 1];
+    for (size_t b = 0; b < kNormalDeviationBins - 1; ++b) {
+        limits[b] = _mm256_set1_ps(kNormalDeviationLimits[b]);
+    }
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x, y, z;
+        loadXYZ8(normals + i * 3, x, y, z);
+
+        const __m256 bad = _mm256_or_ps(nonFiniteMask(x), _mm256_or_ps(nonFiniteMask(y), nonFiniteMask(z)));
+        const unsigned validBits = ~static_cast<unsigned>(_mm256_movemask_ps(bad)) & 0xFFu;
+
+        const __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+                                              _mm256_mul_ps(z, z));
+        const __m256 deviation = _mm256_and_ps(_mm256_sub_ps(_mm256_sqrt_ps(lengthSq), one), absMask);
+
+        // Limits are ascending, so "at or above limit b" counts are nested
+        // and each bin is the difference of two neighbouring counts
+        uint64_t remaining = countBits(validBits);
+        for (size_t b = 0; b < kNormalDeviationBins - 1; ++b) {
+            const unsigned aboveBits = static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_cmp_ps(deviation, limits[b], _CMP_GE_OQ))) & validBits;
+            const uint64_t above = countBits(aboveBits);
+            acc.histogram[b] += remaining - above;
+            remaining = above;
+        }
+        acc.histogram[kNormalDeviationBins - 1] += remaining;
+        acc.nonFinite += 8 - countBits(validBits);
+    }
+
+    accumulateNormalsScalar(normals + i * 3, count - i, acc);
+}
+
+void accumulateTangentsAVX2(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                            int8_t* handedness, TangentAccumulator& acc) {
+    // Vertex held by each lane after loadXYZ8
+    static const int kLaneVertex[8] = {0, 3, 6, 1, 4, 7, 2, 5};
+    const __m256 minLengthSq = _mm256_set1_ps(kMinTangentLengthSq);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 allOnes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 nx, ny, nz, tx, ty, tz, bx, by, bz;
+        loadXYZ8(normals + i * 3, nx, ny, nz);
+        loadXYZ8(tangents + i * 3, tx, ty, tz);
+        loadXYZ8(bitangents + i * 3, bx, by, bz);
+
+        const __m256 badTangent = _mm256_or_ps(nonFiniteMask(tx), _mm256_or_ps(nonFiniteMask(ty), nonFiniteMask(tz)));
+        const __m256 badBitangent = _mm256_or_ps(nonFiniteMask(bx), _mm256_or_ps(nonFiniteMask(by), nonFiniteMask(bz)));
+        const __m256 bad = _mm256_or_ps(badTangent, badBitangent);
+        const __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, tx), _mm256_mul_ps(ty, ty)),
+                                              _mm256_mul_ps(tz, tz));
+        const __m256 shortTangent = _mm256_andnot_ps(bad, _mm256_cmp_ps(lengthSq, minLengthSq, _CMP_LT_OQ));
+        const __m256 usable = _mm256_andnot_ps(_mm256_or_ps(bad, shortTangent), allOnes);
+
+        const __m256 cx = _mm256_sub_ps(_mm256_mul_ps(ny, tz), _mm256_mul_ps(nz, ty));
+        const __m256 cy = _mm256_sub_ps(_mm256_mul_ps(nz, tx), _mm256_mul_ps(nx, tz));
+        const __m256 cz = _mm256_sub_ps(_mm256_mul_ps(nx, ty), _mm256_mul_ps(ny, tx));
+        const __m256 h = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, bx), _mm256_mul_ps(cy, by)),
+                                       _mm256_mul_ps(cz, bz));
+        const unsigned positive = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_and_ps(usable, _mm256_cmp_ps(h, zero, _CMP_GT_OQ))));
+        const unsigned negative = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_and_ps(usable, _mm256_cmp_ps(h, zero, _CMP_LT_OQ))));
+
+        for (int lane = 0; lane < 8; ++lane) {
+            handedness[i + kLaneVertex[lane]] =
+                static_cast<int8_t>(((positive >> lane) & 1) - ((negative >> lane) & 1));
+        }
+        acc.nonFinite += countBits(static_cast<unsigned>(_mm256_movemask_ps(bad)));
+        acc.zeroLength += countBits(static_cast<unsigned>(_mm256_movemask_ps(shortTangent)));
+        acc.mirrored += countBits(negative);
+    }
+
+    accumulateTangentsScalar(normals + i * 3, tangents + i * 3, bitangents + i * 3, count - i, handedness + i, acc);
+}
+
+} // namespace detail
+} // namespace VertexKernels
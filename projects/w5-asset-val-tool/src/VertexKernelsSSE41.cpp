@@ -0,0 +1,200 @@
+// SSE4.1 variants of the vertex stream kernels. This file is compiled with
+// SSE4.1 enabled and is only ever called after a runtime CPU check.
+#include "VertexKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <smmintrin.h>
+
+namespace VertexKernels {
+namespace detail {
+
+namespace {
+    inline uint64_t countBits(unsigned bits) {
+        uint64_t count = 0;
+        for (; bits; bits &= bits - 1) {
+            count++;
+        }
+        return count;
+    }
+
+    // All-ones in every lane whose exponent bits are all set (NaN or Inf)
+    inline __m128 nonFiniteMask(__m128 v) {
+        const __m128i exponent = _mm_set1_epi32(0x7F800000);
+        const __m128i bits = _mm_and_si128(_mm_castps_si128(v), exponent);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(bits, exponent));
+    }
+
+    inline float reduceMin(__m128 m) {
+        m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+
+    inline float reduceMax(__m128 m) {
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+
+    // Split 4 packed xyz vertices into one register per component. Lanes
+    // hold vertices in the order 0,3,2,1 for all three components.
+    inline void loadXYZ4(const float* p, __m128& x, __m128& y, __m128& z) {
+        const __m128 m0 = _mm_loadu_ps(p);
+        const __m128 m1 = _mm_loadu_ps(p + 4);
+        const __m128 m2 = _mm_loadu_ps(p + 8);
+        x = _mm_blend_ps(_mm_blend_ps(m0, m1, 0x4), m2, 0x2);
+        const __m128 yb = _mm_blend_ps(_mm_blend_ps(m0, m1, 0x9), m2, 0x4);
+        const __m128 zb = _mm_blend_ps(_mm_blend_ps(m0, m1, 0x2), m2, 0x9);
+        y = _mm_shuffle_ps(yb, yb, _MM_SHUFFLE(0, 3, 2, 1));
+        z = _mm_shuffle_ps(zb, zb, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+}
+
+void accumulateUVsSSE41(const float* uvs, size_t count, float tolerance, UVAccumulator& acc) {
+    const __m128 low = _mm_set1_ps(-tolerance);
+    const __m128 high = _mm_set1_ps(1.0f + tolerance);
+    const __m128 posMax = _mm_set1_ps(FLT_MAX);
+    const __m128 negMax = _mm_set1_ps(-FLT_MAX);
+    __m128 vmin = posMax;
+    __m128 vmax = negMax;
+
+    // Two interleaved uv pairs per register: even lanes u, odd lanes v
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128 uv = _mm_loadu_ps(uvs + i * 2);
+
+        // A vertex is non-finite if either component is: OR each lane pair
+        __m128 bad = nonFiniteMask(uv);
+        bad = _mm_or_ps(bad, _mm_shuffle_ps(bad, bad, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        vmin = _mm_min_ps(vmin, _mm_blendv_ps(uv, posMax, bad));
+        vmax = _mm_max_ps(vmax, _mm_blendv_ps(uv, negMax, bad));
+
+        const __m128 outside = _mm_andnot_ps(bad, _mm_or_ps(_mm_cmplt_ps(uv, low), _mm_cmpgt_ps(uv, high)));
+        const unsigned outsideBits = static_cast<unsigned>(_mm_movemask_ps(outside));
+        const unsigned badBits = static_cast<unsigned>(_mm_movemask_ps(bad));
+        acc.outOfRange += countBits((outsideBits | (outsideBits >> 1)) & 0x5u);
+        acc.nonFinite += countBits(badBits & 0x5u);
+    }
+
+    alignas(16) float mins[4];
+    alignas(16) float maxs[4];
+    _mm_store_ps(mins, vmin);
+    _mm_store_ps(maxs, vmax);
+    for (int lane = 0; lane < 4; ++lane) {
+        acc.min[lane & 1] = std::min(acc.min[lane & 1], mins[lane]);
+        acc.max[lane & 1] = std::max(acc.max[lane & 1], maxs[lane]);
+    }
+
+    accumulateUVsScalar(uvs + i * 2, count - i, tolerance, acc);
+}
+
+void accumulatePositionsSSE41(const float* positions, size_t count, Vec3Accumulator& acc) {
+    const __m128 posMax = _mm_set1_ps(FLT_MAX);
+    const __m128 negMax = _mm_set1_ps(-FLT_MAX);
+    __m128 minX = posMax, minY = posMax, minZ = posMax;
+    __m128 maxX = negMax, maxY = negMax, maxZ = negMax;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z;
+        loadXYZ4(positions + i * 3, x, y, z);
+
+        const __m128 bad = _mm_or_ps(nonFiniteMask(x), _mm_or_ps(nonFiniteMask(y), nonFiniteMask(z)));
+        minX = _mm_min_ps(minX, _mm_blendv_ps(x, posMax, bad));
+        minY = _mm_min_ps(minY, _mm_blendv_ps(y, posMax, bad));
+        minZ = _mm_min_ps(minZ, _mm_blendv_ps(z, posMax, bad));
+        maxX = _mm_max_ps(maxX, _mm_blendv_ps(x, negMax, bad));
+        maxY = _mm_max_ps(maxY, _mm_blendv_ps(y, negMax, bad));
+        maxZ = _mm_max_ps(maxZ, _mm_blendv_ps(z, negMax, bad));
+        acc.nonFinite += countBits(static_cast<unsigned>(_mm_movemask_ps(bad)));
+    }
+
+    acc.min[0] = std::min(acc.min[0], reduceMin(minX));
+    acc.min[1] = std::min(acc.min[1], reduceMin(minY));
+    acc.min[2] = std::min(acc.min[2], reduceMin(minZ));
+    acc.max[0] = std::max(acc.max[0], reduceMax(maxX));
+    acc.max[1] = std::max(acc.max[1], reduceMax(maxY));
+    acc.max[2] = std::max(acc.max[2], reduceMax(maxZ));
+
+    accumulatePositionsScalar(positions + i * 3, count - i, acc);
+}
+
+void accumulateNormalsSSE41(const float* normals, size_t count, Vec3Accumulator& acc) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 limits[kNormalDeviationBins - 1];
+    for (size_t b = 0; b < kNormalDeviationBins - 1; ++b) {
+        limits[b] = _mm_set1_ps(kNormalDeviationLimits[b]);
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z;
+        loadXYZ4(normals + i * 3, x, y, z);
+
+        const __m128 bad = _mm_or_ps(nonFiniteMask(x), _mm_or_ps(nonFiniteMask(y), nonFiniteMask(z)));
+        const unsigned validBits = ~static_cast<unsigned>(_mm_movemask_ps(bad)) & 0xFu;
+
+        const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 deviation = _mm_and_ps(_mm_sub_ps(_mm_sqrt_ps(lengthSq), one), absMask);
+
+        // Nested "at or above limit b" counts, differenced into bins
+        uint64_t remaining = countBits(validBits);
+        for (size_t b = 0; b < kNormalDeviationBins - 1; ++b) {
+            const unsigned aboveBits = static_cast<unsigned>(
+                _mm_movemask_ps(_mm_cmpge_ps(deviation, limits[b]))) & validBits;
+            const uint64_t above = countBits(aboveBits);
+            acc.histogram[b] += remaining - above;
+            remaining = above;
+        }
+        acc.histogram[kNormalDeviationBins - 1] += remaining;
+        acc.nonFinite += 4 - countBits(validBits);
+    }
+
+    accumulateNormalsScalar(normals + i * 3, count - i, acc);
+}
+
+void accumulateTangentsSSE41(const float* normals, const float* tangents, const float* bitangents, size_t count,
+                             int8_t* handedness, TangentAccumulator& acc) {
+    // Vertex held by each lane after loadXYZ4
+    static const int kLaneVertex[4] = {0, 3, 2, 1};
+    const __m128 minLengthSq = _mm_set1_ps(kMinTangentLengthSq);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 allOnes = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 nx, ny, nz, tx, ty, tz, bx, by, bz;
+        loadXYZ4(normals + i * 3, nx, ny, nz);
+        loadXYZ4(tangents + i * 3, tx, ty, tz);
+        loadXYZ4(bitangents + i * 3, bx, by, bz);
+
+        const __m128 badTangent = _mm_or_ps(nonFiniteMask(tx), _mm_or_ps(nonFiniteMask(ty), nonFiniteMask(tz)));
+        const __m128 badBitangent = _mm_or_ps(nonFiniteMask(bx), _mm_or_ps(nonFiniteMask(by), nonFiniteMask(bz)));
+        const __m128 bad = _mm_or_ps(badTangent, badBitangent);
+        const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz));
+        const __m128 shortTangent = _mm_andnot_ps(bad, _mm_cmplt_ps(lengthSq, minLengthSq));
+        const __m128 usable = _mm_andnot_ps(_mm_or_ps(bad, shortTangent), allOnes);
+
+        const __m128 cx = _mm_sub_ps(_mm_mul_ps(ny, tz), _mm_mul_ps(nz, ty));
+        const __m128 cy = _mm_sub_ps(_mm_mul_ps(nz, tx), _mm_mul_ps(nx, tz));
+        const __m128 cz = _mm_sub_ps(_mm_mul_ps(nx, ty), _mm_mul_ps(ny, tx));
+        const __m128 h = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, bx), _mm_mul_ps(cy, by)), _mm_mul_ps(cz, bz));
+        const unsigned positive = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(usable, _mm_cmpgt_ps(h, zero))));
+        const unsigned negative = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(usable, _mm_cmplt_ps(h, zero))));
+
+        for (int lane = 0; lane < 4; ++lane) {
+            handedness[i + kLaneVertex[lane]] =
+                static_cast<int8_t>(((positive >> lane) & 1) - ((negative >> lane) & 1));
+        }
+        acc.nonFinite += countBits(static_cast<unsigned>(_mm_movemask_ps(bad)));
+        acc.zeroLength += countBits(static_cast<unsigned>(_mm_movemask_ps(shortTangent)));
+        acc.mirrored += countBits(negative);
+    }
+
+    accumulateTangentsScalar(normals + i * 3, tangents + i * 3, bitangents + i * 3, count - i, handedness + i, acc);
+}
+
+} // namespace detail
+} // namespace VertexKernels
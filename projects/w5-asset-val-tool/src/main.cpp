@@ -1,18 +1,42 @@
 #include <iostream>
 #include <string>
+#include <vector>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <fmt/core.h>
 #include "AssetLoader.h"
 #include "Validator.h"
 #include "Reporter.h"
 #include "ValidationConfig.h"
+#include "MeshOptimizer.h"
+#include "GltfWriter.h"
+#include "MeshSimplifier.h"
+#include "MaterialDeduplicator.h"
+#include "GeometryHasher.h"
+#include "MeshletWriter.h"
 
 void printUsage(const char* programName) {
     fmt::print("Usage: {} [OPTIONS] <input_file>\n", programName);
     fmt::print("\nOptions:\n");
-    fmt::print("  -c, --config <file>     Use custom validation config file\n");
+    fmt::print("  -c, --config <file>     Use custom validation config file; repeat to validate against\n");
+    fmt::print("                          several profiles in one pass (the first gives the details)\n");
     fmt::print("  -o, --output <file>     Output report file (default: report.json)\n");
     fmt::print("  -f, --format <format>   Report format: json, html, console (default: json)\n");
+    fmt::print("  -j, --threads <n>       Validation threads (default: config, 0 = all cores)\n");
+    fmt::print("  --fix <file>           Write an optimized copy (.gltf or .glb) after validating\n");
+    fmt::print("  --lods                 Generate LOD chains (ratios from the config)\n");
+    fmt::print("  --hidden               Find triangles hidden inside other geometry (ray cast)\n");
+    fmt::print("  --texel-hints <file>   Write per-mesh mip bias / streaming priority hints (JSON)\n");
+    fmt::print("  --meshlets <file>      Write meshlets with bounds and normal cones for the --fix copy\n");
+    fmt::print("                         (binary; requires --fix)\n");
+    fmt::print("  --mesh-index <file>    Find copies of meshes from earlier runs and record this file's\n");
+    fmt::print("                         (JSON; share one index across a batch)\n");
+    fmt::print("  --material-index <file> Dedup materials against earlier runs and record this file's\n");
+    fmt::print("                         (JSON; share one index across a batch)\n");
+    fmt::print("  --fail-fast            Stop at the first error (same exit code, partial report)\n");
+    fmt::print("  --max-errors <n>       Stop after n errors\n");
     fmt::print("  -v, --verbose           Enable verbose output\n");
     fmt::print("  --no-stats             Disable statistics in report\n");
     fmt::print("  --no-suggestions       Disable suggestions in report\n");
@@ -20,8 +44,14 @@ void printUsage(const char* programName) {
     fmt::print("\nExamples:\n");
     fmt::print("  {} model.gltf\n", programName);
     fmt::print("  {} -c custom_config.json -o validation_report.json model.gltf\n", programName);
+    fmt::print("  {} -c mobile.json -c console.json -c desktop.json -f html -o report.html model.gltf\n", programName);
     fmt::print("  {} -f html -o report.html model.gltf\n", programName);
     fmt::print("  {} -f console model.gltf\n", programName);
+    fmt::print("  {} --fix model_optimized.glb model.gltf\n", programName);
+    fmt::print("  {} --lods --fix model_lods.glb model.gltf\n", programName);
+    fmt::print("  {} --fix model_optimized.glb --meshlets model_optimized.meshlets model.gltf\n", programName);
+    fmt::print("  {} --fail-fast -f console model.gltf\n", programName);
+    fmt::print("  for f in *.gltf; do {} --mesh-index meshes.json --material-index materials.json \"$f\"; done\n", programName);
 }
 
 ReportFormat parseReportFormat(const std::string& formatStr) {
@@ -36,12 +66,22 @@ ReportFormat parseReportFormat(const std::string& formatStr) {
 int main(int argc, char* argv[]) {
     // Command line arguments
     std::string inputFile;
-    std::string configFile = "validation_config.json";
+    std::vector<std::string> configFiles;
     std::string outputFile = "report.json";
     ReportFormat reportFormat = ReportFormat::JSON;
     bool verbose = false;
     bool includeStats = true;
     bool includeSuggestions = true;
+    int threadCount = -1; // -1 = keep the value from the config file
+    std::string fixOutputFile;
+    bool generateLods = false;
+    bool findHidden = false;
+    bool failFast = false;
+    int maxErrors = -1; // -1 = keep the value from the config file
+    std::string texelHintsFile;
+    std::string meshletFile;
+    std::string materialIndexFile;
+    std::string meshIndexFile;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -61,7 +101,7 @@ int main(int argc, char* argv[]) {
             includeSuggestions = false;
         }
         else if ((arg == "-c" || arg == "--config") && i + 1 < argc) {
-            configFile = argv[++i];
+            configFiles.push_back(argv[++i]);
         }
         else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
             outputFile = argv[++i];
@@ -69,6 +109,36 @@ int main(int argc, char* argv[]) {
         else if ((arg == "-f" || arg == "--format") && i + 1 < argc) {
             reportFormat = parseReportFormat(argv[++i]);
         }
+        else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+            threadCount = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--fix" && i + 1 < argc) {
+            fixOutputFile = argv[++i];
+        }
+        else if (arg == "--lods") {
+            generateLods = true;
+        }
+        else if (arg == "--hidden") {
+            findHidden = true;
+        }
+        else if (arg == "--texel-hints" && i + 1 < argc) {
+            texelHintsFile = argv[++i];
+        }
+        else if (arg == "--meshlets" && i + 1 < argc) {
+            meshletFile = argv[++i];
+        }
+        else if (arg == "--mesh-index" && i + 1 < argc) {
+            meshIndexFile = argv[++i];
+        }
+        else if (arg == "--material-index" && i + 1 < argc) {
+            materialIndexFile = argv[++i];
+        }
+        else if (arg == "--fail-fast") {
+            failFast = true;
+        }
+        else if (arg == "--max-errors" && i + 1 < argc) {
+            maxErrors = std::max(0, std::atoi(argv[++i]));
+        }
         else if (arg[0] != '-') {
             inputFile = arg;
         }
@@ -91,19 +161,58 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if (!fixOutputFile.empty() && std::filesystem::exists(fixOutputFile) &&
+        std::filesystem::equivalent(fixOutputFile, inputFile)) {
+        fmt::print(stderr, "Error: --fix output must not overwrite the input file\n");
+        return 1;
+    }
+    
+    // The loader welds and reorders vertices, so meshlet vertex indices
+    // only match the buffers of the copy --fix writes
+    if (!meshletFile.empty() && fixOutputFile.empty()) {
+        fmt::print(stderr, "Error: --meshlets requires --fix; the meshlets index the optimized copy's vertex buffers\n");
+        return 1;
+    }
+    
+    if (configFiles.empty()) {
+        configFiles.push_back("validation_config.json");
+    }
+    
     try {
-        // Load configuration
-        ValidationConfig config;
-        if (std::filesystem::exists(configFile)) {
-            if (verbose) {
-                fmt::print("Loading configuration from: {}\n", configFile);
+        // Load configuration, one profile per config file
+        std::vector<ValidationProfile> profiles;
+        for (const auto& configFile : configFiles) {
+            ValidationProfile profile;
+            profile.name = std::filesystem::path(configFile).stem().string();
+            if (std::filesystem::exists(configFile)) {
+                if (verbose) {
+                    fmt::print("Loading configuration from: {}\n", configFile);
+                }
+                profile.config = ValidationConfig::loadFromFile(configFile);
+            } else {
+                if (verbose) {
+                    fmt::print("Using default configuration (config file '{}' not found)\n", configFile);
+                }
             }
-            config = ValidationConfig::loadFromFile(configFile);
-        } else {
-            if (verbose) {
-                fmt::print("Using default configuration (config file '{}' not found)\n", configFile);
+            
+            if (threadCount >= 0) {
+                profile.config.threadCount = static_cast<uint32_t>(threadCount);
+            }
+            if (generateLods) {
+                profile.config.generateLODs = true;
+            }
+            if (findHidden) {
+                profile.config.checkHiddenGeometry = true;
             }
+            if (failFast) {
+                profile.config.failFast = true;
+            }
+            if (maxErrors >= 0) {
+                profile.config.maxErrors = static_cast<uint32_t>(maxErrors);
+            }
+            profiles.push_back(std::move(profile));
         }
+        const ValidationConfig& config = profiles[0].config;
         
         // Initialize components
         AssetLoader loader;
@@ -139,7 +248,98 @@ int main(int argc, char* argv[]) {
             fmt::print("Validating asset...\n");
         }
         
-        ValidationResult result = validator.validate(sceneData);
+        const auto validationStart = std::chrono::steady_clock::now();
+        ValidationResult result = profiles.size() > 1 ? validator.validateProfiles(sceneData, profiles)
+                                                       : validator.validate(sceneData);
+        
+        if (verbose) {
+            const double validationMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - validationStart).count();
+            fmt::print("Validation took {:.2f} ms\n", validationMs);
+        }
+        
+        // Optimize and write the fixed copy; the report still describes the input
+        const ValidationPlan& plan = validator.getPlan();
+        
+        // Cross-file duplicate meshes and material dedup, before --fix rewrites anything
+        if (!meshIndexFile.empty() && plan.findDuplicateMeshes) {
+            GeometryIndex index;
+            index.load(meshIndexFile);
+            GeometryHasher(plan.matchRigidDuplicates, plan.rigidDuplicateTolerance, plan.minDuplicateTriangles)
+                .matchIndex(sceneData, result.duplicateMeshes, index);
+            index.save(meshIndexFile);
+            if (verbose) {
+                fmt::print("{} meshes already in the mesh index {}\n", result.duplicateMeshes.indexMatches,
+                           meshIndexFile);
+            }
+        }
+        if (!materialIndexFile.empty() && plan.dedupMaterials) {
+            MaterialIndex index;
+            index.load(materialIndexFile);
+            MaterialDeduplicator(plan.materialFactorSteps).matchIndex(sceneData, result.materialDedup, index);
+            index.save(materialIndexFile);
+            if (verbose) {
+                fmt::print("{} materials already in the material index {}\n", result.materialDedup.indexMatches,
+                           materialIndexFile);
+            }
+        }
+
+        if (!fixOutputFile.empty()) {
+            const auto fixStart = std::chrono::steady_clock::now();
+            MeshOptimizer optimizer(plan.weldPositionTolerance, plan.weldAttributeTolerance,
+                                    plan.vertexCacheModel, plan.vertexCacheSize);
+            result.optimizationResults = optimizer.optimizeScene(sceneData, validator.getThreadPool());
+            
+            if (verbose) {
+                const double fixMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - fixStart).count();
+                fmt::print("Optimization took {:.2f} ms\n", fixMs);
+            }
+        }
+        
+        // LODs are built from the optimized meshes when --fix ran
+        if (config.generateLODs && !plan.lodRatios.empty()) {
+            const auto lodStart = std::chrono::steady_clock::now();
+            MeshSimplifier simplifier(plan.lodMaxRelativeError, plan.vertexCacheSize);
+            result.lodResults = simplifier.buildSceneLods(sceneData, plan.lodRatios, validator.getThreadPool());
+            
+            if (verbose) {
+                const double lodMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - lodStart).count();
+                fmt::print("LOD generation took {:.2f} ms\n", lodMs);
+            }
+        }
+        
+        if (!fixOutputFile.empty()) {
+            GltfWriter writer;
+            writer.setIncludeLods(config.writeLODs);
+            if (!writer.write(sceneData, inputFile, fixOutputFile)) {
+                fmt::print(stderr, "Error writing optimized file: {}\n", writer.getLastError());
+                return 1;
+            }
+            result.optimizedFilePath = fixOutputFile;
+            result.optimizedFileSize = writer.getWrittenBytes();
+        }
+        
+        // Meshlets are built from the meshes as written, so they index the
+        // optimized copy's vertex buffers
+        if (!meshletFile.empty()) {
+            const auto meshletStart = std::chrono::steady_clock::now();
+            MeshletBuilder builder(plan.meshletMaxVertices, plan.meshletMaxTriangles);
+            const std::vector<MeshletMesh> meshlets = builder.buildScene(sceneData, validator.getThreadPool());
+            MeshletWriter writer;
+            if (!writer.write(sceneData, meshlets, builder.getMaxVertices(), builder.getMaxTriangles(), meshletFile)) {
+                fmt::print(stderr, "Error writing meshlets: {}\n", writer.getLastError());
+                return 1;
+            }
+            
+            if (verbose) {
+                const double meshletMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - meshletStart).count();
+                fmt::print("Meshlets saved to: {} ({} bytes, {:.2f} ms)\n", meshletFile, writer.getWrittenBytes(),
+                           meshletMs);
+            }
+        }
         
         // Generate report
         bool reportSuccess = false;
@@ -158,6 +358,16 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        if (!texelHintsFile.empty()) {
+            if (!reporter.generateTexelDensityHints(result, texelHintsFile, plan.targetTexelDensity)) {
+                fmt::print(stderr, "Error writing texel density hints: {}\n", reporter.getLastError());
+                return 1;
+            }
+            if (verbose) {
+                fmt::print("Texel density hints saved to: {}\n", texelHintsFile);
+            }
+        }
+        
         // Print summary
         uint32_t totalIssues = result.globalIssues.size();
         for (const auto& meshResult : result.meshResults) {
@@ -174,7 +384,14 @@ int main(int argc, char* argv[]) {
             }
             fmt::print("\n");
         } else {
-            fmt::print("✗ Validation FAILED with {} issues\n", totalIssues);
+            fmt::print("✗ Validation FAILED with {} issues{}\n", totalIssues,
+                       result.stoppedEarly ? " (stopped at the error budget)" : "");
+        }
+        
+        if (!result.profiles.empty()) {
+            const auto passed = std::count_if(result.profiles.begin(), result.profiles.end(),
+                                              [](const ProfileVerdict& verdict) { return verdict.isValid; });
+            fmt::print("{} of {} profiles passed\n", passed, result.profiles.size());
         }
         
         if (reportFormat != ReportFormat::CONSOLE) {
@@ -0,0 +1,226 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+#include "AssetLoader.h"
+#include "GltfWriter.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "QuadOverdrawAnalyzer.h"
+#include "SelfIntersectionAnalyzer.h"
+#include "TangentFrameAnalyzer.h"
+#include "TexelDensityAnalyzer.h"
+#include "ThreadPool.h"
+#include "TriangleBVH.h"
+#include "Validator.h"
+
+// Regression checks on malformed input. Run with no arguments; exits
+// non-zero when a check fails. Every mesh is generated in memory.
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        fmt::print("FAILED: {}\n", what);
+        failures++;
+    }
+}
+
+// Flat grid of gridSize x gridSize quads with planar UVs
+MeshData makeGridMesh(const std::string& name, uint32_t gridSize) {
+    MeshData mesh;
+    mesh.name = name;
+
+    const uint32_t rowVertices = gridSize + 1;
+    for (uint32_t y = 0; y <= gridSize; ++y) {
+        for (uint32_t x = 0; x <= gridSize; ++x) {
+            const float u = static_cast<float>(x) / gridSize;
+            const float v = static_cast<float>(y) / gridSize;
+            mesh.vertices.emplace_back(u, 0.0f, v);
+            mesh.normals.emplace_back(0.0f, 1.0f, 0.0f);
+            mesh.uvCoords.emplace_back(u, v);
+        }
+    }
+    for (uint32_t y = 0; y < gridSize; ++y) {
+        for (uint32_t x = 0; x < gridSize; ++x) {
+            const uint32_t i0 = y * rowVertices + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + rowVertices;
+            const uint32_t i3 = i2 + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    }
+    mesh.triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    mesh.materialIndices.push_back(0);
+    return mesh;
+}
+
+SceneData makeScene(MeshData mesh) {
+    SceneData scene;
+    scene.filePath = "synthetic";
+    scene.totalVertices = static_cast<uint32_t>(mesh.vertices.size());
+    scene.totalTriangles = mesh.triangleCount;
+    scene.meshes.push_back(std::move(mesh));
+    MaterialData material;
+    material.name = "material_0";
+    scene.materials.push_back(material);
+    return scene;
+}
+
+// One +inf and one NaN vertex in a 64-triangle grid
+MeshData makeNonFiniteMesh() {
+    MeshData mesh = makeGridMesh("non_finite", 4);
+    mesh.vertices[6].y = std::numeric_limits<float>::infinity();
+    mesh.vertices[12].x = std::numeric_limits<float>::quiet_NaN();
+    return mesh;
+}
+
+void testBVHOverNonFiniteCorners() {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<glm::vec3> corners;
+    for (int t = 0; t < 64; ++t) {
+        const float x = static_cast<float>(t);
+        corners.emplace_back(x, 0.0f, 0.0f);
+        corners.emplace_back(x + 1.0f, 0.0f, 0.0f);
+        corners.emplace_back(x, t % 7 == 0 ? inf : 1.0f, t % 5 == 0 ? nan : 0.0f);
+    }
+    ThreadPool pool(2);
+    TriangleBVH bvh;
+    bvh.build(corners, pool);
+    expect(bvh.triangleCount() == 64, "BVH over inf/NaN corners keeps every triangle");
+}
+
+void testSelfIntersectionsWithNonFiniteVertex() {
+    const MeshData mesh = makeNonFiniteMesh();
+    ThreadPool pool(2);
+    const SelfIntersectionResult result = SelfIntersectionAnalyzer(1e-5f).analyze(mesh.vertices, mesh.indices, pool);
+    expect(result.intersectingTriangles == 0, "flat grid with an inf/NaN vertex does not self-intersect");
+}
+
+void testDefaultRunWithNonFiniteVertex() {
+    const SceneData scene = makeScene(makeNonFiniteMesh());
+    ValidationConfig config;
+    config.threadCount = 2;
+    Validator validator(config);
+    const ValidationResult result = validator.validate(scene);
+    expect(result.meshResults.size() == 1 && !result.meshResults[0].issues.empty(),
+           "default run reports the non-finite vertex");
+}
+
+// Indices into a mesh with no vertices at all
+void testTrianglePassesWithoutVertices() {
+    MeshData mesh;
+    mesh.name = "no_vertices";
+    mesh.indices = {0, 1, 2, 2, 1, 3};
+    mesh.triangleCount = 2;
+    ThreadPool pool(2);
+
+    const TexelDensityResult density = TexelDensityAnalyzer(512.0f, 2.0f).analyze(
+        mesh.vertices, mesh.uvCoords, mesh.indices, glm::mat4(1.0f), 1024, 1024, pool);
+    expect(density.measuredTriangles == 0, "texel density measures nothing without vertices");
+    const QuadOverdrawProfile overdraw =
+        QuadOverdrawAnalyzer(1080, 60.0f).profile(mesh.vertices, mesh.indices, glm::mat4(1.0f), pool);
+    expect(overdraw.measuredTriangles == 0, "quad overdraw measures nothing without vertices");
+    const TangentFrameResult frames = TangentFrameAnalyzer(90.0f).analyze(mesh, pool);
+    expect(frames.checkedTriangles == 0, "tangent frames check nothing without vertices");
+
+    ValidationConfig config;
+    config.threadCount = 2;
+    Validator validator(config);
+    const ValidationResult result = validator.validate(makeScene(mesh));
+    expect(result.meshResults.size() == 1, "default run completes on a mesh without vertices");
+}
+
+// Every LOD vertex carries the tangent frame of the source vertex it kept
+void testLodsKeepTangentFrames() {
+    MeshData mesh = makeGridMesh("tangents", 16);
+    std::map<std::pair<float, float>, size_t> sourceOf;
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        mesh.tangents.emplace_back(1.0f, 0.0f, static_cast<float>(i));
+        mesh.bitangents.emplace_back(0.0f, static_cast<float>(i), 1.0f);
+        sourceOf[{mesh.vertices[i].x, mesh.vertices[i].z}] = i;
+    }
+    ThreadPool pool(2);
+    MeshLodResult lodResult;
+    const std::vector<MeshData> lods = MeshSimplifier(0.0f, 16).buildLodChain(mesh, {0.5f, 0.25f}, pool, lodResult);
+    expect(lods.size() == 2, "two LOD levels");
+    for (const MeshData& lod : lods) {
+        expect(lod.tangents.size() == lod.vertices.size() && lod.bitangents.size() == lod.vertices.size(),
+               lod.name + " has a tangent frame per vertex");
+        for (size_t i = 0; i < lod.vertices.size() && i < lod.tangents.size() && i < lod.bitangents.size(); ++i) {
+            const size_t source = sourceOf[{lod.vertices[i].x, lod.vertices[i].z}];
+            if (lod.tangents[i] != mesh.tangents[source] || lod.bitangents[i] != mesh.bitangents[source]) {
+                expect(false, lod.name + " keeps each vertex's own tangent frame");
+                break;
+            }
+        }
+    }
+}
+
+// Three nodes instancing one source mesh stay instanced through --fix,
+// with their tangent frames
+void testFixKeepsInstancesAndTangents() {
+    SceneData scene = makeScene(makeGridMesh("shared", 8));
+    MeshData& shared = scene.meshes[0];
+    shared.sourceMesh = 0;
+    for (size_t i = 0; i < shared.vertices.size(); ++i) {
+        shared.tangents.emplace_back(2.0f, 0.0f, 0.0f);
+        shared.bitangents.emplace_back(0.0f, 0.0f, i % 2 == 0 ? 1.0f : -1.0f);
+    }
+    for (int copy = 1; copy < 3; ++copy) {
+        scene.meshes.push_back(scene.meshes[0]);
+        scene.meshes.back().worldTransform[3] = glm::vec4(2.0f * copy, 0.0f, 0.0f, 1.0f);
+    }
+    scene.meshes.push_back(makeGridMesh("single", 4));
+
+    ThreadPool pool(2);
+    const MeshOptimizer optimizer(1e-6f, 1e-3f, VertexCacheModel::FIFO, 16);
+    const std::vector<MeshOptimizationResult> results = optimizer.optimizeScene(scene, pool);
+    expect(results.size() == 2, "one optimization result per source mesh");
+    expect(scene.meshes[1].indices == scene.meshes[0].indices && scene.meshes[2].vertices == scene.meshes[0].vertices,
+           "instances share the optimized buffers");
+
+    const std::string path = (std::filesystem::temp_directory_path() / "asset_validator_instances.gltf").string();
+    GltfWriter writer;
+    expect(writer.write(scene, "synthetic.gltf", path), "optimized copy is written");
+    std::ifstream file(path);
+    const nlohmann::json gltf = nlohmann::json::parse(file, nullptr, false);
+    expect(!gltf.is_discarded() && gltf["meshes"].size() == 2, "one glTF mesh per source mesh");
+    if (gltf.is_discarded() || gltf["nodes"].size() != 4) {
+        expect(false, "one node per instance");
+        return;
+    }
+    for (int node = 0; node < 3; ++node) {
+        expect(gltf["nodes"][node]["mesh"] == 0, "instance nodes point at the shared mesh");
+    }
+    const nlohmann::json& attributes = gltf["meshes"][0]["primitives"][0]["attributes"];
+    expect(attributes.contains("TANGENT") && gltf["accessors"][attributes["TANGENT"].get<size_t>()]["type"] == "VEC4",
+           "tangents are written as VEC4");
+    std::filesystem::remove(path);
+    std::filesystem::remove(std::filesystem::path(path).replace_extension(".bin"));
+}
+
+} // namespace
+
+int main() {
+    testBVHOverNonFiniteCorners();
+    testSelfIntersectionsWithNonFiniteVertex();
+    testDefaultRunWithNonFiniteVertex();
+    testTrianglePassesWithoutVertices();
+    testLodsKeepTangentFrames();
+    testFixKeepsInstancesAndTangents();
+    if (failures > 0) {
+        fmt::print("{} check(s) failed\n", failures);
+        return 1;
+    }
+    fmt::print("All checks passed\n");
+    return 0;
+}